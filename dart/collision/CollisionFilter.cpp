@@ -109,36 +109,35 @@ bool BodyNodeCollisionFilter::ignoresCollision(
   if (object1 == object2)
     return true;
 
-  auto shapeNode1 = object1->getShapeFrame()->asShapeNode();
-  auto shapeNode2 = object2->getShapeFrame()->asShapeNode();
+  // The BodyNode and Skeleton data are cached in the CollisionObjects by their
+  // CollisionGroups ahead of every collision checking, so we don't need to
+  // look them up here for every pair.
+  const auto* bodyNode1 = object1->mBodyNode;
+  const auto* bodyNode2 = object2->mBodyNode;
 
   // We don't filter out for non-ShapeNode because this class shouldn't have the
   // authority to make decisions about filtering any ShapeFrames that aren't
   // attached to a BodyNode. So here we just return false. In order to decide
   // whether the non-ShapeNode should be ignored, please use other collision
   // filters.
-  if (!shapeNode1 || !shapeNode2)
+  if (!bodyNode1 || !bodyNode2)
     return false;
 
-  auto bodyNode1 = shapeNode1->getBodyNodePtr();
-  auto bodyNode2 = shapeNode2->getBodyNodePtr();
-
   if (bodyNode1 == bodyNode2)
     return true;
 
-  if (!bodyNode1->isCollidable() || !bodyNode2->isCollidable())
+  if (!object1->mIsBodyNodeCollidable || !object2->mIsBodyNodeCollidable)
     return true;
 
-  if (bodyNode1->getSkeleton() == bodyNode2->getSkeleton())
+  if (object1->mSkeleton == object2->mSkeleton)
   {
-    auto skeleton = bodyNode1->getSkeleton();
-
-    if (!skeleton->isEnabledSelfCollisionCheck())
+    if (!object1->mIsSelfCollisionCheckEnabled)
       return true;
 
-    if (!skeleton->isEnabledAdjacentBodyCheck())
+    if (!object1->mIsAdjacentBodyCheckEnabled)
     {
-      if (areAdjacentBodies(bodyNode1, bodyNode2))
+      if (object1->mParentBodyNode == bodyNode2
+          || object2->mParentBodyNode == bodyNode1)
         return true;
     }
   }
@@ -75,6 +75,7 @@ void CollisionGroup::addShapeFrame(const dynamics::ShapeFrame* shapeFrame)
   addCollisionObjectToEngine(collObj.get());
 
   mShapeFrameMap.push_back(std::make_pair(shapeFrame, collObj));
+  mEngineDataVersions.push_back(0u);
 }
 
 //==============================================================================
@@ -108,6 +109,8 @@ void CollisionGroup::removeShapeFrame(const dynamics::ShapeFrame* shapeFrame)
 
   removeCollisionObjectFromEngine(search->second.get());
 
+  mEngineDataVersions.erase(
+        mEngineDataVersions.begin() + (search - mShapeFrameMap.begin()));
   mShapeFrameMap.erase(search);
 }
 
@@ -131,6 +134,7 @@ void CollisionGroup::removeAllShapeFrames()
   removeAllCollisionObjectsFromEngine();
 
   mShapeFrameMap.clear();
+  mEngineDataVersions.clear();
 }
 
 //==============================================================================
@@ -161,6 +165,22 @@ const dynamics::ShapeFrame* CollisionGroup::getShapeFrame(
   return nullptr;
 }
 
+//==============================================================================
+CollisionObject* CollisionGroup::getCollisionObject(
+    const dynamics::ShapeFrame* shapeFrame)
+{
+  const auto search
+      = std::find_if(mShapeFrameMap.begin(), mShapeFrameMap.end(),
+                     [&](const std::pair<const dynamics::ShapeFrame*,
+                                         CollisionObjectPtr>& pair)
+                     { return pair.first == shapeFrame; });
+
+  if (mShapeFrameMap.end() == search)
+    return nullptr;
+
+  return search->second.get();
+}
+
 //==============================================================================
 bool CollisionGroup::collide(
     const CollisionOption& option, CollisionResult* result)
@@ -196,8 +216,22 @@ double CollisionGroup::distance(
 //==============================================================================
 void CollisionGroup::updateEngineData()
 {
-  for (auto& pair : mShapeFrameMap)
-    pair.second->updateEngineData();
+  // A CollisionObject can be shared with other CollisionGroups, which may have
+  // already pushed its latest state to the engine, so each CollisionGroup
+  // keeps track of the versions it has seen itself
+  mUpdatedCollisionObjects.clear();
+  for (std::size_t i = 0; i < mShapeFrameMap.size(); ++i)
+  {
+    CollisionObject* object = mShapeFrameMap[i].second.get();
+    object->updateFilterData();
+    object->updateEngineDataIfChanged();
+
+    if (mEngineDataVersions[i] != object->mEngineDataVersion)
+    {
+      mEngineDataVersions[i] = object->mEngineDataVersion;
+      mUpdatedCollisionObjects.push_back(object);
+    }
+  }
 
   updateCollisionGroupEngineData();
 }
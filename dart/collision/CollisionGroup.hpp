@@ -169,6 +169,11 @@ public:
   /// Get the ShapeFrame corresponding to the given index
   const dynamics::ShapeFrame* getShapeFrame(std::size_t index) const;
 
+  /// Get the CollisionObject that was created for the ShapeFrame in this
+  /// CollisionGroup, or nullptr if the ShapeFrame is not in this
+  /// CollisionGroup
+  CollisionObject* getCollisionObject(const dynamics::ShapeFrame* shapeFrame);
+
   /// Perform collision check within this CollisionGroup.
   bool collide(
       const CollisionOption& option = CollisionOption(false, 1u, nullptr),
@@ -237,7 +242,9 @@ protected:
   virtual void removeAllCollisionObjectsFromEngine() = 0;
 
   /// Update the collision detection engine data such as broadphase algorithm.
-  /// This function will be called ahead of every collision checking.
+  /// This function will be called ahead of every collision checking. Only the
+  /// CollisionObjects in mUpdatedCollisionObjects have changed since the last
+  /// call.
   virtual void updateCollisionGroupEngineData() = 0;
 
 protected:
@@ -265,6 +272,14 @@ protected:
   // original and copy are not guranteed to be the same as we copy std::map
   // (e.g., by world cloning).
 
+  /// Engine data version of each CollisionObject in mShapeFrameMap when this
+  /// CollisionGroup last updated its engine data
+  std::vector<std::size_t> mEngineDataVersions;
+
+  /// CollisionObjects whose engine data changed since the previous update of
+  /// this CollisionGroup. This is filled by updateEngineData() right before
+  /// it calls updateCollisionGroupEngineData().
+  std::vector<CollisionObject*> mUpdatedCollisionObjects;
 };
 
 }  // namespace collision
@@ -33,7 +33,9 @@
 #include "dart/collision/CollisionObject.hpp"
 
 #include "dart/collision/CollisionDetector.hpp"
-#include "dart/dynamics/ShapeFrame.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Shape.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
 
 namespace dart {
 namespace collision {
@@ -68,15 +70,94 @@ const Eigen::Isometry3d& CollisionObject::getTransform() const
   return mShapeFrame->getWorldTransform();
 }
 
+//==============================================================================
+std::uint32_t CollisionObject::getCategoryBits() const
+{
+  return mCategoryBits;
+}
+
+//==============================================================================
+std::uint32_t CollisionObject::getMaskBits() const
+{
+  return mMaskBits;
+}
+
+//==============================================================================
+bool CollisionObject::isMaskedOut(const CollisionObject* other) const
+{
+  return !(mCategoryBits & other->mMaskBits)
+      || !(other->mCategoryBits & mMaskBits);
+}
+
 //==============================================================================
 CollisionObject::CollisionObject(
     CollisionDetector* collisionDetector,
     const dynamics::ShapeFrame* shapeFrame)
   : mCollisionDetector(collisionDetector),
-    mShapeFrame(shapeFrame)
+    mShapeFrame(shapeFrame),
+    mEngineDataVersion(0u),
+    mEngineDataTransform(Eigen::Isometry3d::Identity())
 {
   assert(mCollisionDetector);
   assert(mShapeFrame);
+
+  updateFilterData();
+}
+
+//==============================================================================
+bool CollisionObject::updateEngineDataIfChanged()
+{
+  const Eigen::Isometry3d& tf = getTransform();
+
+  if (mEngineDataVersion > 0u
+      && tf.matrix() == mEngineDataTransform.matrix()
+      && !getShape()->checkDataVariance(dynamics::Shape::DYNAMIC_VERTICES))
+    return false;
+
+  updateEngineData();
+
+  mEngineDataTransform = tf;
+  ++mEngineDataVersion;
+
+  return true;
+}
+
+//==============================================================================
+void CollisionObject::updateFilterData()
+{
+  const auto* collisionAspect = mShapeFrame->getCollisionAspect();
+  if (collisionAspect)
+  {
+    mCategoryBits = collisionAspect->getCategoryBits();
+    mMaskBits = collisionAspect->getMaskBits();
+  }
+  else
+  {
+    mCategoryBits = 0x1u;
+    mMaskBits = 0xFFFFFFFFu;
+  }
+
+  const auto* shapeNode = mShapeFrame->asShapeNode();
+  if (!shapeNode)
+  {
+    mBodyNode = nullptr;
+    mParentBodyNode = nullptr;
+    mSkeleton = nullptr;
+    mIsBodyNodeCollidable = true;
+    mIsSelfCollisionCheckEnabled = true;
+    mIsAdjacentBodyCheckEnabled = true;
+
+    return;
+  }
+
+  const auto skeleton = shapeNode->getSkeleton();
+
+  mBodyNode = shapeNode->getBodyNodePtr().get();
+  mParentBodyNode = mBodyNode->getParentBodyNode();
+  mSkeleton = skeleton.get();
+  mIsBodyNodeCollidable = mBodyNode->isCollidable();
+  mIsSelfCollisionCheckEnabled = skeleton->isEnabledSelfCollisionCheck();
+  mIsAdjacentBodyCheckEnabled = skeleton->isEnabledAdjacentBodyCheck();
 }
 
 }  // namespace collision
@@ -33,6 +33,8 @@
 #ifndef DART_COLLISION_COLLISIONOBJECT_HPP_
 #define DART_COLLISION_COLLISIONOBJECT_HPP_
 
+#include <cstdint>
+
 #include <Eigen/Dense>
 
 #include "dart/collision/SmartPointer.hpp"
@@ -46,6 +48,7 @@ class CollisionObject
 public:
 
   friend class CollisionGroup;
+  friend class BodyNodeCollisionFilter;
 
   /// Destructor
   virtual ~CollisionObject() = default;
@@ -65,6 +68,19 @@ public:
   /// Return the transformation of this CollisionObject in world coordinates
   const Eigen::Isometry3d& getTransform() const;
 
+  /// Return the collision category bits of the ShapeFrame as of the last
+  /// update of the CollisionGroup(s) that this CollisionObject belongs to
+  std::uint32_t getCategoryBits() const;
+
+  /// Return the collision mask bits of the ShapeFrame as of the last update of
+  /// the CollisionGroup(s) that this CollisionObject belongs to
+  std::uint32_t getMaskBits() const;
+
+  /// Return true if the category and mask bits of this and the other
+  /// CollisionObject rule out collisions between the two. Collision detectors
+  /// test this in the broad phase before consulting any CollisionFilter.
+  bool isMaskedOut(const CollisionObject* other) const;
+
 protected:
 
   /// Contructor
@@ -76,6 +92,18 @@ protected:
   /// CollisionGroup.
   virtual void updateEngineData() = 0;
 
+  /// Call updateEngineData() unless the ShapeFrame is known to be unchanged
+  /// since the last call, which is when its world transform is the same and
+  /// its Shape does not have dynamic vertices. Return true if
+  /// updateEngineData() was called.
+  bool updateEngineDataIfChanged();
+
+  /// Cache the collision category and mask bits of the ShapeFrame, and the
+  /// BodyNode and Skeleton data that BodyNodeCollisionFilter needs, so that
+  /// pairwise filtering does not need to look them up for every pair. This is
+  /// called by CollisionGroup ahead of every collision checking.
+  void updateFilterData();
+
 protected:
 
   /// Collision detector
@@ -84,6 +112,40 @@ protected:
   /// ShapeFrame
   const dynamics::ShapeFrame* mShapeFrame;
 
+  /// Number of times that updateEngineDataIfChanged() has called
+  /// updateEngineData(). CollisionGroups compare this against the count they
+  /// saw last to find the CollisionObjects that have moved.
+  std::size_t mEngineDataVersion;
+
+  /// World transform of the ShapeFrame the last time that the engine data was
+  /// updated
+  Eigen::Isometry3d mEngineDataTransform;
+
+  /// Collision category bits of the ShapeFrame
+  std::uint32_t mCategoryBits;
+
+  /// Collision mask bits of the ShapeFrame
+  std::uint32_t mMaskBits;
+
+  /// BodyNode that the ShapeFrame is attached to, or nullptr if the ShapeFrame
+  /// is not a ShapeNode
+  const dynamics::BodyNode* mBodyNode;
+
+  /// Parent of mBodyNode
+  const dynamics::BodyNode* mParentBodyNode;
+
+  /// Skeleton of mBodyNode
+  const dynamics::Skeleton* mSkeleton;
+
+  /// Whether mBodyNode is collidable
+  bool mIsBodyNodeCollidable;
+
+  /// Whether self collision check is enabled for mSkeleton
+  bool mIsSelfCollisionCheckEnabled;
+
+  /// Whether adjacent body check is enabled for mSkeleton
+  bool mIsAdjacentBodyCheckEnabled;
+
 };
 
 }  // namespace collision
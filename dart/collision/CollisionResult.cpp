@@ -40,12 +40,31 @@
 namespace dart {
 namespace collision {
 
+namespace {
+
+//==============================================================================
+bool isSamePair(const Contact& contact1, const Contact& contact2)
+{
+  return (contact1.collisionObject1 == contact2.collisionObject1
+          && contact1.collisionObject2 == contact2.collisionObject2)
+      || (contact1.collisionObject1 == contact2.collisionObject2
+          && contact1.collisionObject2 == contact2.collisionObject1);
+}
+
+} // anonymous namespace
+
 //==============================================================================
 void CollisionResult::addContact(const Contact& contact)
 {
+  // The objects of a contact pair only need to be added once
+  if (mContacts.empty() || !isSamePair(mContacts.back(), contact))
+  {
+    mContactPairBegins.push_back(mContacts.size());
+    addObject(contact.collisionObject1);
+    addObject(contact.collisionObject2);
+  }
+
   mContacts.push_back(contact);
-  addObject(contact.collisionObject1);
-  addObject(contact.collisionObject2);
 }
 
 //==============================================================================
@@ -76,6 +95,31 @@ const std::vector<Contact>& CollisionResult::getContacts() const
   return mContacts;
 }
 
+//==============================================================================
+std::size_t CollisionResult::getNumContactPairs() const
+{
+  return mContactPairBegins.size();
+}
+
+//==============================================================================
+std::size_t CollisionResult::getContactPairBegin(std::size_t index) const
+{
+  assert(index < mContactPairBegins.size());
+
+  return mContactPairBegins[index];
+}
+
+//==============================================================================
+std::size_t CollisionResult::getContactPairEnd(std::size_t index) const
+{
+  assert(index < mContactPairBegins.size());
+
+  if (index + 1u < mContactPairBegins.size())
+    return mContactPairBegins[index + 1u];
+
+  return mContacts.size();
+}
+
 //==============================================================================
 const std::unordered_set<const dynamics::BodyNode*>&
 CollisionResult::getCollidingBodyNodes() const
@@ -118,6 +162,7 @@ CollisionResult::operator bool() const
 void CollisionResult::clear()
 {
   mContacts.clear();
+  mContactPairBegins.clear();
   mCollidingShapeFrames.clear();
   mCollidingBodyNodes.clear();
 }
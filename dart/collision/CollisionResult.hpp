@@ -67,6 +67,19 @@ public:
   /// Return contacts
   const std::vector<Contact>& getContacts() const;
 
+  /// Return the number of contact pairs. A contact pair is a run of
+  /// consecutive contacts between the same two collision objects, so the
+  /// contacts that a collision detector reports for a pair of objects at once
+  /// form a single contact pair.
+  std::size_t getNumContactPairs() const;
+
+  /// Return the index of the first contact of the index-th contact pair
+  std::size_t getContactPairBegin(std::size_t index) const;
+
+  /// Return one past the index of the last contact of the index-th contact
+  /// pair
+  std::size_t getContactPairEnd(std::size_t index) const;
+
   /// Return the set of BodyNodes that are in collision
   const std::unordered_set<const dynamics::BodyNode*>&
   getCollidingBodyNodes() const;
@@ -87,7 +100,7 @@ public:
   /// Implicitly converts this CollisionResult to the value of isCollision()
   operator bool() const;
 
-  /// Clear all the contacts
+  /// Clear all the contacts. The memory that holds them is kept for reuse.
   void clear();
 
 protected:
@@ -97,6 +110,9 @@ protected:
   /// List of contact information for each contact
   std::vector<Contact> mContacts;
 
+  /// Index of the first contact of each contact pair
+  std::vector<std::size_t> mContactPairBegins;
+
   /// Set of BodyNodes that are colliding
   std::unordered_set<const dynamics::BodyNode*> mCollidingBodyNodes;
 
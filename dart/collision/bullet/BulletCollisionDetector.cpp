@@ -35,11 +35,19 @@
 
 #include "dart/collision/bullet/BulletCollisionDetector.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include <bullet/BulletCollision/Gimpact/btGImpactShape.h>
+#include <bullet/BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+#include <bullet/BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <bullet/BulletCollision/NarrowPhaseCollision/btPointCollector.h>
+#include <bullet/BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
 
 #include "dart/common/Console.hpp"
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/CollisionFilter.hpp"
+#include "dart/collision/DistanceFilter.hpp"
 #include "dart/collision/bullet/BulletTypes.hpp"
 #include "dart/collision/bullet/BulletCollisionObject.hpp"
 #include "dart/collision/bullet/BulletCollisionGroup.hpp"
@@ -79,6 +87,28 @@ btCollisionShape* createBulletCollisionShapeFromAssimpScene(
 
 btCollisionShape* createBulletCollisionShapeFromAssimpMesh(const aiMesh* mesh);
 
+bool computeConvexDistance(
+    const btConvexShape* shape1, const btTransform& tf1,
+    const btConvexShape* shape2, const btTransform& tf2,
+    double& distance, btVector3& point1, btVector3& point2);
+
+double computePlaneDistance(
+    const btStaticPlaneShape* plane, const btTransform& planeTf,
+    const btConvexShape* shape, const btTransform& shapeTf,
+    btVector3& pointOnPlane, btVector3& pointOnShape);
+
+/// Broadphase callback that collects the proxies overlapping the queried box
+struct DistanceBroadphaseCallback : btBroadphaseAabbCallback
+{
+  std::vector<const btBroadphaseProxy*> proxies;
+
+  bool process(const btBroadphaseProxy* proxy) override
+  {
+    proxies.push_back(proxy);
+    return true;
+  }
+};
+
 } // anonymous namespace
 
 //==============================================================================
@@ -176,8 +206,6 @@ void filterOutCollisions(btCollisionWorld* world)
   assert(dispatcher);
 
   const auto filter = dispatcher->getFilter();
-  if (!filter)
-    return;
 
   const auto numManifolds = dispatcher->getNumManifolds();
 
@@ -196,7 +224,8 @@ void filterOutCollisions(btCollisionWorld* world)
     const auto collObj0 = static_cast<BulletCollisionObject*>(userPtr0);
     const auto collObj1 = static_cast<BulletCollisionObject*>(userPtr1);
 
-    if (filter->ignoresCollision(collObj0, collObj1))
+    if (collObj0->isMaskedOut(collObj1)
+        || (filter && filter->ignoresCollision(collObj0, collObj1)))
       manifoldsToRelease.push_back(contactManifold);
   }
 
@@ -227,10 +256,11 @@ bool BulletCollisionDetector::collide(
       collisionWorld->getDispatcher());
   dispatcher->setFilter(option.collisionFilter);
 
+  castedGroup->updateEngineData();
+
   // Filter out persistent contact pairs already existing in the world
   filterOutCollisions(collisionWorld);
 
-  castedGroup->updateEngineData();
   collisionWorld->performDiscreteCollisionDetection();
 
   if (result)
@@ -294,27 +324,53 @@ bool BulletCollisionDetector::collide(
 
 //==============================================================================
 double BulletCollisionDetector::distance(
-    CollisionGroup* /*group*/,
-    const DistanceOption& /*option*/,
-    DistanceResult* /*result*/)
+    CollisionGroup* group,
+    const DistanceOption& option,
+    DistanceResult* result)
 {
-  dtwarn << "[BulletCollisionDetector::distance] This collision detector does "
-         << "not support (signed) distance queries. Returning 0.0.\n";
+  if (result)
+    result->clear();
 
-  return 0.0;
+  if (!checkGroupValidity(this, group))
+    return 0.0;
+
+  auto casted = static_cast<BulletCollisionGroup*>(group);
+  casted->updateEngineData();
+
+  std::vector<detail::DistanceObject> objects;
+  collectDistanceObjects(casted, objects);
+
+  return computeMinDistance(objects, casted, objects, true, option, result);
 }
 
 //==============================================================================
 double BulletCollisionDetector::distance(
-    CollisionGroup* /*group1*/,
-    CollisionGroup* /*group2*/,
-    const DistanceOption& /*option*/,
-    DistanceResult* /*result*/)
+    CollisionGroup* group1,
+    CollisionGroup* group2,
+    const DistanceOption& option,
+    DistanceResult* result)
 {
-  dtwarn << "[BulletCollisionDetector::distance] This collision detector does "
-         << "not support (signed) distance queries. Returning.\n";
+  if (result)
+    result->clear();
 
-  return 0.0;
+  if (!checkGroupValidity(this, group1))
+    return 0.0;
+
+  if (!checkGroupValidity(this, group2))
+    return 0.0;
+
+  auto casted1 = static_cast<BulletCollisionGroup*>(group1);
+  auto casted2 = static_cast<BulletCollisionGroup*>(group2);
+  casted1->updateEngineData();
+  casted2->updateEngineData();
+
+  std::vector<detail::DistanceObject> objects1;
+  std::vector<detail::DistanceObject> objects2;
+  collectDistanceObjects(casted1, objects1);
+  collectDistanceObjects(casted2, objects2);
+
+  return computeMinDistance(
+        objects1, casted2, objects2, casted1 == casted2, option, result);
 }
 
 //==============================================================================
@@ -383,6 +439,8 @@ void BulletCollisionDetector::reclaimBulletCollisionShape(
 
   if (0u == count)
   {
+    mConvexHullMap.erase(bulletCollShape);
+
     auto userPointer = bulletCollShape->getUserPointer();
     if (userPointer)
       delete static_cast<btTriangleMesh*>(userPointer);
@@ -539,7 +597,183 @@ btCollisionShape* BulletCollisionDetector::createBulletCollisionShape(
   return bulletCollisionShape;
 }
 
+//==============================================================================
+void BulletCollisionDetector::collectDistanceObjects(
+    BulletCollisionGroup* group, std::vector<detail::DistanceObject>& objects)
+{
+  objects.reserve(objects.size() + group->mShapeFrameMap.size());
+
+  for (const auto& pair : group->mShapeFrameMap)
+  {
+    auto object = static_cast<BulletCollisionObject*>(pair.second.get());
+    const auto bulletObject = object->getBulletCollisionObject();
+
+    btVector3 aabbMin;
+    btVector3 aabbMax;
+    bulletObject->getCollisionShape()->getAabb(
+          bulletObject->getWorldTransform(), aabbMin, aabbMax);
+
+    objects.push_back(detail::DistanceObject{
+        object, convertVector3(aabbMin), convertVector3(aabbMax)});
+  }
+}
+
+//==============================================================================
+double BulletCollisionDetector::computeMinDistance(
+    const std::vector<detail::DistanceObject>& objects1,
+    BulletCollisionGroup* group2,
+    const std::vector<detail::DistanceObject>& objects2,
+    bool sameGroup,
+    const DistanceOption& option,
+    DistanceResult* result)
+{
+  std::unordered_map<const btCollisionObject*, std::size_t> indices2;
+  indices2.reserve(objects2.size());
+  for (auto i = 0u; i < objects2.size(); ++i)
+  {
+    indices2[static_cast<BulletCollisionObject*>(
+          objects2[i].object)->getBulletCollisionObject()] = i;
+  }
 
+  DistanceBroadphaseCallback callback;
+
+  const auto queryNeighbors = [&](
+      const detail::DistanceObject& object,
+      double radius,
+      std::vector<std::size_t>& neighbors)
+  {
+    const btVector3 margin(radius, radius, radius);
+
+    callback.proxies.clear();
+    group2->mBulletProadphaseAlg->aabbTest(
+          convertVector3(object.aabbMin) - margin,
+          convertVector3(object.aabbMax) + margin,
+          callback);
+
+    for (const auto proxy : callback.proxies)
+    {
+      const auto search = indices2.find(
+            static_cast<const btCollisionObject*>(proxy->m_clientObject));
+      if (indices2.end() != search)
+        neighbors.push_back(search->second);
+    }
+  };
+
+  const auto computeDistance = [&](
+      const detail::DistanceObject& object1,
+      const detail::DistanceObject& object2,
+      double& distance,
+      Eigen::Vector3d& point1,
+      Eigen::Vector3d& point2)
+  {
+    return computePairDistance(object1, object2, distance, point1, point2);
+  };
+
+  return detail::computeMinDistance(
+        objects1, objects2, sameGroup, queryNeighbors, computeDistance,
+        option, result);
+}
+
+//==============================================================================
+bool BulletCollisionDetector::computePairDistance(
+    const detail::DistanceObject& object1,
+    const detail::DistanceObject& object2,
+    double& distance,
+    Eigen::Vector3d& point1,
+    Eigen::Vector3d& point2)
+{
+  const auto bulletObject1 = static_cast<BulletCollisionObject*>(
+        object1.object)->getBulletCollisionObject();
+  const auto bulletObject2 = static_cast<BulletCollisionObject*>(
+        object2.object)->getBulletCollisionObject();
+  const auto bulletShape1 = bulletObject1->getCollisionShape();
+  const auto bulletShape2 = bulletObject2->getCollisionShape();
+  const auto& tf1 = bulletObject1->getWorldTransform();
+  const auto& tf2 = bulletObject2->getWorldTransform();
+  const auto convexShape1 = getConvexShapeForDistance(bulletShape1);
+  const auto convexShape2 = getConvexShapeForDistance(bulletShape2);
+
+  btVector3 bulletPoint1;
+  btVector3 bulletPoint2;
+
+  if (convexShape1 && convexShape2)
+  {
+    if (!computeConvexDistance(convexShape1, tf1, convexShape2, tf2,
+                               distance, bulletPoint1, bulletPoint2))
+      return false;
+  }
+  else if (convexShape2
+           && bulletShape1->getShapeType() == STATIC_PLANE_PROXYTYPE)
+  {
+    distance = computePlaneDistance(
+          static_cast<const btStaticPlaneShape*>(bulletShape1), tf1,
+          convexShape2, tf2, bulletPoint1, bulletPoint2);
+  }
+  else if (convexShape1
+           && bulletShape2->getShapeType() == STATIC_PLANE_PROXYTYPE)
+  {
+    distance = computePlaneDistance(
+          static_cast<const btStaticPlaneShape*>(bulletShape2), tf2,
+          convexShape1, tf1, bulletPoint2, bulletPoint1);
+  }
+  else
+  {
+    // Distance between two planes is not supported
+    return false;
+  }
+
+  point1 = convertVector3(bulletPoint1);
+  point2 = convertVector3(bulletPoint2);
+
+  return true;
+}
+
+//==============================================================================
+const btConvexShape* BulletCollisionDetector::getConvexShapeForDistance(
+    const btCollisionShape* shape)
+{
+  if (shape->isConvex())
+    return static_cast<const btConvexShape*>(shape);
+
+  if (shape->getShapeType() != GIMPACT_SHAPE_PROXYTYPE)
+    return nullptr;
+
+  const auto search = mConvexHullMap.find(shape);
+  if (mConvexHullMap.end() != search)
+    return search->second.get();
+
+  // Collect the vertices of the triangle mesh into a convex hull
+  struct VertexCollector : btInternalTriangleIndexCallback
+  {
+    btConvexHullShape* hull;
+
+    void internalProcessTriangleIndex(
+        btVector3* triangle, int /*partId*/, int /*triangleIndex*/) override
+    {
+      for (auto i = 0u; i < 3u; ++i)
+        hull->addPoint(triangle[i], false);
+    }
+  };
+
+  std::unique_ptr<btConvexHullShape> hull(new btConvexHullShape());
+
+  VertexCollector collector;
+  collector.hull = hull.get();
+
+  const auto meshShape = static_cast<const btGImpactMeshShape*>(shape);
+  const btScalar large = std::numeric_limits<btScalar>::max();
+  meshShape->getMeshInterface()->InternalProcessAllTriangles(
+        &collector, btVector3(-large, -large, -large),
+        btVector3(large, large, large));
+
+  hull->setMargin(0.0);
+  hull->recalcLocalAabb();
+
+  auto convexHull = hull.get();
+  mConvexHullMap[shape] = std::move(hull);
+
+  return convexHull;
+}
 
 namespace {
 
@@ -876,6 +1110,59 @@ btCollisionShape* createBulletCollisionShapeFromAssimpMesh(const aiMesh* mesh)
   return gimpactMeshShape;
 }
 
+//==============================================================================
+bool computeConvexDistance(
+    const btConvexShape* shape1, const btTransform& tf1,
+    const btConvexShape* shape2, const btTransform& tf2,
+    double& distance, btVector3& point1, btVector3& point2)
+{
+  btVoronoiSimplexSolver simplexSolver;
+  btGjkEpaPenetrationDepthSolver penetrationDepthSolver;
+  btGjkPairDetector detector(
+        shape1, shape2, &simplexSolver, &penetrationDepthSolver);
+
+  btGjkPairDetector::ClosestPointInput input;
+  input.m_transformA = tf1;
+  input.m_transformB = tf2;
+
+  btPointCollector output;
+  detector.getClosestPoints(input, output, nullptr);
+
+  if (!output.m_hasResult)
+    return false;
+
+  // The result point lies on the second shape, and the normal points from the
+  // second shape to the first one. The distance is negative in penetration.
+  distance = output.m_distance;
+  point2 = output.m_pointInWorld;
+  point1 = output.m_pointInWorld
+      + output.m_normalOnBInWorld * output.m_distance;
+
+  return true;
+}
+
+//==============================================================================
+double computePlaneDistance(
+    const btStaticPlaneShape* plane, const btTransform& planeTf,
+    const btConvexShape* shape, const btTransform& shapeTf,
+    btVector3& pointOnPlane, btVector3& pointOnShape)
+{
+  const btVector3 normal = planeTf.getBasis() * plane->getPlaneNormal();
+  const btScalar offset
+      = plane->getPlaneConstant() + normal.dot(planeTf.getOrigin());
+
+  // The point of the shape that is the deepest along the plane normal
+  const btVector3 localDirection = shapeTf.getBasis().transpose() * -normal;
+  pointOnShape = shapeTf(shape->localGetSupportingVertex(localDirection));
+
+  Eigen::Vector3d point;
+  const double distance = detail::computePlaneDistance(
+        convertVector3(normal), offset, convertVector3(pointOnShape), point);
+  pointOnPlane = convertVector3(point);
+
+  return distance;
+}
+
 } // anonymous namespace
 
 } // namespace collision
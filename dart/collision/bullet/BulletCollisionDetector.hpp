@@ -36,10 +36,12 @@
 // Must be included before any Bullet headers.
 #include "dart/config.hpp"
 
+#include <unordered_map>
 #include <vector>
 #include <assimp/scene.h>
 #include <btBulletCollisionCommon.h>
 #include "dart/collision/CollisionDetector.hpp"
+#include "dart/collision/detail/DistancePruning.hpp"
 #include "dart/collision/bullet/BulletCollisionGroup.hpp"
 
 namespace dart {
@@ -119,11 +121,52 @@ private:
   btCollisionShape* createBulletCollisionShape(
       const dynamics::ConstShapePtr& shape);
 
+  /// Append the collision objects of the group to objects along with their
+  /// bounding boxes
+  void collectDistanceObjects(
+      BulletCollisionGroup* group,
+      std::vector<detail::DistanceObject>& objects);
+
+  /// Compute the minimum signed distance between the objects of group1 and
+  /// group2, which are objects1 and objects2, respectively. The candidate pairs
+  /// are found by querying the broadphase of group2 with the bounding boxes of
+  /// objects1 inflated by a search radius. sameGroup should be true if group1
+  /// and group2 are the same group.
+  double computeMinDistance(
+      const std::vector<detail::DistanceObject>& objects1,
+      BulletCollisionGroup* group2,
+      const std::vector<detail::DistanceObject>& objects2,
+      bool sameGroup,
+      const DistanceOption& option,
+      DistanceResult* result);
+
+  /// Compute the signed distance between two objects along with the nearest
+  /// points on them. Return false if the distance between their shapes is not
+  /// supported.
+  bool computePairDistance(
+      const detail::DistanceObject& object1,
+      const detail::DistanceObject& object2,
+      double& distance,
+      Eigen::Vector3d& point1,
+      Eigen::Vector3d& point2);
+
+  /// Return the convex shape that GJK/EPA should use for the given shape in
+  /// distance queries, which is either the shape itself or the convex hull of
+  /// its triangle mesh. Return nullptr if the shape has no convex counterpart
+  /// (e.g., plane).
+  const btConvexShape* getConvexShapeForDistance(
+      const btCollisionShape* shape);
+
 private:
 
   std::map<dynamics::ConstShapePtr,
            std::pair<btCollisionShape*, std::size_t>> mShapeMap;
 
+  /// Convex hulls of the triangle mesh shapes in mShapeMap, which are created
+  /// on demand by distance queries
+  std::map<const btCollisionShape*, std::unique_ptr<btConvexHullShape>>
+      mConvexHullMap;
+
   std::unique_ptr<BulletCollisionGroup> mGroupForFiltering;
 
   static Registrar<BulletCollisionDetector> mRegistrar;
@@ -80,6 +80,9 @@ bool BulletCollisionDispatcher::needsCollision(
   const auto collObj1
       = static_cast<BulletCollisionObject*>(body1->getUserPointer());
 
+  if (collObj0->isMaskedOut(collObj1))
+    return false;
+
   if (mFilter && mFilter->ignoresCollision(collObj0, collObj1))
     return false;
 
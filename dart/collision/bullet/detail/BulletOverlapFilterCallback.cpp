@@ -66,21 +66,25 @@ bool BulletOverlapFilterCallback::needBroadphaseCollision(
 
   bool collide = collide1 & collide2;
 
-  if (collide && filter)
-  {
-    auto object0 = static_cast<btCollisionObject*>(proxy0->m_clientObject);
-    auto object1 = static_cast<btCollisionObject*>(proxy1->m_clientObject);
+  if (!collide)
+    return false;
+
+  auto object0 = static_cast<btCollisionObject*>(proxy0->m_clientObject);
+  auto object1 = static_cast<btCollisionObject*>(proxy1->m_clientObject);
 
-    auto userPtr0 = object0->getUserPointer();
-    auto userPtr1 = object1->getUserPointer();
+  auto userPtr0 = object0->getUserPointer();
+  auto userPtr1 = object1->getUserPointer();
 
-    const auto collObj0 = static_cast<BulletCollisionObject*>(userPtr0);
-    const auto collObj1 = static_cast<BulletCollisionObject*>(userPtr1);
+  const auto collObj0 = static_cast<BulletCollisionObject*>(userPtr0);
+  const auto collObj1 = static_cast<BulletCollisionObject*>(userPtr1);
+
+  if (collObj0->isMaskedOut(collObj1))
+    return false;
 
+  if (filter)
     return !filter->ignoresCollision(collObj0, collObj1);
-  }
 
-  return collide;
+  return true;
 }
 
 }  // namespace detail
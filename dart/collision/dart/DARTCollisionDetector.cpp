@@ -130,6 +130,8 @@ bool DARTCollisionDetector::collide(
     return false;
 
   auto casted = static_cast<DARTCollisionGroup*>(group);
+  casted->updateEngineData();
+
   const auto& objects = casted->mCollisionObjects;
 
   if (objects.empty())
@@ -146,6 +148,9 @@ bool DARTCollisionDetector::collide(
     {
       auto* collObj2 = objects[j];
 
+      if (collObj1->isMaskedOut(collObj2))
+        continue;
+
       if (filter && filter->ignoresCollision(collObj1, collObj2))
         continue;
 
@@ -190,6 +195,8 @@ bool DARTCollisionDetector::collide(
 
   auto casted1 = static_cast<DARTCollisionGroup*>(group1);
   auto casted2 = static_cast<DARTCollisionGroup*>(group2);
+  casted1->updateEngineData();
+  casted2->updateEngineData();
 
   const auto& objects1 = casted1->mCollisionObjects;
   const auto& objects2 = casted2->mCollisionObjects;
@@ -208,6 +215,9 @@ bool DARTCollisionDetector::collide(
     {
       auto* collObj2 = objects2[j];
 
+      if (collObj1->isMaskedOut(collObj2))
+        continue;
+
       if (filter && filter->ignoresCollision(collObj1, collObj2))
         continue;
 
@@ -345,16 +355,18 @@ void postProcess(CollisionObject* o1,
   if (!pairResult.isCollision())
     return;
 
-  // Don't add repeated points
+  // Don't add repeated points. Only the contacts of this pair are compared,
+  // since contacts of different pairs at the same point are distinct.
   const auto tol = 3.0e-12;
+  const auto firstPairContact = totalResult.getNumContacts();
 
-  for (auto pairContact : pairResult.getContacts())
+  for (const auto& pairContact : pairResult.getContacts())
   {
     auto foundClose = false;
 
-    for (auto totalContact : totalResult.getContacts())
+    for (auto i = firstPairContact; i < totalResult.getNumContacts(); ++i)
     {
-      if (isClose(pairContact.point, totalContact.point, tol))
+      if (isClose(pairContact.point, totalResult.getContact(i).point, tol))
       {
         foundClose = true;
         break;
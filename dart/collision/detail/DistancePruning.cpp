@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/detail/DistancePruning.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/DistanceFilter.hpp"
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+namespace {
+
+/// Pair of collision objects to be checked in a distance query
+struct DistancePair
+{
+  /// First collision object
+  const DistanceObject* object1;
+
+  /// Second collision object
+  const DistanceObject* object2;
+
+  /// Distance between the bounding boxes of the two objects, which is a lower
+  /// bound on the distance between the objects themselves
+  double aabbDistance;
+};
+
+//==============================================================================
+/// Append the pairs of objects1 and objects2 whose bounding boxes are within
+/// radius of each other unless the distance filter of the option excludes them
+void collectDistancePairs(
+    const std::vector<DistanceObject>& objects1,
+    const std::vector<DistanceObject>& objects2,
+    bool sameGroup,
+    double radius,
+    const DistanceNeighborQuery& queryNeighbors,
+    const DistanceOption& option,
+    std::vector<DistancePair>& pairs)
+{
+  const auto& filter = option.distanceFilter;
+  std::vector<std::size_t> indices2;
+
+  for (auto i = 0u; i < objects1.size(); ++i)
+  {
+    const auto& object1 = objects1[i];
+
+    indices2.clear();
+    if (isBounded(object1))
+    {
+      queryNeighbors(object1, radius, indices2);
+    }
+    else
+    {
+      // An unbounded object is near every object
+      for (auto j = 0u; j < objects2.size(); ++j)
+        indices2.push_back(j);
+    }
+
+    for (const auto j : indices2)
+    {
+      // Each pair of the same group is reported once for each of the objects
+      if (sameGroup && j <= i)
+        continue;
+
+      const auto& object2 = objects2[j];
+
+      // Distance between two unbounded objects is not supported
+      if (!isBounded(object1) && !isBounded(object2))
+        continue;
+
+      const auto aabbDistance = computeAabbDistance(
+            object1.aabbMin, object1.aabbMax,
+            object2.aabbMin, object2.aabbMax);
+      if (aabbDistance > radius)
+        continue;
+
+      if (filter && !filter->needDistance(object1.object, object2.object))
+        continue;
+
+      pairs.push_back(DistancePair{&object1, &object2, aabbDistance});
+    }
+  }
+}
+
+//==============================================================================
+/// Compute the minimum signed distance over the pairs. Return false if no
+/// distance was computed for any of the pairs.
+bool computeMinPairDistance(
+    std::vector<DistancePair>& pairs,
+    const PairDistanceQuery& computePairDistance,
+    const DistanceOption& option,
+    double& minDistance,
+    DistanceResult* result)
+{
+  std::sort(pairs.begin(), pairs.end(),
+            [](const DistancePair& pair1, const DistancePair& pair2)
+            { return pair1.aabbDistance < pair2.aabbDistance; });
+
+  auto found = false;
+  minDistance = 0.0;
+
+  for (const auto& pair : pairs)
+  {
+    // The bounding box distances of the remaining pairs are not less than this
+    // one, so none of them can be closer than the current minimum.
+    if (found && pair.aabbDistance >= minDistance)
+      break;
+
+    double distance;
+    Eigen::Vector3d point1;
+    Eigen::Vector3d point2;
+    if (!computePairDistance(*pair.object1, *pair.object2,
+                             distance, point1, point2))
+      continue;
+
+    if (found && distance >= minDistance)
+      continue;
+
+    found = true;
+    minDistance = distance;
+
+    if (result)
+    {
+      result->unclampedMinDistance = distance;
+      result->minDistance = std::max(distance, option.distanceLowerBound);
+      result->shapeFrame1 = pair.object1->object->getShapeFrame();
+      result->shapeFrame2 = pair.object2->object->getShapeFrame();
+
+      if (option.enableNearestPoints)
+      {
+        result->nearestPoint1 = point1;
+        result->nearestPoint2 = point2;
+      }
+    }
+
+    if (minDistance <= option.distanceLowerBound)
+      break;
+  }
+
+  return found;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+double computeMinDistance(
+    const std::vector<DistanceObject>& objects1,
+    const std::vector<DistanceObject>& objects2,
+    bool sameGroup,
+    const DistanceNeighborQuery& queryNeighbors,
+    const PairDistanceQuery& computePairDistance,
+    const DistanceOption& option,
+    DistanceResult* result)
+{
+  if (objects1.empty() || objects2.empty())
+    return std::max(0.0, option.distanceLowerBound);
+
+  // Bounding box of all the bounded objects and the size of the smallest one,
+  // which bound the search radius from above and from below, respectively.
+  // Unbounded objects are paired with every object anyway.
+  Eigen::Vector3d sceneMin
+      = Eigen::Vector3d::Constant(std::numeric_limits<double>::infinity());
+  Eigen::Vector3d sceneMax = -sceneMin;
+  auto minObjectSize = std::numeric_limits<double>::infinity();
+  for (const auto* objects : {&objects1, &objects2})
+  {
+    for (const auto& object : *objects)
+    {
+      if (!isBounded(object))
+        continue;
+
+      sceneMin = sceneMin.cwiseMin(object.aabbMin);
+      sceneMax = sceneMax.cwiseMax(object.aabbMax);
+      minObjectSize = std::min(
+            minObjectSize, (object.aabbMax - object.aabbMin).norm());
+    }
+  }
+  const double maxRadius = std::isfinite(minObjectSize)
+      ? (sceneMax - sceneMin).norm() : 0.0;
+
+  auto radius = std::max(0.0, option.distanceLowerBound);
+  auto minDistance = 0.0;
+  std::vector<DistancePair> pairs;
+
+  while (true)
+  {
+    pairs.clear();
+    collectDistancePairs(objects1, objects2, sameGroup, radius,
+                         queryNeighbors, option, pairs);
+
+    const auto found = computeMinPairDistance(
+          pairs, computePairDistance, option, minDistance, result);
+
+    // The pairs left out are farther apart than the radius, so none of them
+    // can be closer than the minimum found within the radius. Once the radius
+    // covers the whole scene, no pair is left out.
+    if ((found && minDistance <= radius) || radius >= maxRadius)
+      break;
+
+    // Search again with the radius of the minimum found so far, or keep
+    // doubling the radius until any pair is found.
+    auto nextRadius
+        = found ? minDistance : std::max(2.0 * radius, minObjectSize);
+    if (nextRadius <= radius)
+      nextRadius = maxRadius;
+
+    radius = nextRadius;
+  }
+
+  return std::max(minDistance, option.distanceLowerBound);
+}
+
+//==============================================================================
+bool isBounded(const DistanceObject& object)
+{
+  for (auto i = 0u; i < 3u; ++i)
+  {
+    if (!std::isfinite(object.aabbMin[i]) || !std::isfinite(object.aabbMax[i]))
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+double computeAabbDistance(
+    const Eigen::Vector3d& min1, const Eigen::Vector3d& max1,
+    const Eigen::Vector3d& min2, const Eigen::Vector3d& max2)
+{
+  const Eigen::Vector3d gap
+      = (min1 - max2).cwiseMax(min2 - max1).cwiseMax(Eigen::Vector3d::Zero());
+
+  return gap.norm();
+}
+
+//==============================================================================
+double computePlaneDistance(
+    const Eigen::Vector3d& normal,
+    double offset,
+    const Eigen::Vector3d& pointOnShape,
+    Eigen::Vector3d& pointOnPlane)
+{
+  const double distance = normal.dot(pointOnShape) - offset;
+  pointOnPlane = pointOnShape - distance * normal;
+
+  return distance;
+}
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
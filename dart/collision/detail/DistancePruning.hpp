@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DETAIL_DISTANCEPRUNING_HPP_
+#define DART_COLLISION_DETAIL_DISTANCEPRUNING_HPP_
+
+#include <functional>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/collision/DistanceOption.hpp"
+#include "dart/collision/DistanceResult.hpp"
+
+namespace dart {
+namespace collision {
+
+class CollisionObject;
+
+namespace detail {
+
+/// Collision object of a CollisionGroup to be checked in a distance query
+struct DistanceObject
+{
+  /// Collision object
+  CollisionObject* object;
+
+  /// Lower corner of the bounding box of the object in world coordinates
+  Eigen::Vector3d aabbMin;
+
+  /// Upper corner of the bounding box of the object in world coordinates
+  Eigen::Vector3d aabbMax;
+};
+
+/// Function that appends to indices2 the indices of the objects of the second
+/// group whose bounding boxes may be within radius of the bounding box of the
+/// given object. It is called with bounded objects only, and may report more
+/// objects than needed.
+using DistanceNeighborQuery = std::function<void(
+    const DistanceObject& object,
+    double radius,
+    std::vector<std::size_t>& indices2)>;
+
+/// Function that computes the signed distance between two objects along with
+/// the nearest points on them. It returns false if the distance between the
+/// objects is not supported.
+using PairDistanceQuery = std::function<bool(
+    const DistanceObject& object1,
+    const DistanceObject& object2,
+    double& distance,
+    Eigen::Vector3d& point1,
+    Eigen::Vector3d& point2)>;
+
+/// Compute the minimum signed distance between objects1 and objects2, which
+/// belong to the first and the second group, respectively. The candidate pairs
+/// are found with queryNeighbors for a search radius around each object of the
+/// first group, and the radius grows until it covers the minimum distance
+/// found so far. Within a radius, the pairs are checked in the order of their
+/// bounding box distances so that the rest can be skipped once none of them
+/// can be closer than the current minimum. sameGroup should be true if the
+/// two groups are the same group. Objects with unbounded bounding boxes
+/// (e.g., planes) are paired with every object.
+double computeMinDistance(
+    const std::vector<DistanceObject>& objects1,
+    const std::vector<DistanceObject>& objects2,
+    bool sameGroup,
+    const DistanceNeighborQuery& queryNeighbors,
+    const PairDistanceQuery& computePairDistance,
+    const DistanceOption& option,
+    DistanceResult* result);
+
+/// Return true if the bounding box of the object is finite
+bool isBounded(const DistanceObject& object);
+
+/// Return the distance between two axis-aligned bounding boxes, which is zero
+/// if they overlap
+double computeAabbDistance(
+    const Eigen::Vector3d& min1, const Eigen::Vector3d& max1,
+    const Eigen::Vector3d& min2, const Eigen::Vector3d& max2);
+
+/// Return the signed distance from the plane of the given normal and offset to
+/// pointOnShape, which should be the deepest point of the shape along the
+/// negated normal, and set pointOnPlane to the projection of pointOnShape onto
+/// the plane. All the quantities are in world coordinates.
+double computePlaneDistance(
+    const Eigen::Vector3d& normal,
+    double offset,
+    const Eigen::Vector3d& pointOnShape,
+    Eigen::Vector3d& pointOnPlane);
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DETAIL_DISTANCEPRUNING_HPP_
@@ -1088,16 +1088,16 @@ bool collisionCallback(
   const auto& filter      = option.collisionFilter;
 
   // Filtering
-  if (filter)
-  {
-    auto collisionObject1 = static_cast<FCLCollisionObject*>(o1->getUserData());
-    auto collisionObject2 = static_cast<FCLCollisionObject*>(o2->getUserData());
-    assert(collisionObject1);
-    assert(collisionObject2);
+  auto collisionObject1 = static_cast<FCLCollisionObject*>(o1->getUserData());
+  auto collisionObject2 = static_cast<FCLCollisionObject*>(o2->getUserData());
+  assert(collisionObject1);
+  assert(collisionObject2);
 
-    if (filter->ignoresCollision(collisionObject2, collisionObject1))
-      return collData->done;
-  }
+  if (collisionObject1->isMaskedOut(collisionObject2))
+    return collData->done;
+
+  if (filter && filter->ignoresCollision(collisionObject2, collisionObject1))
+    return collData->done;
 
   // Clear previous results
   fclResult.clear();
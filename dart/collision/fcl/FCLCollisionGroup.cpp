@@ -59,7 +59,8 @@ void FCLCollisionGroup::addCollisionObjectToEngine(CollisionObject* object)
   auto casted = static_cast<FCLCollisionObject*>(object);
   mBroadPhaseAlg->registerObject(casted->getFCLCollisionObject());
 
-  initializeEngineData();
+  // The broadphase is rebalanced by the next update instead of here, so that
+  // adding many objects one at a time does not rebuild it each time
 }
 
 //==============================================================================
@@ -72,8 +73,6 @@ void FCLCollisionGroup::addCollisionObjectsToEngine(
 
     mBroadPhaseAlg->registerObject(casted->getFCLCollisionObject());
   }
-
-  initializeEngineData();
 }
 
 //==============================================================================
@@ -82,8 +81,6 @@ void FCLCollisionGroup::removeCollisionObjectFromEngine(CollisionObject* object)
   auto casted = static_cast<FCLCollisionObject*>(object);
 
   mBroadPhaseAlg->unregisterObject(casted->getFCLCollisionObject());
-
-  initializeEngineData();
 }
 
 //==============================================================================
@@ -97,7 +94,16 @@ void FCLCollisionGroup::removeAllCollisionObjectsFromEngine()
 //==============================================================================
 void FCLCollisionGroup::updateCollisionGroupEngineData()
 {
-  mBroadPhaseAlg->update();
+  // Only refit the objects that have moved. This also rebalances the tree if
+  // objects have been registered or unregistered since the last update.
+  mUpdatedFCLCollisionObjects.clear();
+  for (auto object : mUpdatedCollisionObjects)
+  {
+    mUpdatedFCLCollisionObjects.push_back(
+          static_cast<FCLCollisionObject*>(object)->getFCLCollisionObject());
+  }
+
+  mBroadPhaseAlg->update(mUpdatedFCLCollisionObjects);
 }
 
 //==============================================================================
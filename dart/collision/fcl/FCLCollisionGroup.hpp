@@ -90,6 +90,11 @@ protected:
   /// FCL broad-phase algorithm
   std::unique_ptr<FCLCollisionManager> mBroadPhaseAlg;
 
+  /// FCL collision objects passed to the broad-phase algorithm to be refitted.
+  /// This is kept as a member to avoid reallocation on every update.
+  std::vector<dart::collision::fcl::CollisionObject*>
+      mUpdatedFCLCollisionObjects;
+
 };
 
 }  // namespace collision
@@ -32,8 +32,14 @@
 
 #include "dart/collision/ode/OdeCollisionDetector.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
 #include <ode/ode.h>
 
+#include "dart/common/Console.hpp"
 #include "dart/dynamics/SphereShape.hpp"
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/EllipsoidShape.hpp"
@@ -45,6 +51,8 @@
 #include "dart/dynamics/MeshShape.hpp"
 #include "dart/dynamics/SoftMeshShape.hpp"
 #include "dart/collision/CollisionFilter.hpp"
+#include "dart/collision/DistanceFilter.hpp"
+#include "dart/collision/detail/DistancePruning.hpp"
 #include "dart/collision/ode/OdeTypes.hpp"
 #include "dart/collision/ode/OdeCollisionGroup.hpp"
 #include "dart/collision/ode/OdeCollisionObject.hpp"
@@ -69,6 +77,71 @@ Contact convertContact(
     OdeCollisionObject* b2,
     const CollisionOption& option);
 
+/// Vertex of the simplex of GJK along with the points of the two shapes that
+/// it is the difference of
+struct SimplexVertex
+{
+  Eigen::Vector3d point;
+  Eigen::Vector3d point1;
+  Eigen::Vector3d point2;
+};
+
+/// Data of the broadphase query that collects the geoms whose bounding boxes
+/// overlap the query geom
+struct DistanceQueryData
+{
+  dGeomID queryGeomId;
+  std::vector<dGeomID> geomIds;
+};
+
+/// Map from the collision objects of a distance query to their ODE geoms
+using DistanceGeomMap = std::unordered_map<const CollisionObject*, dGeomID>;
+
+void collectDistanceObjects(
+    dSpaceID spaceId,
+    std::vector<detail::DistanceObject>& objects,
+    DistanceGeomMap& geomIds);
+
+double computeMinDistance(
+    const std::vector<detail::DistanceObject>& objects1,
+    dSpaceID spaceId2,
+    const std::vector<detail::DistanceObject>& objects2,
+    const DistanceGeomMap& geomIds,
+    bool sameGroup,
+    const DistanceOption& option,
+    dContactGeom* contactGeoms,
+    DistanceResult* result);
+
+void DistanceQueryCallback(void* data, dGeomID o1, dGeomID o2);
+
+bool computePairDistance(
+    const detail::DistanceObject& object1,
+    const detail::DistanceObject& object2,
+    const DistanceGeomMap& geomIds,
+    dContactGeom* contactGeoms,
+    double& distance,
+    Eigen::Vector3d& point1,
+    Eigen::Vector3d& point2);
+
+Eigen::Vector3d computeSupportPoint(
+    const dynamics::Shape* shape, const Eigen::Vector3d& direction);
+
+void computeClosestPointOnSimplex(
+    SimplexVertex* simplex,
+    std::size_t& size,
+    double* weights,
+    Eigen::Vector3d& closest);
+
+bool computeConvexDistance(
+    const dynamics::Shape* shape1, const Eigen::Isometry3d& tf1,
+    const dynamics::Shape* shape2, const Eigen::Isometry3d& tf2,
+    double& distance, Eigen::Vector3d& point1, Eigen::Vector3d& point2);
+
+double computePlaneDistance(
+    const dynamics::PlaneShape* plane, const Eigen::Isometry3d& planeTf,
+    const dynamics::Shape* shape, const Eigen::Isometry3d& shapeTf,
+    Eigen::Vector3d& pointOnPlane, Eigen::Vector3d& pointOnShape);
+
 struct OdeCollisionCallbackData
 {
   dContactGeom* contactGeoms;
@@ -192,27 +265,75 @@ bool OdeCollisionDetector::collide(
   return data.numContacts > 0;
 }
 
+//==============================================================================
+static bool checkGroupValidity(OdeCollisionDetector* cd, CollisionGroup* group)
+{
+  if (cd != group->getCollisionDetector().get())
+  {
+    dterr << "[OdeCollisionDetector::distance] Attempting to compute distance "
+          << "for a collision group that is created from a different collision "
+          << "detector instance.\n";
+
+    return false;
+  }
+
+  return true;
+}
+
 //==============================================================================
 double OdeCollisionDetector::distance(
-    CollisionGroup* /*group*/,
-    const DistanceOption& /*option*/,
-    DistanceResult* /*result*/)
+    CollisionGroup* group,
+    const DistanceOption& option,
+    DistanceResult* result)
 {
-  dterr << "[OdeCollisionDetector] Distance query is not supported. "
-        << "Returning -1.0 instead.\n";
-  return -1.0;
+  if (result)
+    result->clear();
+
+  if (!checkGroupValidity(this, group))
+    return 0.0;
+
+  auto odeGroup = static_cast<OdeCollisionGroup*>(group);
+  odeGroup->updateEngineData();
+
+  std::vector<detail::DistanceObject> objects;
+  DistanceGeomMap geomIds;
+  collectDistanceObjects(odeGroup->getOdeSpaceId(), objects, geomIds);
+
+  return computeMinDistance(objects, odeGroup->getOdeSpaceId(), objects,
+                            geomIds, true, option, contactCollisions, result);
 }
 
 //==============================================================================
 double OdeCollisionDetector::distance(
-    CollisionGroup* /*group1*/,
-    CollisionGroup* /*group2*/,
-    const DistanceOption& /*option*/,
-    DistanceResult* /*result*/)
+    CollisionGroup* group1,
+    CollisionGroup* group2,
+    const DistanceOption& option,
+    DistanceResult* result)
 {
-  dterr << "[OdeCollisionDetector] Distance query is not supported. "
-        << "Returning -1.0 instead.\n";
-  return -1.0;
+  if (result)
+    result->clear();
+
+  if (!checkGroupValidity(this, group1))
+    return 0.0;
+
+  if (!checkGroupValidity(this, group2))
+    return 0.0;
+
+  auto odeGroup1 = static_cast<OdeCollisionGroup*>(group1);
+  odeGroup1->updateEngineData();
+
+  auto odeGroup2 = static_cast<OdeCollisionGroup*>(group2);
+  odeGroup2->updateEngineData();
+
+  std::vector<detail::DistanceObject> objects1;
+  std::vector<detail::DistanceObject> objects2;
+  DistanceGeomMap geomIds;
+  collectDistanceObjects(odeGroup1->getOdeSpaceId(), objects1, geomIds);
+  collectDistanceObjects(odeGroup2->getOdeSpaceId(), objects2, geomIds);
+
+  return computeMinDistance(objects1, odeGroup2->getOdeSpaceId(), objects2,
+                            geomIds, odeGroup1 == odeGroup2, option,
+                            contactCollisions, result);
 }
 
 //==============================================================================
@@ -269,6 +390,9 @@ void CollisionCallback(void* data, dGeomID o1, dGeomID o2)
   assert(collObj1);
   assert(collObj2);
 
+  if (collObj1->isMaskedOut(collObj2))
+    return;
+
   if (filter && filter->ignoresCollision(collObj1, collObj2))
       return;
 
@@ -334,6 +458,424 @@ Contact convertContact(
   return contact;
 }
 
+//==============================================================================
+void collectDistanceObjects(
+    dSpaceID spaceId,
+    std::vector<detail::DistanceObject>& objects,
+    DistanceGeomMap& geomIds)
+{
+  const auto numGeoms = dSpaceGetNumGeoms(spaceId);
+  objects.reserve(objects.size() + static_cast<std::size_t>(numGeoms));
+
+  for (auto i = 0; i < numGeoms; ++i)
+  {
+    const auto geomId = dSpaceGetGeom(spaceId, i);
+    const auto object = static_cast<OdeCollisionObject*>(dGeomGetData(geomId));
+    assert(object);
+
+    dReal aabb[6];
+    dGeomGetAABB(geomId, aabb);
+
+    objects.push_back(detail::DistanceObject{
+        object,
+        Eigen::Vector3d(aabb[0], aabb[2], aabb[4]),
+        Eigen::Vector3d(aabb[1], aabb[3], aabb[5])});
+    geomIds[object] = geomId;
+  }
+}
+
+//==============================================================================
+double computeMinDistance(
+    const std::vector<detail::DistanceObject>& objects1,
+    dSpaceID spaceId2,
+    const std::vector<detail::DistanceObject>& objects2,
+    const DistanceGeomMap& geomIds,
+    bool sameGroup,
+    const DistanceOption& option,
+    dContactGeom* contactGeoms,
+    DistanceResult* result)
+{
+  std::unordered_map<dGeomID, std::size_t> indices2;
+  indices2.reserve(objects2.size());
+  for (auto i = 0u; i < objects2.size(); ++i)
+    indices2[geomIds.at(objects2[i].object)] = i;
+
+  // Box geom used to query the broadphase of the second group
+  const auto queryGeomId = dCreateBox(nullptr, 1.0, 1.0, 1.0);
+
+  DistanceQueryData data;
+  data.queryGeomId = queryGeomId;
+
+  const auto queryNeighbors = [&](
+      const detail::DistanceObject& object,
+      double radius,
+      std::vector<std::size_t>& neighbors)
+  {
+    const Eigen::Vector3d size = object.aabbMax - object.aabbMin
+        + Eigen::Vector3d::Constant(2.0 * radius);
+    const Eigen::Vector3d center = 0.5 * (object.aabbMin + object.aabbMax);
+
+    dGeomBoxSetLengths(queryGeomId, size.x(), size.y(), size.z());
+    dGeomSetPosition(queryGeomId, center.x(), center.y(), center.z());
+
+    data.geomIds.clear();
+    dSpaceCollide2(queryGeomId, reinterpret_cast<dGeomID>(spaceId2),
+                   &data, DistanceQueryCallback);
+
+    for (const auto geomId : data.geomIds)
+    {
+      const auto search = indices2.find(geomId);
+      if (indices2.end() != search)
+        neighbors.push_back(search->second);
+    }
+  };
+
+  const auto computeDistance = [&](
+      const detail::DistanceObject& object1,
+      const detail::DistanceObject& object2,
+      double& distance,
+      Eigen::Vector3d& point1,
+      Eigen::Vector3d& point2)
+  {
+    return computePairDistance(
+          object1, object2, geomIds, contactGeoms, distance, point1, point2);
+  };
+
+  const auto minDistance = detail::computeMinDistance(
+        objects1, objects2, sameGroup, queryNeighbors, computeDistance,
+        option, result);
+
+  dGeomDestroy(queryGeomId);
+
+  return minDistance;
+}
+
+//==============================================================================
+void DistanceQueryCallback(void* data, dGeomID o1, dGeomID o2)
+{
+  auto queryData = static_cast<DistanceQueryData*>(data);
+
+  queryData->geomIds.push_back(o1 == queryData->queryGeomId ? o2 : o1);
+}
+
+//==============================================================================
+bool computePairDistance(
+    const detail::DistanceObject& object1,
+    const detail::DistanceObject& object2,
+    const DistanceGeomMap& geomIds,
+    dContactGeom* contactGeoms,
+    double& distance,
+    Eigen::Vector3d& point1,
+    Eigen::Vector3d& point2)
+{
+  using dynamics::PlaneShape;
+
+  const auto odeObject1 = static_cast<OdeCollisionObject*>(object1.object);
+  const auto odeObject2 = static_cast<OdeCollisionObject*>(object2.object);
+  const auto shape1 = odeObject1->getShape().get();
+  const auto shape2 = odeObject2->getShape().get();
+  const Eigen::Isometry3d& tf1 = odeObject1->getTransform();
+  const Eigen::Isometry3d& tf2 = odeObject2->getTransform();
+
+  if (shape1->is<PlaneShape>() && shape2->is<PlaneShape>())
+  {
+    // Distance between two planes is not supported
+    return false;
+  }
+  else if (shape1->is<PlaneShape>())
+  {
+    distance = computePlaneDistance(
+          static_cast<const PlaneShape*>(shape1), tf1, shape2, tf2,
+          point1, point2);
+    return true;
+  }
+  else if (shape2->is<PlaneShape>())
+  {
+    distance = computePlaneDistance(
+          static_cast<const PlaneShape*>(shape2), tf2, shape1, tf1,
+          point2, point1);
+    return true;
+  }
+
+  if (computeConvexDistance(shape1, tf1, shape2, tf2, distance, point1, point2))
+    return true;
+
+  // The shapes are in contact, so take the penetration depth of the deepest
+  // contact reported by ODE. The contact normal points from the second geom to
+  // the first one. The witness points of GJK are kept if ODE reports no contact
+  // with positive depth.
+  const auto numContacts = dCollide(
+        geomIds.at(object1.object), geomIds.at(object2.object),
+        MAX_COLLIDE_RETURNS, contactGeoms, sizeof(contactGeoms[0]));
+
+  distance = 0.0;
+  for (auto i = 0; i < numContacts; ++i)
+  {
+    const auto& contact = contactGeoms[i];
+    if (-contact.depth >= distance)
+      continue;
+
+    const Eigen::Vector3d pos = OdeTypes::convertVector3(contact.pos);
+    const Eigen::Vector3d normal = OdeTypes::convertVector3(contact.normal);
+
+    distance = -contact.depth;
+    point1 = pos - 0.5 * contact.depth * normal;
+    point2 = pos + 0.5 * contact.depth * normal;
+  }
+
+  return true;
+}
+
+//==============================================================================
+Eigen::Vector3d computeSupportPoint(
+    const dynamics::Shape* shape, const Eigen::Vector3d& direction)
+{
+  using dynamics::SphereShape;
+  using dynamics::BoxShape;
+  using dynamics::CapsuleShape;
+  using dynamics::CylinderShape;
+  using dynamics::MeshShape;
+
+  const auto length = direction.norm();
+  const Eigen::Vector3d unit
+      = length > 0.0 ? Eigen::Vector3d(direction / length)
+                     : Eigen::Vector3d::Zero();
+  const auto sign = [](double value) { return value < 0.0 ? -1.0 : 1.0; };
+
+  if (shape->is<SphereShape>())
+  {
+    return static_cast<const SphereShape*>(shape)->getRadius() * unit;
+  }
+  else if (shape->is<BoxShape>())
+  {
+    const Eigen::Vector3d halfSize
+        = 0.5 * static_cast<const BoxShape*>(shape)->getSize();
+
+    return Eigen::Vector3d(sign(direction.x()) * halfSize.x(),
+                           sign(direction.y()) * halfSize.y(),
+                           sign(direction.z()) * halfSize.z());
+  }
+  else if (shape->is<CapsuleShape>())
+  {
+    const auto capsule = static_cast<const CapsuleShape*>(shape);
+
+    Eigen::Vector3d point = capsule->getRadius() * unit;
+    point.z() += sign(direction.z()) * 0.5 * capsule->getHeight();
+
+    return point;
+  }
+  else if (shape->is<CylinderShape>())
+  {
+    const auto cylinder = static_cast<const CylinderShape*>(shape);
+
+    Eigen::Vector3d point(direction.x(), direction.y(), 0.0);
+    const auto radialLength = point.norm();
+    if (radialLength > 0.0)
+      point *= cylinder->getRadius() / radialLength;
+    point.z() = sign(direction.z()) * 0.5 * cylinder->getHeight();
+
+    return point;
+  }
+  else if (shape->is<MeshShape>())
+  {
+    // Use the convex hull of the vertices, as the Bullet detector does
+    const auto meshShape = static_cast<const MeshShape*>(shape);
+    const Eigen::Vector3d& scale = meshShape->getScale();
+    const auto scene = meshShape->getMesh();
+
+    Eigen::Vector3d point = Eigen::Vector3d::Zero();
+    auto maxDot = -std::numeric_limits<double>::infinity();
+    for (auto i = 0u; i < scene->mNumMeshes; ++i)
+    {
+      const auto mesh = scene->mMeshes[i];
+      for (auto j = 0u; j < mesh->mNumVertices; ++j)
+      {
+        const auto& vertex = mesh->mVertices[j];
+        const Eigen::Vector3d scaled(vertex.x * scale.x(),
+                                     vertex.y * scale.y(),
+                                     vertex.z * scale.z());
+        const auto dot = scaled.dot(direction);
+        if (dot > maxDot)
+        {
+          maxDot = dot;
+          point = scaled;
+        }
+      }
+    }
+
+    return point;
+  }
+
+  // The unsupported shapes are represented by spheres of 0.01 radius in ODE
+  return 0.01 * unit;
+}
+
+//==============================================================================
+void computeClosestPointOnSimplex(
+    SimplexVertex* simplex,
+    std::size_t& size,
+    double* weights,
+    Eigen::Vector3d& closest)
+{
+  using Matrix3X = Eigen::Matrix<double, 3, Eigen::Dynamic, 0, 3, 3>;
+  using MatrixX
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, 3, 3>;
+  using VectorX = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, 3, 1>;
+
+  auto minSquaredNorm = std::numeric_limits<double>::infinity();
+  auto minMask = 0u;
+  double minWeights[4];
+
+  // The closest point lies in the relative interior of one of the faces of the
+  // simplex, where the projection of the origin onto the face has positive
+  // barycentric coordinates. Among those faces, it is the closest projection.
+  for (auto mask = 1u; mask < (1u << size); ++mask)
+  {
+    std::size_t indices[4];
+    auto count = 0u;
+    for (auto i = 0u; i < size; ++i)
+    {
+      if (mask & (1u << i))
+        indices[count++] = i;
+    }
+
+    const Eigen::Vector3d& origin = simplex[indices[0]].point;
+    Matrix3X edges(3, count - 1u);
+    for (auto i = 1u; i < count; ++i)
+      edges.col(i - 1u) = simplex[indices[i]].point - origin;
+
+    double faceWeights[4];
+    Eigen::Vector3d point = origin;
+    faceWeights[0] = 1.0;
+
+    if (count > 1u)
+    {
+      const MatrixX gram = edges.transpose() * edges;
+      const Eigen::FullPivLU<MatrixX> lu(gram);
+      if (lu.rank() < static_cast<int>(count - 1u))
+        continue;
+
+      const VectorX coeffs = lu.solve(VectorX(-edges.transpose() * origin));
+      if ((coeffs.array() <= 0.0).any() || coeffs.sum() >= 1.0)
+        continue;
+
+      faceWeights[0] = 1.0 - coeffs.sum();
+      for (auto i = 1u; i < count; ++i)
+        faceWeights[i] = coeffs[i - 1u];
+      point += edges * coeffs;
+    }
+
+    const auto squaredNorm = point.squaredNorm();
+    if (squaredNorm < minSquaredNorm)
+    {
+      minSquaredNorm = squaredNorm;
+      minMask = mask;
+      std::copy(faceWeights, faceWeights + count, minWeights);
+      closest = point;
+    }
+  }
+
+  // Keep only the vertices of the closest face
+  auto count = 0u;
+  for (auto i = 0u; i < size; ++i)
+  {
+    if (minMask & (1u << i))
+    {
+      simplex[count] = simplex[i];
+      weights[count] = minWeights[count];
+      ++count;
+    }
+  }
+  size = count;
+}
+
+//==============================================================================
+bool computeConvexDistance(
+    const dynamics::Shape* shape1, const Eigen::Isometry3d& tf1,
+    const dynamics::Shape* shape2, const Eigen::Isometry3d& tf2,
+    double& distance, Eigen::Vector3d& point1, Eigen::Vector3d& point2)
+{
+  const auto maxNumIterations = 128u;
+  const auto tolerance = 1e-9;
+  const auto relativeTolerance = 1e-10;
+
+  // Support point of the Minkowski difference of the shapes
+  const auto support = [&](const Eigen::Vector3d& direction)
+  {
+    SimplexVertex vertex;
+    vertex.point1 = tf1 * computeSupportPoint(
+          shape1, tf1.linear().transpose() * direction);
+    vertex.point2 = tf2 * computeSupportPoint(
+          shape2, tf2.linear().transpose() * -direction);
+    vertex.point = vertex.point1 - vertex.point2;
+
+    return vertex;
+  };
+
+  SimplexVertex simplex[4];
+  double weights[4];
+
+  Eigen::Vector3d direction = tf1.translation() - tf2.translation();
+  if (direction.squaredNorm() < tolerance * tolerance)
+    direction = Eigen::Vector3d::UnitX();
+
+  simplex[0] = support(-direction);
+  weights[0] = 1.0;
+  std::size_t size = 1u;
+  Eigen::Vector3d closest = simplex[0].point;
+
+  auto intersecting = false;
+  for (auto i = 0u; i < maxNumIterations; ++i)
+  {
+    const auto squaredDistance = closest.squaredNorm();
+
+    // The simplex encloses the origin, or touches it
+    if (4u == size || squaredDistance < tolerance * tolerance)
+    {
+      intersecting = true;
+      break;
+    }
+
+    // Stop once the new vertex can't bring the simplex closer to the origin
+    const auto vertex = support(-closest);
+    if (squaredDistance - closest.dot(vertex.point)
+        <= relativeTolerance * squaredDistance)
+      break;
+
+    simplex[size++] = vertex;
+    computeClosestPointOnSimplex(simplex, size, weights, closest);
+  }
+
+  distance = closest.norm();
+  point1.setZero();
+  point2.setZero();
+  for (auto i = 0u; i < size; ++i)
+  {
+    point1 += weights[i] * simplex[i].point1;
+    point2 += weights[i] * simplex[i].point2;
+  }
+
+  return !intersecting;
+}
+
+//==============================================================================
+double computePlaneDistance(
+    const dynamics::PlaneShape* plane, const Eigen::Isometry3d& planeTf,
+    const dynamics::Shape* shape, const Eigen::Isometry3d& shapeTf,
+    Eigen::Vector3d& pointOnPlane, Eigen::Vector3d& pointOnShape)
+{
+  const Eigen::Vector3d normal = planeTf.linear() * plane->getNormal();
+  const double offset
+      = plane->getOffset() + normal.dot(planeTf.translation());
+
+  // The point of the shape that is the deepest along the plane normal
+  pointOnShape = shapeTf * computeSupportPoint(
+        shape, shapeTf.linear().transpose() * -normal);
+
+  return detail::computePlaneDistance(
+        normal, offset, pointOnShape, pointOnPlane);
+}
+
 } // anonymous namespace
 
 } // namespace collision
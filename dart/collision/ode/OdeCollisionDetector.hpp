@@ -84,13 +84,13 @@ public:
       const CollisionOption& option = CollisionOption(false, 1u, nullptr),
       CollisionResult* result = nullptr) override;
 
-  /// \warning Not implemented yet.
+  // Documentation inherited
   double distance(
       CollisionGroup* group,
       const DistanceOption& option = DistanceOption(false, 0.0, nullptr),
       DistanceResult* result = nullptr) override;
 
-  /// \warning Not implemented yet.
+  // Documentation inherited
   double distance(
       CollisionGroup* group1,
       CollisionGroup* group2,
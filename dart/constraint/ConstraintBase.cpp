@@ -59,6 +59,13 @@ std::size_t ConstraintBase::getDimension() const
   return mDim;
 }
 
+//==============================================================================
+bool ConstraintBase::collectReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& /*_skeletons*/) const
+{
+  return false;
+}
+
 //==============================================================================
 void ConstraintBase::uniteSkeletons()
 {
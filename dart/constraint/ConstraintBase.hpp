@@ -34,6 +34,7 @@
 #define DART_CONSTRAINT_CONSTRAINTBASE_HPP_
 
 #include <cstddef>
+#include <vector>
 
 #include "dart/dynamics/SmartPointer.hpp"
 
@@ -104,6 +105,14 @@ public:
   ///
   virtual dynamics::SkeletonPtr getRootSkeleton() const = 0;
 
+  /// Append the Skeletons whose velocities are changed by the impulses of this
+  /// constraint to _skeletons. Two constraints are coupled in the LCP only if
+  /// they share one of these Skeletons. Return false if the Skeletons are not
+  /// known, in which case this constraint is treated as coupled to all the
+  /// others.
+  virtual bool collectReactiveSkeletons(
+      std::vector<dynamics::Skeleton*>& _skeletons) const;
+
   ///
   virtual void uniteSkeletons();
 
@@ -32,11 +32,16 @@
 
 #include "dart/constraint/ConstraintSolver.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "dart/common/Console.hpp"
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/CollisionGroup.hpp"
 #include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/Contact.hpp"
+#include "dart/collision/DistanceFilter.hpp"
 #include "dart/collision/fcl/FCLCollisionDetector.hpp"
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
 #include "dart/dynamics/BodyNode.hpp"
@@ -49,6 +54,7 @@
 #include "dart/constraint/JointLimitConstraint.hpp"
 #include "dart/constraint/ServoMotorConstraint.hpp"
 #include "dart/constraint/JointCoulombFrictionConstraint.hpp"
+#include "dart/constraint/LCPTrace.hpp"
 #include "dart/constraint/DantzigLCPSolver.hpp"
 #include "dart/constraint/PGSLCPSolver.hpp"
 
@@ -57,6 +63,140 @@ namespace constraint {
 
 using namespace dynamics;
 
+namespace {
+
+//==============================================================================
+/// Distance filter for finding what a ShapeFrame with continuous collision is
+/// about to hit, which skips the pairs that the collision filter of the
+/// constraint solver would skip as well as the ShapeFrame itself
+class SpeculativeContactFilter : public collision::DistanceFilter
+{
+public:
+  SpeculativeContactFilter(
+      const std::shared_ptr<collision::CollisionFilter>& collisionFilter)
+    : mCollisionFilter(collisionFilter)
+  {
+    // Do nothing
+  }
+
+  bool needDistance(
+      const collision::CollisionObject* object1,
+      const collision::CollisionObject* object2) const override
+  {
+    if (object1->getShapeFrame() == object2->getShapeFrame())
+      return false;
+
+    if (object1->isMaskedOut(object2))
+      return false;
+
+    return !mCollisionFilter
+        || !mCollisionFilter->ignoresCollision(object1, object2);
+  }
+
+protected:
+  std::shared_ptr<collision::CollisionFilter> mCollisionFilter;
+};
+
+//==============================================================================
+Eigen::Vector3d getPointVelocity(
+    const dynamics::Frame* frame, const Eigen::Vector3d& point)
+{
+  return frame->getLinearVelocity() + frame->getAngularVelocity().cross(
+        point - frame->getWorldTransform().translation());
+}
+
+//==============================================================================
+/// Reduce the contacts of a contact manifold to the deepest one and up to three
+/// others that span the largest area with it in the plane of the manifold
+void reduceContactManifold(
+    const collision::CollisionResult& result,
+    const Eigen::Vector3d& normal,
+    std::vector<std::size_t>& manifold)
+{
+  if (manifold.size() <= 4u)
+    return;
+
+  const auto point = [&](std::size_t i) -> const Eigen::Vector3d& {
+    return result.getContact(manifold[i]).point;
+  };
+  const auto area = [&](const Eigen::Vector3d& a, const Eigen::Vector3d& b,
+                        const Eigen::Vector3d& c) {
+    return normal.dot((b - a).cross(c - a));
+  };
+
+  // The deepest contact
+  std::size_t i0 = 0u;
+  for (auto i = 1u; i < manifold.size(); ++i)
+  {
+    if (result.getContact(manifold[i]).penetrationDepth
+        > result.getContact(manifold[i0]).penetrationDepth)
+      i0 = i;
+  }
+
+  // The farthest contact from the deepest one
+  std::size_t i1 = i0;
+  double maxDistance = 0.0;
+  for (auto i = 0u; i < manifold.size(); ++i)
+  {
+    const double distance = (point(i) - point(i0)).squaredNorm();
+    if (distance > maxDistance)
+    {
+      maxDistance = distance;
+      i1 = i;
+    }
+  }
+
+  // The contact that makes the largest triangle with the two
+  std::size_t i2 = i0;
+  double maxArea = 0.0;
+  for (auto i = 0u; i < manifold.size(); ++i)
+  {
+    const double triangleArea
+        = std::abs(area(point(i0), point(i1), point(i)));
+    if (triangleArea > maxArea)
+    {
+      maxArea = triangleArea;
+      i2 = i;
+    }
+  }
+
+  std::vector<std::size_t> reduced{manifold[i0]};
+  if (i1 != i0)
+    reduced.push_back(manifold[i1]);
+
+  if (i2 != i0)
+  {
+    reduced.push_back(manifold[i2]);
+
+    // Orient the triangle counterclockwise around the normal, and then find
+    // the contact that adds the largest area outside of it
+    if (area(point(i0), point(i1), point(i2)) < 0.0)
+      std::swap(i1, i2);
+
+    std::size_t i3 = i0;
+    double maxAddedArea = 0.0;
+    for (auto i = 0u; i < manifold.size(); ++i)
+    {
+      const double addedArea = -std::min(
+          {area(point(i0), point(i1), point(i)),
+           area(point(i1), point(i2), point(i)),
+           area(point(i2), point(i0), point(i))});
+      if (addedArea > maxAddedArea)
+      {
+        maxAddedArea = addedArea;
+        i3 = i;
+      }
+    }
+
+    if (i3 != i0)
+      reduced.push_back(manifold[i3]);
+  }
+
+  manifold.swap(reduced);
+}
+
+} // anonymous namespace
+
 //==============================================================================
 ConstraintSolver::ConstraintSolver(double timeStep)
   : mCollisionDetector(collision::FCLCollisionDetector::create()),
@@ -64,6 +204,8 @@ ConstraintSolver::ConstraintSolver(double timeStep)
     mCollisionOption(
       collision::CollisionOption(
         true, 1000u, std::make_shared<collision::BodyNodeCollisionFilter>())),
+    mIsMissingDistanceReported(false),
+    mContactManifoldReductionEnabled(false),
     mTimeStep(timeStep),
     mLCPSolver(new DantzigLCPSolver(mTimeStep))
 {
@@ -102,6 +244,7 @@ void ConstraintSolver::addSkeleton(const SkeletonPtr& skeleton)
   mCollisionGroup->addShapeFramesOf(skeleton.get());
   mSkeletons.push_back(skeleton);
   mConstrainedGroups.reserve(mSkeletons.size());
+  mJointConstraintVersions.clear();
 }
 
 //==============================================================================
@@ -128,6 +271,7 @@ void ConstraintSolver::removeSkeleton(const SkeletonPtr& skeleton)
   mSkeletons.erase(remove(mSkeletons.begin(), mSkeletons.end(), skeleton),
                    mSkeletons.end());
   mConstrainedGroups.reserve(mSkeletons.size());
+  mJointConstraintVersions.clear();
 }
 
 //==============================================================================
@@ -143,6 +287,7 @@ void ConstraintSolver::removeAllSkeletons()
 {
   mCollisionGroup->removeAllShapeFrames();
   mSkeletons.clear();
+  mJointConstraintVersions.clear();
 }
 
 //==============================================================================
@@ -183,6 +328,27 @@ void ConstraintSolver::removeAllConstraints()
   mManualConstraints.clear();
 }
 
+//==============================================================================
+std::size_t ConstraintSolver::getNumConstraints() const
+{
+  return mManualConstraints.size();
+}
+
+//==============================================================================
+ConstraintBasePtr ConstraintSolver::getConstraint(std::size_t _index)
+{
+  assert(_index < mManualConstraints.size());
+  return mManualConstraints[_index];
+}
+
+//==============================================================================
+ConstConstraintBasePtr ConstraintSolver::getConstraint(
+    std::size_t _index) const
+{
+  assert(_index < mManualConstraints.size());
+  return mManualConstraints[_index];
+}
+
 //==============================================================================
 void ConstraintSolver::clearLastCollisionResult()
 {
@@ -229,6 +395,8 @@ void ConstraintSolver::setCollisionDetector(
     return;
 
   mCollisionDetector = collisionDetector;
+  mIsMissingDistanceReported = false;
+  mContinuousCollisionGroups.clear();
 
   mCollisionGroup = mCollisionDetector->createCollisionGroupAsSharedPtr();
 
@@ -286,11 +454,27 @@ ConstraintSolver::getLastCollisionResult() const
   return mCollisionResult;
 }
 
+//==============================================================================
+void ConstraintSolver::setContactManifoldReductionEnabled(bool enabled)
+{
+  mContactManifoldReductionEnabled = enabled;
+}
+
+//==============================================================================
+bool ConstraintSolver::isContactManifoldReductionEnabled() const
+{
+  return mContactManifoldReductionEnabled;
+}
+
 //==============================================================================
 void ConstraintSolver::setLCPSolver(std::unique_ptr<LCPSolver> _lcpSolver)
 {
   assert(_lcpSolver && "Invalid LCP solver.");
 
+  // Keep recording the LCPs of the new solver
+  if (mLCPSolver && !_lcpSolver->getTrace())
+    _lcpSolver->setTrace(mLCPSolver->getTrace());
+
   mLCPSolver = std::move(_lcpSolver);
 }
 
@@ -300,6 +484,29 @@ LCPSolver* ConstraintSolver::getLCPSolver() const
   return mLCPSolver.get();
 }
 
+//==============================================================================
+bool ConstraintSolver::startLCPCapture(const std::string& _fileName)
+{
+  auto trace = std::make_shared<LCPTraceWriter>(_fileName);
+  if (!trace->isOpen())
+    return false;
+
+  mLCPSolver->setTrace(std::move(trace));
+  return true;
+}
+
+//==============================================================================
+void ConstraintSolver::stopLCPCapture()
+{
+  mLCPSolver->setTrace(nullptr);
+}
+
+//==============================================================================
+bool ConstraintSolver::isCapturingLCPs() const
+{
+  return mLCPSolver->getTrace() != nullptr;
+}
+
 //==============================================================================
 void ConstraintSolver::solve()
 {
@@ -321,6 +528,20 @@ DART_SUPPRESS_DEPRECATED_END
   solveConstrainedGroups();
 }
 
+//==============================================================================
+std::size_t ConstraintSolver::getNumConstrainedGroups() const
+{
+  return mConstrainedGroups.size();
+}
+
+//==============================================================================
+const ConstrainedGroup& ConstraintSolver::getConstrainedGroup(
+    std::size_t _index) const
+{
+  assert(_index < mConstrainedGroups.size());
+  return mConstrainedGroups[_index];
+}
+
 //==============================================================================
 bool ConstraintSolver::containSkeleton(const ConstSkeletonPtr& _skeleton) const
 {
@@ -342,6 +563,7 @@ bool ConstraintSolver::checkAndAddSkeleton(const SkeletonPtr& _skeleton)
   if (!containSkeleton(_skeleton))
   {
     mSkeletons.push_back(_skeleton);
+    mJointConstraintVersions.clear();
     return true;
   }
   else
@@ -401,25 +623,22 @@ void ConstraintSolver::updateConstraints()
 
   mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
 
+  updateSpeculativeContacts();
+
+  reduceContactManifolds();
+
   // Destroy previous contact constraints
   mContactConstraints.clear();
 
   // Destroy previous soft contact constraints
   mSoftContactConstraints.clear();
 
-  // Create new contact constraints
-  for (auto i = 0u; i < mCollisionResult.getNumContacts(); ++i)
+  // Set colliding bodies once for each contact pair
+  for (auto i = 0u; i < mCollisionResult.getNumContactPairs(); ++i)
   {
-    auto& ct = mCollisionResult.getContact(i);
+    const auto& ct = mCollisionResult.getContact(
+          mCollisionResult.getContactPairBegin(i));
 
-    if (collision::Contact::isZeroNormal(ct.normal))
-    {
-      // Skip this contact. This is because we assume that a contact with
-      // zero-length normal is invalid.
-      continue;
-    }
-
-    // Set colliding bodies
     auto shapeFrame1 = const_cast<dynamics::ShapeFrame*>(
           ct.collisionObject1->getShapeFrame());
     auto shapeFrame2 = const_cast<dynamics::ShapeFrame*>(
@@ -429,6 +648,19 @@ DART_SUPPRESS_DEPRECATED_BEGIN
     shapeFrame1->asShapeNode()->getBodyNodePtr()->setColliding(true);
     shapeFrame2->asShapeNode()->getBodyNodePtr()->setColliding(true);
 DART_SUPPRESS_DEPRECATED_END
+  }
+
+  // Create new contact constraints
+  for (const auto i : mContactIndices)
+  {
+    auto& ct = mCollisionResult.getContact(i);
+
+    if (collision::Contact::isZeroNormal(ct.normal))
+    {
+      // Skip this contact. This is because we assume that a contact with
+      // zero-length normal is invalid.
+      continue;
+    }
 
     if (isSoftContact(ct))
     {
@@ -442,6 +674,12 @@ DART_SUPPRESS_DEPRECATED_END
     }
   }
 
+  for (auto& ct : mSpeculativeContacts)
+  {
+    mContactConstraints.push_back(
+          std::make_shared<ContactConstraint>(ct, mTimeStep));
+  }
+
   // Add the new contact constraints to dynamic constraint list
   for (const auto& contactConstraint : mContactConstraints)
   {
@@ -463,14 +701,58 @@ DART_SUPPRESS_DEPRECATED_END
   //----------------------------------------------------------------------------
   // Update automatic constraints: joint constraints
   //----------------------------------------------------------------------------
+  // The joint constraints are kept across steps and only recreated when the
+  // properties of a Skeleton or its joints changed, which bumps its version
+  bool skeletonsChanged = mJointConstraintVersions.size() != mSkeletons.size();
+  for (auto i = 0u; !skeletonsChanged && i < mSkeletons.size(); ++i)
+  {
+    skeletonsChanged
+        = mJointConstraintVersions[i] != mSkeletons[i]->getVersion();
+  }
+
+  if (skeletonsChanged)
+    createJointConstraints();
+
+  // Add active joint limit
+  for (auto& jointLimitConstraint : mJointLimitConstraints)
+  {
+    jointLimitConstraint->update();
+
+    if (jointLimitConstraint->isActive())
+      mActiveConstraints.push_back(jointLimitConstraint);
+  }
+
+  for (auto& servoMotorConstraint : mServoMotorConstraints)
+  {
+    servoMotorConstraint->update();
+
+    if (servoMotorConstraint->isActive())
+      mActiveConstraints.push_back(servoMotorConstraint);
+  }
+
+  for (auto& jointFrictionConstraint : mJointCoulombFrictionConstraints)
+  {
+    jointFrictionConstraint->update();
+
+    if (jointFrictionConstraint->isActive())
+      mActiveConstraints.push_back(jointFrictionConstraint);
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::createJointConstraints()
+{
   // Destroy previous joint constraints
   mJointLimitConstraints.clear();
   mServoMotorConstraints.clear();
   mJointCoulombFrictionConstraints.clear();
+  mJointConstraintVersions.clear();
 
   // Create new joint constraints
   for (const auto& skel : mSkeletons)
   {
+    mJointConstraintVersions.push_back(skel->getVersion());
+
     const std::size_t numJoints = skel->getNumJoints();
     for (std::size_t i = 0; i < numJoints; i++)
     {
@@ -490,106 +772,113 @@ DART_SUPPRESS_DEPRECATED_END
         }
       }
 
+      // Joints whose limits are all infinite can never reach them
       if (joint->isPositionLimitEnforced())
-        mJointLimitConstraints.push_back(
-              std::make_shared<JointLimitConstraint>(joint));
+      {
+        for (std::size_t j = 0; j < dof; ++j)
+        {
+          if (std::isfinite(joint->getPositionLowerLimit(j))
+              || std::isfinite(joint->getPositionUpperLimit(j)))
+          {
+            mJointLimitConstraints.push_back(
+                  std::make_shared<JointLimitConstraint>(joint));
+            break;
+          }
+        }
+      }
 
       if (joint->getActuatorType() == dynamics::Joint::SERVO)
         mServoMotorConstraints.push_back(
               std::make_shared<ServoMotorConstraint>(joint));
     }
   }
-
-  // Add active joint limit
-  for (auto& jointLimitConstraint : mJointLimitConstraints)
-  {
-    jointLimitConstraint->update();
-
-    if (jointLimitConstraint->isActive())
-      mActiveConstraints.push_back(jointLimitConstraint);
-  }
-
-  for (auto& servoMotorConstraint : mServoMotorConstraints)
-  {
-    servoMotorConstraint->update();
-
-    if (servoMotorConstraint->isActive())
-      mActiveConstraints.push_back(servoMotorConstraint);
-  }
-
-  for (auto& jointFrictionConstraint : mJointCoulombFrictionConstraints)
-  {
-    jointFrictionConstraint->update();
-
-    if (jointFrictionConstraint->isActive())
-      mActiveConstraints.push_back(jointFrictionConstraint);
-  }
 }
 
 //==============================================================================
 void ConstraintSolver::buildConstrainedGroups()
 {
-  // Clear constrained groups
-  mConstrainedGroups.clear();
-
   // Exit if there is no active constraint
   if (mActiveConstraints.empty())
+  {
+    mConstrainedGroups.clear();
     return;
+  }
 
   //----------------------------------------------------------------------------
   // Unite skeletons according to constraints's relationships
   //----------------------------------------------------------------------------
-  for (std::vector<ConstraintBasePtr>::iterator it = mActiveConstraints.begin();
-       it != mActiveConstraints.end(); ++it)
-  {
-    (*it)->uniteSkeletons();
-  }
+  for (const auto& constraint : mActiveConstraints)
+    constraint->uniteSkeletons();
 
   //----------------------------------------------------------------------------
-  // Build constraint groups
+  // Number the unions
   //----------------------------------------------------------------------------
-  for (std::vector<ConstraintBasePtr>::const_iterator it = mActiveConstraints.begin();
-       it != mActiveConstraints.end(); ++it)
+  // The skeleton that a constraint reports is in the right union, but it is
+  // not necessarily the root of that union, so the path to the root is
+  // compressed first.
+  const std::size_t numConstraints = mActiveConstraints.size();
+  const std::size_t noGroup = numConstraints;
+  mConstraintRoots.resize(numConstraints);
+  for (std::size_t i = 0; i < numConstraints; ++i)
   {
-    bool found = false;
-    dynamics::SkeletonPtr skel = (*it)->getRootSkeleton();
+    mConstraintRoots[i] = ConstraintBase::compressPath(
+          mActiveConstraints[i]->getRootSkeleton());
+    mConstraintRoots[i]->mUnionIndex = noGroup;
+  }
 
-    for (std::vector<ConstrainedGroup>::const_iterator itConstGroup
-         = mConstrainedGroups.begin();
-         itConstGroup != mConstrainedGroups.end(); ++itConstGroup)
+  mConstrainedGroupSizes.clear();
+  for (const auto& root : mConstraintRoots)
+  {
+    if (root->mUnionIndex == noGroup)
     {
-      if ((*itConstGroup).mRootSkeleton == skel)
-      {
-        found = true;
-        break;
-      }
+      root->mUnionIndex = mConstrainedGroupSizes.size();
+      mConstrainedGroupSizes.push_back(0u);
     }
 
-    if (found)
-      continue;
-
-    ConstrainedGroup newConstGroup;
-    newConstGroup.mRootSkeleton = skel;
-    skel->mUnionIndex = mConstrainedGroups.size();
-    mConstrainedGroups.push_back(newConstGroup);
+    ++mConstrainedGroupSizes[root->mUnionIndex];
   }
 
-  // Add active constraints to constrained groups
-  for (std::vector<ConstraintBasePtr>::const_iterator it = mActiveConstraints.begin();
-       it != mActiveConstraints.end(); ++it)
+  //----------------------------------------------------------------------------
+  // Build constraint groups
+  //----------------------------------------------------------------------------
+  // The groups are sorted from the largest to the smallest so that the most
+  // expensive ones can be scheduled first
+  const std::size_t numGroups = mConstrainedGroupSizes.size();
+  mConstrainedGroupOrder.resize(numGroups);
+  std::iota(mConstrainedGroupOrder.begin(), mConstrainedGroupOrder.end(), 0u);
+  std::stable_sort(mConstrainedGroupOrder.begin(), mConstrainedGroupOrder.end(),
+                   [&](std::size_t _a, std::size_t _b)
   {
-    dynamics::SkeletonPtr skel = (*it)->getRootSkeleton();
-    mConstrainedGroups[skel->mUnionIndex].addConstraint(*it);
+    return mConstrainedGroupSizes[_a] > mConstrainedGroupSizes[_b];
+  });
+
+  // From here on mConstrainedGroupSizes maps each union to its group
+  for (std::size_t i = 0; i < numGroups; ++i)
+    mConstrainedGroupSizes[mConstrainedGroupOrder[i]] = i;
+
+  // The groups that already exist keep the storage of their constraint lists
+  mConstrainedGroups.resize(numGroups);
+  for (auto& group : mConstrainedGroups)
+    group.removeAllConstraints();
+
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const dynamics::SkeletonPtr& root = mConstraintRoots[i];
+    ConstrainedGroup& group
+        = mConstrainedGroups[mConstrainedGroupSizes[root->mUnionIndex]];
+    if (group.mConstraints.empty())
+      group.mRootSkeleton = root;
+
+    group.addConstraint(mActiveConstraints[i]);
   }
 
+  mConstraintRoots.clear();
+
   //----------------------------------------------------------------------------
   // Reset union since we don't need union information anymore.
   //----------------------------------------------------------------------------
-  for (std::vector<dynamics::SkeletonPtr>::iterator it = mSkeletons.begin();
-       it != mSkeletons.end(); ++it)
-  {
-    (*it)->resetUnion();
-  }
+  for (const auto& skel : mSkeletons)
+    skel->resetUnion();
 }
 
 //==============================================================================
@@ -602,6 +891,187 @@ void ConstraintSolver::solveConstrainedGroups()
   }
 }
 
+//==============================================================================
+void ConstraintSolver::updateSpeculativeContacts()
+{
+  mSpeculativeContacts.clear();
+
+  std::vector<const dynamics::ShapeFrame*> shapeFrames;
+  for (auto i = 0u; i < mCollisionGroup->getNumShapeFrames(); ++i)
+  {
+    const auto shapeFrame = mCollisionGroup->getShapeFrame(i);
+    const auto collisionAspect = shapeFrame->getCollisionAspect();
+
+    if (collisionAspect && collisionAspect->getContinuousCollision())
+      shapeFrames.push_back(shapeFrame);
+  }
+
+  if (shapeFrames.empty())
+  {
+    mContinuousCollisionGroups.clear();
+    return;
+  }
+
+  // The DART collision detector has no distance queries, so continuous
+  // collision is ignored with it. This is reported once rather than by every
+  // distance query of every step.
+  if (dynamic_cast<collision::DARTCollisionDetector*>(
+        mCollisionDetector.get()))
+  {
+    if (!mIsMissingDistanceReported)
+    {
+      dtwarn << "[ConstraintSolver] Continuous collision is enabled for "
+             << shapeFrames.size() << " ShapeFrame(s), but the collision "
+             << "detector [" << mCollisionDetector->getType() << "] does "
+             << "not support distance queries. Ignoring continuous "
+             << "collision until the collision detector is changed.\n";
+      mIsMissingDistanceReported = true;
+    }
+    return;
+  }
+
+  // Keep the groups of the ShapeFrames that still have continuous collision,
+  // and only create groups for the ShapeFrames that have just enabled it
+  decltype(mContinuousCollisionGroups) groups;
+  groups.reserve(shapeFrames.size());
+  for (const auto shapeFrame : shapeFrames)
+  {
+    auto& group = groups[shapeFrame];
+
+    const auto search = mContinuousCollisionGroups.find(shapeFrame);
+    if (mContinuousCollisionGroups.end() != search)
+    {
+      group = std::move(search->second);
+    }
+    else
+    {
+      group = mCollisionDetector->createCollisionGroupAsSharedPtr();
+      group->addShapeFrame(shapeFrame);
+    }
+  }
+  mContinuousCollisionGroups.swap(groups);
+
+  collision::DistanceOption option(
+      true, 0.0, std::make_shared<SpeculativeContactFilter>(
+        mCollisionOption.collisionFilter));
+  collision::DistanceResult result;
+
+  for (const auto shapeFrame : shapeFrames)
+  {
+    mContinuousCollisionGroups[shapeFrame]->distance(
+          mCollisionGroup.get(), option, &result);
+
+    // Penetrating pairs are already handled by the discrete collision
+    // detection
+    if (!result.found() || result.unclampedMinDistance <= 0.0)
+      continue;
+
+    auto shapeFrame1 = result.shapeFrame1;
+    auto shapeFrame2 = result.shapeFrame2;
+    Eigen::Vector3d point1 = result.nearestPoint1;
+    Eigen::Vector3d point2 = result.nearestPoint2;
+    if (shapeFrame1 != shapeFrame)
+    {
+      std::swap(shapeFrame1, shapeFrame2);
+      std::swap(point1, point2);
+    }
+
+    collision::Contact contact;
+    contact.normal = point1 - point2;
+    if (collision::Contact::isZeroNormal(contact.normal))
+      continue;
+    contact.normal.normalize();
+
+    // Skip unless the ShapeFrame would close the gap within this time step
+    const double distance = result.unclampedMinDistance;
+    const double approachingVelocity
+        = (getPointVelocity(shapeFrame2, point2)
+           - getPointVelocity(shapeFrame1, point1)).dot(contact.normal);
+    if (approachingVelocity * mTimeStep <= distance)
+      continue;
+
+    contact.point = 0.5 * (point1 + point2);
+    contact.penetrationDepth = -distance;
+    contact.collisionObject1 = mCollisionGroup->getCollisionObject(shapeFrame1);
+    contact.collisionObject2 = mCollisionGroup->getCollisionObject(shapeFrame2);
+    assert(contact.collisionObject1);
+    assert(contact.collisionObject2);
+
+    // SoftContactConstraint does not support separated contacts
+    if (isSoftContact(contact))
+      continue;
+
+    mSpeculativeContacts.push_back(contact);
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::reduceContactManifolds()
+{
+  const auto numContacts = mCollisionResult.getNumContacts();
+
+  if (!mContactManifoldReductionEnabled || numContacts <= 4u)
+  {
+    mContactIndices.resize(numContacts);
+    std::iota(mContactIndices.begin(), mContactIndices.end(), 0u);
+    return;
+  }
+
+  // Contacts with normals within about 18 degrees of each other are treated
+  // as lying on the same contact plane
+  const double coplanarTolerance = 0.95;
+
+  mContactIndices.clear();
+
+  std::vector<Eigen::Vector3d> normals;
+  std::vector<std::vector<std::size_t>> manifolds;
+
+  for (auto i = 0u; i < mCollisionResult.getNumContactPairs(); ++i)
+  {
+    const auto begin = mCollisionResult.getContactPairBegin(i);
+    const auto end = mCollisionResult.getContactPairEnd(i);
+
+    if (end - begin <= 4u)
+    {
+      for (auto j = begin; j < end; ++j)
+        mContactIndices.push_back(j);
+      continue;
+    }
+
+    // Merge the contacts with coplanar normals into manifolds. The normals are
+    // flipped to the same object order first.
+    const auto collisionObject1
+        = mCollisionResult.getContact(begin).collisionObject1;
+    normals.clear();
+    manifolds.clear();
+    for (auto j = begin; j < end; ++j)
+    {
+      const auto& contact = mCollisionResult.getContact(j);
+      Eigen::Vector3d normal = contact.normal;
+      if (contact.collisionObject1 != collisionObject1)
+        normal = -normal;
+
+      auto k = 0u;
+      while (k < normals.size() && normals[k].dot(normal) < coplanarTolerance)
+        ++k;
+
+      if (k == normals.size())
+      {
+        normals.push_back(normal);
+        manifolds.emplace_back();
+      }
+      manifolds[k].push_back(j);
+    }
+
+    for (auto k = 0u; k < manifolds.size(); ++k)
+    {
+      reduceContactManifold(mCollisionResult, normals[k], manifolds[k]);
+      mContactIndices.insert(
+            mContactIndices.end(), manifolds[k].begin(), manifolds[k].end());
+    }
+  }
+}
+
 //==============================================================================
 bool ConstraintSolver::isSoftContact(const collision::Contact& contact) const
 {
@@ -33,6 +33,8 @@
 #ifndef DART_CONSTRAINT_CONSTRAINTSOVER_HPP_
 #define DART_CONSTRAINT_CONSTRAINTSOVER_HPP_
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -90,6 +92,16 @@ public:
   /// Remove all constraints
   void removeAllConstraints();
 
+  /// Return the number of constraints that were added to this
+  /// ConstraintSolver
+  std::size_t getNumConstraints() const;
+
+  /// Return the index-th constraint that was added to this ConstraintSolver
+  ConstraintBasePtr getConstraint(std::size_t _index);
+
+  /// Return the index-th constraint that was added to this ConstraintSolver
+  ConstConstraintBasePtr getConstraint(std::size_t _index) const;
+
   /// Clears the last collision result
   void clearLastCollisionResult();
 
@@ -137,15 +149,49 @@ public:
   /// Return the last collision checking result
   const collision::CollisionResult& getLastCollisionResult() const;
 
+  /// Set whether the contacts between each pair of colliding objects are
+  /// reduced to contact manifolds before contact constraints are created.
+  /// Contacts with nearly the same normal form a manifold, and a manifold with
+  /// more than four contacts keeps only the deepest contact and the three
+  /// others that span the largest area with it. This shrinks the LCP when
+  /// collision detectors report many near duplicate contacts, such as for
+  /// meshes. Disabled by default.
+  void setContactManifoldReductionEnabled(bool enabled);
+
+  /// Return true if contacts are reduced to contact manifolds before contact
+  /// constraints are created
+  bool isContactManifoldReductionEnabled() const;
+
   /// Set LCP solver
   void setLCPSolver(std::unique_ptr<LCPSolver> _lcpSolver);
 
   /// Get LCP solver
   LCPSolver* getLCPSolver() const;
 
+  /// Start recording the LCP of every ConstrainedGroup, with its solution and
+  /// solve time, to the binary trace file _fileName. LCPTraceReader reads the
+  /// trace back, so slow or failing steps can be reproduced and solvers can
+  /// be compared offline. Return false if the file cannot be created.
+  bool startLCPCapture(const std::string& _fileName);
+
+  /// Stop recording LCPs and close the trace file
+  void stopLCPCapture();
+
+  /// Return true if LCPs are being recorded
+  bool isCapturingLCPs() const;
+
   /// Solve constraint impulses and apply them to the skeletons
   void solve();
 
+  /// Return the number of constrained groups that the last call to solve()
+  /// built
+  std::size_t getNumConstrainedGroups() const;
+
+  /// Return a constrained group that the last call to solve() built. The
+  /// groups are sorted from the one with the most constraints to the one with
+  /// the fewest.
+  const ConstrainedGroup& getConstrainedGroup(std::size_t _index) const;
+
 private:
   /// Check if the skeleton is contained in this solver
   bool containSkeleton(const dynamics::ConstSkeletonPtr& _skeleton) const;
@@ -162,6 +208,24 @@ private:
   /// Update constraints
   void updateConstraints();
 
+  /// Fill mSpeculativeContacts for the ShapeFrames that have continuous
+  /// collision enabled in their CollisionAspect. Each such ShapeFrame gets a
+  /// contact with the closest object that it would reach within the time
+  /// step, so that it cannot tunnel through the object. The contacts only
+  /// become contact constraints, and are not part of mCollisionResult since
+  /// the ShapeFrames are not in collision yet.
+  void updateSpeculativeContacts();
+
+  /// Fill mContactIndices with the contacts of mCollisionResult that contact
+  /// constraints are created for, which are all of them unless contact
+  /// manifold reduction is enabled
+  void reduceContactManifolds();
+
+  /// Recreate the joint limit, servo motor and joint Coulomb friction
+  /// constraints of the joints in mSkeletons, and record the versions of the
+  /// Skeletons they were created for
+  void createJointConstraints();
+
   /// Build constrained groupsContact
   void buildConstrainedGroups();
 
@@ -185,6 +249,26 @@ private:
   /// Last collision checking result
   collision::CollisionResult mCollisionResult;
 
+  /// Collision groups that each hold one of the ShapeFrames that have
+  /// continuous collision enabled, for finding its speculative contact. They
+  /// are kept for as long as the ShapeFrame has continuous collision enabled.
+  std::unordered_map<const dynamics::ShapeFrame*, collision::CollisionGroupPtr>
+      mContinuousCollisionGroups;
+
+  /// Speculative contacts of the last update of the constraints
+  std::vector<collision::Contact> mSpeculativeContacts;
+
+  /// Whether the collision detector has been reported to lack the distance
+  /// queries that speculative contacts need
+  bool mIsMissingDistanceReported;
+
+  /// Indices of the contacts in mCollisionResult that contact constraints are
+  /// created for
+  std::vector<std::size_t> mContactIndices;
+
+  /// Whether contacts are reduced to contact manifolds
+  bool mContactManifoldReductionEnabled;
+
   /// Time step
   double mTimeStep;
 
@@ -209,14 +293,29 @@ private:
   /// Joint Coulomb friction constraints those are automatically created
   std::vector<JointCoulombFrictionConstraintPtr> mJointCoulombFrictionConstraints;
 
+  /// Version of each Skeleton in mSkeletons when the joint constraints were
+  /// last created. This is cleared whenever a Skeleton is added or removed.
+  std::vector<std::size_t> mJointConstraintVersions;
+
   /// Constraints that manually added
   std::vector<ConstraintBasePtr> mManualConstraints;
 
   /// Active constraints
   std::vector<ConstraintBasePtr> mActiveConstraints;
 
-  /// Constraint group list
+  /// Constraint group list, sorted from the largest group to the smallest
   std::vector<ConstrainedGroup> mConstrainedGroups;
+
+  /// Root of the union of each active constraint. This is only filled while
+  /// the constrained groups are being built.
+  std::vector<dynamics::SkeletonPtr> mConstraintRoots;
+
+  /// Number of constraints in each union while the constrained groups are
+  /// being built, and then the index of the group of each union
+  std::vector<std::size_t> mConstrainedGroupSizes;
+
+  /// Unions sorted from the largest to the smallest
+  std::vector<std::size_t> mConstrainedGroupOrder;
 };
 
 }  // namespace constraint
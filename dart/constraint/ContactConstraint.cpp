@@ -422,7 +422,14 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       // A. Penetration correction
       double bouncingVelocity = mContacts[i]->penetrationDepth
                                 - mErrorAllowance;
-      if (bouncingVelocity < 0.0)
+      if (mContacts[i]->penetrationDepth < 0.0)
+      {
+        // The bodies are still apart (e.g., speculative contact), so they may
+        // approach each other by the gap within this time step
+        bouncingVelocity
+            = mContacts[i]->penetrationDepth * _info->invTimeStep;
+      }
+      else if (bouncingVelocity < 0.0)
       {
         bouncingVelocity = 0.0;
       }
@@ -490,7 +497,14 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       // A. Penetration correction
       double bouncingVelocity = mContacts[i]->penetrationDepth
                                 - DART_ERROR_ALLOWANCE;
-      if (bouncingVelocity < 0.0)
+      if (mContacts[i]->penetrationDepth < 0.0)
+      {
+        // The bodies are still apart (e.g., speculative contact), so they may
+        // approach each other by the gap within this time step
+        bouncingVelocity
+            = mContacts[i]->penetrationDepth * _info->invTimeStep;
+      }
+      else if (bouncingVelocity < 0.0)
       {
         bouncingVelocity = 0.0;
       }
@@ -769,6 +783,22 @@ dynamics::SkeletonPtr ContactConstraint::getRootSkeleton() const
     return mBodyNode2->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+bool ContactConstraint::collectReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& _skeletons) const
+{
+  if (mBodyNode1->isReactive())
+    _skeletons.push_back(mBodyNode1->getSkeleton().get());
+
+  if (mBodyNode2->isReactive()
+      && mBodyNode2->getSkeleton() != mBodyNode1->getSkeleton())
+  {
+    _skeletons.push_back(mBodyNode2->getSkeleton().get());
+  }
+
+  return true;
+}
+
 //==============================================================================
 void ContactConstraint::updateFirstFrictionalDirection()
 {
@@ -32,6 +32,9 @@
 
 #include "dart/constraint/DantzigLCPSolver.hpp"
 
+#include <chrono>
+#include <vector>
+
 #ifndef NDEBUG
 #include <iomanip>
 #include <iostream>
@@ -42,6 +45,7 @@
 #include "dart/common/Console.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/constraint/LCPTrace.hpp"
 #include "dart/lcpsolver/Lemke.hpp"
 
 namespace dart {
@@ -160,9 +164,23 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
 //  print(n, A, x, lo, hi, b, w, findex);
 //  std::cout << std::endl;
 
+  // Record the LCP before dSolveLCP() overwrites it
+  LCPProblem problem;
+  if (mTrace)
+    problem.setProblem(n, nSkip, A, x, b, lo, hi, findex);
+
   // Solve LCP using ODE's Dantzig algorithm
+  const auto start = std::chrono::steady_clock::now();
   dSolveLCP(n, A, x, b, w, 0, lo, hi, findex);
 
+  if (mTrace)
+  {
+    problem.mSolveTime = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+    problem.mX = Eigen::Map<const Eigen::VectorXd>(x, n);
+    mTrace->write(problem);
+  }
+
   // Print LCP formulation
 //  dtdbg << "After solve:" << std::endl;
 //  print(n, A, x, lo, hi, b, w, findex);
@@ -187,6 +205,38 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
   delete[] findex;
 }
 
+//==============================================================================
+bool DantzigLCPSolver::solveLCP(LCPProblem& _problem)
+{
+  const std::size_t n = _problem.getDimension();
+  if (0u == n)
+    return true;
+
+  // dSolveLCP() overwrites its inputs, so it works on copies
+  const std::size_t nSkip = dPAD(n);
+  std::vector<double> A(n * nSkip, 0.0);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    for (std::size_t j = 0; j < n; ++j)
+      A[i * nSkip + j] = _problem.mA(i, j);
+  }
+  std::vector<double> b(_problem.mB.data(), _problem.mB.data() + n);
+  std::vector<double> lo(_problem.mLo.data(), _problem.mLo.data() + n);
+  std::vector<double> hi(_problem.mHi.data(), _problem.mHi.data() + n);
+  std::vector<int> findex(_problem.mFIndex.data(), _problem.mFIndex.data() + n);
+  std::vector<double> w(n, 0.0);
+  _problem.mX = _problem.mInitialGuess;
+
+  const auto start = std::chrono::steady_clock::now();
+  dSolveLCP(n, A.data(), _problem.mX.data(), b.data(), w.data(), 0, lo.data(),
+            hi.data(), findex.data());
+  _problem.mSolveTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+  _problem.mNumIterations = 0u;
+
+  return true;
+}
+
 //==============================================================================
 #ifndef NDEBUG
 bool DantzigLCPSolver::isSymmetric(std::size_t _n, double* _A)
@@ -55,6 +55,9 @@ public:
   // Documentation inherited
   void solve(ConstrainedGroup* _group) override;
 
+  // Documentation inherited
+  bool solveLCP(LCPProblem& _problem) override;
+
 #ifndef NDEBUG
 private:
   /// Return true if the matrix is symmetric
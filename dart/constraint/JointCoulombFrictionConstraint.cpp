@@ -273,6 +273,15 @@ dynamics::SkeletonPtr JointCoulombFrictionConstraint::getRootSkeleton() const
   return mJoint->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+bool JointCoulombFrictionConstraint::collectReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& _skeletons) const
+{
+  _skeletons.push_back(mJoint->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 bool JointCoulombFrictionConstraint::isActive() const
 {
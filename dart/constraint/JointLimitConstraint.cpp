@@ -383,6 +383,15 @@ dynamics::SkeletonPtr JointLimitConstraint::getRootSkeleton() const
   return mJoint->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+bool JointLimitConstraint::collectReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& _skeletons) const
+{
+  _skeletons.push_back(mJoint->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 bool JointLimitConstraint::isActive() const
 {
@@ -34,9 +34,29 @@
 
 #include <cassert>
 
+#include "dart/constraint/LCPTrace.hpp"
+
 namespace dart {
 namespace constraint {
 
+//==============================================================================
+bool LCPSolver::solveLCP(LCPProblem& /*_problem*/)
+{
+  return false;
+}
+
+//==============================================================================
+void LCPSolver::setTrace(std::shared_ptr<LCPTraceWriter> _trace)
+{
+  mTrace = std::move(_trace);
+}
+
+//==============================================================================
+const std::shared_ptr<LCPTraceWriter>& LCPSolver::getTrace() const
+{
+  return mTrace;
+}
+
 //==============================================================================
 void LCPSolver::setTimeStep(double _timeStep)
 {
@@ -33,10 +33,14 @@
 #ifndef DART_CONSTRAINT_LCPSOLVER_HPP_
 #define DART_CONSTRAINT_LCPSOLVER_HPP_
 
+#include <memory>
+
 namespace dart {
 namespace constraint {
 
 class ConstrainedGroup;
+struct LCPProblem;
+class LCPTraceWriter;
 
 /// LCPSolver
 class LCPSolver
@@ -45,6 +49,20 @@ public:
   /// Solve constriant impulses for a constrained group
   virtual void solve(ConstrainedGroup* _group) = 0;
 
+  /// Solve a LCP that is given directly instead of assembled from a
+  /// ConstrainedGroup, such as one read from a trace, and store the solution,
+  /// the solve time and the number of iterations in _problem. Return false if
+  /// this solver does not support it.
+  virtual bool solveLCP(LCPProblem& _problem);
+
+  /// Record the LCP of every ConstrainedGroup that this solver solves, with
+  /// its solution and solve time, to _trace. Pass nullptr to stop recording.
+  void setTrace(std::shared_ptr<LCPTraceWriter> _trace);
+
+  /// Return the trace that LCPs are recorded to, or nullptr if they are not
+  /// recorded
+  const std::shared_ptr<LCPTraceWriter>& getTrace() const;
+
   /// Set time step
   void setTimeStep(double _timeStep);
 
@@ -61,6 +79,9 @@ protected:
 protected:
   /// Simulation time step
   double mTimeStep;
+
+  /// Trace that LCPs are recorded to
+  std::shared_ptr<LCPTraceWriter> mTrace;
 };
 
 } // namespace constraint
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/LCPTrace.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "dart/common/Console.hpp"
+
+namespace dart {
+namespace constraint {
+
+namespace {
+
+const char traceMagic[4] = {'D', 'L', 'C', 'P'};
+const std::uint32_t traceVersion = 1u;
+
+//==============================================================================
+template <typename T>
+void writeValue(std::ofstream& _file, const T& _value)
+{
+  _file.write(reinterpret_cast<const char*>(&_value), sizeof(T));
+}
+
+//==============================================================================
+template <typename T>
+bool readValue(std::ifstream& _file, T& _value)
+{
+  return static_cast<bool>(
+        _file.read(reinterpret_cast<char*>(&_value), sizeof(T)));
+}
+
+//==============================================================================
+void writeVector(std::ofstream& _file, const Eigen::VectorXd& _vector)
+{
+  _file.write(reinterpret_cast<const char*>(_vector.data()),
+              static_cast<std::streamsize>(_vector.size() * sizeof(double)));
+}
+
+//==============================================================================
+bool readVector(std::ifstream& _file, std::size_t _n, Eigen::VectorXd& _vector)
+{
+  _vector.resize(static_cast<int>(_n));
+  return static_cast<bool>(
+        _file.read(reinterpret_cast<char*>(_vector.data()),
+                   static_cast<std::streamsize>(_n * sizeof(double))));
+}
+
+//==============================================================================
+std::uint64_t getNumRemainingBytes(std::ifstream& _file)
+{
+  const std::streampos position = _file.tellg();
+  _file.seekg(0, std::ios::end);
+  const std::streampos end = _file.tellg();
+  _file.seekg(position);
+
+  if (position < 0 || end < position)
+    return 0u;
+
+  return static_cast<std::uint64_t>(end - position);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+LCPProblem::LCPProblem()
+  : mSolveTime(0.0),
+    mNumIterations(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void LCPProblem::setProblem(
+    std::size_t _n, std::size_t _nSkip, const double* _A, const double* _x,
+    const double* _b, const double* _lo, const double* _hi, const int* _findex)
+{
+  const int n = static_cast<int>(_n);
+
+  mA.resize(n, n);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+      mA(i, j) = _A[static_cast<std::size_t>(i) * _nSkip + j];
+  }
+
+  mInitialGuess = Eigen::Map<const Eigen::VectorXd>(_x, n);
+  mB = Eigen::Map<const Eigen::VectorXd>(_b, n);
+  mLo = Eigen::Map<const Eigen::VectorXd>(_lo, n);
+  mHi = Eigen::Map<const Eigen::VectorXd>(_hi, n);
+  mFIndex = Eigen::Map<const Eigen::VectorXi>(_findex, n);
+  mX.setZero(n);
+  mSolveTime = 0.0;
+  mNumIterations = 0u;
+}
+
+//==============================================================================
+std::size_t LCPProblem::getDimension() const
+{
+  return static_cast<std::size_t>(mB.size());
+}
+
+//==============================================================================
+double LCPProblem::computeResidual(const Eigen::VectorXd& _x) const
+{
+  const Eigen::VectorXd w = mA * _x - mB;
+
+  double residual = 0.0;
+  for (int i = 0; i < _x.size(); ++i)
+  {
+    double lo = mLo[i];
+    double hi = mHi[i];
+    if (mFIndex[i] >= 0)
+    {
+      hi = std::abs(mHi[i] * _x[mFIndex[i]]);
+      lo = -hi;
+    }
+
+    const double projected = std::min(std::max(_x[i] - w[i], lo), hi);
+    residual = std::max(residual, std::abs(_x[i] - projected));
+  }
+
+  return residual;
+}
+
+//==============================================================================
+double LCPProblem::computeResidual() const
+{
+  return computeResidual(mX);
+}
+
+//==============================================================================
+LCPTraceWriter::LCPTraceWriter(const std::string& _fileName)
+  : mFile(_fileName, std::ios::binary | std::ios::trunc),
+    mNumProblems(0u)
+{
+  if (!mFile)
+  {
+    dterr << "[LCPTraceWriter] Failed to open '" << _fileName
+          << "' for writing.\n";
+    return;
+  }
+
+  mFile.write(traceMagic, sizeof(traceMagic));
+  writeValue(mFile, traceVersion);
+}
+
+//==============================================================================
+bool LCPTraceWriter::isOpen() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mFile.is_open() && mFile.good();
+}
+
+//==============================================================================
+void LCPTraceWriter::write(const LCPProblem& _problem)
+{
+  const std::size_t n = _problem.getDimension();
+  assert(static_cast<std::size_t>(_problem.mA.rows()) == n);
+  assert(static_cast<std::size_t>(_problem.mX.size()) == n);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (!mFile)
+    return;
+
+  writeValue(mFile, static_cast<std::uint32_t>(n));
+  writeValue(mFile, static_cast<std::uint32_t>(_problem.mNumIterations));
+  writeValue(mFile, _problem.mSolveTime);
+  writeVector(mFile, _problem.mB);
+  writeVector(mFile, _problem.mLo);
+  writeVector(mFile, _problem.mHi);
+  writeVector(mFile, _problem.mInitialGuess);
+  writeVector(mFile, _problem.mX);
+  for (std::size_t i = 0; i < n; ++i)
+    writeValue(mFile, static_cast<std::int32_t>(_problem.mFIndex[i]));
+
+  // The matrix is symmetric, so only its upper triangle is stored
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    for (std::size_t j = i; j < n; ++j)
+      writeValue(mFile, _problem.mA(i, j));
+  }
+
+  ++mNumProblems;
+}
+
+//==============================================================================
+std::size_t LCPTraceWriter::getNumProblems() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumProblems;
+}
+
+//==============================================================================
+LCPTraceReader::LCPTraceReader(const std::string& _fileName)
+  : mFile(_fileName, std::ios::binary),
+    mValid(false)
+{
+  if (!mFile)
+  {
+    dterr << "[LCPTraceReader] Failed to open '" << _fileName << "'.\n";
+    return;
+  }
+
+  char magic[sizeof(traceMagic)];
+  std::uint32_t version = 0u;
+  if (!mFile.read(magic, sizeof(magic))
+      || std::memcmp(magic, traceMagic, sizeof(magic)) != 0
+      || !readValue(mFile, version))
+  {
+    dterr << "[LCPTraceReader] '" << _fileName << "' is not an LCP trace.\n";
+    return;
+  }
+
+  if (version != traceVersion)
+  {
+    dterr << "[LCPTraceReader] '" << _fileName << "' has unsupported version "
+          << version << ".\n";
+    return;
+  }
+
+  mValid = true;
+}
+
+//==============================================================================
+bool LCPTraceReader::isOpen() const
+{
+  return mValid;
+}
+
+//==============================================================================
+bool LCPTraceReader::read(LCPProblem& _problem)
+{
+  if (!mValid)
+    return false;
+
+  std::uint32_t n = 0u;
+  std::uint32_t numIterations = 0u;
+  if (!readValue(mFile, n))
+    return false;
+
+  // A corrupt dimension must not make the vectors and the matrix below
+  // allocate more than the rest of the trace could ever fill. Each problem
+  // stores the iteration count, the solve time, five vectors, the friction
+  // indices and the upper triangle of the matrix.
+  const std::uint64_t size = n;
+  const std::uint64_t numRemainingBytes = getNumRemainingBytes(mFile);
+  const std::uint64_t numVectorBytes
+      = sizeof(std::uint32_t) + sizeof(double)
+        + size * (5u * sizeof(double) + sizeof(std::int32_t));
+  if (numRemainingBytes < numVectorBytes
+      || (numRemainingBytes - numVectorBytes) / sizeof(double)
+         < size * (size + 1u) / 2u)
+  {
+    dtwarn << "[LCPTraceReader] The trace is too short for a problem of "
+           << "dimension " << n << ".\n";
+    mValid = false;
+    return false;
+  }
+
+  if (!readValue(mFile, numIterations)
+      || !readValue(mFile, _problem.mSolveTime)
+      || !readVector(mFile, n, _problem.mB)
+      || !readVector(mFile, n, _problem.mLo)
+      || !readVector(mFile, n, _problem.mHi)
+      || !readVector(mFile, n, _problem.mInitialGuess)
+      || !readVector(mFile, n, _problem.mX))
+  {
+    dtwarn << "[LCPTraceReader] The trace ends in the middle of a problem.\n";
+    mValid = false;
+    return false;
+  }
+  _problem.mNumIterations = numIterations;
+
+  _problem.mFIndex.resize(n);
+  for (std::uint32_t i = 0; i < n; ++i)
+  {
+    std::int32_t findex = -1;
+    if (!readValue(mFile, findex) || findex < -1
+        || findex >= static_cast<std::int32_t>(n))
+    {
+      dtwarn << "[LCPTraceReader] The trace has an invalid friction index.\n";
+      mValid = false;
+      return false;
+    }
+    _problem.mFIndex[i] = findex;
+  }
+
+  _problem.mA.resize(n, n);
+  for (std::uint32_t i = 0; i < n; ++i)
+  {
+    for (std::uint32_t j = i; j < n; ++j)
+    {
+      if (!readValue(mFile, _problem.mA(i, j)))
+      {
+        dtwarn << "[LCPTraceReader] The trace ends in the middle of a "
+               << "problem.\n";
+        mValid = false;
+        return false;
+      }
+      _problem.mA(j, i) = _problem.mA(i, j);
+    }
+  }
+
+  return true;
+}
+
+}  // namespace constraint
+}  // namespace dart
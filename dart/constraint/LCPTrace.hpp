@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_LCPTRACE_HPP_
+#define DART_CONSTRAINT_LCPTRACE_HPP_
+
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace constraint {
+
+/// LCPProblem is a LCP as an LCPSolver assembles it for a ConstrainedGroup,
+/// in the form that ODE's dSolveLCP() takes: find x and w such that
+/// A * x = b + w and, for each row i, lo_i <= x_i <= hi_i where w_i >= 0 if
+/// x_i = lo_i, w_i <= 0 if x_i = hi_i and w_i = 0 otherwise. A friction row i
+/// has findex_i >= 0, and its bounds are -hi_i * x_findex_i and
+/// hi_i * x_findex_i instead.
+struct LCPProblem
+{
+  /// Symmetric LCP matrix
+  Eigen::MatrixXd mA;
+
+  Eigen::VectorXd mB;
+
+  Eigen::VectorXd mLo;
+
+  Eigen::VectorXd mHi;
+
+  /// Row that bounds each friction row, or -1 for the other rows
+  Eigen::VectorXi mFIndex;
+
+  /// Initial guess of x. Constraints warm start with their previous impulses.
+  Eigen::VectorXd mInitialGuess;
+
+  /// Solution
+  Eigen::VectorXd mX;
+
+  /// Wall-clock time that solving took in seconds
+  double mSolveTime;
+
+  /// Number of iterations that solving took, or zero for solvers that do not
+  /// iterate
+  std::size_t mNumIterations;
+
+  /// Constructor
+  LCPProblem();
+
+  /// Set the problem from the arrays an LCPSolver passes to ODE's
+  /// dSolveLCP(), where _A is stored by rows with a leading dimension of
+  /// _nSkip, and _x is the initial guess
+  void setProblem(std::size_t _n, std::size_t _nSkip, const double* _A,
+                  const double* _x, const double* _b, const double* _lo,
+                  const double* _hi, const int* _findex);
+
+  /// Return the number of rows
+  std::size_t getDimension() const;
+
+  /// Return the largest violation of the LCP conditions by _x, that is the
+  /// infinity norm of x - clamp(x - w, lo, hi) where w = A * x - b.
+  double computeResidual(const Eigen::VectorXd& _x) const;
+
+  /// Return the largest violation of the LCP conditions by the solution
+  double computeResidual() const;
+};
+
+/// LCPTraceWriter records LCPProblems to a binary trace file that
+/// LCPTraceReader reads back, for example to replay the LCPs of a simulation
+/// through other LCPSolvers offline.
+///
+/// The file starts with the four characters "DLCP" and a 32-bit format
+/// version. Each problem then follows as its 32-bit dimension n, its 32-bit
+/// number of iterations, its solve time, the n entries of each of b, lo, hi,
+/// the initial guess and the solution, the n 32-bit entries of findex, and
+/// the n * (n + 1) / 2 entries of the upper triangle of A row by row. Numbers
+/// are stored as doubles and integers in the byte order of the machine that
+/// recorded them.
+class LCPTraceWriter
+{
+public:
+  /// Constructor. Creates _fileName, or truncates it if it exists.
+  explicit LCPTraceWriter(const std::string& _fileName);
+
+  /// Return true if the file was opened and nothing has failed to be written
+  bool isOpen() const;
+
+  /// Append a problem to the trace. This can be called from multiple threads.
+  void write(const LCPProblem& _problem);
+
+  /// Return the number of problems written so far
+  std::size_t getNumProblems() const;
+
+private:
+  /// Trace file
+  std::ofstream mFile;
+
+  /// Number of problems written so far
+  std::size_t mNumProblems;
+
+  /// Mutex that serializes writes
+  mutable std::mutex mMutex;
+};
+
+/// LCPTraceReader reads the problems recorded by LCPTraceWriter in order
+class LCPTraceReader
+{
+public:
+  /// Constructor
+  explicit LCPTraceReader(const std::string& _fileName);
+
+  /// Return true if the file was opened and starts with a valid header
+  bool isOpen() const;
+
+  /// Read the next problem into _problem. Return false at the end of the
+  /// trace, or if the rest of the trace is corrupt.
+  bool read(LCPProblem& _problem);
+
+private:
+  /// Trace file
+  std::ifstream mFile;
+
+  /// Whether the file starts with a valid header
+  bool mValid;
+};
+
+}  // namespace constraint
+}  // namespace dart
+
+#endif  // DART_CONSTRAINT_LCPTRACE_HPP_
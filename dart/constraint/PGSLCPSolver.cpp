@@ -32,6 +32,10 @@
 
 #include "dart/constraint/PGSLCPSolver.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
 #ifndef NDEBUG
 #include <iomanip>
 #include <iostream>
@@ -42,6 +46,7 @@
 #include "dart/common/Console.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/constraint/LCPTrace.hpp"
 #include "dart/lcpsolver/Lemke.hpp"
 
 namespace dart {
@@ -160,9 +165,25 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
 
   // Solve LCP using ODE's Dantzig algorithm
 //  dSolveLCP(n, A, x, b, w, 0, lo, hi, findex);
+  // Record the LCP before solvePGS() scales it
+  LCPProblem problem;
+  if (mTrace)
+    problem.setProblem(n, nSkip, A, x, b, lo, hi, findex);
+
   PGSOption option;
   option.setDefault();
-  solvePGS(n, nSkip, 0, A, x, b, lo, hi, findex, &option);
+  int numIterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  solvePGS(n, nSkip, 0, A, x, b, lo, hi, findex, &option, &numIterations);
+
+  if (mTrace)
+  {
+    problem.mSolveTime = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+    problem.mNumIterations = static_cast<std::size_t>(numIterations);
+    problem.mX = Eigen::Map<const Eigen::VectorXd>(x, n);
+    mTrace->write(problem);
+  }
 
   // Print LCP formulation
   //  dtdbg << "After solve:" << std::endl;
@@ -188,6 +209,40 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
   delete[] findex;
 }
 
+//==============================================================================
+bool PGSLCPSolver::solveLCP(LCPProblem& _problem)
+{
+  const std::size_t n = _problem.getDimension();
+  if (0u == n)
+    return true;
+
+  // solvePGS() scales A and b, so it works on copies
+  const std::size_t nSkip = dPAD(n);
+  std::vector<double> A(n * nSkip, 0.0);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    for (std::size_t j = 0; j < n; ++j)
+      A[i * nSkip + j] = _problem.mA(i, j);
+  }
+  std::vector<double> b(_problem.mB.data(), _problem.mB.data() + n);
+  std::vector<double> lo(_problem.mLo.data(), _problem.mLo.data() + n);
+  std::vector<double> hi(_problem.mHi.data(), _problem.mHi.data() + n);
+  std::vector<int> findex(_problem.mFIndex.data(), _problem.mFIndex.data() + n);
+  _problem.mX = _problem.mInitialGuess;
+
+  PGSOption option;
+  option.setDefault();
+  int numIterations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  solvePGS(n, nSkip, 0, A.data(), _problem.mX.data(), b.data(), lo.data(),
+           hi.data(), findex.data(), &option, &numIterations);
+  _problem.mSolveTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+  _problem.mNumIterations = static_cast<std::size_t>(numIterations);
+
+  return true;
+}
+
 //==============================================================================
 #ifndef NDEBUG
 bool PGSLCPSolver::isSymmetric(std::size_t _n, double* _A)
@@ -342,7 +397,8 @@ void PGSLCPSolver::print(std::size_t _n, double* _A, double* _x,
 #endif
 
 bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
-              double * lo, double * hi, int * findex, PGSOption * option)
+              double * lo, double * hi, int * findex, PGSOption * option,
+              int * numIterations)
 {
   // LDLT solver will work !!!
   //if (nub == n)
@@ -416,6 +472,8 @@ bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
   if (sentinel)
   {
     delete[] order;
+    if (numIterations)
+      *numIterations = 1;
     return true;
   }
 
@@ -500,6 +558,11 @@ bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
       break;
   }
   delete[] order;
+
+  // The initial loop counts as the first iteration
+  if (numIterations)
+    *numIterations = std::min(iter + 1, option->itermax);
+
   return sentinel;
 }
 
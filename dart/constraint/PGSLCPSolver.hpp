@@ -54,6 +54,9 @@ public:
   // Documentation inherited
   void solve(ConstrainedGroup* _group) override;
 
+  // Documentation inherited
+  bool solveLCP(LCPProblem& _problem) override;
+
 #ifndef NDEBUG
 private:
   /// Return true if the matrix is symmetric
@@ -79,10 +82,13 @@ struct PGSOption
   void setDefault();
 };
 
+/// Solve a LCP with projected Gauss-Seidel iterations. A and b are scaled in
+/// place. If numIterations is not null, the number of iterations is stored in
+/// it.
 bool solvePGS(int n, int nskip, int /*nub*/, double* A,
                             double* x, double * b,
                             double * lo, double * hi, int * findex,
-                            PGSOption * option);
+                            PGSOption * option, int* numIterations = nullptr);
 
 
 } // namespace constraint
@@ -276,6 +276,15 @@ dynamics::SkeletonPtr ServoMotorConstraint::getRootSkeleton() const
   return mJoint->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+bool ServoMotorConstraint::collectReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& skeletons) const
+{
+  skeletons.push_back(mJoint->getSkeleton().get());
+
+  return true;
+}
+
 //==============================================================================
 bool ServoMotorConstraint::isActive() const
 {
@@ -87,27 +87,22 @@ SoftContactConstraint::SoftContactConstraint(
   // TODO(JS): Assumed single contact
   mContacts.push_back(&contact);
 
-  // Set the colliding state of body nodes and point masses to false
-  if (mSoftBodyNode1)
-  {
-    for (std::size_t i = 0; i < mSoftBodyNode1->getNumPointMasses(); ++i)
-      mSoftBodyNode1->getPointMass(i)->setColliding(false);
-  }
-  if (mSoftBodyNode2)
-  {
-    for (std::size_t i = 0; i < mSoftBodyNode2->getNumPointMasses(); ++i)
-      mSoftBodyNode2->getPointMass(i)->setColliding(false);
-  }
-
-  // Select colling point mass based on trimesh ID
+  // Note: The colliding state of the point masses is cleared once per step by
+  // ConstraintSolver::solve(), so it must not be cleared here. Doing it here
+  // would cost O(points) per contact and would also erase the state set by the
+  // other soft contacts of the same step.
+
+  // Select the colliding point mass as the one closest to the contact point.
+  // This goes through the spatial lookup of the SoftBodyNode rather than the
+  // triangle ID of the contact, which only some collision detectors provide.
   if (mSoftBodyNode1)
   {
     if (contact.collisionObject1->getShape()->getType()
         == dynamics::SoftMeshShape::getStaticType())
     {
-      mPointMass1 = selectCollidingPointMass(mSoftBodyNode1, contact.point,
-                                             contact.triID1);
-      mPointMass1->setColliding(true);
+      mPointMass1 = mSoftBodyNode1->getNearestPointMass(contact.point);
+      if (mPointMass1)
+        mPointMass1->setColliding(true);
     }
   }
   if (mSoftBodyNode2)
@@ -115,9 +110,9 @@ SoftContactConstraint::SoftContactConstraint(
     if (contact.collisionObject2->getShape()->getType()
         == dynamics::SoftMeshShape::getStaticType())
     {
-      mPointMass2 = selectCollidingPointMass(mSoftBodyNode2, contact.point,
-                                             contact.triID2);
-      mPointMass2->setColliding(true);
+      mPointMass2 = mSoftBodyNode2->getNearestPointMass(contact.point);
+      if (mPointMass2)
+        mPointMass2->setColliding(true);
     }
   }
 
@@ -917,6 +912,22 @@ dynamics::SkeletonPtr SoftContactConstraint::getRootSkeleton() const
     return mBodyNode2->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+bool SoftContactConstraint::collectReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& _skeletons) const
+{
+  if (mBodyNode1->isReactive())
+    _skeletons.push_back(mBodyNode1->getSkeleton().get());
+
+  if (mBodyNode2->isReactive()
+      && mBodyNode2->getSkeleton() != mBodyNode1->getSkeleton())
+  {
+    _skeletons.push_back(mBodyNode2->getSkeleton().get());
+  }
+
+  return true;
+}
+
 //==============================================================================
 void SoftContactConstraint::uniteSkeletons()
 {
@@ -994,68 +1005,5 @@ Eigen::MatrixXd SoftContactConstraint::getTangentBasisMatrixODE(
   return T;
 }
 
-//==============================================================================
-template <typename PointMassT, typename SoftBodyNodeT>
-static PointMassT selectCollidingPointMassT(
-    SoftBodyNodeT _softBodyNode,
-    const Eigen::Vector3d& _point,
-    int _faceId)
-{
-  PointMassT pointMass = nullptr;
-
-  const Eigen::Vector3i& face = _softBodyNode->getFace(_faceId);
-
-  PointMassT pm0 = _softBodyNode->getPointMass(face[0]);
-  PointMassT pm1 = _softBodyNode->getPointMass(face[1]);
-  PointMassT pm2 = _softBodyNode->getPointMass(face[2]);
-
-  const Eigen::Vector3d& pos1 = pm0->getWorldPosition();
-  const Eigen::Vector3d& pos2 = pm1->getWorldPosition();
-  const Eigen::Vector3d& pos3 = pm2->getWorldPosition();
-
-  double dist0 = (pos1 - _point).dot(pos1 - _point);
-  double dist1 = (pos2 - _point).dot(pos2 - _point);
-  double dist2 = (pos3 - _point).dot(pos3 - _point);
-
-  if (dist0 > dist1)
-  {
-    if (dist1 > dist2)
-      pointMass = pm2;
-    else
-      pointMass = pm1;
-  }
-  else
-  {
-    if (dist0 > dist2)
-      pointMass = pm2;
-    else
-      pointMass = pm0;
-  }
-
-  return pointMass;
-}
-
-//==============================================================================
-const dynamics::PointMass* SoftContactConstraint::selectCollidingPointMass(
-    const dynamics::SoftBodyNode* _softBodyNode,
-    const Eigen::Vector3d& _point,
-    int _faceId) const
-{
-  return selectCollidingPointMassT<const dynamics::PointMass*,
-                                   const dynamics::SoftBodyNode*>(
-        _softBodyNode, _point, _faceId);
-}
-
-//==============================================================================
-dynamics::PointMass* SoftContactConstraint::selectCollidingPointMass(
-    dynamics::SoftBodyNode* _softBodyNode,
-    const Eigen::Vector3d& _point,
-    int _faceId) const
-{
-  return selectCollidingPointMassT<dynamics::PointMass*,
-                                   dynamics::SoftBodyNode*>(
-        _softBodyNode, _point, _faceId);
-}
-
 }  // namespace constraint
 }  // namespace dart
@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/SparsePGSLCPSolver.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+
+#include "dart/constraint/ConstraintBase.hpp"
+#include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/constraint/LCPTrace.hpp"
+
+namespace dart {
+namespace constraint {
+
+//==============================================================================
+SparsePGSLCPSolver::SparsePGSLCPSolver(double _timestep)
+  : LCPSolver(_timestep),
+    mNumIterations(0u)
+{
+  mOption.setDefault();
+}
+
+//==============================================================================
+SparsePGSLCPSolver::~SparsePGSLCPSolver()
+{
+  // Do nothing
+}
+
+//==============================================================================
+void SparsePGSLCPSolver::solve(ConstrainedGroup* _group)
+{
+  // If there is no constraint, then just return true.
+  const std::size_t numConstraints = _group->getNumConstraints();
+  if (numConstraints == 0)
+    return;
+
+  buildBlocks(_group);
+  fillLCP(_group);
+
+  // Record the LCP before solvePGS() scales it
+  LCPProblem problem;
+  if (mTrace)
+    captureLCP(problem);
+
+  const auto start = std::chrono::steady_clock::now();
+  solvePGS();
+
+  if (mTrace)
+  {
+    problem.mSolveTime = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+    problem.mNumIterations = mNumIterations;
+    problem.mX = Eigen::Map<const Eigen::VectorXd>(mX.data(), mX.size());
+    mTrace->write(problem);
+  }
+
+  // Apply constraint impulses
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const ConstraintBasePtr& constraint = _group->getConstraint(i);
+    constraint->applyImpulse(mX.data() + mOffsets[i]);
+    constraint->excite();
+  }
+}
+
+//==============================================================================
+bool SparsePGSLCPSolver::solveLCP(LCPProblem& _problem)
+{
+  const std::size_t n = _problem.getDimension();
+  if (0u == n)
+    return true;
+
+  mOffsets.resize(n + 1u);
+  mRowConstraints.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    mOffsets[i] = i;
+    mRowConstraints[i] = i;
+  }
+  mOffsets[n] = n;
+
+  // The diagonal is always stored, since solvePGS() looks it up
+  mBlockBegins.resize(n + 1u);
+  mBlockColumns.clear();
+  mValues.clear();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    mBlockBegins[i] = mBlockColumns.size();
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      const double value = _problem.mA(i, j);
+      if (value != 0.0 || i == j)
+      {
+        mBlockColumns.push_back(j);
+        mValues.push_back(value);
+      }
+    }
+  }
+  mBlockBegins[n] = mBlockColumns.size();
+
+  mBlockValues.resize(mBlockColumns.size() + 1u);
+  for (std::size_t b = 0; b < mBlockValues.size(); ++b)
+    mBlockValues[b] = b;
+
+  mX.assign(_problem.mInitialGuess.data(), _problem.mInitialGuess.data() + n);
+  mB.assign(_problem.mB.data(), _problem.mB.data() + n);
+  mLo.assign(_problem.mLo.data(), _problem.mLo.data() + n);
+  mHi.assign(_problem.mHi.data(), _problem.mHi.data() + n);
+  mFIndex.assign(_problem.mFIndex.data(), _problem.mFIndex.data() + n);
+
+  const auto start = std::chrono::steady_clock::now();
+  solvePGS();
+  _problem.mSolveTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+  _problem.mNumIterations = mNumIterations;
+  _problem.mX = Eigen::Map<const Eigen::VectorXd>(mX.data(), n);
+
+  return true;
+}
+
+//==============================================================================
+void SparsePGSLCPSolver::setOption(const PGSOption& _option)
+{
+  mOption = _option;
+}
+
+//==============================================================================
+const PGSOption& SparsePGSLCPSolver::getOption() const
+{
+  return mOption;
+}
+
+//==============================================================================
+std::size_t SparsePGSLCPSolver::getNumBlocks() const
+{
+  return mBlockColumns.size();
+}
+
+//==============================================================================
+std::size_t SparsePGSLCPSolver::getNumEntries() const
+{
+  return mValues.size();
+}
+
+//==============================================================================
+std::size_t SparsePGSLCPSolver::getNumIterations() const
+{
+  return mNumIterations;
+}
+
+//==============================================================================
+void SparsePGSLCPSolver::buildBlocks(ConstrainedGroup* _group)
+{
+  const std::size_t numConstraints = _group->getNumConstraints();
+
+  // Compute offset indices, and collect the Skeletons that couple the
+  // constraints
+  mOffsets.resize(numConstraints + 1u);
+  mOffsets[0] = 0u;
+  mReactiveSkeletons.clear();
+  mReactiveSkeletonBegins.resize(numConstraints + 1u);
+  mSkeletonConstraints.clear();
+  mDenseConstraints.clear();
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const ConstraintBasePtr& constraint = _group->getConstraint(i);
+    assert(constraint->getDimension() > 0);
+    mOffsets[i + 1u] = mOffsets[i] + constraint->getDimension();
+
+    mReactiveSkeletonBegins[i] = mReactiveSkeletons.size();
+    if (!constraint->collectReactiveSkeletons(mReactiveSkeletons))
+    {
+      mReactiveSkeletons.resize(mReactiveSkeletonBegins[i]);
+      mDenseConstraints.push_back(i);
+    }
+
+    for (auto j = mReactiveSkeletonBegins[i]; j < mReactiveSkeletons.size();
+         ++j)
+    {
+      mSkeletonConstraints.emplace_back(mReactiveSkeletons[j], i);
+    }
+  }
+  mReactiveSkeletonBegins[numConstraints] = mReactiveSkeletons.size();
+
+  std::sort(mSkeletonConstraints.begin(), mSkeletonConstraints.end());
+
+  mRowConstraints.resize(mOffsets.back());
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    std::fill(mRowConstraints.begin() + mOffsets[i],
+              mRowConstraints.begin() + mOffsets[i + 1u], i);
+  }
+
+  // Lay out the blocks of each constraint. A constraint is coupled to itself,
+  // to the constraints that share one of its reactive Skeletons and to the
+  // constraints whose Skeletons are unknown.
+  mMarks.assign(numConstraints, numConstraints);
+  mBlockBegins.resize(numConstraints + 1u);
+  mBlockColumns.clear();
+
+  const auto addColumn = [&](std::size_t _row, std::size_t _col) {
+    if (mMarks[_col] == _row)
+      return;
+
+    mMarks[_col] = _row;
+    mBlockColumns.push_back(_col);
+  };
+
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    mBlockBegins[i] = mBlockColumns.size();
+
+    addColumn(i, i);
+
+    if (std::binary_search(
+          mDenseConstraints.begin(), mDenseConstraints.end(), i))
+    {
+      for (std::size_t k = 0; k < numConstraints; ++k)
+        addColumn(i, k);
+    }
+    else
+    {
+      for (auto j = mReactiveSkeletonBegins[i];
+           j < mReactiveSkeletonBegins[i + 1u]; ++j)
+      {
+        const auto range = std::equal_range(
+              mSkeletonConstraints.begin(), mSkeletonConstraints.end(),
+              std::make_pair(mReactiveSkeletons[j], std::size_t(0u)),
+              [](const std::pair<dynamics::Skeleton*, std::size_t>& _a,
+                 const std::pair<dynamics::Skeleton*, std::size_t>& _b) {
+          return _a.first < _b.first;
+        });
+
+        for (auto it = range.first; it != range.second; ++it)
+          addColumn(i, it->second);
+      }
+
+      for (const auto k : mDenseConstraints)
+        addColumn(i, k);
+    }
+
+    std::sort(mBlockColumns.begin() + mBlockBegins[i], mBlockColumns.end());
+  }
+  mBlockBegins[numConstraints] = mBlockColumns.size();
+
+  mBlockValues.resize(mBlockColumns.size() + 1u);
+  std::size_t numEntries = 0u;
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const std::size_t dim = mOffsets[i + 1u] - mOffsets[i];
+    for (auto b = mBlockBegins[i]; b < mBlockBegins[i + 1u]; ++b)
+    {
+      const std::size_t k = mBlockColumns[b];
+      mBlockValues[b] = numEntries;
+      numEntries += dim * (mOffsets[k + 1u] - mOffsets[k]);
+    }
+  }
+  mBlockValues.back() = numEntries;
+  mValues.resize(numEntries);
+}
+
+//==============================================================================
+void SparsePGSLCPSolver::fillLCP(ConstrainedGroup* _group)
+{
+  const std::size_t numConstraints = _group->getNumConstraints();
+  const std::size_t n = mOffsets.back();
+
+  mX.resize(n);
+  mB.resize(n);
+  mLo.resize(n);
+  mHi.resize(n);
+  mW.assign(n, 0.0);
+  mFIndex.assign(n, -1);
+
+  ConstraintInfo constInfo;
+  constInfo.invTimeStep = 1.0 / mTimeStep;
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const ConstraintBasePtr& constraint = _group->getConstraint(i);
+    const std::size_t offset = mOffsets[i];
+    const std::size_t dim = mOffsets[i + 1u] - offset;
+
+    constInfo.x      = mX.data()      + offset;
+    constInfo.lo     = mLo.data()     + offset;
+    constInfo.hi     = mHi.data()     + offset;
+    constInfo.b      = mB.data()      + offset;
+    constInfo.findex = mFIndex.data() + offset;
+    constInfo.w      = mW.data()      + offset;
+
+    // Fill vectors: lo, hi, b, w
+    constraint->getInformation(&constInfo);
+
+    // Fill the blocks of this constraint by impulse tests. The blocks of the
+    // constraints before this one are the transposes of the ones that were
+    // already filled.
+    constraint->excite();
+    for (std::size_t j = 0; j < dim; ++j)
+    {
+      // Adjust findex for global index
+      if (mFIndex[offset + j] >= 0)
+        mFIndex[offset + j] += offset;
+
+      constraint->applyUnitImpulse(j);
+
+      for (auto b = mBlockBegins[i]; b < mBlockBegins[i + 1u]; ++b)
+      {
+        const std::size_t k = mBlockColumns[b];
+        const std::size_t dimK = mOffsets[k + 1u] - mOffsets[k];
+        double* row = mValues.data() + mBlockValues[b] + j * dimK;
+
+        if (k >= i)
+        {
+          _group->getConstraint(k)->getVelocityChange(row, k == i);
+        }
+        else
+        {
+          const double* transpose
+              = mValues.data() + mBlockValues[findBlock(k, i)];
+          for (std::size_t l = 0; l < dimK; ++l)
+            row[l] = transpose[l * dim + j];
+        }
+      }
+    }
+    constraint->unexcite();
+  }
+}
+
+//==============================================================================
+void SparsePGSLCPSolver::captureLCP(LCPProblem& _problem) const
+{
+  const std::size_t n = mOffsets.back();
+  const std::size_t numConstraints = mOffsets.size() - 1u;
+
+  _problem.mA.setZero(n, n);
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const std::size_t offset = mOffsets[i];
+    const std::size_t dim = mOffsets[i + 1u] - offset;
+    for (auto b = mBlockBegins[i]; b < mBlockBegins[i + 1u]; ++b)
+    {
+      const std::size_t k = mBlockColumns[b];
+      const std::size_t offsetK = mOffsets[k];
+      const std::size_t dimK = mOffsets[k + 1u] - offsetK;
+      const double* values = mValues.data() + mBlockValues[b];
+
+      for (std::size_t j = 0; j < dim; ++j)
+      {
+        for (std::size_t l = 0; l < dimK; ++l)
+          _problem.mA(offset + j, offsetK + l) = values[j * dimK + l];
+      }
+    }
+  }
+
+  _problem.mInitialGuess = Eigen::Map<const Eigen::VectorXd>(mX.data(), n);
+  _problem.mB = Eigen::Map<const Eigen::VectorXd>(mB.data(), n);
+  _problem.mLo = Eigen::Map<const Eigen::VectorXd>(mLo.data(), n);
+  _problem.mHi = Eigen::Map<const Eigen::VectorXd>(mHi.data(), n);
+  _problem.mFIndex = Eigen::Map<const Eigen::VectorXi>(mFIndex.data(), n);
+}
+
+//==============================================================================
+std::size_t SparsePGSLCPSolver::findBlock(
+    std::size_t _row, std::size_t _col) const
+{
+  const auto begin = mBlockColumns.begin() + mBlockBegins[_row];
+  const auto end = mBlockColumns.begin() + mBlockBegins[_row + 1u];
+  const auto it = std::lower_bound(begin, end, _col);
+  assert(it != end && *it == _col);
+
+  return static_cast<std::size_t>(it - mBlockColumns.begin());
+}
+
+//==============================================================================
+double SparsePGSLCPSolver::getDiagonal(std::size_t _row) const
+{
+  const std::size_t i = mRowConstraints[_row];
+  const std::size_t dim = mOffsets[i + 1u] - mOffsets[i];
+  const std::size_t j = _row - mOffsets[i];
+
+  return mValues[mBlockValues[findBlock(i, i)] + j * dim + j];
+}
+
+//==============================================================================
+double SparsePGSLCPSolver::computeGaussSeidelValue(std::size_t _row) const
+{
+  const std::size_t i = mRowConstraints[_row];
+  const std::size_t j = _row - mOffsets[i];
+
+  // The blocks are sorted by column, so this sums in the same order as the
+  // dense PGS solver does
+  double value = mB[_row];
+  for (auto b = mBlockBegins[i]; b < mBlockBegins[i + 1u]; ++b)
+  {
+    const std::size_t k = mBlockColumns[b];
+    const std::size_t offsetK = mOffsets[k];
+    const std::size_t dimK = mOffsets[k + 1u] - offsetK;
+    const double* row = mValues.data() + mBlockValues[b] + j * dimK;
+
+    for (std::size_t l = 0; l < dimK; ++l)
+    {
+      if (offsetK + l != _row)
+        value -= row[l] * mX[offsetK + l];
+    }
+  }
+
+  return value;
+}
+
+//==============================================================================
+void SparsePGSLCPSolver::project(std::size_t _row, double _value)
+{
+  double lo = mLo[_row];
+  double hi = mHi[_row];
+
+  // Friction index
+  if (mFIndex[_row] >= 0)
+  {
+    hi = mHi[_row] * mX[mFIndex[_row]];
+    lo = -hi;
+  }
+
+  if (_value > hi)
+    mX[_row] = hi;
+  else if (_value < lo)
+    mX[_row] = lo;
+  else
+    mX[_row] = _value;
+}
+
+//==============================================================================
+bool SparsePGSLCPSolver::solvePGS()
+{
+  const std::size_t n = mOffsets.back();
+  const double oneMinusSorW = 1.0 - mOption.sor_w;
+
+  //--- ORDERING & INITIAL LOOP & TEST
+  mOrder.clear();
+  bool sentinel = true;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const double diagonal = getDiagonal(i);
+    if (diagonal < mOption.eps_div)
+    {
+      mX[i] = 0.0;
+      continue;
+    }
+    mOrder.push_back(i);
+
+    const double oldX = mX[i];
+    project(i, computeGaussSeidelValue(i) / diagonal);
+
+    if (sentinel && std::abs(mX[i] - oldX) > mOption.eps_res)
+      sentinel = false;
+  }
+
+  mNumIterations = 1u;
+  if (sentinel)
+    return true;
+
+  //--- SCALING
+  for (const auto index : mOrder)
+  {
+    const std::size_t i = mRowConstraints[index];
+    const std::size_t j = index - mOffsets[i];
+    const double scale = 1.0 / getDiagonal(index);
+
+    mB[index] *= scale;
+    for (auto b = mBlockBegins[i]; b < mBlockBegins[i + 1u]; ++b)
+    {
+      const std::size_t k = mBlockColumns[b];
+      const std::size_t dimK = mOffsets[k + 1u] - mOffsets[k];
+      double* row = mValues.data() + mBlockValues[b] + j * dimK;
+
+      for (std::size_t l = 0; l < dimK; ++l)
+        row[l] *= scale;
+    }
+  }
+
+  //--- ITERATION LOOP
+  for (int iter = 1; iter < mOption.itermax; ++iter)
+  {
+    sentinel = true;
+
+    for (const auto index : mOrder)
+    {
+      const double oldX = mX[index];
+      project(index, mOption.sor_w * computeGaussSeidelValue(index)
+                     + oneMinusSorW * oldX);
+
+      if (sentinel && std::abs(mX[index]) > mOption.eps_div)
+      {
+        if (std::abs((mX[index] - oldX) / mX[index]) > mOption.eps_ea)
+          sentinel = false;
+      }
+    }
+
+    ++mNumIterations;
+    if (sentinel)
+      break;
+  }
+
+  return sentinel;
+}
+
+} // namespace constraint
+} // namespace dart
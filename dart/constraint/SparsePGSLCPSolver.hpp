@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_SPARSEPGSLCPSOLVER_HPP_
+#define DART_CONSTRAINT_SPARSEPGSLCPSOLVER_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "dart/constraint/LCPSolver.hpp"
+#include "dart/constraint/PGSLCPSolver.hpp"
+
+namespace dart {
+
+namespace dynamics {
+class Skeleton;
+}  // namespace dynamics
+
+namespace constraint {
+
+/// SparsePGSLCPSolver solves the same projected Gauss-Seidel iterations as
+/// PGSLCPSolver, but stores the LCP matrix of a constrained group as a block
+/// sparse matrix. A block couples two constraints and is only stored when
+/// they share a Skeleton that either one can change the velocity of (see
+/// ConstraintBase::collectReactiveSkeletons()). In a group such as a long
+/// chain of stacked objects, where each contact couples only two bodies, the
+/// memory and the time of building and iterating the matrix scale with the
+/// number of coupled constraint pairs instead of the square of the number of
+/// rows. The buffers are kept between calls to avoid reallocations.
+class SparsePGSLCPSolver : public LCPSolver
+{
+public:
+  /// Constructor
+  explicit SparsePGSLCPSolver(double _timestep);
+
+  /// Destructor
+  virtual ~SparsePGSLCPSolver();
+
+  // Documentation inherited
+  void solve(ConstrainedGroup* _group) override;
+
+  /// Solve a LCP given directly. Each row is treated as a constraint of its
+  /// own, and only the nonzero entries of the matrix are stored.
+  bool solveLCP(LCPProblem& _problem) override;
+
+  /// Set the options of the PGS iterations
+  void setOption(const PGSOption& _option);
+
+  /// Return the options of the PGS iterations
+  const PGSOption& getOption() const;
+
+  /// Return the number of blocks in the LCP matrix of the last solved group
+  std::size_t getNumBlocks() const;
+
+  /// Return the number of entries stored for the LCP matrix of the last
+  /// solved group
+  std::size_t getNumEntries() const;
+
+  /// Return the number of PGS iterations of the last solve
+  std::size_t getNumIterations() const;
+
+private:
+  /// Find which constraints are coupled, and lay out the blocks of the matrix
+  void buildBlocks(ConstrainedGroup* _group);
+
+  /// Fill the blocks and the vectors of the LCP by impulse tests
+  void fillLCP(ConstrainedGroup* _group);
+
+  /// Return the index of the block of constraints _row and _col
+  std::size_t findBlock(std::size_t _row, std::size_t _col) const;
+
+  /// Return the _row-th diagonal entry of the matrix
+  double getDiagonal(std::size_t _row) const;
+
+  /// Return the _row-th entry of b minus the product of the off-diagonal
+  /// entries of the _row-th row of the matrix and x
+  double computeGaussSeidelValue(std::size_t _row) const;
+
+  /// Set the _row-th entry of x to _value clamped to its bounds
+  void project(std::size_t _row, double _value);
+
+  /// Run the PGS iterations. Return true if they converged.
+  bool solvePGS();
+
+  /// Record the LCP of the current group to mTrace before it is solved
+  void captureLCP(LCPProblem& _problem) const;
+
+  /// Options of the PGS iterations
+  PGSOption mOption;
+
+  /// Index of the first row of each constraint, followed by the total number
+  /// of rows
+  std::vector<std::size_t> mOffsets;
+
+  /// Constraint of each row
+  std::vector<std::size_t> mRowConstraints;
+
+  /// Reactive Skeletons of all the constraints one after another
+  std::vector<dynamics::Skeleton*> mReactiveSkeletons;
+
+  /// Index of the first reactive Skeleton of each constraint in
+  /// mReactiveSkeletons, followed by the total number of them
+  std::vector<std::size_t> mReactiveSkeletonBegins;
+
+  /// Pairs of reactive Skeleton and constraint index sorted by Skeleton
+  std::vector<std::pair<dynamics::Skeleton*, std::size_t>> mSkeletonConstraints;
+
+  /// Constraints that are coupled to all the others
+  std::vector<std::size_t> mDenseConstraints;
+
+  /// The last constraint that each constraint was found to be coupled to while
+  /// the blocks are built
+  std::vector<std::size_t> mMarks;
+
+  /// Index of the first block of each constraint, followed by the total number
+  /// of blocks. The blocks of a constraint are sorted by column.
+  std::vector<std::size_t> mBlockBegins;
+
+  /// Constraint that each block couples its row constraint to
+  std::vector<std::size_t> mBlockColumns;
+
+  /// Index of the first entry of each block in mValues, followed by the total
+  /// number of entries. Each block is stored in row-major order.
+  std::vector<std::size_t> mBlockValues;
+
+  /// Entries of the blocks
+  std::vector<double> mValues;
+
+  /// Order in which the rows are iterated
+  std::vector<std::size_t> mOrder;
+
+  /// Number of PGS iterations of the last solve
+  std::size_t mNumIterations;
+
+  std::vector<double> mX;
+  std::vector<double> mB;
+  std::vector<double> mW;
+  std::vector<double> mLo;
+  std::vector<double> mHi;
+  std::vector<int> mFIndex;
+};
+
+} // namespace constraint
+} // namespace dart
+
+#endif  // DART_CONSTRAINT_SPARSEPGSLCPSOLVER_HPP_
@@ -370,6 +370,22 @@ dynamics::SkeletonPtr WeldJointConstraint::getRootSkeleton() const
   }
 }
 
+//==============================================================================
+bool WeldJointConstraint::collectReactiveSkeletons(
+    std::vector<dynamics::Skeleton*>& _skeletons) const
+{
+  if (mBodyNode1->isReactive())
+    _skeletons.push_back(mBodyNode1->getSkeleton().get());
+
+  if (mBodyNode2 && mBodyNode2->isReactive()
+      && mBodyNode2->getSkeleton() != mBodyNode1->getSkeleton())
+  {
+    _skeletons.push_back(mBodyNode2->getSkeleton().get());
+  }
+
+  return true;
+}
+
 //==============================================================================
 void WeldJointConstraint::uniteSkeletons()
 {
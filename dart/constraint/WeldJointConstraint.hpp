@@ -93,6 +93,10 @@ protected:
   // Documentation inherited
   dynamics::SkeletonPtr getRootSkeleton() const override;
 
+  // Documentation inherited
+  bool collectReactiveSkeletons(
+      std::vector<dynamics::Skeleton*>& _skeletons) const override;
+
   // Documentation inherited
   void uniteSkeletons() override;
 
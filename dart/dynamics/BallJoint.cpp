@@ -149,6 +149,15 @@ void BallJoint::updateDegreeOfFreedomNames()
     mDofs[2]->setName(Joint::mAspectProperties.mName + "_z", false);
 }
 
+//==============================================================================
+Eigen::Isometry3d BallJoint::computeRelativeTransformStatic(
+    const Eigen::Vector3d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * convertToTransform(_positions)
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void BallJoint::updateRelativeTransform() const
 {
@@ -472,6 +472,8 @@ void BodyNode::setMass(double _mass)
   const SkeletonPtr& skel = getSkeleton();
   if(skel)
     skel->updateTotalMass();
+
+  incrementVersion();
 }
 
 //==============================================================================
@@ -489,6 +491,7 @@ void BodyNode::setMomentOfInertia(double _Ixx, double _Iyy, double _Izz,
         _Ixy, _Ixz, _Iyz);
 
   dirtyArticulatedInertia();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -559,6 +562,7 @@ void BodyNode::setLocalCOM(const Eigen::Vector3d& _com)
   mAspectProperties.mInertia.setLocalCOM(_com);
 
   dirtyArticulatedInertia();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -1374,7 +1378,11 @@ void BodyNode::processNewEntity(Entity* _newChildEntity)
   // We should consider doing something to unify these two pipelines that are
   // currently independent of each other.
   if(JacobianNode* node = dynamic_cast<JacobianNode*>(_newChildEntity))
-    mChildJacobianNodes.insert(node);
+  {
+    if(std::find(mChildJacobianNodes.begin(), mChildJacobianNodes.end(), node)
+       == mChildJacobianNodes.end())
+      mChildJacobianNodes.push_back(node);
+  }
 
   // Here we want to sort out whether the Entity that has been added is a child
   // BodyNode or not
@@ -1386,7 +1394,8 @@ void BodyNode::processNewEntity(Entity* _newChildEntity)
     return;
 
   // Check if it's already accounted for in our Non-BodyNode Entities
-  if(mNonBodyNodeEntities.find(_newChildEntity) != mNonBodyNodeEntities.end())
+  if(std::find(mNonBodyNodeEntities.begin(), mNonBodyNodeEntities.end(),
+               _newChildEntity) != mNonBodyNodeEntities.end())
   {
     dtwarn << "[BodyNode::processNewEntity] Attempting to add an Entity ["
            << _newChildEntity->getName() << "] as a child Entity of ["
@@ -1395,7 +1404,7 @@ void BodyNode::processNewEntity(Entity* _newChildEntity)
   }
 
   // Add it to the Non-BodyNode Entities
-  mNonBodyNodeEntities.insert(_newChildEntity);
+  mNonBodyNodeEntities.push_back(_newChildEntity);
 }
 
 //==============================================================================
@@ -1408,11 +1417,15 @@ void BodyNode::processRemovedEntity(Entity* _oldChildEntity)
     mChildBodyNodes.erase(it);
 
   if(JacobianNode* node = dynamic_cast<JacobianNode*>(_oldChildEntity))
-    mChildJacobianNodes.erase(node);
+  {
+    mChildJacobianNodes.erase(
+          std::remove(mChildJacobianNodes.begin(), mChildJacobianNodes.end(),
+                      node), mChildJacobianNodes.end());
+  }
 
-  if(std::find(mNonBodyNodeEntities.begin(), mNonBodyNodeEntities.end(),
-               _oldChildEntity) != mNonBodyNodeEntities.end())
-    mNonBodyNodeEntities.erase(_oldChildEntity);
+  mNonBodyNodeEntities.erase(
+        std::remove(mNonBodyNodeEntities.begin(), mNonBodyNodeEntities.end(),
+                    _oldChildEntity), mNonBodyNodeEntities.end());
 }
 
 //==============================================================================
@@ -1992,13 +2005,7 @@ void BodyNode::aggregateGravityForceVector(Eigen::VectorXd& _g,
                           (*it)->mG_F);
   }
 
-  std::size_t nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd g = -(mParentJoint->getRelativeJacobian().transpose() * mG_F);
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _g.segment(iStart, nGenCoords) = g;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_g, -mG_F);
 }
 
 //==============================================================================
@@ -2038,14 +2045,7 @@ void BodyNode::aggregateCombinedVector(Eigen::VectorXd& _Cg,
     mCg_F += math::dAdInvT((*it)->getParentJoint()->mT, (*it)->mCg_F);
   }
 
-  std::size_t nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd Cg
-        = mParentJoint->getRelativeJacobian().transpose() * mCg_F;
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _Cg.segment(iStart, nGenCoords) = Cg;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_Cg, mCg_F);
 }
 
 //==============================================================================
@@ -2060,13 +2060,7 @@ void BodyNode::aggregateExternalForces(Eigen::VectorXd& _Fext)
                              (*it)->mFext_F);
   }
 
-  std::size_t nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd Fext = mParentJoint->getRelativeJacobian().transpose()*mFext_F;
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _Fext.segment(iStart, nGenCoords) = Fext;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_Fext, mFext_F);
 }
 
 //==============================================================================
@@ -2085,26 +2079,14 @@ void BodyNode::aggregateSpatialToGeneralized(Eigen::VectorXd& _generalized,
   }
 
   // Project the spatial quantity to generalized coordinates
-  const auto numDofs = mParentJoint->getNumDofs();
-  if (numDofs > 0u)
-  {
-    const std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _generalized.segment(iStart, numDofs)
-        = mParentJoint->getSpatialToGeneralized(mArbitrarySpatial);
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_generalized, mArbitrarySpatial);
 }
 
 //==============================================================================
 void BodyNode::updateMassMatrix()
 {
   mM_dV.setZero();
-  std::size_t dof = mParentJoint->getNumDofs();
-  if (dof > 0)
-  {
-    mM_dV.noalias() += mParentJoint->getRelativeJacobian()
-                       * mParentJoint->getAccelerations();
-    assert(!math::isNan(mM_dV));
-  }
+  mParentJoint->addAccelerationTo(mM_dV);
   if (mParentBodyNode)
     mM_dV += math::AdInvT(mParentJoint->getRelativeTransform(),
                           mParentBodyNode->mM_dV);
@@ -2133,13 +2115,7 @@ void BodyNode::aggregateMassMatrix(Eigen::MatrixXd& _MCol, std::size_t _col)
   assert(!math::isNan(mM_F));
 
   //
-  std::size_t dof = mParentJoint->getNumDofs();
-  if (dof > 0)
-  {
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _MCol.block(iStart, _col, dof, 1).noalias() =
-        mParentJoint->getRelativeJacobian().transpose() * mM_F;
-  }
+  mParentJoint->getMassMatrixSegment(_MCol, _col, mM_F);
 }
 
 //==============================================================================
@@ -2167,24 +2143,7 @@ void BodyNode::aggregateAugMassMatrix(Eigen::MatrixXd& _MCol, std::size_t _col,
   assert(!math::isNan(mM_F));
 
   //
-  std::size_t dof = mParentJoint->getNumDofs();
-  if (dof > 0)
-  {
-    Eigen::MatrixXd K = Eigen::MatrixXd::Zero(dof, dof);
-    Eigen::MatrixXd D = Eigen::MatrixXd::Zero(dof, dof);
-    for (std::size_t i = 0; i < dof; ++i)
-    {
-      K(i, i) = mParentJoint->getSpringStiffness(i);
-      D(i, i) = mParentJoint->getDampingCoefficient(i);
-    }
-
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-
-    _MCol.block(iStart, _col, dof, 1).noalias()
-        = mParentJoint->getRelativeJacobian().transpose() * mM_F
-          + D * (_timeStep * mParentJoint->getAccelerations())
-          + K * (_timeStep * _timeStep * mParentJoint->getAccelerations());
-  }
+  mParentJoint->getAugMassMatrixSegment(_MCol, _col, mM_F, _timeStep);
 }
 
 //==============================================================================
@@ -1083,7 +1083,7 @@ protected:
 
   /// Array of child Entities that are not BodyNodes. Organizing them separately
   /// allows some performance optimizations.
-  std::set<Entity*> mNonBodyNodeEntities;
+  std::vector<Entity*> mNonBodyNodeEntities;
 
   /// A increasingly sorted list of dependent dof indices.
   std::vector<std::size_t> mDependentGenCoordIndices;
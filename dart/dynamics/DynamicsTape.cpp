@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/DynamicsTape.hpp"
+
+#include "dart/math/Geometry.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+DynamicsTape::DynamicsTape()
+  : mSkeleton(nullptr),
+    mVersion(0),
+    mSupported(false)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool DynamicsTape::computeForwardDynamics(const Skeleton& _skel)
+{
+  if(!compile(_skel))
+    return false;
+
+  updateKinematics(_skel);
+
+  const std::size_t numBodies = mParents.size();
+  const double timeStep = _skel.getTimeStep();
+
+  mForces = _skel.getCommands();
+  mAccelerations.resize(mPositions.size());
+  mTotalForces.resize(mPositions.size());
+
+  // Backward recursion: articulated inertias and bias forces. Each body
+  // pushes its contribution into its parent, which always has a lower index.
+  for(std::size_t i = numBodies; i-- > 0; )
+  {
+    const int offset = mDofOffsets[i];
+    const int numDofs = mNumDofs[i];
+
+    if(!mForceActuated[i])
+      mForces.segment(offset, numDofs).setZero();
+
+    const Eigen::Matrix6d& AI = mArtInertias[i];
+    const Eigen::Vector6d& c = mPartialAccelerations[i];
+    const Eigen::Vector6d& p = mBiasForces[i];
+    ProjectedInertia& invProjAI = mInvProjArtInertias[i];
+
+    const auto S = mJacobians.middleCols(offset, numDofs);
+    const Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 6> AIS = AI * S;
+
+    const auto q = mPositions.segment(offset, numDofs);
+    const auto dq = mVelocities.segment(offset, numDofs);
+    const auto k = mSpringStiffnesses.segment(offset, numDofs);
+    const auto d = mDampingCoefficients.segment(offset, numDofs);
+    const auto q0 = mRestPositions.segment(offset, numDofs);
+
+    // Projected articulated inertia, including the additional inertia of the
+    // implicit damping and spring forces
+    if(numDofs > 0)
+    {
+      ProjectedInertia projAI = S.transpose() * AIS;
+      projAI.diagonal() += timeStep * d + timeStep * timeStep * k;
+      invProjAI = projAI.inverse();
+    }
+    else
+    {
+      invProjAI.resize(0, 0);
+    }
+
+    // Total joint force
+    auto u = mTotalForces.segment(offset, numDofs);
+    u = mForces.segment(offset, numDofs)
+        - k.cwiseProduct(q - q0 + dq * timeStep)
+        - d.cwiseProduct(dq)
+        - S.transpose() * (AI * c + p);
+
+    const int parent = mParents[i];
+    if(parent < 0)
+      continue;
+
+    Eigen::Matrix6d PI = AI;
+    PI.noalias() -= AIS * invProjAI * AIS.transpose();
+    mArtInertias[parent] += math::transformInertia(
+          mRelativeTransforms[i].inverse(), PI);
+
+    const Eigen::Vector6d beta = p + AI * (c + S * (invProjAI * u));
+    mBiasForces[parent] += math::dAdInvT(mRelativeTransforms[i], beta);
+  }
+
+  // Forward recursion: joint accelerations and transmitted forces
+  for(std::size_t i = 0; i < numBodies; ++i)
+  {
+    const int offset = mDofOffsets[i];
+    const int numDofs = mNumDofs[i];
+    const int parent = mParents[i];
+
+    Eigen::Vector6d& A = mAccelerationsSpatial[i];
+    if(parent < 0)
+      A.setZero();
+    else
+      A = math::AdInvT(mRelativeTransforms[i], mAccelerationsSpatial[parent]);
+
+    const auto S = mJacobians.middleCols(offset, numDofs);
+    auto ddq = mAccelerations.segment(offset, numDofs);
+    ddq = mInvProjArtInertias[i] * (mTotalForces.segment(offset, numDofs)
+                                    - S.transpose() * (mArtInertias[i] * A));
+
+    A += S * ddq + mPartialAccelerations[i];
+
+    mBodyForces[i] = mBiasForces[i];
+    mBodyForces[i].noalias() += mArtInertias[i] * A;
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool DynamicsTape::computeInverseDynamics(const Skeleton& _skel,
+                                          bool _withExternalForces,
+                                          bool _withDampingForces,
+                                          bool _withSpringForces)
+{
+  if(!compile(_skel))
+    return false;
+
+  updateKinematics(_skel);
+
+  const std::size_t numBodies = mParents.size();
+  const double timeStep = _skel.getTimeStep();
+  const Eigen::Vector3d& gravity = _skel.getGravity();
+
+  mAccelerations = _skel.getAccelerations();
+  mForces.resize(mPositions.size());
+
+  // Forward recursion: spatial accelerations and the forces of the bodies
+  // on their own
+  for(std::size_t i = 0; i < numBodies; ++i)
+  {
+    const int offset = mDofOffsets[i];
+    const int numDofs = mNumDofs[i];
+    const int parent = mParents[i];
+
+    Eigen::Vector6d& A = mAccelerationsSpatial[i];
+    if(parent < 0)
+      A.setZero();
+    else
+      A = math::AdInvT(mRelativeTransforms[i], mAccelerationsSpatial[parent]);
+
+    A.noalias() += mJacobians.middleCols(offset, numDofs)
+        * mAccelerations.segment(offset, numDofs);
+    A += mPartialAccelerations[i];
+
+    const Eigen::Matrix6d& I = mInertias[i];
+    const Eigen::Vector6d& V = mVelocitiesSpatial[i];
+    Eigen::Vector6d& F = mBodyForces[i];
+    F.noalias() = I * A;
+
+    if(_withExternalForces)
+      F -= mSkeleton->getBodyNode(i)->getExternalForceLocal();
+
+    if(mGravityModes[i])
+      F.noalias() -= I * math::AdInvRLinear(mWorldTransforms[i], gravity);
+
+    F -= math::dad(V, I * V);
+  }
+
+  // Backward recursion: transmitted forces and joint forces
+  for(std::size_t i = numBodies; i-- > 0; )
+  {
+    const int offset = mDofOffsets[i];
+    const int numDofs = mNumDofs[i];
+    const Eigen::Vector6d& F = mBodyForces[i];
+
+    auto tau = mForces.segment(offset, numDofs);
+    tau.noalias() = mJacobians.middleCols(offset, numDofs).transpose() * F;
+
+    const auto q = mPositions.segment(offset, numDofs);
+    const auto dq = mVelocities.segment(offset, numDofs);
+
+    if(_withDampingForces)
+      tau += mDampingCoefficients.segment(offset, numDofs).cwiseProduct(dq);
+
+    if(_withSpringForces)
+    {
+      tau += mSpringStiffnesses.segment(offset, numDofs).cwiseProduct(
+            q - mRestPositions.segment(offset, numDofs) + dq * timeStep);
+    }
+
+    const int parent = mParents[i];
+    if(parent >= 0)
+      mBodyForces[parent] += math::dAdInvT(mRelativeTransforms[i], F);
+  }
+
+  return true;
+}
+
+//==============================================================================
+const Eigen::VectorXd& DynamicsTape::getAccelerations() const
+{
+  return mAccelerations;
+}
+
+//==============================================================================
+const Eigen::VectorXd& DynamicsTape::getForces() const
+{
+  return mForces;
+}
+
+//==============================================================================
+const Eigen::Vector6d& DynamicsTape::getBodyForce(std::size_t _index) const
+{
+  return mBodyForces[_index];
+}
+
+//==============================================================================
+const Eigen::Vector6d& DynamicsTape::getSpatialAcceleration(
+    std::size_t _index) const
+{
+  return mAccelerationsSpatial[_index];
+}
+
+//==============================================================================
+void DynamicsTape::reset()
+{
+  mSkeleton = nullptr;
+}
+
+//==============================================================================
+bool DynamicsTape::compile(const Skeleton& _skel)
+{
+  if(mSkeleton == &_skel && mVersion == _skel.getVersion())
+    return mSupported;
+
+  mSkeleton = &_skel;
+  mVersion = _skel.getVersion();
+  mSupported = (_skel.getNumSoftBodyNodes() == 0);
+
+  const std::size_t numBodies = _skel.getNumBodyNodes();
+  const std::size_t numDofs = _skel.getNumDofs();
+
+  mParents.resize(numBodies);
+  mJointTypes.resize(numBodies);
+  mDofOffsets.resize(numBodies);
+  mNumDofs.resize(numBodies);
+  mJoints.resize(numBodies);
+  mGravityModes.resize(numBodies);
+  mForceActuated.resize(numBodies);
+  mParentToJoint.resize(numBodies);
+  mJointToChild.resize(numBodies);
+  mAxes.resize(numBodies);
+  mInertias.resize(numBodies);
+
+  mRelativeTransforms.resize(numBodies);
+  mWorldTransforms.resize(numBodies);
+  mVelocitiesSpatial.resize(numBodies);
+  mPartialAccelerations.resize(numBodies);
+  mAccelerationsSpatial.resize(numBodies);
+  mBiasForces.resize(numBodies);
+  mBodyForces.resize(numBodies);
+  mArtInertias.resize(numBodies);
+  mInvProjArtInertias.resize(numBodies);
+
+  mSpringStiffnesses.resize(numDofs);
+  mDampingCoefficients.resize(numDofs);
+  mRestPositions.resize(numDofs);
+  mJacobians.setZero(6, numDofs);
+  mJacobianDerivs.setZero(6, numDofs);
+
+  for(std::size_t i = 0; i < numBodies && mSupported; ++i)
+  {
+    const BodyNode* bn = _skel.getBodyNode(i);
+    const Joint* joint = bn->getParentJoint();
+    const BodyNode* parent = bn->getParentBodyNode();
+
+    mParents[i] = parent? static_cast<int>(parent->getIndexInSkeleton()) : -1;
+    mJoints[i] = joint;
+    mNumDofs[i] = static_cast<int>(joint->getNumDofs());
+    mDofOffsets[i] = (mNumDofs[i] > 0)?
+          static_cast<int>(joint->getDof(0)->getIndexInSkeleton()) : 0;
+    mGravityModes[i] = bn->getGravityMode();
+    mInertias[i] = bn->getSpatialInertia();
+    mParentToJoint[i] = joint->getTransformFromParentBodyNode();
+    mJointToChild[i] = joint->getTransformFromChildBodyNode().inverse();
+
+    // The passes rely on parents coming before their children and on the
+    // DOFs of each joint being contiguous
+    if(mParents[i] >= static_cast<int>(i))
+      mSupported = false;
+
+    for(int k = 0; k < mNumDofs[i]; ++k)
+    {
+      if(joint->getDof(k)->getIndexInSkeleton()
+         != static_cast<std::size_t>(mDofOffsets[i] + k))
+        mSupported = false;
+
+      mSpringStiffnesses[mDofOffsets[i] + k] = joint->getSpringStiffness(k);
+      mDampingCoefficients[mDofOffsets[i] + k]
+          = joint->getDampingCoefficient(k);
+      mRestPositions[mDofOffsets[i] + k] = joint->getRestPosition(k);
+    }
+
+    switch(joint->getActuatorType())
+    {
+      case Joint::FORCE:
+        mForceActuated[i] = true;
+        break;
+      case Joint::PASSIVE:
+      case Joint::SERVO:
+        mForceActuated[i] = false;
+        break;
+      default:
+        mSupported = false;
+        break;
+    }
+
+    if(const RevoluteJoint* revolute
+       = dynamic_cast<const RevoluteJoint*>(joint))
+    {
+      mJointTypes[i] = REVOLUTE;
+      mAxes[i] = revolute->getAxis();
+      mJacobians.col(mDofOffsets[i]) = math::AdTAngular(
+            joint->getTransformFromChildBodyNode(), mAxes[i]);
+    }
+    else if(const PrismaticJoint* prismatic
+            = dynamic_cast<const PrismaticJoint*>(joint))
+    {
+      mJointTypes[i] = PRISMATIC;
+      mAxes[i] = prismatic->getAxis();
+      mJacobians.col(mDofOffsets[i]) = math::AdTLinear(
+            joint->getTransformFromChildBodyNode(), mAxes[i]);
+    }
+    else if(dynamic_cast<const WeldJoint*>(joint))
+    {
+      mJointTypes[i] = WELD;
+      mRelativeTransforms[i] = mParentToJoint[i] * mJointToChild[i];
+    }
+    else
+    {
+      mJointTypes[i] = GENERIC;
+    }
+  }
+
+  return mSupported;
+}
+
+//==============================================================================
+void DynamicsTape::updateKinematics(const Skeleton& _skel)
+{
+  const std::size_t numBodies = mParents.size();
+  const Eigen::Vector3d& gravity = _skel.getGravity();
+
+  mPositions = _skel.getPositions();
+  mVelocities = _skel.getVelocities();
+
+  for(std::size_t i = 0; i < numBodies; ++i)
+  {
+    const int offset = mDofOffsets[i];
+    const int numDofs = mNumDofs[i];
+    Eigen::Isometry3d& T = mRelativeTransforms[i];
+
+    switch(mJointTypes[i])
+    {
+      case REVOLUTE:
+        T = mParentToJoint[i]
+            * math::expAngular(mAxes[i] * mPositions[offset])
+            * mJointToChild[i];
+        break;
+      case PRISMATIC:
+        T = mParentToJoint[i]
+            * Eigen::Translation3d(mAxes[i] * mPositions[offset])
+            * mJointToChild[i];
+        break;
+      case WELD:
+        break;
+      case GENERIC:
+      {
+        const Joint* joint = mJoints[i];
+        T = joint->getRelativeTransform();
+        mJacobians.middleCols(offset, numDofs)
+            = joint->getRelativeJacobian();
+        mJacobianDerivs.middleCols(offset, numDofs)
+            = joint->getRelativeJacobianTimeDeriv();
+        break;
+      }
+    }
+
+    const int parent = mParents[i];
+    const auto S = mJacobians.middleCols(offset, numDofs);
+    const auto dq = mVelocities.segment(offset, numDofs);
+
+    Eigen::Vector6d relativeVelocity;
+    relativeVelocity.noalias() = S * dq;
+
+    Eigen::Vector6d& V = mVelocitiesSpatial[i];
+    if(parent < 0)
+    {
+      mWorldTransforms[i] = T;
+      V = relativeVelocity;
+    }
+    else
+    {
+      mWorldTransforms[i] = mWorldTransforms[parent] * T;
+      V = math::AdInvT(T, mVelocitiesSpatial[parent]) + relativeVelocity;
+    }
+
+    Eigen::Vector6d& c = mPartialAccelerations[i];
+    c = math::ad(V, relativeVelocity);
+    if(mJointTypes[i] == GENERIC)
+      c.noalias() += mJacobianDerivs.middleCols(offset, numDofs) * dq;
+
+    // Seed the articulated inertia and bias force with the body's own terms;
+    // the backward pass of forward dynamics adds the children's terms.
+    const Eigen::Matrix6d& I = mInertias[i];
+    mArtInertias[i] = I;
+
+    Eigen::Vector6d& p = mBiasForces[i];
+    p = -math::dad(V, I * V)
+        - _skel.getBodyNode(i)->getExternalForceLocal();
+    if(mGravityModes[i])
+      p.noalias() -= I * math::AdInvRLinear(mWorldTransforms[i], gravity);
+  }
+}
+
+} // namespace dynamics
+} // namespace dart
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_DYNAMICSTAPE_HPP_
+#define DART_DYNAMICS_DYNAMICSTAPE_HPP_
+
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/common/Memory.hpp"
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+namespace dynamics {
+
+class Skeleton;
+class Joint;
+
+/// DynamicsTape is a flattened copy of the kinematic tree of a Skeleton,
+/// stored as structure-of-arrays in topological order, on which the
+/// articulated body algorithm (forward dynamics) and the recursive
+/// Newton-Euler algorithm (inverse dynamics) run as plain loops.
+///
+/// The structure and the properties of the Skeleton (joint types, joint
+/// offsets, inertias, springs and dampers) are recorded the first time the
+/// tape is used, and they are only recorded again when the version of the
+/// Skeleton changes. The state (positions, velocities, commands and external
+/// forces) is read on every call.
+///
+/// RevoluteJoint, PrismaticJoint and WeldJoint are evaluated directly on the
+/// tape. The transforms and Jacobians of other joint types are read from the
+/// Joint. SoftBodyNodes and kinematic actuator types (ACCELERATION, VELOCITY,
+/// LOCKED) are not supported; the compute functions return false for
+/// Skeletons that use them, so that the caller can fall back to the regular
+/// BodyNode recursions.
+class DynamicsTape
+{
+public:
+
+  /// Constructor
+  DynamicsTape();
+
+  /// Compute the joint accelerations of _skel in the same way as
+  /// Skeleton::computeForwardDynamics(). Returns false if _skel is not
+  /// supported by the tape.
+  bool computeForwardDynamics(const Skeleton& _skel);
+
+  /// Compute the joint forces that produce the current accelerations of _skel
+  /// in the same way as Skeleton::computeInverseDynamics(). Returns false if
+  /// _skel is not supported by the tape.
+  bool computeInverseDynamics(const Skeleton& _skel,
+                              bool _withExternalForces = false,
+                              bool _withDampingForces = false,
+                              bool _withSpringForces = false);
+
+  /// Joint accelerations computed by the last call to
+  /// computeForwardDynamics()
+  const Eigen::VectorXd& getAccelerations() const;
+
+  /// Joint forces of the last computation. After computeForwardDynamics()
+  /// these are the commands of FORCE joints and zero for the others.
+  const Eigen::VectorXd& getForces() const;
+
+  /// Transmitted spatial force of a BodyNode from the last computation,
+  /// expressed in the BodyNode's frame
+  const Eigen::Vector6d& getBodyForce(std::size_t _index) const;
+
+  /// Spatial acceleration of a BodyNode from the last computation, expressed
+  /// in the BodyNode's frame
+  const Eigen::Vector6d& getSpatialAcceleration(std::size_t _index) const;
+
+  /// Force the tape to be recompiled the next time it is used
+  void reset();
+
+protected:
+
+  enum JointType
+  {
+    GENERIC = 0,
+    REVOLUTE,
+    PRISMATIC,
+    WELD
+  };
+
+  /// Record the structure and properties of _skel if it has changed since
+  /// the last call. Returns false if _skel is not supported.
+  bool compile(const Skeleton& _skel);
+
+  /// Read the state of _skel and run the forward kinematics pass, which
+  /// computes transforms, Jacobians, velocities and velocity-dependent terms
+  void updateKinematics(const Skeleton& _skel);
+
+  /// The Skeleton that the tape was compiled for
+  const Skeleton* mSkeleton;
+
+  /// Version of mSkeleton when the tape was compiled
+  std::size_t mVersion;
+
+  /// Whether mSkeleton can be handled by the tape
+  bool mSupported;
+
+  /// \{ \name Structure (one entry per BodyNode)
+
+  std::vector<int> mParents;
+  std::vector<JointType> mJointTypes;
+  std::vector<int> mDofOffsets;
+  std::vector<int> mNumDofs;
+  std::vector<const Joint*> mJoints;
+  std::vector<bool> mGravityModes;
+  std::vector<bool> mForceActuated;
+  common::aligned_vector<Eigen::Isometry3d> mParentToJoint;
+  common::aligned_vector<Eigen::Isometry3d> mJointToChild;
+  std::vector<Eigen::Vector3d> mAxes;
+  common::aligned_vector<Eigen::Matrix6d> mInertias;
+
+  /// \}
+
+  /// \{ \name Joint properties (one entry per DOF)
+
+  Eigen::VectorXd mSpringStiffnesses;
+  Eigen::VectorXd mDampingCoefficients;
+  Eigen::VectorXd mRestPositions;
+
+  /// \}
+
+  /// \{ \name State (one entry per DOF)
+
+  Eigen::VectorXd mPositions;
+  Eigen::VectorXd mVelocities;
+  Eigen::VectorXd mAccelerations;
+  Eigen::VectorXd mForces;
+  Eigen::VectorXd mTotalForces;
+
+  /// \}
+
+  /// \{ \name Kinematics and dynamics (one entry per BodyNode)
+
+  common::aligned_vector<Eigen::Isometry3d> mRelativeTransforms;
+  common::aligned_vector<Eigen::Isometry3d> mWorldTransforms;
+  common::aligned_vector<Eigen::Vector6d> mVelocitiesSpatial;
+  common::aligned_vector<Eigen::Vector6d> mPartialAccelerations;
+  common::aligned_vector<Eigen::Vector6d> mAccelerationsSpatial;
+  common::aligned_vector<Eigen::Vector6d> mBiasForces;
+  common::aligned_vector<Eigen::Vector6d> mBodyForces;
+  common::aligned_vector<Eigen::Matrix6d> mArtInertias;
+
+  using ProjectedInertia = Eigen::Matrix<
+      double, Eigen::Dynamic, Eigen::Dynamic, 0, 6, 6>;
+  common::aligned_vector<ProjectedInertia> mInvProjArtInertias;
+
+  /// Relative Jacobians of all the joints, side by side (6 x DOFs)
+  math::Jacobian mJacobians;
+
+  /// Time derivatives of the relative Jacobians (6 x DOFs)
+  math::Jacobian mJacobianDerivs;
+
+  /// \}
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_DYNAMICSTAPE_HPP_
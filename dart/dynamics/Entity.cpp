@@ -32,6 +32,8 @@
 
 #include "dart/dynamics/Entity.hpp"
 
+#include <algorithm>
+
 #include "dart/common/Console.hpp"
 #include "dart/common/StlHelpers.hpp"
 #include "dart/dynamics/Frame.hpp"
@@ -246,6 +248,9 @@ void Entity::changeParentFrame(Frame* _newParentFrame)
     if (it != mParentFrame->mChildEntities.end())
     {
       mParentFrame->mChildEntities.erase(it);
+      std::vector<Entity*>& siblings = mParentFrame->mChildEntityArray;
+      siblings.erase(std::remove(siblings.begin(), siblings.end(), this),
+                     siblings.end());
       mParentFrame->processRemovedEntity(this);
     }
   }
@@ -258,7 +263,8 @@ void Entity::changeParentFrame(Frame* _newParentFrame)
     {
       // The WorldFrame should not keep track of its children, or else we get
       // concurrency issues (race conditions).
-      mParentFrame->mChildEntities.insert(this);
+      if(mParentFrame->mChildEntities.insert(this).second)
+        mParentFrame->mChildEntityArray.push_back(this);
       mParentFrame->processNewEntity(this);
     }
     dirtyTransform();
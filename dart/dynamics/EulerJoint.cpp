@@ -332,11 +332,19 @@ void EulerJoint::updateDegreeOfFreedomNames()
   }
 }
 
+//==============================================================================
+Eigen::Isometry3d EulerJoint::computeRelativeTransformStatic(
+    const Eigen::Vector3d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * convertToTransform(_positions)
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void EulerJoint::updateRelativeTransform() const
 {
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint * convertToTransform(getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   assert(math::verifyTransform(mT));
 }
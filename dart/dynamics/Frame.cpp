@@ -453,7 +453,8 @@ void Frame::dirtyTransform()
   dirtyVelocity(); // Global Velocity depends on the Global Transform
 
   // Always trigger the signal, in case a new subscriber has registered in the
-  // time since the last signal
+  // time since the last signal. This is not coalesced: without subscribers the
+  // raise is an empty loop, so the cost of invalidation is the walk below.
   mTransformUpdatedSignal.raise(this);
 
   // If we already know we need to update, just quit
@@ -462,7 +463,7 @@ void Frame::dirtyTransform()
 
   mNeedTransformUpdate = true;
 
-  for(Entity* entity : mChildEntities)
+  for(Entity* entity : mChildEntityArray)
     entity->dirtyTransform();
 }
 
@@ -481,7 +482,7 @@ void Frame::dirtyVelocity()
 
   mNeedVelocityUpdate = true;
 
-  for(Entity* entity : mChildEntities)
+  for(Entity* entity : mChildEntityArray)
     entity->dirtyVelocity();
 }
 
@@ -498,7 +499,7 @@ void Frame::dirtyAcceleration()
 
   mNeedAccelerationUpdate = true;
 
-  for(Entity* entity : mChildEntities)
+  for(Entity* entity : mChildEntityArray)
     entity->dirtyAcceleration();
 }
 
@@ -34,6 +34,7 @@
 #define DART_DYNAMICS_FRAME_HPP_
 
 #include <set>
+#include <vector>
 
 #include <Eigen/Geometry>
 
@@ -308,6 +309,10 @@ protected:
   /// Container of this Frame's child Entities.
   std::set<Entity*> mChildEntities;
 
+  /// Same contents as mChildEntities, but stored contiguously so that the
+  /// dirty*() functions do not need to walk a tree every time they get called.
+  std::vector<Entity*> mChildEntityArray;
+
 private:
   /// Contains whether or not this is the World Frame
   const bool mAmWorld;
@@ -585,6 +585,15 @@ void FreeJoint::updateDegreeOfFreedomNames()
     mDofs[5]->setName(Joint::mAspectProperties.mName + "_pos_z", false);
 }
 
+//==============================================================================
+Eigen::Isometry3d FreeJoint::computeRelativeTransformStatic(
+    const Eigen::Vector6d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * convertToTransform(_positions)
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void FreeJoint::updateRelativeTransform() const
 {
@@ -36,6 +36,7 @@
 #include <string>
 #include <array>
 #include "dart/dynamics/detail/GenericJointAspect.hpp"
+#include "dart/dynamics/detail/GenericJointKernels.hpp"
 
 namespace dart {
 namespace dynamics {
@@ -492,6 +493,17 @@ public:
   /// \{ \name Jacobians
   //----------------------------------------------------------------------------
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransform(
+      const Eigen::VectorXd& positions) const override;
+
+  // Documentation inherited
+  bool canComputeRelativeTransform() const override;
+
+  /// Fixed-size version of computeRelativeTransform()
+  virtual Eigen::Isometry3d computeRelativeTransformStatic(
+      const Vector& positions) const = 0;
+
   // Documentation inherited
   const math::Jacobian getRelativeJacobian() const override;
 
@@ -667,10 +679,28 @@ protected:
   Eigen::VectorXd getSpatialToGeneralized(
       const Eigen::Vector6d& spatial) override;
 
+  // Documentation inherited
+  void getSpatialToGeneralizedSegment(
+      Eigen::VectorXd& generalized, const Eigen::Vector6d& spatial) override;
+
+  // Documentation inherited
+  void getMassMatrixSegment(Eigen::MatrixXd& massMat,
+                            const std::size_t col,
+                            const Eigen::Vector6d& spatialForce) override;
+
+  // Documentation inherited
+  void getAugMassMatrixSegment(Eigen::MatrixXd& augMassMat,
+                               const std::size_t col,
+                               const Eigen::Vector6d& spatialForce,
+                               double timeStep) override;
+
   /// \}
 
 protected:
 
+  /// Fixed-size kernels used by the recursive dynamics routines
+  using Kernels = detail::GenericJointKernels<ConfigSpaceT::NumDofsEigen>;
+
   /// Array of DegreeOfFreedom objects
   std::array<DegreeOfFreedom*, NumDofs> mDofs;
 
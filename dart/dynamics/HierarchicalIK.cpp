@@ -212,47 +212,42 @@ const IKHierarchy& HierarchicalIK::getIKHierarchy() const
 //==============================================================================
 const std::vector<Eigen::MatrixXd>& HierarchicalIK::computeNullSpaces() const
 {
-  bool recompute = false;
   const ConstSkeletonPtr& skel = getSkeleton();
-  const std::size_t nDofs = skel->getNumDofs();
-  if(static_cast<std::size_t>(mLastPositions.size()) != nDofs)
-  {
-    recompute = true;
-  }
-  else
-  {
-    for(std::size_t i=0; i < nDofs; ++i)
-    {
-      if(mLastPositions[i] != skel->getDof(i)->getPosition())
-      {
-        recompute = true;
-        break;
-      }
-    }
-  }
-
-  // TODO(MXG): When deciding whether we need to recompute, we should also check
-  // the "version" of the Skeleton, as soon as the Skeleton versioning features
-  // are available. The version should account for information about changes in
-  // indexing and changes in Joint / BodyNode properties.
-
-  if(!recompute)
-    return mNullSpaceCache;
-
+  const int nDofs = static_cast<int>(skel->getNumDofs());
   const IKHierarchy& hierarchy = getIKHierarchy();
 
   mNullSpaceCache.resize(hierarchy.size());
+  mRowSpaceCache.resize(hierarchy.size());
+
+  // Each level's null space only needs to be rebuilt if the null space of the
+  // level above it changed, or if one of the Jacobians in this level changed.
+  bool aboveChanged = false;
   bool zeroedNullSpace = false;
   for(std::size_t i=0; i < hierarchy.size(); ++i)
   {
     const std::vector< std::shared_ptr<InverseKinematics> >& level =
         hierarchy[i];
+    std::vector<RowSpaceCache>& rowSpaces = mRowSpaceCache[i];
 
     Eigen::MatrixXd& NS = mNullSpaceCache[i];
+    bool changed = aboveChanged || NS.rows() != nDofs
+                   || rowSpaces.size() != level.size();
+
+    rowSpaces.resize(level.size());
+    for(std::size_t j=0; j < level.size(); ++j)
+    {
+      if(updateRowSpace(*level[j], rowSpaces[j]))
+        changed = true;
+    }
+
+    aboveChanged = changed;
+    if(!changed)
+      continue;
+
     if(i == 0)
     {
       // Start with an identity null space
-      NS = Eigen::MatrixXd::Identity(nDofs, nDofs);
+      NS.setIdentity(nDofs, nDofs);
     }
     else if(zeroedNullSpace)
     {
@@ -266,44 +261,109 @@ const std::vector<Eigen::MatrixXd>& HierarchicalIK::computeNullSpaces() const
       NS = mNullSpaceCache[i-1];
     }
 
-    mJacCache.resize(6, nDofs);
     for(std::size_t j=0; j < level.size(); ++j)
     {
-      const std::shared_ptr<InverseKinematics>& ik = level[j];
-
-      if(!ik->isActive())
+      const RowSpaceCache& rowSpace = rowSpaces[j];
+      if(!rowSpace.mActive)
         continue;
 
-      const math::Jacobian& J = ik->computeJacobian();
-      const std::vector<std::size_t>& dofs = ik->getDofs();
+      const Eigen::MatrixXd& B = rowSpace.mBasis;
+      const std::vector<std::size_t>& dofs = rowSpace.mDofs;
+      const int rank = static_cast<int>(B.cols());
 
-      mJacCache.setZero();
-      for(std::size_t d=0; d < dofs.size(); ++d)
-      {
-        std::size_t k = dofs[d];
-        mJacCache.block<6,1>(0,k) = J.block<6,1>(0,d);
-      }
-
-      mSVDCache.compute(mJacCache, Eigen::ComputeFullV);
-      math::extractNullSpace(mSVDCache, mPartialNullspaceCache);
+      if(rank == 0)
+        continue;
 
-      if(mPartialNullspaceCache.rows() > 0 && mPartialNullspaceCache.cols() > 0)
-      {
-        NS *= mPartialNullspaceCache * mPartialNullspaceCache.transpose();
-      }
-      else
+      if(rank >= nDofs)
       {
         // There no longer exists a null space for this or any lower level
         NS.setZero();
         zeroedNullSpace = true;
         break;
       }
+
+      // Multiply NS by the null space projector I - B*B^T of this module.
+      // B only has nonzero rows for the module's own DOFs, so only those
+      // columns of NS are read and modified.
+      mProjectionCache.setZero(nDofs, rank);
+      for(std::size_t k=0; k < dofs.size(); ++k)
+        mProjectionCache.noalias() += NS.col(dofs[k]) * B.row(k);
+
+      for(std::size_t k=0; k < dofs.size(); ++k)
+        NS.col(dofs[k]).noalias() -= mProjectionCache * B.row(k).transpose();
     }
   }
 
   return mNullSpaceCache;
 }
 
+//==============================================================================
+bool HierarchicalIK::updateRowSpace(
+    const InverseKinematics& _ik, RowSpaceCache& _cache) const
+{
+  const bool active = _ik.isActive();
+  const std::vector<std::size_t>& dofs = _ik.getDofs();
+  const std::vector<std::size_t>& dependencies =
+      _ik.getNode()->getDependentGenCoordIndices();
+  const ConstSkeletonPtr& skel = getSkeleton();
+
+  bool changed = _cache.mIK != &_ik
+      || _cache.mSkeletonVersion != skel->getVersion()
+      || _cache.mActive != active
+      || _cache.mDofs != dofs
+      || _cache.mOffset != _ik.getOffset()
+      || _cache.mDependentPositions.size()
+         != static_cast<int>(dependencies.size());
+
+  if(!changed)
+  {
+    for(std::size_t k=0; k < dependencies.size(); ++k)
+    {
+      if(_cache.mDependentPositions[k]
+         != skel->getDof(dependencies[k])->getPosition())
+      {
+        changed = true;
+        break;
+      }
+    }
+  }
+
+  if(!changed)
+    return false;
+
+  _cache.mIK = &_ik;
+  _cache.mSkeletonVersion = skel->getVersion();
+  _cache.mActive = active;
+  _cache.mDofs = dofs;
+  _cache.mOffset = _ik.getOffset();
+  _cache.mDependentPositions.resize(static_cast<int>(dependencies.size()));
+  for(std::size_t k=0; k < dependencies.size(); ++k)
+  {
+    _cache.mDependentPositions[k] =
+        skel->getDof(dependencies[k])->getPosition();
+  }
+
+  if(!active || dofs.empty())
+  {
+    _cache.mBasis.resize(static_cast<int>(dofs.size()), 0);
+    return true;
+  }
+
+  // The columns of Q from a column-pivoting QR of J^T that correspond to
+  // nonzero pivots form an orthonormal basis for the row space of J. This is
+  // much cheaper than the full SVD that would be needed to get a basis for
+  // the null space directly, and the null space projector is simply
+  // I - B*B^T.
+  const math::Jacobian& J = _ik.computeJacobian();
+  mQRCache.compute(J.transpose());
+  const int rank = static_cast<int>(mQRCache.rank());
+
+  _cache.mBasis.setIdentity(static_cast<int>(dofs.size()), rank);
+  _cache.mBasis.applyOnTheLeft(mQRCache.householderQ());
+
+  return true;
+}
+
 //==============================================================================
 Eigen::VectorXd HierarchicalIK::getPositions() const
 {
@@ -349,7 +409,7 @@ ConstSkeletonPtr HierarchicalIK::getAffiliation() const
 //==============================================================================
 void HierarchicalIK::clearCaches()
 {
-  mLastPositions.resize(0);
+  mRowSpaceCache.clear();
 }
 
 //==============================================================================
@@ -415,15 +475,58 @@ void HierarchicalIK::Objective::evalGradient(
     Eigen::Map<Eigen::VectorXd> gradMap(mGradCache.data(), _grad.size());
     hik->mNullSpaceObjective->evalGradient(_x, gradMap);
 
-    hik->setPositions(_x);
+    addNullSpaceGradient(*hik, _x, _grad);
+  }
+}
 
-    const std::vector<Eigen::MatrixXd>& nullspaces = hik->computeNullSpaces();
-    if(nullspaces.size() > 0)
-    {
-      // Project through the deepest null space
-      mGradCache = nullspaces.back() * mGradCache;
-    }
+//==============================================================================
+double HierarchicalIK::Objective::evalWithGradient(
+    const Eigen::VectorXd& _x, Eigen::Map<Eigen::VectorXd> _grad) const
+{
+  const std::shared_ptr<HierarchicalIK>& hik = mIK.lock();
+
+  if(nullptr == hik)
+  {
+    dterr << "[HierarchicalIK::Objective::evalWithGradient] Attempting to use "
+          << "an Objective function of an expired HierarchicalIK module!\n";
+    assert(false);
+    return 0;
+  }
+
+  double cost = 0.0;
 
+  if(hik->mObjective)
+    cost += hik->mObjective->evalWithGradient(_x, _grad);
+  else
+    _grad.setZero();
+
+  if(hik->mNullSpaceObjective)
+  {
+    mGradCache.resize(_grad.size());
+    Eigen::Map<Eigen::VectorXd> gradMap(mGradCache.data(), _grad.size());
+    cost += hik->mNullSpaceObjective->evalWithGradient(_x, gradMap);
+
+    addNullSpaceGradient(*hik, _x, _grad);
+  }
+
+  return cost;
+}
+
+//==============================================================================
+void HierarchicalIK::Objective::addNullSpaceGradient(
+    HierarchicalIK& _hik, const Eigen::VectorXd& _x,
+    Eigen::Map<Eigen::VectorXd>& _grad) const
+{
+  _hik.setPositions(_x);
+
+  const std::vector<Eigen::MatrixXd>& nullspaces = _hik.computeNullSpaces();
+  if(nullspaces.size() > 0)
+  {
+    // Project through the deepest null space
+    _grad.noalias() += nullspaces.back() * mGradCache;
+  }
+  else
+  {
     _grad += mGradCache;
   }
 }
@@ -469,12 +572,12 @@ double HierarchicalIK::Constraint::eval(const Eigen::VectorXd& _x) const
         continue;
 
       const std::vector<std::size_t>& dofs = ik->getDofs();
-      Eigen::VectorXd q(dofs.size());
+      mPositionCache.resize(static_cast<int>(dofs.size()));
       for(std::size_t k=0; k < dofs.size(); ++k)
-        q[k] = _x[dofs[k]];
+        mPositionCache[k] = _x[dofs[k]];
 
       InverseKinematics::ErrorMethod& method = ik->getErrorMethod();
-      const Eigen::Vector6d& error = method.evalError(q);
+      const Eigen::Vector6d& error = method.evalError(mPositionCache);
 
       cost += error.dot(error);
     }
@@ -510,9 +613,9 @@ void HierarchicalIK::Constraint::evalGradient(
 
       // Grab only the dependent coordinates from q
       const std::vector<std::size_t>& dofs = ik->getDofs();
-      Eigen::VectorXd q(dofs.size());
+      mPositionCache.resize(static_cast<int>(dofs.size()));
       for(std::size_t k=0; k < dofs.size(); ++k)
-        q[k] = _x[dofs[k]];
+        mPositionCache[k] = _x[dofs[k]];
 
       // Compute the gradient of this specific error term
       mTempGradCache.setZero(dofs.size());
@@ -520,7 +623,7 @@ void HierarchicalIK::Constraint::evalGradient(
                                           mTempGradCache.size());
 
       InverseKinematics::GradientMethod& method = ik->getGradientMethod();
-      method.evalGradient(q, gradMap);
+      method.evalGradient(mPositionCache, gradMap);
 
       // Add the components of this gradient into the gradient of this level
       for(std::size_t k=0; k < dofs.size(); ++k)
@@ -530,12 +633,105 @@ void HierarchicalIK::Constraint::evalGradient(
     // Project this level's gradient through the null spaces of the levels with
     // higher precedence, then add it to the overall gradient
     if(i > 0)
-      _grad += nullspaces[i-1] * mLevelGradCache;
+      _grad.noalias() += nullspaces[i-1] * mLevelGradCache;
     else
       _grad += mLevelGradCache;
   }
 }
 
+//==============================================================================
+std::size_t HierarchicalIK::Constraint::getResidualDimension() const
+{
+  const std::shared_ptr<HierarchicalIK>& hik = mIK.lock();
+  if(nullptr == hik)
+    return 0u;
+
+  std::size_t dim = 0u;
+  for(const auto& level : hik->getIKHierarchy())
+  {
+    for(const std::shared_ptr<InverseKinematics>& ik : level)
+    {
+      if(ik->isActive())
+        dim += 6u;
+    }
+  }
+
+  return dim;
+}
+
+//==============================================================================
+void HierarchicalIK::Constraint::evalResidual(
+    const Eigen::VectorXd& _x, Eigen::Map<Eigen::VectorXd> _residual) const
+{
+  const std::shared_ptr<HierarchicalIK>& hik = mIK.lock();
+  if(nullptr == hik)
+  {
+    dterr << "[HierarchicalIK::Constraint::evalResidual] Attempting to use a "
+          << "Constraint function of an expired HierarchicalIK module!\n";
+    assert(false);
+    return;
+  }
+
+  int row = 0;
+  for(const auto& level : hik->getIKHierarchy())
+  {
+    for(const std::shared_ptr<InverseKinematics>& ik : level)
+    {
+      if(!ik->isActive())
+        continue;
+
+      const std::vector<std::size_t>& dofs = ik->getDofs();
+      mPositionCache.resize(static_cast<int>(dofs.size()));
+      for(std::size_t k=0; k < dofs.size(); ++k)
+        mPositionCache[k] = _x[dofs[k]];
+
+      _residual.segment<6>(row) =
+          ik->getErrorMethod().evalUnclampedError(mPositionCache);
+      row += 6;
+    }
+  }
+}
+
+//==============================================================================
+void HierarchicalIK::Constraint::evalResidualJacobian(
+    const Eigen::VectorXd& _x, Eigen::Map<Eigen::MatrixXd> _jacobian) const
+{
+  const std::shared_ptr<HierarchicalIK>& hik = mIK.lock();
+  if(nullptr == hik)
+  {
+    dterr << "[HierarchicalIK::Constraint::evalResidualJacobian] Attempting to "
+          << "use a Constraint function of an expired HierarchicalIK module!\n";
+    assert(false);
+    return;
+  }
+
+  // Each IK module only depends on its own DOFs, so most of this Jacobian is
+  // zero. The LevenbergMarquardtSolver takes advantage of that.
+  _jacobian.setZero();
+
+  int row = 0;
+  for(const auto& level : hik->getIKHierarchy())
+  {
+    for(const std::shared_ptr<InverseKinematics>& ik : level)
+    {
+      if(!ik->isActive())
+        continue;
+
+      const std::vector<std::size_t>& dofs = ik->getDofs();
+      mPositionCache.resize(static_cast<int>(dofs.size()));
+      for(std::size_t k=0; k < dofs.size(); ++k)
+        mPositionCache[k] = _x[dofs[k]];
+
+      const math::Jacobian& J =
+          ik->getErrorMethod().evalErrorJacobian(mPositionCache);
+      for(std::size_t k=0; k < dofs.size(); ++k)
+        _jacobian.block<6,1>(row, dofs[k]) = J.col(k);
+
+      row += 6;
+    }
+  }
+}
+
 //==============================================================================
 HierarchicalIK::HierarchicalIK(const SkeletonPtr& _skeleton)
   : mSkeleton(_skeleton)
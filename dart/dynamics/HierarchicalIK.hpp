@@ -208,8 +208,17 @@ protected:
     void evalGradient(const Eigen::VectorXd& _x,
                       Eigen::Map<Eigen::VectorXd> _grad) const override;
 
+    // Documentation inherited
+    double evalWithGradient(const Eigen::VectorXd& _x,
+                            Eigen::Map<Eigen::VectorXd> _grad) const override;
+
   protected:
 
+    /// Project the null space objective gradient stored in mGradCache through
+    /// the deepest null space of the hierarchy at _x and add it to _grad.
+    void addNullSpaceGradient(HierarchicalIK& _hik, const Eigen::VectorXd& _x,
+                              Eigen::Map<Eigen::VectorXd>& _grad) const;
+
     /// Pointer to this Objective's HierarchicalIK module
     std::weak_ptr<HierarchicalIK> mIK;
 
@@ -222,7 +231,12 @@ protected:
   /// of this HierarchicalIK module. This class is not meant to be extended or
   /// instantiated by a user. Call HierarchicalIK::resetProblem() to set
   /// the constraint of the module's Problem to an HierarchicalIK::Constraint.
-  class Constraint final : public Function, public optimizer::Function
+  ///
+  /// For least-squares solvers, the residual of this Constraint stacks the
+  /// unclamped errors of every active IK module in the hierarchy. Note that
+  /// least-squares solvers weigh all of those errors equally, regardless of
+  /// their hierarchy level.
+  class Constraint final : public Function, public optimizer::ResidualFunction
   {
   public:
 
@@ -243,6 +257,18 @@ protected:
     void evalGradient(const Eigen::VectorXd& _x,
                       Eigen::Map<Eigen::VectorXd> _grad) const override;
 
+    // Documentation inherited
+    std::size_t getResidualDimension() const override;
+
+    // Documentation inherited
+    void evalResidual(const Eigen::VectorXd& _x,
+                      Eigen::Map<Eigen::VectorXd> _residual) const override;
+
+    // Documentation inherited
+    void evalResidualJacobian(
+        const Eigen::VectorXd& _x,
+        Eigen::Map<Eigen::MatrixXd> _jacobian) const override;
+
   protected:
 
     /// Pointer to this Constraint's HierarchicalIK module
@@ -253,6 +279,9 @@ protected:
 
     /// Cache for temporary gradients
     mutable Eigen::VectorXd mTempGradCache;
+
+    /// Cache for the positions of the DOFs of each IK module
+    mutable Eigen::VectorXd mPositionCache;
   };
 
   /// Constructor
@@ -286,20 +315,50 @@ protected:
   /// Weak pointer to self
   std::weak_ptr<HierarchicalIK> mPtr;
 
-  /// Cache for the last positions
-  mutable Eigen::VectorXd mLastPositions;
+  /// The row space of one IK module's Jacobian, along with everything that
+  /// the Jacobian depends on, so that it only gets recomputed when necessary
+  struct RowSpaceCache
+  {
+    /// The IK module that this cache was computed for
+    const InverseKinematics* mIK = nullptr;
+
+    /// The version of the Skeleton, which changes with its structure and with
+    /// the properties of its Joints and BodyNodes
+    std::size_t mSkeletonVersion = 0;
+
+    /// Whether the IK module was active
+    bool mActive = false;
+
+    /// The DOFs of the IK module
+    std::vector<std::size_t> mDofs;
+
+    /// The offset of the IK module
+    Eigen::Vector3d mOffset = Eigen::Vector3d::Zero();
+
+    /// Positions of the DOFs that the IK module's Node depends on
+    Eigen::VectorXd mDependentPositions;
+
+    /// Orthonormal basis for the row space of the IK module's Jacobian. Each
+    /// row corresponds to one of mDofs.
+    Eigen::MatrixXd mBasis;
+  };
+
+  /// Refresh the row space cache of an IK module if its Jacobian may have
+  /// changed. Returns true if the cache was refreshed.
+  bool updateRowSpace(const InverseKinematics& _ik,
+                      RowSpaceCache& _cache) const;
 
   /// Cache for null space computations
   mutable std::vector<Eigen::MatrixXd> mNullSpaceCache;
 
-  /// Cache for a partial null space computation
-  mutable Eigen::MatrixXd mPartialNullspaceCache;
+  /// Row space caches for each IK module in the hierarchy
+  mutable std::vector< std::vector<RowSpaceCache> > mRowSpaceCache;
 
-  /// Cache for the null space SVD
-  mutable Eigen::JacobiSVD<math::Jacobian> mSVDCache;
+  /// Cache for the row space QR decompositions
+  mutable Eigen::ColPivHouseholderQR<Eigen::MatrixXd> mQRCache;
 
-  /// Cache for Jacobians
-  mutable math::Jacobian mJacCache;
+  /// Cache for applying null space projections
+  mutable Eigen::MatrixXd mProjectionCache;
 
 public:
   // To get byte-aligned Eigen vectors
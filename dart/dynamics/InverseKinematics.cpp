@@ -31,8 +31,15 @@
  */
 
 #include "dart/dynamics/InverseKinematics.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/DegreeOfFreedom.hpp"
+#include "dart/dynamics/EndEffector.hpp"
 #include "dart/dynamics/SimpleFrame.hpp"
 #include "dart/optimizer/GradientDescentSolver.hpp"
 
@@ -119,6 +126,254 @@ bool InverseKinematics::solve(Eigen::VectorXd& positions, bool _applySolution)
   return wasSolved;
 }
 
+//==============================================================================
+InverseKinematics::BatchOptions::BatchOptions(
+    bool warmStart, std::size_t numThreads)
+  : mWarmStart(warmStart),
+    mNumThreads(numThreads)
+{
+  // Do nothing
+}
+
+//==============================================================================
+static JacobianNode* getNodeOfClone(
+    const JacobianNode* _node, const SkeletonPtr& _skelClone)
+{
+  if(const BodyNode* bn = dynamic_cast<const BodyNode*>(_node))
+    return _skelClone->getBodyNode(bn->getIndexInSkeleton());
+
+  if(const EndEffector* ee = dynamic_cast<const EndEffector*>(_node))
+    return _skelClone->getEndEffector(ee->getIndexInSkeleton());
+
+  return nullptr;
+}
+
+//==============================================================================
+static bool isClonedPerModule(
+    const std::shared_ptr<optimizer::Function>& _function)
+{
+  // Functions that are not InverseKinematics::Functions are shared by clones
+  // of an IK module, see cloneIkFunc()
+  return nullptr == _function
+      || nullptr != std::dynamic_pointer_cast<InverseKinematics::Function>(
+           _function);
+}
+
+//==============================================================================
+/// Sort the targets along a Z-order (Morton) curve of their positions, so that
+/// targets that are next to each other in the order are usually close to each
+/// other in space as well.
+static std::vector<std::size_t> computeZOrder(
+    const common::aligned_vector<Eigen::Isometry3d>& _targets)
+{
+  const std::size_t numBits = 21u;
+  const double maxCell = static_cast<double>((1u << numBits) - 1u);
+
+  Eigen::Vector3d lower = Eigen::Vector3d::Constant(
+        std::numeric_limits<double>::infinity());
+  Eigen::Vector3d upper = -lower;
+  for(const Eigen::Isometry3d& target : _targets)
+  {
+    lower = lower.cwiseMin(target.translation());
+    upper = upper.cwiseMax(target.translation());
+  }
+  const Eigen::Vector3d extent = upper - lower;
+
+  std::vector<std::pair<std::uint64_t, std::size_t>> keys(_targets.size());
+  for(std::size_t i=0; i < _targets.size(); ++i)
+  {
+    const Eigen::Vector3d& p = _targets[i].translation();
+    std::uint64_t key = 0u;
+    for(int a=0; a < 3; ++a)
+    {
+      const std::uint64_t cell = extent[a] > 0.0 ?
+            static_cast<std::uint64_t>((p[a]-lower[a])/extent[a] * maxCell)
+          : 0u;
+      for(std::size_t b=0; b < numBits; ++b)
+        key |= ((cell >> b) & 1u) << (3u*b + static_cast<std::size_t>(a));
+    }
+
+    keys[i] = std::make_pair(key, i);
+  }
+
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<std::size_t> order(_targets.size());
+  for(std::size_t i=0; i < keys.size(); ++i)
+    order[i] = keys[i].second;
+
+  return order;
+}
+
+//==============================================================================
+std::size_t InverseKinematics::solveBatch(
+    const common::aligned_vector<Eigen::Isometry3d>& _targets,
+    const std::vector<Eigen::VectorXd>& _seeds,
+    std::vector<Eigen::VectorXd>& _solutions,
+    std::vector<bool>& _successes,
+    const BatchOptions& _options) const
+{
+  const std::size_t numTargets = _targets.size();
+  _solutions.assign(numTargets, Eigen::VectorXd());
+  _successes.assign(numTargets, false);
+
+  if(0 == numTargets)
+    return 0u;
+
+  if(nullptr == mSolver || nullptr == mProblem)
+  {
+    dtwarn << "[InverseKinematics::solveBatch] The Solver or the Problem for "
+           << "an InverseKinematics module associated with ["
+           << mNode->getName() << "] is a nullptr. You must reset them before "
+           << "you can use the module.\n";
+    return 0u;
+  }
+
+  if(_seeds.size() > 1u && _seeds.size() != numTargets)
+  {
+    dterr << "[InverseKinematics::solveBatch] The number of seeds ["
+          << _seeds.size() << "] must be 0, 1, or equal to the number of "
+          << "targets [" << numTargets << "].\n";
+    return 0u;
+  }
+
+  const ConstSkeletonPtr skel = getNode()->getSkeleton();
+  const Eigen::VectorXd defaultSeed = getPositions();
+
+  Eigen::VectorXd lowerBounds(mDofs.size());
+  Eigen::VectorXd upperBounds(mDofs.size());
+  for(std::size_t i=0; i < mDofs.size(); ++i)
+  {
+    lowerBounds[i] = skel->getDof(mDofs[i])->getPositionLowerLimit();
+    upperBounds[i] = skel->getDof(mDofs[i])->getPositionUpperLimit();
+  }
+
+  std::size_t numWorkers = _options.mNumThreads;
+  if(0u == numWorkers)
+    numWorkers = std::max(1u, std::thread::hardware_concurrency());
+  numWorkers = std::min(numWorkers, numTargets);
+
+  bool canCloneFunctions = isClonedPerModule(mObjective)
+      && isClonedPerModule(mNullSpaceObjective)
+      && isClonedPerModule(mProblem->getObjective());
+  for(std::size_t i=0; i < mProblem->getNumEqConstraints(); ++i)
+    canCloneFunctions &= isClonedPerModule(mProblem->getEqConstraint(i));
+  for(std::size_t i=0; i < mProblem->getNumIneqConstraints(); ++i)
+    canCloneFunctions &= isClonedPerModule(mProblem->getIneqConstraint(i));
+
+  if(!canCloneFunctions)
+    numWorkers = 1u;
+
+  // Each worker solves a contiguous range of this order. With warm starting,
+  // that keeps neighboring targets together.
+  std::vector<std::size_t> order;
+  if(_options.mWarmStart)
+  {
+    order = computeZOrder(_targets);
+  }
+  else
+  {
+    order.resize(numTargets);
+    for(std::size_t i=0; i < numTargets; ++i)
+      order[i] = i;
+  }
+
+  // Every worker gets its own copy of the Skeleton and of this IK module. The
+  // copies are made up front by this thread so that the workers never read
+  // from the original Skeleton.
+  std::vector<SkeletonPtr> skelClones(numWorkers);
+  std::vector<InverseKinematicsPtr> ikClones(numWorkers);
+  for(std::size_t w=0; w < numWorkers; ++w)
+  {
+    skelClones[w] = skel->clone();
+    skelClones[w]->setPositions(skel->getPositions());
+    skelClones[w]->setVelocities(Eigen::VectorXd::Zero(skel->getNumDofs()));
+
+    JacobianNode* node = getNodeOfClone(getNode(), skelClones[w]);
+    if(nullptr == node)
+    {
+      dterr << "[InverseKinematics::solveBatch] Unable to find the counterpart "
+            << "of [" << mNode->getName() << "] in a clone of its Skeleton. "
+            << "solveBatch() is only supported for BodyNodes and "
+            << "EndEffectors.\n";
+      return 0u;
+    }
+
+    const InverseKinematicsPtr ik = clone(node);
+    ik->setTarget(std::make_shared<SimpleFrame>(
+                    Frame::World(), node->getName()+"_batch_target"));
+
+    const std::shared_ptr<optimizer::Problem>& problem = ik->getProblem();
+    problem->setDimension(mDofs.size());
+    problem->setLowerBounds(lowerBounds);
+    problem->setUpperBounds(upperBounds);
+
+    ikClones[w] = ik;
+  }
+
+  // std::vector<bool> cannot be written concurrently, so the workers record
+  // their results here first.
+  std::vector<char> successes(numTargets, 0);
+
+  const auto solveRange = [&](std::size_t w, std::size_t begin, std::size_t end)
+  {
+    const InverseKinematicsPtr& ik = ikClones[w];
+    const std::shared_ptr<optimizer::Problem>& problem = ik->getProblem();
+    const std::shared_ptr<optimizer::Solver>& solver = ik->getSolver();
+    const std::shared_ptr<SimpleFrame> target = ik->getTarget();
+
+    const Eigen::VectorXd* lastSolution = nullptr;
+
+    for(std::size_t k=begin; k < end; ++k)
+    {
+      const std::size_t i = order[k];
+
+      const Eigen::VectorXd* initialGuess = &defaultSeed;
+      if(1u == _seeds.size())
+        initialGuess = &_seeds[0];
+      else if(!_seeds.empty())
+        initialGuess = &_seeds[i];
+
+      if(_options.mWarmStart && nullptr != lastSolution)
+        initialGuess = lastSolution;
+
+      target->setTransform(_targets[i]);
+      problem->setInitialGuess(*initialGuess);
+
+      successes[i] = solver->solve();
+      _solutions[i] = problem->getOptimalSolution();
+
+      if(successes[i])
+        lastSolution = &_solutions[i];
+    }
+  };
+
+  const std::size_t chunk = (numTargets + numWorkers - 1) / numWorkers;
+  std::vector<std::thread> threads;
+  threads.reserve(numWorkers - 1);
+  for(std::size_t w=1; w < numWorkers; ++w)
+  {
+    const std::size_t begin = std::min(w*chunk, numTargets);
+    const std::size_t end = std::min(begin + chunk, numTargets);
+    threads.emplace_back(solveRange, w, begin, end);
+  }
+
+  solveRange(0, 0, std::min(chunk, numTargets));
+
+  for(std::thread& thread : threads)
+    thread.join();
+
+  std::size_t numSolved = 0u;
+  for(std::size_t i=0; i < numTargets; ++i)
+  {
+    _successes[i] = (successes[i] != 0);
+    if(_successes[i])
+      ++numSolved;
+  }
+
+  return numSolved;
+}
+
 //==============================================================================
 static std::shared_ptr<optimizer::Function> cloneIkFunc(
     const std::shared_ptr<optimizer::Function>& _function,
@@ -200,6 +455,7 @@ InverseKinematics::ErrorMethod::ErrorMethod(
   : mIK(_ik),
     mMethodName(_methodName),
     mLastError(Eigen::Vector6d::Constant(std::nan(""))),
+    mLastUnclampedError(Eigen::Vector6d::Constant(std::nan(""))),
     mErrorP(_properties)
 {
   // Do nothing
@@ -254,9 +510,83 @@ const Eigen::Vector6d& InverseKinematics::ErrorMethod::evalError(
   mLastPositions = _q;
 
   mLastError = computeError();
+
   return mLastError;
 }
 
+//==============================================================================
+Eigen::Vector6d InverseKinematics::ErrorMethod::computeUnclampedError()
+{
+  return computeError();
+}
+
+//==============================================================================
+const Eigen::Vector6d& InverseKinematics::ErrorMethod::evalUnclampedError(
+    const Eigen::VectorXd& _q)
+{
+  if(_q.size() != static_cast<int>(mIK->getDofs().size()) || _q.size() == 0)
+  {
+    // evalError() reports the mismatch
+    mLastUnclampedError = evalError(_q);
+    return mLastUnclampedError;
+  }
+
+  if(_q.size() == mLastUnclampedPositions.size()
+     && _q == mLastUnclampedPositions)
+    return mLastUnclampedError;
+
+  mIK->setPositionsIfChanged(_q);
+  mLastUnclampedPositions = _q;
+
+  mLastUnclampedError = computeUnclampedError();
+
+  return mLastUnclampedError;
+}
+
+//==============================================================================
+const math::Jacobian& InverseKinematics::ErrorMethod::evalErrorJacobian(
+    const Eigen::VectorXd& _q)
+{
+  const Eigen::Vector6d& error = evalUnclampedError(_q);
+  mIK->setPositionsIfChanged(_q);
+
+  const math::Jacobian& J = mIK->computeJacobian();
+  mLastErrorJacobian.resize(6, J.cols());
+
+  // The error is computed in the target's reference frame, where each
+  // component is weighted and zeroed while it is inside of its bounds. It is
+  // then rotated into the world frame, which is also the frame of J.
+  //
+  // A component that is inside of finite bounds keeps its row, even though its
+  // error is locally flat. Otherwise a Gauss-Newton step that corrects the
+  // other components is free to push it back out of its bounds, and the solver
+  // stalls right next to the solution. Only components that are unbounded on
+  // both sides are dropped.
+  const Frame* refFrame = mIK->getTarget()->getParentFrame();
+  const Eigen::Matrix3d R = refFrame->getWorldTransform().linear();
+  const double threshold = 1e-12 * error.norm();
+  const Eigen::Vector6d& lower = mErrorP.mBounds.first;
+  const Eigen::Vector6d& upper = mErrorP.mBounds.second;
+
+  for(int b=0; b < 6; b += 3)
+  {
+    const Eigen::Vector3d localError = R.transpose() * error.segment<3>(b);
+    Eigen::Vector3d scale;
+    for(int i=0; i < 3; ++i)
+    {
+      const bool bounded =
+          std::isfinite(lower[b+i]) || std::isfinite(upper[b+i]);
+      scale[i] = (bounded || std::abs(localError[i]) > threshold) ?
+            mErrorP.mErrorWeights[b+i] : 0.0;
+    }
+
+    const Eigen::Matrix3d M = R * scale.asDiagonal() * R.transpose();
+    mLastErrorJacobian.middleRows<3>(b).noalias() = M * J.middleRows<3>(b);
+  }
+
+  return mLastErrorJacobian;
+}
+
 //==============================================================================
 const std::string& InverseKinematics::ErrorMethod::getMethodName() const
 {
@@ -405,6 +735,7 @@ void InverseKinematics::ErrorMethod::clearCache()
   // This will force the error to be recomputed the next time computeError is
   // called
   mLastPositions.resize(0);
+  mLastUnclampedPositions.resize(0);
 }
 
 //==============================================================================
@@ -466,6 +797,18 @@ Eigen::Isometry3d InverseKinematics::TaskSpaceRegion::computeDesiredTransform(
 
 //==============================================================================
 Eigen::Vector6d InverseKinematics::TaskSpaceRegion::computeError()
+{
+  Eigen::Vector6d error = computeUnclampedError();
+
+  const double errorLength = error.norm();
+  if(errorLength > mErrorP.mErrorLengthClamp)
+    error *= mErrorP.mErrorLengthClamp / errorLength;
+
+  return error;
+}
+
+//==============================================================================
+Eigen::Vector6d InverseKinematics::TaskSpaceRegion::computeUnclampedError()
 {
   // This is a slightly modified implementation of the Berenson et al Task Space
   // Region method found in "Task Space Regions: A Framework for
@@ -543,9 +886,6 @@ Eigen::Vector6d InverseKinematics::TaskSpaceRegion::computeError()
 
   error = error.cwiseProduct(mErrorP.mErrorWeights);
 
-  if(error.norm() > mErrorP.mErrorLengthClamp)
-    error = error.normalized()*mErrorP.mErrorLengthClamp;
-
   if(!mIK->getTarget()->getParentFrame()->isWorld())
   {
     // Transform the error term into the world frame if it's not already
@@ -643,10 +983,18 @@ void InverseKinematics::GradientMethod::evalGradient(
   }
 
   const Eigen::Vector6d& error = mIK->getErrorMethod().evalError(_q);
-  mIK->setPositions(_q);
+
+  // Whenever evalError() recomputes the error, it leaves the Skeleton at _q,
+  // so the kinematics that it just updated can be reused for the Jacobian.
+  mIK->setPositionsIfChanged(_q);
+
   mLastGradient.resize(_grad.size());
   computeGradient(error, mLastGradient);
   _grad = mLastGradient;
+
+  // computeGradient() may move the Skeleton, which clears this cache through
+  // the node connection, so the positions must be recorded afterwards.
+  mLastPositions = _q;
 }
 
 //==============================================================================
@@ -671,6 +1019,7 @@ void InverseKinematics::GradientMethod::clampGradient(
 void InverseKinematics::GradientMethod::setComponentWiseClamp(double _clamp)
 {
   mGradientP.mComponentWiseClamp = std::abs(_clamp);
+  clearCache();
 }
 
 //==============================================================================
@@ -694,6 +1043,7 @@ void InverseKinematics::GradientMethod::setComponentWeights(
     const Eigen::VectorXd& _weights)
 {
   mGradientP.mComponentWeights = _weights;
+  clearCache();
 }
 
 //==============================================================================
@@ -708,7 +1058,9 @@ void InverseKinematics::GradientMethod::convertJacobianMethodOutputToGradient(
     Eigen::VectorXd& grad, const std::vector<std::size_t>& dofs)
 {
   const SkeletonPtr& skel = mIK->getNode()->getSkeleton();
-  mInitialPositionsCache = skel->getPositions(dofs);
+  mInitialPositionsCache.resize(static_cast<int>(dofs.size()));
+  for(std::size_t i=0; i < dofs.size(); ++i)
+    mInitialPositionsCache[i] = skel->getDof(dofs[i])->getPosition();
 
   for(std::size_t i=0; i < dofs.size(); ++i)
     skel->getDof(dofs[i])->setVelocity(grad[i]);
@@ -725,8 +1077,8 @@ void InverseKinematics::GradientMethod::convertJacobianMethodOutputToGradient(
       joint->setVelocity(j, 0.0);
   }
 
-  grad = skel->getPositions(dofs);
-  grad -= mInitialPositionsCache;
+  for(std::size_t i=0; i < dofs.size(); ++i)
+    grad[i] = skel->getDof(dofs[i])->getPosition() - mInitialPositionsCache[i];
 }
 
 //==============================================================================
@@ -801,13 +1153,20 @@ void InverseKinematics::JacobianDLS::computeGradient(
   int rows = J.rows(), cols = J.cols();
   if(rows <= cols)
   {
-    _grad = J.transpose()*(pow(damping,2)*Eigen::MatrixXd::Identity(rows, rows)
-            + J*J.transpose() ).inverse() * _error;
+    // The task space is always 6-dimensional, so this system can be solved
+    // entirely with fixed-size matrices.
+    Eigen::Matrix6d A;
+    A.noalias() = J*J.transpose();
+    A.diagonal().array() += damping*damping;
+    _grad.noalias() = J.transpose() * A.ldlt().solve(_error);
   }
   else
   {
-    _grad = ( pow(damping,2)*Eigen::MatrixXd::Identity(cols, cols) +
-            J.transpose()*J).inverse() * J.transpose() * _error;
+    mNormalCache.noalias() = J.transpose()*J;
+    mNormalCache.diagonal().array() += damping*damping;
+    mRhsCache.noalias() = J.transpose()*_error;
+    mLDLTCache.compute(mNormalCache);
+    _grad = mLDLTCache.solve(mRhsCache);
   }
 
   convertJacobianMethodOutputToGradient(_grad, mIK->getDofs());
@@ -819,6 +1178,7 @@ void InverseKinematics::JacobianDLS::computeGradient(
 void InverseKinematics::JacobianDLS::setDampingCoefficient(double _damping)
 {
   mDLSProperties.mDamping = _damping;
+  clearCache();
 }
 
 //==============================================================================
@@ -856,7 +1216,7 @@ void InverseKinematics::JacobianTranspose::computeGradient(
     Eigen::VectorXd& _grad)
 {
   const math::Jacobian& J = mIK->computeJacobian();
-  _grad = J.transpose() * _error;
+  _grad.noalias() = J.transpose() * _error;
 
   convertJacobianMethodOutputToGradient(_grad, mIK->getDofs());
   applyWeights(_grad);
@@ -1589,10 +1949,10 @@ const JacobianNode* InverseKinematics::getAffiliation() const
 //==============================================================================
 const math::Jacobian& InverseKinematics::computeJacobian() const
 {
-  // TODO(MXG): Test whether we can safely use a const reference here instead of
-  // just a regular const
-  const math::Jacobian fullJacobian = hasOffset()?
-        getNode()->getWorldJacobian(mOffset) : getNode()->getWorldJacobian();
+  // Bind to the Node's cached Jacobian instead of copying it. The offset (if
+  // any) is applied only to the columns that we actually use, which avoids
+  // allocating a full offset Jacobian each time this gets called.
+  const math::Jacobian& fullJacobian = getNode()->getWorldJacobian();
 
   mJacobian.setZero(6, getDofs().size());
 
@@ -1603,6 +1963,14 @@ const math::Jacobian& InverseKinematics::computeJacobian() const
       mJacobian.block<6,1>(0,j) = fullJacobian.block<6,1>(0,i);
   }
 
+  if(hasOffset())
+  {
+    const Eigen::Vector3d offset =
+        getNode()->getWorldTransform().linear() * mOffset;
+    for(int j=0; j < mJacobian.cols(); ++j)
+      mJacobian.block<3,1>(3,j) += mJacobian.block<3,1>(0,j).cross(offset);
+  }
+
   return mJacobian;
 }
 
@@ -1627,6 +1995,20 @@ void InverseKinematics::setPositions(const Eigen::VectorXd& _q)
   skel->setPositions(mDofs, _q);
 }
 
+//==============================================================================
+void InverseKinematics::setPositionsIfChanged(const Eigen::VectorXd& _q)
+{
+  const SkeletonPtr& skel = getNode()->getSkeleton();
+  for(std::size_t i=0; i < mDofs.size(); ++i)
+  {
+    if(skel->getDof(mDofs[i])->getPosition() != _q[static_cast<int>(i)])
+    {
+      setPositions(_q);
+      return;
+    }
+  }
+}
+
 //==============================================================================
 void InverseKinematics::clearCaches()
 {
@@ -1693,13 +2075,57 @@ void InverseKinematics::Objective::evalGradient(
     Eigen::Map<Eigen::VectorXd> gradMap(mGradCache.data(), _grad.size());
     mIK->mNullSpaceObjective->evalGradient(_x, gradMap);
 
-    mIK->setPositions(_x);
+    addNullSpaceGradient(_x, _grad);
+  }
+}
+
+//==============================================================================
+double InverseKinematics::Objective::evalWithGradient(
+    const Eigen::VectorXd& _x, Eigen::Map<Eigen::VectorXd> _grad) const
+{
+  if(nullptr == mIK)
+  {
+    dterr << "[InverseKinematics::Objective::evalWithGradient] Attempting to "
+          << "use an Objective function of an expired InverseKinematics "
+          << "module!\n";
+    assert(false);
+    return 0;
+  }
+
+  double cost = 0.0;
+
+  if(mIK->mObjective)
+    cost += mIK->mObjective->evalWithGradient(_x, _grad);
+  else
+    _grad.setZero();
+
+  if(mIK->mNullSpaceObjective)
+  {
+    mGradCache.resize(_grad.size());
+    Eigen::Map<Eigen::VectorXd> gradMap(mGradCache.data(), _grad.size());
+    cost += mIK->mNullSpaceObjective->evalWithGradient(_x, gradMap);
 
-    const math::Jacobian& J = mIK->computeJacobian();
-    mSVDCache.compute(J, Eigen::ComputeFullV);
-    math::extractNullSpace(mSVDCache, mNullSpaceCache);
-    _grad += mNullSpaceCache*mNullSpaceCache.transpose() * mGradCache;
+    addNullSpaceGradient(_x, _grad);
   }
+
+  return cost;
+}
+
+//==============================================================================
+void InverseKinematics::Objective::addNullSpaceGradient(
+    const Eigen::VectorXd& _x, Eigen::Map<Eigen::VectorXd>& _grad) const
+{
+  mIK->setPositions(_x);
+
+  const math::Jacobian& J = mIK->computeJacobian();
+  mSVDCache.compute(J, Eigen::ComputeFullV);
+  math::extractNullSpace(mSVDCache, mNullSpaceCache);
+
+  // Apply the projection as two matrix-vector products so that the dense
+  // projector N*N^T never needs to be formed.
+  mNullSpaceProjectionCache.noalias() =
+      mNullSpaceCache.transpose() * mGradCache;
+  _grad.noalias() += mNullSpaceCache * mNullSpaceProjectionCache;
 }
 
 //==============================================================================
@@ -1745,6 +2171,68 @@ void InverseKinematics::Constraint::evalGradient(
   mIK->getGradientMethod().evalGradient(_x, _grad);
 }
 
+//==============================================================================
+double InverseKinematics::Constraint::evalWithGradient(
+    const Eigen::VectorXd& _x, Eigen::Map<Eigen::VectorXd> _grad) const
+{
+  if(nullptr == mIK)
+  {
+    dterr << "[InverseKinematics::Constraint::evalWithGradient] Attempting to "
+          << "use a Constraint function of an expired InverseKinematics "
+          << "module!\n";
+    assert(false);
+    return 0;
+  }
+
+  // The error must be evaluated first: computing the gradient may move the
+  // Skeleton away from _x, which would force the error to be recomputed with
+  // a second forward kinematics pass. Once the error is cached, the gradient
+  // reuses the kinematics that it was computed with.
+  const double error = mIK->getErrorMethod().evalError(_x).norm();
+  mIK->getGradientMethod().evalGradient(_x, _grad);
+
+  return error;
+}
+
+//==============================================================================
+std::size_t InverseKinematics::Constraint::getResidualDimension() const
+{
+  return 6u;
+}
+
+//==============================================================================
+void InverseKinematics::Constraint::evalResidual(
+    const Eigen::VectorXd& _x, Eigen::Map<Eigen::VectorXd> _residual) const
+{
+  if(nullptr == mIK)
+  {
+    dterr << "[InverseKinematics::Constraint::evalResidual] Attempting to use "
+          << "a Constraint function of an expired InverseKinematics module!\n";
+    assert(false);
+    _residual.setZero();
+    return;
+  }
+
+  _residual = mIK->getErrorMethod().evalUnclampedError(_x);
+}
+
+//==============================================================================
+void InverseKinematics::Constraint::evalResidualJacobian(
+    const Eigen::VectorXd& _x, Eigen::Map<Eigen::MatrixXd> _jacobian) const
+{
+  if(nullptr == mIK)
+  {
+    dterr << "[InverseKinematics::Constraint::evalResidualJacobian] Attempting "
+          << "to use a Constraint function of an expired InverseKinematics "
+          << "module!\n";
+    assert(false);
+    _jacobian.setZero();
+    return;
+  }
+
+  _jacobian = mIK->getErrorMethod().evalErrorJacobian(_x);
+}
+
 //==============================================================================
 InverseKinematics::InverseKinematics(JacobianNode* _node)
   : mActive(true),
@@ -38,6 +38,7 @@
 
 #include <Eigen/SVD>
 
+#include "dart/common/Memory.hpp"
 #include "dart/common/sub_ptr.hpp"
 #include "dart/common/Signal.hpp"
 #include "dart/common/Subject.hpp"
@@ -45,6 +46,7 @@
 #include "dart/optimizer/Solver.hpp"
 #include "dart/optimizer/Problem.hpp"
 #include "dart/optimizer/Function.hpp"
+#include "dart/optimizer/ResidualFunction.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
 #include "dart/dynamics/JacobianNode.hpp"
 
@@ -136,6 +138,57 @@ public:
   /// solved positions.
   bool solve(Eigen::VectorXd& positions, bool _applySolution = true);
 
+  /// Settings for solveBatch()
+  struct BatchOptions
+  {
+    /// If true, the targets are sorted along a Z-order curve of their
+    /// positions, and each target will be initialized with the solution of
+    /// the last target before it in that order that was solved, which is
+    /// usually one of its nearest neighbors. Otherwise the seed of the target
+    /// will be used as the initial guess.
+    bool mWarmStart;
+
+    /// Number of worker threads. A value of 0 means that the number of
+    /// concurrent threads supported by the hardware will be used. Only one
+    /// thread will be used if the IK module has Functions that cannot be
+    /// cloned (see solveBatch()).
+    std::size_t mNumThreads;
+
+    /// Default constructor
+    BatchOptions(bool warmStart = true, std::size_t numThreads = 0);
+  };
+
+  /// Solve the IK Problem for each of the given targets.
+  ///
+  /// Each entry of _targets is the desired world transform of this module's
+  /// Node. The Problem, the Solver, and the bounds are set up once per worker
+  /// and reused across all the targets that the worker is responsible for.
+  /// The workers operate on clones of the Skeleton, so the Skeleton of this
+  /// IK module is never modified by this function.
+  ///
+  /// The initial guess for each target is taken from _seeds, whose components
+  /// must correspond to the components of getDofs(). _seeds may be empty (the
+  /// current positions are used for every target), have one entry (used for
+  /// every target), or have one entry per target. When warm starting is
+  /// enabled, targets that have a previously solved neighbor in the same
+  /// worker will use that neighbor's solution instead.
+  ///
+  /// Each worker also gets its own clone of every Function of this IK module
+  /// that inherits InverseKinematics::Function, which serves as the hook for
+  /// cloning. Any other optimizer::Function would be shared between the
+  /// workers, and it cannot be assumed to be thread safe, so solveBatch()
+  /// solves all the targets in the calling thread when the objective, the
+  /// null space objective, or the Problem has such a Function.
+  ///
+  /// Upon return, _solutions and _successes will have one entry per target.
+  /// The number of targets that were solved successfully is returned.
+  std::size_t solveBatch(
+      const common::aligned_vector<Eigen::Isometry3d>& _targets,
+      const std::vector<Eigen::VectorXd>& _seeds,
+      std::vector<Eigen::VectorXd>& _solutions,
+      std::vector<bool>& _successes,
+      const BatchOptions& _options = BatchOptions()) const;
+
   /// Clone this IK module, but targeted at a new Node. Any Functions in the
   /// Problem that inherit InverseKinematics::Function will be adapted to the
   /// new IK module. Any generic optimizer::Function will just be copied over
@@ -390,6 +443,10 @@ protected:
   /// Reset the signal connection for this IK module's Node
   void resetNodeConnection();
 
+  /// Set the positions of this IK module's DOFs only if they differ from _q.
+  /// This avoids invalidating kinematics that were already computed at _q.
+  void setPositionsIfChanged(const Eigen::VectorXd& _q);
+
   /// Connection to the target update
   common::Connection mTargetConnection;
 
@@ -538,6 +595,12 @@ public:
   /// an update is needed.
   virtual Eigen::Vector6d computeError() = 0;
 
+  /// Override this function if your computeError() applies the error length
+  /// clamp, and return the error without it. Least-squares solvers use this
+  /// through evalUnclampedError(). The default implementation returns
+  /// computeError().
+  virtual Eigen::Vector6d computeUnclampedError();
+
   /// Override this function with your implementation of computing the desired
   /// given the current transform and error vector. If you want the desired
   /// transform to always be equal to the Target's transform, you can simply
@@ -548,6 +611,28 @@ public:
   /// This function is used to handle caching the error vector.
   const Eigen::Vector6d& evalError(const Eigen::VectorXd& _q);
 
+  /// Same as evalError(), but uses computeUnclampedError(). Least-squares
+  /// solvers need this, because a clamped error hides any progress that is
+  /// made while the error is longer than the clamp.
+  const Eigen::Vector6d& evalUnclampedError(const Eigen::VectorXd& _q);
+
+  /// Evaluate the Jacobian of evalUnclampedError() with respect to the DOFs of
+  /// the IK module at _q.
+  ///
+  /// The default implementation assumes the error is structured the way that
+  /// TaskSpaceRegion computes it: a weighted displacement of the Node relative
+  /// to the target, expressed in the target's reference frame and then
+  /// rotated into the world frame, whose components are zero while they are
+  /// inside of the bounds. Components with a finite bound keep their rows
+  /// while they are inside of it, so that least-squares steps hold them there.
+  /// Override this if your error has a different structure.
+  ///
+  /// Like computeJacobian(), this is taken with respect to the generalized
+  /// velocities, so for joints whose positions are not Euclidean (such as
+  /// BallJoint and FreeJoint) it only approximates the derivative with respect
+  /// to the positions.
+  virtual const math::Jacobian& evalErrorJacobian(const Eigen::VectorXd& _q);
+
   /// Get the name of this ErrorMethod.
   const std::string& getMethodName() const;
 
@@ -649,6 +734,15 @@ protected:
   /// The last error vector computed by this ErrorMethod
   Eigen::Vector6d mLastError;
 
+  /// The last joint positions passed into evalUnclampedError()
+  Eigen::VectorXd mLastUnclampedPositions;
+
+  /// The last error vector computed by computeUnclampedError()
+  Eigen::Vector6d mLastUnclampedError;
+
+  /// The last Jacobian computed by evalErrorJacobian()
+  math::Jacobian mLastErrorJacobian;
+
   /// The properties of this ErrorMethod
   Properties mErrorP;
 
@@ -707,6 +801,9 @@ public:
   // Documentation inherited
   Eigen::Vector6d computeError() override;
 
+  // Documentation inherited
+  Eigen::Vector6d computeUnclampedError() override;
+
   /// Set whether this TaskSpaceRegion should compute its error vector from
   /// the center of the region.
   void setComputeFromCenter(bool computeFromCenter);
@@ -919,6 +1016,15 @@ protected:
   /// Properties of this Damped Least Squares method
   UniqueProperties mDLSProperties;
 
+private:
+
+  /// Caches used by computeGradient to avoid reallocating the damped normal
+  /// equations on each iteration when there are fewer DOFs than task space
+  /// dimensions.
+  Eigen::MatrixXd mNormalCache;
+  Eigen::VectorXd mRhsCache;
+  Eigen::LDLT<Eigen::MatrixXd> mLDLTCache;
+
 };
 
 //==============================================================================
@@ -1249,14 +1355,26 @@ public:
   void evalGradient(const Eigen::VectorXd& _x,
                     Eigen::Map<Eigen::VectorXd> _grad) const override;
 
+  // Documentation inherited
+  double evalWithGradient(const Eigen::VectorXd& _x,
+                          Eigen::Map<Eigen::VectorXd> _grad) const override;
+
 protected:
 
+  /// Project the null space objective gradient stored in mGradCache onto the
+  /// null space of the IK module's Jacobian at _x and add it to _grad.
+  void addNullSpaceGradient(const Eigen::VectorXd& _x,
+                            Eigen::Map<Eigen::VectorXd>& _grad) const;
+
   /// Pointer to this Objective's IK module
   sub_ptr<InverseKinematics> mIK;
 
   /// Cache for the gradient of the Objective
   mutable Eigen::VectorXd mGradCache;
 
+  /// Cache for the null space coordinates of the null space gradient
+  mutable Eigen::VectorXd mNullSpaceProjectionCache;
+
   /// Cache for the null space SVD
   mutable Eigen::JacobiSVD<math::Jacobian> mSVDCache;
   // TODO(JS): Need to define aligned operator new for this?
@@ -1276,8 +1394,14 @@ public:
 /// instantiated by a user. Call InverseKinematics::resetProblem() to set the
 /// first equality constraint of the module's Problem to an
 /// InverseKinematics::Constraint.
+///
+/// For least-squares solvers, the residual of this Constraint is the
+/// unclamped error vector of the ErrorMethod and its Jacobian comes from
+/// ErrorMethod::evalErrorJacobian(). eval() and evalGradient() keep returning
+/// the norm of the (clamped) error and the output of the GradientMethod, which
+/// is what the GradientDescentSolver expects.
 class InverseKinematics::Constraint final :
-    public Function, public optimizer::Function
+    public Function, public optimizer::ResidualFunction
 {
 public:
 
@@ -1297,6 +1421,22 @@ public:
   void evalGradient(const Eigen::VectorXd& _x,
                     Eigen::Map<Eigen::VectorXd> _grad) const override;
 
+  // Documentation inherited
+  double evalWithGradient(const Eigen::VectorXd& _x,
+                          Eigen::Map<Eigen::VectorXd> _grad) const override;
+
+  // Documentation inherited
+  std::size_t getResidualDimension() const override;
+
+  // Documentation inherited
+  void evalResidual(const Eigen::VectorXd& _x,
+                    Eigen::Map<Eigen::VectorXd> _residual) const override;
+
+  // Documentation inherited
+  void evalResidualJacobian(
+      const Eigen::VectorXd& _x,
+      Eigen::Map<Eigen::MatrixXd> _jacobian) const override;
+
 protected:
 
   /// Pointer to this Constraint's IK module
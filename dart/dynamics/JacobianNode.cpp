@@ -31,6 +31,9 @@
  */
 
 #include "dart/dynamics/JacobianNode.hpp"
+
+#include <algorithm>
+
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/InverseKinematics.hpp"
 
@@ -43,7 +46,9 @@ namespace dynamics {
 // std::unique_ptr<InverseKinematics> class member
 JacobianNode::~JacobianNode()
 {
-  mBodyNode->mChildJacobianNodes.erase(this);
+  std::vector<JacobianNode*>& siblings = mBodyNode->mChildJacobianNodes;
+  siblings.erase(std::remove(siblings.begin(), siblings.end(), this),
+                 siblings.end());
 }
 
 //==============================================================================
@@ -92,7 +97,7 @@ JacobianNode::JacobianNode(BodyNode* bn)
     mIsWorldJacobianClassicDerivDirty(true)
 {
   if(this != bn)
-    bn->mChildJacobianNodes.insert(this);
+    bn->mChildJacobianNodes.push_back(this);
 }
 
 //==============================================================================
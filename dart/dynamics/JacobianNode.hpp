@@ -35,6 +35,7 @@
 
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "dart/dynamics/Frame.hpp"
 #include "dart/dynamics/Node.hpp"
@@ -300,8 +301,10 @@ protected:
   /// Inverse kinematics module which gets lazily created upon request
   std::shared_ptr<InverseKinematics> mIK;
 
-  /// JacobianNode children that descend from this JacobianNode
-  std::unordered_set<JacobianNode*> mChildJacobianNodes;
+  /// JacobianNode children that descend from this JacobianNode. These are kept
+  /// in a contiguous array because they get visited every time the Jacobians
+  /// are invalidated.
+  std::vector<JacobianNode*> mChildJacobianNodes;
 
 };
 
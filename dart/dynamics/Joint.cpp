@@ -185,7 +185,11 @@ const std::string& Joint::getName() const
 //==============================================================================
 void Joint::setActuatorType(Joint::ActuatorType _actuatorType)
 {
+  if (mAspectProperties.mActuatorType == _actuatorType)
+    return;
+
   mAspectProperties.mActuatorType = _actuatorType;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -314,6 +318,23 @@ const Eigen::Isometry3d& Joint::getRelativeTransform() const
   return mT;
 }
 
+//==============================================================================
+Eigen::Isometry3d Joint::computeRelativeTransform(
+    const Eigen::VectorXd& /*positions*/) const
+{
+  dterr << "[Joint::computeRelativeTransform] The Joint type [" << getType()
+        << "] of the Joint named [" << getName() << "] (" << this << ") does "
+        << "not implement this function. Returning the identity.\n";
+
+  return Eigen::Isometry3d::Identity();
+}
+
+//==============================================================================
+bool Joint::canComputeRelativeTransform() const
+{
+  return false;
+}
+
 //==============================================================================
 const Eigen::Vector6d& Joint::getRelativeSpatialVelocity() const
 {
@@ -353,7 +374,11 @@ const Eigen::Vector6d& Joint::getRelativePrimaryAcceleration() const
 //==============================================================================
 void Joint::setPositionLimitEnforced(bool _isPositionLimitEnforced)
 {
+  if (mAspectProperties.mIsPositionLimitEnforced == _isPositionLimitEnforced)
+    return;
+
   mAspectProperties.mIsPositionLimitEnforced = _isPositionLimitEnforced;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -442,6 +467,7 @@ void Joint::setTransformFromParentBodyNode(const Eigen::Isometry3d& _T)
   assert(math::verifyTransform(_T));
   mAspectProperties.mT_ParentBodyToJoint = _T;
   notifyPositionUpdated();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -451,6 +477,7 @@ void Joint::setTransformFromChildBodyNode(const Eigen::Isometry3d& _T)
   mAspectProperties.mT_ChildBodyToJoint = _T;
   updateRelativeJacobian();
   notifyPositionUpdated();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -524,6 +551,53 @@ void Joint::updateLocalJacobianTimeDeriv() const
   updateRelativeJacobianTimeDeriv();
 }
 
+//==============================================================================
+void Joint::getSpatialToGeneralizedSegment(
+    Eigen::VectorXd& _generalized, const Eigen::Vector6d& _spatial)
+{
+  const std::size_t dof = getNumDofs();
+  if (dof > 0)
+  {
+    _generalized.segment(getIndexInTree(0), dof)
+        = getRelativeJacobian().transpose() * _spatial;
+  }
+}
+
+//==============================================================================
+void Joint::getMassMatrixSegment(Eigen::MatrixXd& _massMat,
+                                 const std::size_t _col,
+                                 const Eigen::Vector6d& _spatialForce)
+{
+  const std::size_t dof = getNumDofs();
+  if (dof > 0)
+  {
+    _massMat.block(getIndexInTree(0), _col, dof, 1)
+        = getRelativeJacobian().transpose() * _spatialForce;
+  }
+}
+
+//==============================================================================
+void Joint::getAugMassMatrixSegment(Eigen::MatrixXd& _augMassMat,
+                                    const std::size_t _col,
+                                    const Eigen::Vector6d& _spatialForce,
+                                    double _timeStep)
+{
+  const std::size_t dof = getNumDofs();
+  if (dof == 0)
+    return;
+
+  // Implicit joint damping and spring terms
+  Eigen::VectorXd implicitForce = getAccelerations();
+  for (std::size_t i = 0; i < dof; ++i)
+  {
+    implicitForce[i] *= _timeStep * getDampingCoefficient(i)
+                        + _timeStep * _timeStep * getSpringStiffness(i);
+  }
+
+  _augMassMat.block(getIndexInTree(0), _col, dof, 1)
+      = getRelativeJacobian().transpose() * _spatialForce + implicitForce;
+}
+
 //==============================================================================
 void Joint::updateArticulatedInertia() const
 {
@@ -623,6 +623,22 @@ public:
   /// expressed in the child BodyNode frame
   const Eigen::Isometry3d& getRelativeTransform() const;
 
+  /// Compute the transform of the child BodyNode relative to the parent
+  /// BodyNode for the given positions of this Joint. The Joint types of DART
+  /// neither read nor update the state of the Joint, so this may be called
+  /// concurrently.
+  ///
+  /// The default implementation cannot compute the transform, so it reports
+  /// an error and returns the identity. Custom Joint types should override it
+  /// along with canComputeRelativeTransform().
+  virtual Eigen::Isometry3d computeRelativeTransform(
+      const Eigen::VectorXd& positions) const;
+
+  /// Return true if computeRelativeTransform() is implemented by this Joint
+  /// type. MetaSkeleton::computeBatchForwardKinematics() evaluates the
+  /// Joints for which this is false by setting their positions instead.
+  virtual bool canComputeRelativeTransform() const;
+
   /// Get spatial velocity of the child BodyNode relative to the parent BodyNode
   /// expressed in the child BodyNode frame
   const Eigen::Vector6d& getRelativeSpatialVelocity() const;
@@ -941,6 +957,25 @@ protected:
   virtual Eigen::VectorXd getSpatialToGeneralized(
       const Eigen::Vector6d& _spatial) = 0;
 
+  /// Assign J^T * _spatial to the segment of _generalized that belongs to
+  /// this joint. GenericJoint overrides this so that no temporary is
+  /// allocated.
+  virtual void getSpatialToGeneralizedSegment(
+      Eigen::VectorXd& _generalized, const Eigen::Vector6d& _spatial);
+
+  /// Assign J^T * _spatialForce to the segment of column _col of _massMat that
+  /// belongs to this joint
+  virtual void getMassMatrixSegment(Eigen::MatrixXd& _massMat,
+                                    const std::size_t _col,
+                                    const Eigen::Vector6d& _spatialForce);
+
+  /// Same as getMassMatrixSegment(), plus the implicit joint damping and
+  /// spring terms of the augmented mass matrix
+  virtual void getAugMassMatrixSegment(Eigen::MatrixXd& _augMassMat,
+                                       const std::size_t _col,
+                                       const Eigen::Vector6d& _spatialForce,
+                                       double _timeStep);
+
   /// \}
 
 protected:
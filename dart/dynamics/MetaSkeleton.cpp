@@ -30,10 +30,17 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "dart/dynamics/MetaSkeleton.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+
 #include "dart/common/Console.hpp"
+#include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/DegreeOfFreedom.hpp"
 #include "dart/dynamics/JacobianNode.hpp"
-#include "dart/dynamics/MetaSkeleton.hpp"
+#include "dart/dynamics/Joint.hpp"
 
 namespace dart {
 namespace dynamics {
@@ -156,6 +163,70 @@ static void setAllValuesFromVector(MetaSkeleton* skel,
   }
 }
 
+//==============================================================================
+/// Same as setAllValuesFromVector(), except that every run of entries which
+/// covers all the DegreeOfFreedoms of one Joint (in order) is handed to that
+/// Joint in a single call. This lets each Joint invalidate its child subtree
+/// once rather than once per DegreeOfFreedom, and lets it skip the
+/// invalidation entirely when the values did not change.
+template <void (DegreeOfFreedom::*setValue)(double _value),
+          void (Joint::*setValues)(const Eigen::VectorXd& _values)>
+static void setAllValuesByJoint(MetaSkeleton* skel,
+                                const Eigen::VectorXd& _values,
+                                const std::string& _fname,
+                                const std::string& _vname)
+{
+  const std::size_t nDofs = skel->getNumDofs();
+  if( _values.size() != static_cast<int>(nDofs) )
+  {
+    // Let the generic version report the error
+    setAllValuesFromVector<setValue>(skel, _values, _fname, _vname);
+    return;
+  }
+
+  Eigen::VectorXd segment;
+  std::size_t i = 0;
+  while(i < nDofs)
+  {
+    DegreeOfFreedom* dof = skel->getDof(i);
+    Joint* joint = dof ? dof->getJoint() : nullptr;
+    const std::size_t jointDofs = joint ? joint->getNumDofs() : 0u;
+
+    bool wholeJoint = (jointDofs > 1u && dof->getIndexInJoint() == 0u
+                       && i + jointDofs <= nDofs);
+    for(std::size_t k = 1; wholeJoint && k < jointDofs; ++k)
+    {
+      const DegreeOfFreedom* next = skel->getDof(i + k);
+      wholeJoint = next && next->getJoint() == joint
+          && next->getIndexInJoint() == k;
+    }
+
+    if(wholeJoint)
+    {
+      segment = _values.segment(i, jointDofs);
+      (joint->*setValues)(segment);
+      i += jointDofs;
+      continue;
+    }
+
+    if(dof)
+    {
+      (dof->*setValue)(_values[i]);
+    }
+    else
+    {
+      dterr << "[MetaSkeleton::" << _fname << "] DegreeOfFreedom #" << i
+            << " in the MetaSkeleton named [" << skel->getName() << "] ("
+            << skel << ") has expired! ReferentialSkeletons should call "
+            << "update() after structural changes have been made to the "
+            << "BodyNodes they refer to. Nothing will be set for this specific "
+            << "DegreeOfFreedom.\n";
+      assert(false);
+    }
+    ++i;
+  }
+}
+
 //==============================================================================
 template <double (DegreeOfFreedom::*getValue)() const>
 static Eigen::VectorXd getValuesFromVector(
@@ -378,7 +449,7 @@ double MetaSkeleton::getPosition(std::size_t _index) const
 //==============================================================================
 void MetaSkeleton::setPositions(const Eigen::VectorXd& _positions)
 {
-  setAllValuesFromVector<&DegreeOfFreedom::setPosition>(
+  setAllValuesByJoint<&DegreeOfFreedom::setPosition, &Joint::setPositions>(
         this, _positions, "setPositions", "_positions");
 }
 
@@ -515,7 +586,7 @@ double MetaSkeleton::getVelocity(std::size_t _index) const
 //==============================================================================
 void MetaSkeleton::setVelocities(const Eigen::VectorXd& _velocities)
 {
-  setAllValuesFromVector<&DegreeOfFreedom::setVelocity>(
+  setAllValuesByJoint<&DegreeOfFreedom::setVelocity, &Joint::setVelocities>(
         this, _velocities, "setVelocities", "_velocities");
 }
 
@@ -652,7 +723,8 @@ double MetaSkeleton::getAcceleration(std::size_t _index) const
 //==============================================================================
 void MetaSkeleton::setAccelerations(const Eigen::VectorXd& _accelerations)
 {
-  setAllValuesFromVector<&DegreeOfFreedom::setAcceleration>(
+  setAllValuesByJoint<&DegreeOfFreedom::setAcceleration,
+                      &Joint::setAccelerations>(
         this, _accelerations, "setAccelerations", "_accelerations");
 }
 
@@ -1062,6 +1134,248 @@ math::Jacobian MetaSkeleton::getJacobianSpatialDeriv(
   return math::AdRJac(_node->getTransform(_inCoordinatesOf), result);
 }
 
+//==============================================================================
+void MetaSkeleton::computeBatchForwardKinematics(
+    const Eigen::MatrixXd& _positions,
+    const std::vector<const BodyNode*>& _bodyNodes,
+    common::aligned_vector<Eigen::Isometry3d>& _transforms,
+    Eigen::MatrixXd* _jacobians,
+    std::size_t _numThreads) const
+{
+  const std::size_t numDofs = getNumDofs();
+  const std::size_t numBodies = _bodyNodes.size();
+  const std::size_t numConfigs = static_cast<std::size_t>(_positions.cols());
+
+  if(static_cast<std::size_t>(_positions.rows()) != numDofs)
+  {
+    dterr << "[MetaSkeleton::computeBatchForwardKinematics] The number of rows "
+          << "of _positions [" << _positions.rows() << "] does not match the "
+          << "number of DOFs [" << numDofs << "] of the MetaSkeleton named ["
+          << getName() << "] (" << this << ")\n";
+    _transforms.clear();
+    if(_jacobians)
+      _jacobians->resize(6, 0);
+    return;
+  }
+
+  _transforms.resize(numConfigs * numBodies);
+  if(_jacobians)
+    _jacobians->setZero(6, numDofs * numBodies * numConfigs);
+
+  if(0u == numConfigs || 0u == numBodies)
+    return;
+
+  // The union of the kinematic chains of the requested BodyNodes is flattened
+  // into an array of links in which every parent precedes its children. Each
+  // link records where the positions of its Joint come from: a row of
+  // _positions for the coordinates of this MetaSkeleton, or the current
+  // position for any other coordinate.
+  struct Link
+  {
+    const Joint* mJoint;
+    std::size_t mParent;
+    std::vector<std::size_t> mRows;
+    bool mIsConstant;
+  };
+
+  std::vector<Link> links;
+  std::vector<Eigen::VectorXd> jointPositions;
+  std::vector<std::size_t> bodyLinks(numBodies);
+  std::unordered_map<const BodyNode*, std::size_t> linkMap;
+
+  std::vector<const BodyNode*> chain;
+  for(std::size_t b = 0; b < numBodies; ++b)
+  {
+    chain.clear();
+    for(const BodyNode* bn = _bodyNodes[b];
+        bn != nullptr && linkMap.find(bn) == linkMap.end();
+        bn = bn->getParentBodyNode())
+    {
+      chain.push_back(bn);
+    }
+
+    for(auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+      const BodyNode* bn = *it;
+      const Joint* joint = bn->getParentJoint();
+      const BodyNode* parent = bn->getParentBodyNode();
+
+      Link link;
+      link.mJoint = joint;
+      link.mParent = parent ? linkMap[parent] : INVALID_INDEX;
+      link.mRows.resize(joint->getNumDofs());
+      link.mIsConstant = true;
+      for(std::size_t k = 0; k < joint->getNumDofs(); ++k)
+      {
+        link.mRows[k] = getIndexOf(joint->getDof(k), false);
+        if(INVALID_INDEX != link.mRows[k])
+          link.mIsConstant = false;
+      }
+
+      linkMap[bn] = links.size();
+      links.push_back(link);
+      jointPositions.push_back(joint->getPositions());
+    }
+
+    bodyLinks[b] = linkMap[_bodyNodes[b]];
+  }
+
+  const std::size_t numLinks = links.size();
+
+  // Joint types that cannot compute their relative transforms for given
+  // positions are evaluated by setting the positions of this MetaSkeleton, one
+  // configuration at a time on this thread
+  bool isSerial = false;
+  for(const Link& link : links)
+  {
+    if(!link.mIsConstant && !link.mJoint->canComputeRelativeTransform())
+      isSerial = true;
+  }
+
+  if(isSerial)
+  {
+    MetaSkeleton* self = const_cast<MetaSkeleton*>(this);
+    const Eigen::VectorXd oldPositions = getPositions();
+
+    for(std::size_t c = 0; c < numConfigs; ++c)
+    {
+      self->setPositions(_positions.col(c));
+
+      for(std::size_t b = 0; b < numBodies; ++b)
+      {
+        _transforms[c*numBodies + b] = _bodyNodes[b]->getWorldTransform();
+
+        if(_jacobians)
+        {
+          _jacobians->block(0, (c*numBodies + b) * numDofs, 6, numDofs)
+              = getWorldJacobian(_bodyNodes[b]);
+        }
+      }
+    }
+
+    self->setPositions(oldPositions);
+    return;
+  }
+
+  // Joints that do not depend on any coordinate of this MetaSkeleton have the
+  // same relative transform in every configuration
+  common::aligned_vector<Eigen::Isometry3d> constantTransforms(numLinks);
+  for(std::size_t l = 0; l < numLinks; ++l)
+  {
+    const Link& link = links[l];
+    if(!link.mIsConstant)
+      continue;
+
+    if(link.mJoint->canComputeRelativeTransform())
+    {
+      constantTransforms[l]
+          = link.mJoint->computeRelativeTransform(jointPositions[l]);
+    }
+    else
+    {
+      constantTransforms[l] = link.mJoint->getRelativeTransform();
+    }
+  }
+
+  std::size_t numWorkers = _numThreads;
+  if(0u == numWorkers)
+    numWorkers = std::max(1u, std::thread::hardware_concurrency());
+  numWorkers = std::min(numWorkers, numConfigs);
+
+  const auto computeRange = [&](std::size_t begin, std::size_t end)
+  {
+    // Every worker owns its position buffers, world transforms and relative
+    // Jacobians, and only writes to the outputs of its own configurations
+    std::vector<Eigen::VectorXd> q = jointPositions;
+    common::aligned_vector<Eigen::Isometry3d> worldTransforms(numLinks);
+    std::vector<math::Jacobian> relativeJacobians(_jacobians ? numLinks : 0u);
+
+    for(std::size_t c = begin; c < end; ++c)
+    {
+      for(std::size_t l = 0; l < numLinks; ++l)
+      {
+        const Link& link = links[l];
+
+        Eigen::Isometry3d relative;
+        if(link.mIsConstant)
+        {
+          relative = constantTransforms[l];
+        }
+        else
+        {
+          for(std::size_t k = 0; k < link.mRows.size(); ++k)
+          {
+            if(INVALID_INDEX != link.mRows[k])
+              q[l][k] = _positions(link.mRows[k], c);
+          }
+
+          relative = link.mJoint->computeRelativeTransform(q[l]);
+
+          // The relative Jacobian of a link is shared by all the requested
+          // BodyNodes that descend from it
+          if(_jacobians)
+            relativeJacobians[l] = link.mJoint->getRelativeJacobian(q[l]);
+        }
+
+        if(INVALID_INDEX == link.mParent)
+          worldTransforms[l] = relative;
+        else
+          worldTransforms[l] = worldTransforms[link.mParent] * relative;
+      }
+
+      for(std::size_t b = 0; b < numBodies; ++b)
+      {
+        const std::size_t l = bodyLinks[b];
+        _transforms[c*numBodies + b] = worldTransforms[l];
+
+        if(nullptr == _jacobians)
+          continue;
+
+        // The world Jacobian column of a coordinate of an ancestor Joint is
+        // the relative Jacobian of that Joint, transformed by the world
+        // rotation of the Joint's child and by the offset between the origins
+        // of the Joint's child and of the requested BodyNode.
+        const Eigen::Vector3d& origin = worldTransforms[l].translation();
+        const std::size_t column = (c*numBodies + b) * numDofs;
+        for(std::size_t a = l; a != INVALID_INDEX; a = links[a].mParent)
+        {
+          const Link& link = links[a];
+          if(link.mIsConstant)
+            continue;
+
+          Eigen::Isometry3d T = worldTransforms[a];
+          T.translation() -= origin;
+
+          const math::Jacobian& S = relativeJacobians[a];
+          for(std::size_t k = 0; k < link.mRows.size(); ++k)
+          {
+            if(INVALID_INDEX == link.mRows[k])
+              continue;
+
+            _jacobians->col(column + link.mRows[k])
+                = math::AdT(T, S.col(k));
+          }
+        }
+      }
+    }
+  };
+
+  const std::size_t chunk = (numConfigs + numWorkers - 1) / numWorkers;
+  std::vector<std::thread> threads;
+  threads.reserve(numWorkers - 1);
+  for(std::size_t w = 1; w < numWorkers; ++w)
+  {
+    const std::size_t begin = std::min(w*chunk, numConfigs);
+    const std::size_t end = std::min(begin + chunk, numConfigs);
+    threads.emplace_back(computeRange, begin, end);
+  }
+
+  computeRange(0, std::min(chunk, numConfigs));
+
+  for(std::thread& thread : threads)
+    thread.join();
+}
+
 //==============================================================================
 double MetaSkeleton::computeLagrangian() const
 {
@@ -38,6 +38,7 @@
 
 #include <Eigen/Dense>
 
+#include "dart/common/Memory.hpp"
 #include "dart/common/Signal.hpp"
 #include "dart/common/Subject.hpp"
 #include "dart/math/Geometry.hpp"
@@ -629,6 +630,41 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Batch Kinematics
+  //----------------------------------------------------------------------------
+
+  /// Compute the world transforms of a set of BodyNodes for many
+  /// configurations at once, without changing the state of this MetaSkeleton.
+  ///
+  /// Each column of _positions holds one configuration of the generalized
+  /// coordinates of this MetaSkeleton, in the order of getDofs(). Any
+  /// generalized coordinate that the BodyNodes depend on but that does not
+  /// belong to this MetaSkeleton keeps its current position.
+  ///
+  /// Upon return, _transforms[c*_bodyNodes.size() + b] is the world transform
+  /// of _bodyNodes[b] in configuration c. If _jacobians is not a nullptr, it is
+  /// resized to 6 x (getNumDofs() * _bodyNodes.size() * _positions.cols()),
+  /// and the 6 x getNumDofs() block that starts at column
+  /// (c*_bodyNodes.size() + b) * getNumDofs() holds what
+  /// getWorldJacobian(_bodyNodes[b]) would return in configuration c.
+  ///
+  /// The configurations are split across _numThreads worker threads. A value
+  /// of 0 means that the number of concurrent threads supported by the
+  /// hardware will be used. If any of the Joints that depend on the
+  /// coordinates of this MetaSkeleton cannot compute its relative transform
+  /// (see Joint::canComputeRelativeTransform()), the configurations are
+  /// instead evaluated one at a time on the calling thread by setting the
+  /// positions of this MetaSkeleton, which are restored afterwards.
+  void computeBatchForwardKinematics(
+      const Eigen::MatrixXd& _positions,
+      const std::vector<const BodyNode*>& _bodyNodes,
+      common::aligned_vector<Eigen::Isometry3d>& _transforms,
+      Eigen::MatrixXd* _jacobians = nullptr,
+      std::size_t _numThreads = 0) const;
+
+  /// \}
+
   //----------------------------------------------------------------------------
   /// \{ \name Jacobian derivatives
   //----------------------------------------------------------------------------
@@ -264,15 +264,21 @@ void PlanarJoint::updateDegreeOfFreedomNames()
   }
 }
 
+//==============================================================================
+Eigen::Isometry3d PlanarJoint::computeRelativeTransformStatic(
+    const Eigen::Vector3d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * Eigen::Translation3d(mAspectProperties.mTransAxis1 * _positions[0])
+         * Eigen::Translation3d(mAspectProperties.mTransAxis2 * _positions[1])
+         * math::expAngular    (mAspectProperties.mRotAxis    * _positions[2])
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void PlanarJoint::updateRelativeTransform() const
 {
-  const Eigen::Vector3d& positions = getPositionsStatic();
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::Translation3d(mAspectProperties.mTransAxis1 * positions[0])
-       * Eigen::Translation3d(mAspectProperties.mTransAxis2 * positions[1])
-       * math::expAngular    (mAspectProperties.mRotAxis    * positions[2])
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
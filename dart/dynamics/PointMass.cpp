@@ -1124,6 +1124,7 @@ void PointMassNotifier::dirtyTransform()
   mNeedPartialAccelerationUpdate = true;
   mNeedAccelerationUpdate = true;
 
+  mParentSoftBodyNode->mPointMassGrid.mNeedsUpdate = true;
   mParentSoftBodyNode->dirtyArticulatedInertia();
   mParentSoftBodyNode->dirtyExternalForces();
 }
@@ -175,12 +175,19 @@ void PrismaticJoint::updateDegreeOfFreedomNames()
     mDofs[0]->setName(Joint::mAspectProperties.mName, false);
 }
 
+//==============================================================================
+Eigen::Isometry3d PrismaticJoint::computeRelativeTransformStatic(
+    const GenericJoint<math::R1Space>::Vector& positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * Eigen::Translation3d(getAxis() * positions[0])
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void PrismaticJoint::updateRelativeTransform() const
 {
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::Translation3d(getAxis() * getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
@@ -176,12 +176,19 @@ void RevoluteJoint::updateDegreeOfFreedomNames()
     mDofs[0]->setName(Joint::mAspectProperties.mName, false);
 }
 
+//==============================================================================
+Eigen::Isometry3d RevoluteJoint::computeRelativeTransformStatic(
+    const GenericJoint<math::R1Space>::Vector& positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * math::expAngular(getAxis() * positions[0])
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void RevoluteJoint::updateRelativeTransform() const
 {
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * math::expAngular(getAxis() * getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
@@ -199,16 +199,24 @@ void ScrewJoint::updateDegreeOfFreedomNames()
 }
 
 //==============================================================================
-void ScrewJoint::updateRelativeTransform() const
+Eigen::Isometry3d ScrewJoint::computeRelativeTransformStatic(
+    const GenericJoint<math::R1Space>::Vector& positions) const
 {
   using namespace dart::math::suffixes;
 
   Eigen::Vector6d S = Eigen::Vector6d::Zero();
   S.head<3>() = getAxis();
   S.tail<3>() = getAxis() * getPitch() / 2.0_pi;
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * math::expMap(S * getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * math::expMap(S * positions[0])
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
+//==============================================================================
+void ScrewJoint::updateRelativeTransform() const
+{
+  mT = computeRelativeTransformStatic(getPositionsStatic());
+
   assert(math::verifyTransform(mT));
 }
 
@@ -50,8 +50,14 @@ VisualAspectProperties::VisualAspectProperties(const Eigen::Vector4d& color,
 
 //==============================================================================
 CollisionAspectProperties::CollisionAspectProperties(
-    const bool collidable)
-  : mCollidable(collidable)
+    const bool collidable,
+    const std::uint32_t categoryBits,
+    const std::uint32_t maskBits,
+    const bool continuousCollision)
+  : mCollidable(collidable),
+    mCategoryBits(categoryBits),
+    mMaskBits(maskBits),
+    mContinuousCollision(continuousCollision)
 {
   // Do nothing
 }
@@ -126,6 +126,18 @@ public:
   // void setCollidable(const bool& value);
   // const bool& getCollidable() const;
 
+  DART_COMMON_SET_GET_ASPECT_PROPERTY( std::uint32_t, CategoryBits )
+  // void setCategoryBits(const std::uint32_t& value);
+  // const std::uint32_t& getCategoryBits() const;
+
+  DART_COMMON_SET_GET_ASPECT_PROPERTY( std::uint32_t, MaskBits )
+  // void setMaskBits(const std::uint32_t& value);
+  // const std::uint32_t& getMaskBits() const;
+
+  DART_COMMON_SET_GET_ASPECT_PROPERTY( bool, ContinuousCollision )
+  // void setContinuousCollision(const bool& value);
+  // const bool& getContinuousCollision() const;
+
   /// Return true if this body can collide with others bodies
   bool isCollidable() const;
 
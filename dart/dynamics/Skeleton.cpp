@@ -447,6 +447,8 @@ SkeletonPtr Skeleton::clone(const std::string& cloneName) const
   }
 
   skelClone->setProperties(getAspectProperties());
+  skelClone->setUseDynamicsTape(isUsingDynamicsTape());
+  skelClone->setUseImplicitEuler(isUsingImplicitEuler());
   skelClone->setName(cloneName);
   skelClone->setState(getState());
 
@@ -2028,6 +2030,7 @@ const Eigen::VectorXd& Skeleton::getConstraintForces() const
 Skeleton::Skeleton(const AspectPropertiesData& properties)
   : mTotalMass(0.0),
     mIsImpulseApplied(false),
+    mIsUsingImplicitEuler(false),
     mUnionSize(1)
 {
   createAspect<Aspect>(properties);
@@ -2162,6 +2165,7 @@ void Skeleton::registerBodyNode(BodyNode* _newBodyNode)
   }
 #endif // ------- Debug mode
 
+  incrementVersion();
   _newBodyNode->mStructuralChangeSignal.raise(_newBodyNode);
 }
 
@@ -2190,6 +2194,8 @@ void Skeleton::registerJoint(Joint* _newJoint)
     treeDofs.push_back(_newJoint->getDof(i));
     _newJoint->getDof(i)->mIndexInTree = treeDofs.size()-1;
   }
+
+  incrementVersion();
 }
 
 //==============================================================================
@@ -2327,6 +2333,7 @@ void Skeleton::unregisterBodyNode(BodyNode* _oldBodyNode)
   }
 
   updateTotalMass();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -2374,6 +2381,8 @@ void Skeleton::unregisterJoint(Joint* _oldJoint)
     DegreeOfFreedom* dof = treeDofs[i];
     dof->mIndexInTree = i;
   }
+
+  incrementVersion();
 }
 
 //==============================================================================
@@ -3548,6 +3557,17 @@ void Skeleton::computeForwardKinematics(bool _updateTransforms,
 //==============================================================================
 void Skeleton::computeForwardDynamics()
 {
+  if (mDynamicsTape && mDynamicsTape->computeForwardDynamics(*this))
+  {
+    setForces(mDynamicsTape->getForces());
+    setAccelerations(mDynamicsTape->getAccelerations());
+
+    for (std::size_t i = 0; i < mSkelCache.mBodyNodes.size(); ++i)
+      mSkelCache.mBodyNodes[i]->mF = mDynamicsTape->getBodyForce(i);
+
+    return;
+  }
+
   // Note: Articulated Inertias will be updated automatically when
   // getArtInertiaImplicit() is called in BodyNode::updateBiasForce()
 
@@ -3564,6 +3584,42 @@ void Skeleton::computeForwardDynamics()
   }
 }
 
+//==============================================================================
+void Skeleton::setUseDynamicsTape(bool _use)
+{
+  if (_use == isUsingDynamicsTape())
+    return;
+
+  if (_use)
+    mDynamicsTape.reset(new DynamicsTape);
+  else
+    mDynamicsTape.reset();
+}
+
+//==============================================================================
+bool Skeleton::isUsingDynamicsTape() const
+{
+  return mDynamicsTape != nullptr;
+}
+
+//==============================================================================
+void Skeleton::setUseImplicitEuler(bool _use)
+{
+  if (_use == mIsUsingImplicitEuler)
+    return;
+
+  mIsUsingImplicitEuler = _use;
+
+  for (std::size_t i = 0; i < mTreeCache.size(); ++i)
+    dirtyArticulatedInertia(i);
+}
+
+//==============================================================================
+bool Skeleton::isUsingImplicitEuler() const
+{
+  return mIsUsingImplicitEuler;
+}
+
 //==============================================================================
 void Skeleton::computeInverseDynamics(bool _withExternalForces,
                                       bool _withDampingForces,
@@ -46,6 +46,7 @@
 #include "dart/dynamics/detail/BodyNodeAspect.hpp"
 #include "dart/dynamics/SpecializedNodeManager.hpp"
 #include "dart/dynamics/detail/SkeletonAspect.hpp"
+#include "dart/dynamics/DynamicsTape.hpp"
 
 namespace dart {
 namespace dynamics {
@@ -646,6 +647,27 @@ public:
   /// Compute forward dynamics
   void computeForwardDynamics();
 
+  /// Run computeForwardDynamics() on a DynamicsTape, a flattened copy of this
+  /// Skeleton that is only rebuilt when the Skeleton changes. The results are
+  /// written back as joint accelerations, so the BodyNode quantities that
+  /// depend on them are updated lazily as usual. Skeletons that the tape does
+  /// not support automatically use the regular recursions instead.
+  void setUseDynamicsTape(bool _use);
+
+  /// Return true if computeForwardDynamics() uses a DynamicsTape
+  bool isUsingDynamicsTape() const;
+
+  /// Integrate stiff springs with linearly implicit Euler. Joint springs and
+  /// dampers are always treated this way by the forward dynamics: their
+  /// stiffness and damping enter the articulated inertia exactly as they enter
+  /// getAugMassMatrix(). When this is enabled, the edge springs of
+  /// SoftBodyNodes are treated implicitly as well, instead of only the vertex
+  /// springs, so much stiffer soft bodies remain stable at a given time step.
+  void setUseImplicitEuler(bool _use);
+
+  /// Return true if setUseImplicitEuler(true) has been called
+  bool isUsingImplicitEuler() const;
+
   /// Compute inverse dynamics
   void computeInverseDynamics(bool _withExternalForces = false,
                               bool _withDampingForces = false,
@@ -1282,6 +1304,13 @@ protected:
   /// Flag for status of impulse testing.
   bool mIsImpulseApplied;
 
+  /// Flattened copy of this Skeleton that computeForwardDynamics() runs on.
+  /// This is nullptr unless setUseDynamicsTape(true) has been called.
+  std::unique_ptr<DynamicsTape> mDynamicsTape;
+
+  /// True if the edge springs of SoftBodyNodes are integrated implicitly
+  bool mIsUsingImplicitEuler;
+
   mutable std::mutex mMutex;
 
 public:
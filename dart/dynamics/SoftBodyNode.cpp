@@ -32,8 +32,12 @@
 
 #include "dart/dynamics/SoftBodyNode.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "dart/common/Console.hpp"
@@ -246,7 +250,8 @@ SoftBodyNode::SoftBodyNode(BodyNode* _parentBodyNode,
   : Entity(Frame::World(), false),
     Frame(Frame::World()),
     Base(std::make_tuple(_parentBodyNode, _parentJoint, _properties)),
-    mSoftShapeNode(nullptr)
+    mSoftShapeNode(nullptr),
+    mNumPointMassThreads(1u)
 {
   createSoftBodyAspect();
   mNotifier = new PointMassNotifier(this, getName()+"_PointMassNotifier");
@@ -482,6 +487,158 @@ PointMass* SoftBodyNode::addPointMass(const PointMass::Properties& _properties)
   return mPointMasses.back();
 }
 
+//==============================================================================
+PointMass* SoftBodyNode::getNearestPointMass(const Eigen::Vector3d& _point)
+{
+  if(mPointMasses.empty())
+    return nullptr;
+
+  return mPointMasses[getNearestPointMassIndex(_point)];
+}
+
+//==============================================================================
+const PointMass* SoftBodyNode::getNearestPointMass(
+    const Eigen::Vector3d& _point) const
+{
+  if(mPointMasses.empty())
+    return nullptr;
+
+  return mPointMasses[getNearestPointMassIndex(_point)];
+}
+
+//==============================================================================
+void SoftBodyNode::updatePointMassGrid() const
+{
+  PointMassGrid& grid = mPointMassGrid;
+  const std::size_t numPoints = mPointMasses.size();
+
+  Eigen::Vector3d lower = Eigen::Vector3d::Constant(
+        std::numeric_limits<double>::infinity());
+  Eigen::Vector3d upper = -lower;
+  for(const PointMass* pointMass : mPointMasses)
+  {
+    const Eigen::Vector3d& x = pointMass->getWorldPosition();
+    lower = lower.cwiseMin(x);
+    upper = upper.cwiseMax(x);
+  }
+
+  // Aim for about one PointMass per cell
+  const Eigen::Vector3d extent = upper - lower;
+  const double cellsPerAxis = std::ceil(std::cbrt(static_cast<double>(
+                                                    numPoints)));
+  grid.mOrigin = lower;
+  grid.mCellSize = std::max(extent.maxCoeff() / cellsPerAxis,
+                            std::numeric_limits<double>::min());
+  for(int i = 0; i < 3; ++i)
+    grid.mDims[i] = static_cast<int>(extent[i] / grid.mCellSize) + 1;
+
+  // Counting sort of the PointMasses by cell
+  const std::size_t numCells = static_cast<std::size_t>(grid.mDims.prod());
+  grid.mCellStart.assign(numCells + 1, 0u);
+  std::vector<std::size_t> cells(numPoints);
+  for(std::size_t i = 0; i < numPoints; ++i)
+  {
+    const Eigen::Vector3i c = ((mPointMasses[i]->getWorldPosition() - lower)
+                               / grid.mCellSize).cast<int>()
+                              .cwiseMin(grid.mDims - Eigen::Vector3i::Ones());
+    cells[i] = static_cast<std::size_t>(
+          (c[2] * grid.mDims[1] + c[1]) * grid.mDims[0] + c[0]);
+    ++grid.mCellStart[cells[i] + 1];
+  }
+
+  for(std::size_t c = 0; c < numCells; ++c)
+    grid.mCellStart[c + 1] += grid.mCellStart[c];
+
+  std::vector<std::size_t> next(grid.mCellStart.begin(),
+                                grid.mCellStart.end() - 1);
+  grid.mIndices.resize(numPoints);
+  grid.mPositions.resize(numPoints);
+  for(std::size_t i = 0; i < numPoints; ++i)
+  {
+    const std::size_t entry = next[cells[i]]++;
+    grid.mIndices[entry] = i;
+    grid.mPositions[entry] = mPointMasses[i]->getWorldPosition();
+  }
+
+  grid.mNeedsUpdate = false;
+}
+
+//==============================================================================
+std::size_t SoftBodyNode::getNearestPointMassIndex(
+    const Eigen::Vector3d& _point) const
+{
+  assert(!mPointMasses.empty());
+
+  // The notifier flags the grid whenever the PointMasses move, but the number
+  // of PointMasses can also change without them moving
+  if(mPointMassGrid.mNeedsUpdate
+     || mPointMassGrid.mIndices.size() != mPointMasses.size())
+  {
+    updatePointMassGrid();
+  }
+
+  const PointMassGrid& grid = mPointMassGrid;
+  const Eigen::Vector3d local = (_point - grid.mOrigin) / grid.mCellSize;
+  Eigen::Vector3i center;
+  for(int i = 0; i < 3; ++i)
+  {
+    center[i] = static_cast<int>(std::min(std::max(std::floor(local[i]), 0.0),
+                                          grid.mDims[i] - 1.0));
+  }
+
+  // Visit the cells in shells of growing Chebyshev distance r around the cell
+  // of _point. Every PointMass outside of the shells visited so far is at
+  // least r cells away, so the search stops as soon as the best candidate is
+  // closer than that.
+  std::size_t nearest = grid.mIndices[0];
+  double minDistance = std::numeric_limits<double>::infinity();
+  const int maxRadius = grid.mDims.maxCoeff();
+  for(int r = 0; r <= maxRadius; ++r)
+  {
+    const Eigen::Vector3i radius = Eigen::Vector3i::Constant(r);
+    const Eigen::Vector3i lo
+        = (center - radius).cwiseMax(Eigen::Vector3i::Zero());
+    const Eigen::Vector3i hi
+        = (center + radius).cwiseMin(grid.mDims - Eigen::Vector3i::Ones());
+
+    for(int z = lo[2]; z <= hi[2]; ++z)
+    {
+      for(int y = lo[1]; y <= hi[1]; ++y)
+      {
+        // Cells in the interior of the shell were visited by an earlier shell
+        const bool onShell = std::abs(z - center[2]) == r
+            || std::abs(y - center[1]) == r;
+        const int step = (onShell || r == 0) ? 1 : 2 * r;
+
+        for(int x = onShell ? lo[0] : center[0] - r; x <= hi[0]; x += step)
+        {
+          if(x < lo[0])
+            continue;
+
+          const std::size_t cell = static_cast<std::size_t>(
+                (z * grid.mDims[1] + y) * grid.mDims[0] + x);
+          for(std::size_t e = grid.mCellStart[cell];
+              e < grid.mCellStart[cell + 1]; ++e)
+          {
+            const double distance = (grid.mPositions[e] - _point).squaredNorm();
+            if(distance < minDistance)
+            {
+              minDistance = distance;
+              nearest = grid.mIndices[e];
+            }
+          }
+        }
+      }
+    }
+
+    const double reach = r * grid.mCellSize;
+    if(minDistance <= reach * reach)
+      break;
+  }
+
+  return nearest;
+}
+
 //==============================================================================
 void SoftBodyNode::connectPointMasses(std::size_t _idx1, std::size_t _idx2)
 {
@@ -530,13 +687,89 @@ void SoftBodyNode::checkArticulatedInertiaUpdate() const
     skel->updateArticulatedInertia(mTreeIndex);
 }
 
+//==============================================================================
+/// Minimum number of PointMasses handed to each thread. The threads are started
+/// and joined for every pass over the PointMasses, several times per step, and
+/// that costs on the order of 10 us per thread. A pass spends a few tens of ns
+/// per PointMass, so each thread needs a few thousand of them before the launch
+/// cost drops to about a tenth of its work.
+static const std::size_t MinPointMassesPerThread = 4096u;
+
+//==============================================================================
+/// Split [0, _count) into contiguous chunks and call _function(begin, end) on
+/// each of them, using up to _numThreads threads (0 means one per hardware
+/// core). _function must only write to the PointMasses in its own range.
+template <typename Function>
+static void forEachPointMassRange(std::size_t _count, std::size_t _numThreads,
+                                  Function _function)
+{
+  std::size_t numWorkers = _numThreads;
+  if(0u == numWorkers)
+    numWorkers = std::max(1u, std::thread::hardware_concurrency());
+  numWorkers = std::min(numWorkers, _count / MinPointMassesPerThread);
+
+  if(numWorkers <= 1u)
+  {
+    _function(static_cast<std::size_t>(0u), _count);
+    return;
+  }
+
+  const std::size_t chunk = (_count + numWorkers - 1) / numWorkers;
+  std::vector<std::thread> threads;
+  threads.reserve(numWorkers - 1);
+  for(std::size_t w=1; w < numWorkers; ++w)
+  {
+    const std::size_t begin = std::min(w * chunk, _count);
+    const std::size_t end = std::min(begin + chunk, _count);
+    threads.emplace_back(_function, begin, end);
+  }
+
+  _function(static_cast<std::size_t>(0u), std::min(chunk, _count));
+
+  for(std::thread& thread : threads)
+    thread.join();
+}
+
+//==============================================================================
+void SoftBodyNode::setNumPointMassThreads(std::size_t _numThreads)
+{
+  mNumPointMassThreads = _numThreads;
+}
+
+//==============================================================================
+std::size_t SoftBodyNode::getNumPointMassThreads() const
+{
+  return mNumPointMassThreads;
+}
+
+//==============================================================================
+// Dev's Note: The routines below that loop over the PointMasses do the same
+// work as the corresponding PointMass::update*() functions, but they read the
+// quantities of this SoftBodyNode once per call instead of once per PointMass,
+// and they read the PointMass caches directly instead of through the lazily
+// updating getters. That second point is what allows the loops to be split
+// across threads, so each routine first makes sure that the caches it reads
+// are up to date.
+
 //==============================================================================
 void SoftBodyNode::updateTransform()
 {
   BodyNode::updateTransform();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updateTransform();
+  const Eigen::Isometry3d& W = getWorldTransform();
+  const auto& states = mAspectState.mPointStates;
+  const auto& props = mAspectProperties.mPointProps;
+  forEachPointMassRange(mPointMasses.size(), mNumPointMassThreads,
+                        [&](std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      PointMass* pointMass = mPointMasses[i];
+      pointMass->mX = states[i].mPositions + props[i].mX0;
+      pointMass->mW = W.translation() + W.linear() * pointMass->mX;
+      assert(!math::isNan(pointMass->mW));
+    }
+  });
 
   mNotifier->clearTransformNotice();
 }
@@ -546,8 +779,23 @@ void SoftBodyNode::updateVelocity()
 {
   BodyNode::updateVelocity();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updateVelocity();
+  if(mNotifier->needsTransformUpdate())
+    updateTransform();
+
+  const Eigen::Vector6d& V = getSpatialVelocity();
+  const auto& states = mAspectState.mPointStates;
+  forEachPointMassRange(mPointMasses.size(), mNumPointMassThreads,
+                        [&](std::size_t begin, std::size_t end)
+  {
+    // v = w(parent) x mX + v(parent) + dq
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      PointMass* pointMass = mPointMasses[i];
+      pointMass->mV = V.head<3>().cross(pointMass->mX) + V.tail<3>()
+          + states[i].mVelocities;
+      assert(!math::isNan(pointMass->mV));
+    }
+  });
 
   mNotifier->clearVelocityNotice();
 }
@@ -557,8 +805,18 @@ void SoftBodyNode::updatePartialAcceleration() const
 {
   BodyNode::updatePartialAcceleration();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updatePartialAcceleration();
+  const Eigen::Vector3d w = getSpatialVelocity().head<3>();
+  const auto& states = mAspectState.mPointStates;
+  forEachPointMassRange(mPointMasses.size(), mNumPointMassThreads,
+                        [&](std::size_t begin, std::size_t end)
+  {
+    // eta = w(parent) x dq
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      mPointMasses[i]->mEta = w.cross(states[i].mVelocities);
+      assert(!math::isNan(mPointMasses[i]->mEta));
+    }
+  });
 
   mNotifier->clearPartialAccelerationNotice();
 }
@@ -656,13 +914,75 @@ void SoftBodyNode::updateJointImpulseFD()
   BodyNode::updateJointImpulseFD();
 }
 
+//==============================================================================
+/// Accumulates the weighted moments of a set of PointMass positions so that
+/// their contribution to an articulated inertia can be added in one go
+struct PointMassMoments
+{
+  double mSum = 0.0;
+  Eigen::Vector3d mFirst = Eigen::Vector3d::Zero();
+  Eigen::Matrix3d mSecond = Eigen::Matrix3d::Zero();
+
+  void add(const Eigen::Vector3d& _x, double _weight)
+  {
+    mSum += _weight;
+    mFirst.noalias() += _weight * _x;
+    mSecond.noalias() += (_weight * _x) * _x.transpose();
+  }
+
+  /// Adds sum_i w_i * [-[x_i]^2, [x_i]; -[x_i], I] to _AI
+  void addTo(Eigen::Matrix6d& _AI) const
+  {
+    const Eigen::Matrix3d skew = math::makeSkewSymmetric(mFirst);
+
+    _AI.topLeftCorner<3, 3>() -= mSecond;
+    _AI.topLeftCorner<3, 3>().diagonal().array() += mSecond.trace();
+    _AI.topRightCorner<3, 3>() += skew;
+    _AI.bottomLeftCorner<3, 3>() -= skew;
+    _AI.bottomRightCorner<3, 3>().diagonal().array() += mSum;
+  }
+};
+
 //==============================================================================
 void SoftBodyNode::updateArtInertia(double _timeStep) const
 {
   const Eigen::Matrix6d& mI =
       BodyNode::mAspectProperties.mInertia.getSpatialTensor();
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateArtInertiaFD(_timeStep);
+
+  const double kv = getVertexSpringStiffness();
+  const double ke = getEdgeSpringStiffness();
+  const double kd = getDampingCoefficient();
+  const auto& props = mAspectProperties.mPointProps;
+
+  // The edge springs pulling a PointMass back toward its neighbors act like an
+  // additional vertex spring of stiffness nN*ke on it, which is treated
+  // implicitly along with kv when the Skeleton asks for implicit Euler.
+  const ConstSkeletonPtr skel = getSkeleton();
+  const bool implicitEdges = skel && skel->isUsingImplicitEuler();
+
+  forEachPointMassRange(mPointMasses.size(), mNumPointMassThreads,
+                        [&](std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      PointMass* pointMass = mPointMasses[i];
+      const double mass = props[i].mMass;
+
+      double stiffness = kv;
+      if (implicitEdges)
+        stiffness += props[i].mConnectedPointMassIndices.size() * ke;
+
+      // Cache data: PsiK and Psi
+      pointMass->mPsi = 1.0 / mass;
+      pointMass->mImplicitPsi
+          = 1.0 / (mass + _timeStep * kd + _timeStep * _timeStep * stiffness);
+      assert(!math::isNan(pointMass->mImplicitPsi));
+
+      // Cache data: Pi
+      pointMass->mPi = mass - mass * mass * pointMass->mPsi;
+      pointMass->mImplicitPi = mass - mass * mass * pointMass->mImplicitPsi;
+    }
+  });
 
   assert(mParentJoint != nullptr);
 
@@ -680,13 +1000,19 @@ void SoftBodyNode::updateArtInertia(double _timeStep) const
                                              child->mArtInertiaImplicit);
   }
 
-  //
+  // Every PointMass adds Pi * [-[x]^2, [x]; -[x], I] to the articulated
+  // inertia. Since [x]^2 = x*x^T - (x^T*x)*I, the sum over all the PointMasses
+  // only needs the first and second moments of their positions.
+  PointMassMoments moments;
+  PointMassMoments implicitMoments;
   for (const auto& pointMass : mPointMasses)
   {
-    _addPiToArtInertia(pointMass->getLocalPosition(), pointMass->mPi);
-    _addPiToArtInertiaImplicit(pointMass->getLocalPosition(),
-                               pointMass->mImplicitPi);
+    const Eigen::Vector3d& x = pointMass->getLocalPosition();
+    moments.add(x, pointMass->mPi);
+    implicitMoments.add(x, pointMass->mImplicitPi);
   }
+  moments.addTo(mArtInertia);
+  implicitMoments.addTo(mArtInertiaImplicit);
 
   // Verification
   assert(!math::isNan(mArtInertia));
@@ -707,8 +1033,7 @@ void SoftBodyNode::updateBiasForce(const Eigen::Vector3d& _gravity,
 {
   const Eigen::Matrix6d& mI =
       BodyNode::mAspectProperties.mInertia.getSpatialTensor();
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateBiasForceFD(_timeStep, _gravity);
+  updatePointMassBiasForces(_gravity, _timeStep);
 
   // Gravity force
   if (BodyNode::mAspectProperties.mGravityMode == true)
@@ -735,11 +1060,15 @@ void SoftBodyNode::updateBiasForce(const Eigen::Vector3d& _gravity,
   }
 
   //
+  Eigen::Vector3d moment = Eigen::Vector3d::Zero();
+  Eigen::Vector3d force = Eigen::Vector3d::Zero();
   for (const auto& pointMass : mPointMasses)
   {
-    mBiasForce.head<3>() += pointMass->getLocalPosition().cross(pointMass->mBeta);
-    mBiasForce.tail<3>() += pointMass->mBeta;
+    moment.noalias() += pointMass->mX.cross(pointMass->mBeta);
+    force += pointMass->mBeta;
   }
+  mBiasForce.head<3>() += moment;
+  mBiasForce.tail<3>() += force;
 
   // Verifycation
   assert(!math::isNan(mBiasForce));
@@ -756,9 +1085,33 @@ void SoftBodyNode::updateAccelerationFD()
 {
   BodyNode::updateAccelerationFD();
 
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateAccelerationFD();
+  if(mNotifier->needsPartialAccelerationUpdate())
+    updatePartialAcceleration();
+  checkArticulatedInertiaUpdate();
+
+  const Eigen::Vector6d& A = getSpatialAcceleration();
+  auto& states = mAspectState.mPointStates;
+  const auto& props = mAspectProperties.mPointProps;
+  forEachPointMassRange(mPointMasses.size(), mNumPointMassThreads,
+                        [&](std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      PointMass* pointMass = mPointMasses[i];
+
+      // ddq = imp_psi*(alpha - m*(dw(parent) x mX + dv(parent))
+      const Eigen::Vector3d a = A.head<3>().cross(pointMass->mX) + A.tail<3>();
+      states[i].mAccelerations = pointMass->mImplicitPsi
+          * (pointMass->mAlpha - props[i].mMass * a);
+      assert(!math::isNan(states[i].mAccelerations));
 
+      // dv = dw(parent) x mX + dv(parent) + eata + ddq
+      pointMass->mA = a + pointMass->mEta + states[i].mAccelerations;
+    }
+  });
+
+  // Setting the accelerations of the PointMasses would dirty this notice, but
+  // the accelerations that depend on them were just computed as well.
   mNotifier->clearAccelerationNotice();
 }
 
@@ -767,8 +1120,81 @@ void SoftBodyNode::updateTransmittedForceFD()
 {
   BodyNode::updateTransmittedForceFD();
 
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateTransmittedForce();
+  if(mNotifier->needsAccelerationUpdate())
+    updateAccelerationID();
+
+  const auto& props = mAspectProperties.mPointProps;
+  forEachPointMassRange(mPointMasses.size(), mNumPointMassThreads,
+                        [&](std::size_t begin, std::size_t end)
+  {
+    // f = m*dv + B
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      PointMass* pointMass = mPointMasses[i];
+      pointMass->mF = pointMass->mB;
+      pointMass->mF.noalias() += props[i].mMass * pointMass->mA;
+    }
+  });
+}
+
+//==============================================================================
+void SoftBodyNode::updatePointMassBiasForces(const Eigen::Vector3d& _gravity,
+                                             double _timeStep)
+{
+  if(mNotifier->needsVelocityUpdate())
+    updateVelocity();
+  if(mNotifier->needsPartialAccelerationUpdate())
+    updatePartialAcceleration();
+  checkArticulatedInertiaUpdate();
+
+  const Eigen::Vector3d w = getSpatialVelocity().head<3>();
+  const bool gravityMode = getGravityMode();
+  const Eigen::Vector3d localGravity
+      = getWorldTransform().linear().transpose() * _gravity;
+  const double kv = getVertexSpringStiffness();
+  const double ke = getEdgeSpringStiffness();
+  const double kd = getDampingCoefficient();
+  const auto& states = mAspectState.mPointStates;
+  const auto& props = mAspectProperties.mPointProps;
+
+  forEachPointMassRange(mPointMasses.size(), mNumPointMassThreads,
+                        [&](std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      PointMass* pointMass = mPointMasses[i];
+      const PointMass::State& state = states[i];
+      const std::vector<std::size_t>& connections
+          = props[i].mConnectedPointMassIndices;
+      const double mass = props[i].mMass;
+
+      // B = w(parent) x m*v - fext - fgravity
+      pointMass->mB = w.cross(mass * pointMass->mV) - pointMass->mFext;
+      if(gravityMode)
+        pointMass->mB -= mass * localGravity;
+      assert(!math::isNan(pointMass->mB));
+
+      // Cache data: alpha
+      const double k = kv + static_cast<double>(connections.size()) * ke;
+      pointMass->mAlpha = state.mForces
+          - k * state.mPositions
+          - (_timeStep * k + kd) * state.mVelocities
+          - mass * pointMass->mEta
+          - pointMass->mB;
+      for(const std::size_t j : connections)
+      {
+        pointMass->mAlpha
+            += ke * (states[j].mPositions + _timeStep * states[j].mVelocities);
+      }
+      assert(!math::isNan(pointMass->mAlpha));
+
+      // Cache data: beta
+      pointMass->mBeta = pointMass->mB;
+      pointMass->mBeta.noalias() += mass * (pointMass->mEta
+          + pointMass->mImplicitPsi * pointMass->mAlpha);
+      assert(!math::isNan(pointMass->mBeta));
+    }
+  });
 }
 
 //==============================================================================
@@ -913,24 +1339,7 @@ void SoftBodyNode::aggregateAugMassMatrix(Eigen::MatrixXd& _MCol, std::size_t _c
   }
   assert(!math::isNan(mM_F));
 
-  std::size_t dof = mParentJoint->getNumDofs();
-  if (dof > 0)
-  {
-    Eigen::MatrixXd K = Eigen::MatrixXd::Zero(dof, dof);
-    Eigen::MatrixXd D = Eigen::MatrixXd::Zero(dof, dof);
-    for (std::size_t i = 0; i < dof; ++i)
-    {
-      K(i, i) = mParentJoint->getSpringStiffness(i);
-      D(i, i) = mParentJoint->getDampingCoefficient(i);
-    }
-    int iStart = mParentJoint->getIndexInTree(0);
-
-    // TODO(JS): Not recommended to use Joint::getAccelerations
-    _MCol.block(iStart, _col, dof, 1).noalias()
-        = mParentJoint->getRelativeJacobian().transpose() * mM_F
-          + D * (_timeStep * mParentJoint->getAccelerations())
-          + K * (_timeStep * _timeStep * mParentJoint->getAccelerations());
-  }
+  mParentJoint->getAugMassMatrixSegment(_MCol, _col, mM_F, _timeStep);
 }
 
 //==============================================================================
@@ -1104,13 +1513,7 @@ void SoftBodyNode::aggregateGravityForceVector(Eigen::VectorXd& _g,
     mG_F.tail<3>() += (*it)->mG_F;
   }
 
-  int nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd g = -(mParentJoint->getRelativeJacobian().transpose() * mG_F);
-    int iStart = mParentJoint->getIndexInTree(0);
-    _g.segment(iStart, nGenCoords) = g;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_g, -mG_F);
 }
 
 //==============================================================================
@@ -1190,14 +1593,7 @@ void SoftBodyNode::aggregateExternalForces(Eigen::VectorXd& _Fext)
     mFext_F.tail<3>() += (*it)->mFext;
   }
 
-  int nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd Fext
-        = mParentJoint->getRelativeJacobian().transpose() * mFext_F;
-    int iStart = mParentJoint->getIndexInTree(0);
-    _Fext.segment(iStart, nGenCoords) = Fext;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_Fext, mFext_F);
 }
 
 //==============================================================================
@@ -1218,35 +1614,6 @@ void SoftBodyNode::clearInternalForces()
     mPointMasses[i]->resetForces();
 }
 
-//==============================================================================
-void SoftBodyNode::_addPiToArtInertia(const Eigen::Vector3d& _p, double _Pi) const
-{
-  Eigen::Matrix3d tmp = math::makeSkewSymmetric(_p);
-
-  mArtInertia.topLeftCorner<3, 3>()    -= _Pi * tmp * tmp;
-  mArtInertia.topRightCorner<3, 3>()   += _Pi * tmp;
-  mArtInertia.bottomLeftCorner<3, 3>() -= _Pi * tmp;
-
-  mArtInertia(3, 3) += _Pi;
-  mArtInertia(4, 4) += _Pi;
-  mArtInertia(5, 5) += _Pi;
-}
-
-//==============================================================================
-void SoftBodyNode::_addPiToArtInertiaImplicit(const Eigen::Vector3d& _p,
-                                              double _ImplicitPi) const
-{
-  Eigen::Matrix3d tmp = math::makeSkewSymmetric(_p);
-
-  mArtInertiaImplicit.topLeftCorner<3, 3>()    -= _ImplicitPi * tmp * tmp;
-  mArtInertiaImplicit.topRightCorner<3, 3>()   += _ImplicitPi * tmp;
-  mArtInertiaImplicit.bottomLeftCorner<3, 3>() -= _ImplicitPi * tmp;
-
-  mArtInertiaImplicit(3, 3) += _ImplicitPi;
-  mArtInertiaImplicit(4, 4) += _ImplicitPi;
-  mArtInertiaImplicit(5, 5) += _ImplicitPi;
-}
-
 //==============================================================================
 void SoftBodyNode::updateInertiaWithPointMass()
 {
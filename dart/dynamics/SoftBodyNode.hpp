@@ -136,6 +136,16 @@ public:
   /// Return all the point masses in this SoftBodyNode
   const std::vector<PointMass*>& getPointMasses() const;
 
+  /// Get the PointMass whose world position is closest to _point, or a nullptr
+  /// if this SoftBodyNode has no PointMasses. The lookup goes through a uniform
+  /// grid over the world positions of the PointMasses, which is rebuilt the
+  /// first time it is needed after they move, so each query takes O(1)
+  /// expected time.
+  PointMass* getNearestPointMass(const Eigen::Vector3d& _point);
+
+  /// Const version of getNearestPointMass()
+  const PointMass* getNearestPointMass(const Eigen::Vector3d& _point) const;
+
   /// \brief
   void connectPointMasses(std::size_t _idx1, std::size_t _idx2);
 
@@ -148,6 +158,17 @@ public:
   /// \brief
   std::size_t getNumFaces() const;
 
+  /// Set the number of threads that may be used to update the PointMasses of
+  /// this SoftBodyNode during the recursive dynamics routines. Pass 0 to use
+  /// one thread per hardware core. The threads are started for each pass over
+  /// the PointMasses, so every thread gets at least 4096 PointMasses and
+  /// smaller meshes are always updated on the calling thread. The default is 1.
+  void setNumPointMassThreads(std::size_t _numThreads);
+
+  /// Get the number of threads that may be used to update the PointMasses of
+  /// this SoftBodyNode
+  std::size_t getNumPointMassThreads() const;
+
   // Documentation inherited.
   void clearConstraintImpulse() override;
 
@@ -201,6 +222,11 @@ protected:
   void updateBiasForce(const Eigen::Vector3d& _gravity,
                        double _timeStep) override;
 
+  /// Update the bias forces of the PointMasses, which are the PointMass part
+  /// of updateBiasForce()
+  void updatePointMassBiasForces(const Eigen::Vector3d& _gravity,
+                                 double _timeStep);
+
   // Documentation inherited.
   void updateBiasImpulse() override;
 
@@ -314,14 +340,47 @@ protected:
   ///
   math::Inertia mArtInertiaImplicit2;
 
-private:
-  /// \brief
-  void _addPiToArtInertia(const Eigen::Vector3d& _p, double _Pi) const;
+  /// Number of threads that may be used to update the PointMasses
+  std::size_t mNumPointMassThreads;
 
-  /// \brief
-  void _addPiToArtInertiaImplicit(const Eigen::Vector3d& _p,
-                                  double _ImplicitPi) const;
+  /// Uniform grid over the world positions of the PointMasses, used by
+  /// getNearestPointMass(). The PointMasses of each cell are stored
+  /// contiguously, in the compressed row layout given by mCellStart.
+  struct PointMassGrid
+  {
+    /// Lower corner of the grid
+    Eigen::Vector3d mOrigin;
+
+    /// Edge length of the cubic cells
+    double mCellSize;
 
+    /// Number of cells along each axis
+    Eigen::Vector3i mDims;
+
+    /// Cell c holds the entries [mCellStart[c], mCellStart[c+1])
+    std::vector<std::size_t> mCellStart;
+
+    /// Index of the PointMass of each entry
+    std::vector<std::size_t> mIndices;
+
+    /// World position of the PointMass of each entry
+    std::vector<Eigen::Vector3d> mPositions;
+
+    /// True when the PointMasses have moved since the grid was built
+    bool mNeedsUpdate = true;
+  };
+
+  /// Cache for getNearestPointMass()
+  mutable PointMassGrid mPointMassGrid;
+
+  /// Rebuild mPointMassGrid from the current PointMass positions
+  void updatePointMassGrid() const;
+
+  /// Index of the PointMass closest to _point. Must not be called when there
+  /// are no PointMasses.
+  std::size_t getNearestPointMassIndex(const Eigen::Vector3d& _point) const;
+
+private:
   ///
   void updateInertiaWithPointMass();
 };
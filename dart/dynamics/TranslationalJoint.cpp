@@ -115,12 +115,19 @@ void TranslationalJoint::updateDegreeOfFreedomNames()
     mDofs[2]->setName(Joint::mAspectProperties.mName + "_z", false);
 }
 
+//==============================================================================
+Eigen::Isometry3d TranslationalJoint::computeRelativeTransformStatic(
+    const Eigen::Vector3d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * Eigen::Translation3d(_positions)
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void TranslationalJoint::updateRelativeTransform() const
 {
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::Translation3d(getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
@@ -218,14 +218,20 @@ void TranslationalJoint2D::updateDegreeOfFreedomNames()
     mDofs[1]->setName(Joint::mAspectProperties.mName + "_2", false);
 }
 
+//==============================================================================
+Eigen::Isometry3d TranslationalJoint2D::computeRelativeTransformStatic(
+    const Eigen::Vector2d& positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * Eigen::Translation3d(
+               mAspectProperties.getTranslationalAxes() * positions)
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void TranslationalJoint2D::updateRelativeTransform() const
 {
-  const Eigen::Vector2d& positions = getPositionsStatic();
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::Translation3d(
-             mAspectProperties.getTranslationalAxes() * positions)
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
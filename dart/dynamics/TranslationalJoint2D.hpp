@@ -128,6 +128,10 @@ public:
   Eigen::Matrix<double, 6, 2> getRelativeJacobianStatic(
       const Eigen::Vector2d& positions) const override;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Eigen::Vector2d& positions) const override;
+
 protected:
   /// Constructor called by Skeleton class
   explicit TranslationalJoint2D(const Properties& properties);
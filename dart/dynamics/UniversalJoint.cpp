@@ -185,14 +185,21 @@ void UniversalJoint::updateDegreeOfFreedomNames()
     mDofs[1]->setName(Joint::mAspectProperties.mName + "_2", false);
 }
 
+//==============================================================================
+Eigen::Isometry3d UniversalJoint::computeRelativeTransformStatic(
+    const Eigen::Vector2d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+         * Eigen::AngleAxisd(_positions[0], getAxis1())
+         * Eigen::AngleAxisd(_positions[1], getAxis2())
+         * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void UniversalJoint::updateRelativeTransform() const
 {
-  const Eigen::Vector2d& positions = getPositionsStatic();
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::AngleAxisd(positions[0], getAxis1())
-       * Eigen::AngleAxisd(positions[1], getAxis2())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
+
   assert(math::verifyTransform(mT));
 }
 
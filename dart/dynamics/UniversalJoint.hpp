@@ -101,6 +101,10 @@ public:
   Eigen::Matrix<double, 6, 2> getRelativeJacobianStatic(
       const Eigen::Vector2d& _positions) const override;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Eigen::Vector2d& _positions) const override;
+
 protected:
 
   /// Constructor called by Skeleton class
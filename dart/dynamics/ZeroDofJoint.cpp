@@ -685,6 +685,20 @@ Eigen::Vector6d ZeroDofJoint::getBodyConstraintWrench() const
   return mChildBodyNode->getBodyForce();
 }
 
+//==============================================================================
+Eigen::Isometry3d ZeroDofJoint::computeRelativeTransform(
+    const Eigen::VectorXd& /*_positions*/) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
+//==============================================================================
+bool ZeroDofJoint::canComputeRelativeTransform() const
+{
+  return true;
+}
+
 //==============================================================================
 const math::Jacobian ZeroDofJoint::getRelativeJacobian() const
 {
@@ -919,5 +933,31 @@ Eigen::VectorXd ZeroDofJoint::getSpatialToGeneralized(
   return Eigen::VectorXd::Zero(0);
 }
 
+//==============================================================================
+void ZeroDofJoint::getSpatialToGeneralizedSegment(
+    Eigen::VectorXd& /*_generalized*/, const Eigen::Vector6d& /*_spatial*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ZeroDofJoint::getMassMatrixSegment(
+    Eigen::MatrixXd& /*_massMat*/,
+    const std::size_t /*_col*/,
+    const Eigen::Vector6d& /*_spatialForce*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ZeroDofJoint::getAugMassMatrixSegment(
+    Eigen::MatrixXd& /*_augMassMat*/,
+    const std::size_t /*_col*/,
+    const Eigen::Vector6d& /*_spatialForce*/,
+    double /*_timeStep*/)
+{
+  // Do nothing
+}
+
 }  // namespace dynamics
 }  // namespace dart
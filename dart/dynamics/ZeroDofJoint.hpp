@@ -409,6 +409,13 @@ protected:
   /// \{ \name Recursive dynamics routines
   //----------------------------------------------------------------------------
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransform(
+      const Eigen::VectorXd& _positions) const override;
+
+  // Documentation inherited
+  bool canComputeRelativeTransform() const override;
+
   // Documentation inherited
   const math::Jacobian getRelativeJacobian() const override;
 
@@ -548,6 +555,21 @@ protected:
   Eigen::VectorXd getSpatialToGeneralized(
       const Eigen::Vector6d& _spatial) override;
 
+  // Documentation inherited
+  void getSpatialToGeneralizedSegment(
+      Eigen::VectorXd& _generalized, const Eigen::Vector6d& _spatial) override;
+
+  // Documentation inherited
+  void getMassMatrixSegment(Eigen::MatrixXd& _massMat,
+                            const std::size_t _col,
+                            const Eigen::Vector6d& _spatialForce) override;
+
+  // Documentation inherited
+  void getAugMassMatrixSegment(Eigen::MatrixXd& _augMassMat,
+                               const std::size_t _col,
+                               const Eigen::Vector6d& _spatialForce,
+                               double _timeStep) override;
+
   /// \}
 
 private:
@@ -1552,6 +1552,27 @@ double GenericJoint<ConfigSpaceT>::computePotentialEnergy() const
   return pe;
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+Eigen::Isometry3d GenericJoint<ConfigSpaceT>::computeRelativeTransform(
+    const Eigen::VectorXd& positions) const
+{
+  if (static_cast<std::size_t>(positions.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(computeRelativeTransform, positions);
+    return Eigen::Isometry3d::Identity();
+  }
+
+  return computeRelativeTransformStatic(positions);
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+bool GenericJoint<ConfigSpaceT>::canComputeRelativeTransform() const
+{
+  return true;
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 const math::Jacobian
@@ -1776,9 +1797,9 @@ void GenericJoint<ConfigSpaceT>::addChildArtInertiaToDynamic(
     const Eigen::Matrix6d& childArtInertia)
 {
   // Child body's articulated inertia
-  JacobianMatrix AIS = childArtInertia * getRelativeJacobianStatic();
-  Eigen::Matrix6d PI = childArtInertia;
-  PI.noalias() -= AIS * mInvProjArtInertia * AIS.transpose();
+  Eigen::Matrix6d PI;
+  Kernels::complementInertia(
+      PI, childArtInertia, getRelativeJacobianStatic(), mInvProjArtInertia);
   assert(!math::isNan(PI));
 
   // Add child body's articulated inertia to parent body's articulated inertia.
@@ -1832,9 +1853,10 @@ void GenericJoint<ConfigSpaceT>::addChildArtInertiaImplicitToDynamic(
     const Eigen::Matrix6d& childArtInertia)
 {
   // Child body's articulated inertia
-  JacobianMatrix AIS = childArtInertia * getRelativeJacobianStatic();
-  Eigen::Matrix6d PI = childArtInertia;
-  PI.noalias() -= AIS * mInvProjArtInertiaImplicit * AIS.transpose();
+  Eigen::Matrix6d PI;
+  Kernels::complementInertia(
+      PI, childArtInertia, getRelativeJacobianStatic(),
+      mInvProjArtInertiaImplicit);
   assert(!math::isNan(PI));
 
   // Add child body's articulated inertia to parent body's articulated inertia.
@@ -1884,8 +1906,8 @@ void GenericJoint<ConfigSpaceT>::updateInvProjArtInertiaDynamic(
     const Eigen::Matrix6d& artInertia)
 {
   // Projected articulated inertia
-  const JacobianMatrix& Jacobian = getRelativeJacobianStatic();
-  const Matrix projAI = Jacobian.transpose() * artInertia * Jacobian;
+  const Matrix projAI
+      = Kernels::projectInertia(artInertia, getRelativeJacobianStatic());
 
   // Inversion of projected articulated inertia
   mInvProjArtInertia = math::inverse<ConfigSpaceT>(projAI);
@@ -1934,8 +1956,8 @@ void GenericJoint<ConfigSpaceT>::updateInvProjArtInertiaImplicitDynamic(
     double timeStep)
 {
   // Projected articulated inertia
-  const JacobianMatrix& Jacobian = getRelativeJacobianStatic();
-  Matrix projAI = Jacobian.transpose() * artInertia * Jacobian;
+  Matrix projAI
+      = Kernels::projectInertia(artInertia, getRelativeJacobianStatic());
 
   // Add additional inertia for implicit damping and spring force
   projAI +=
@@ -1998,12 +2020,11 @@ void GenericJoint<ConfigSpaceT>::addChildBiasForceToDynamic(
     const Eigen::Vector6d& childPartialAcc)
 {
   // Compute beta
-  const Eigen::Vector6d beta
-      = childBiasForce
-        + childArtInertia
-          * (childPartialAcc
-             + getRelativeJacobianStatic() * getInvProjArtInertiaImplicit()
-               *mTotalForce);
+  const Vector invProjForce = getInvProjArtInertiaImplicit() * mTotalForce;
+  Eigen::Vector6d beta = childBiasForce;
+  beta.noalias() += childArtInertia * childPartialAcc;
+  beta += Kernels::multiplyInertia(
+      childArtInertia, getRelativeJacobianStatic(), invProjForce);
 
   //    Eigen::Vector6d beta
   //        = _childBiasForce;
@@ -2082,10 +2103,11 @@ void GenericJoint<ConfigSpaceT>::addChildBiasImpulseToDynamic(
     const Eigen::Vector6d& childBiasImpulse)
 {
   // Compute beta
+  const Vector invProjImpulse = getInvProjArtInertia() * mTotalImpulse;
   const Eigen::Vector6d beta
       = childBiasImpulse
-        + childArtInertia*getRelativeJacobianStatic()
-          *getInvProjArtInertia()*mTotalImpulse;
+        + Kernels::multiplyInertia(
+            childArtInertia, getRelativeJacobianStatic(), invProjImpulse);
 
   // Verification
   assert(!math::isNan(beta));
@@ -2260,8 +2282,9 @@ void GenericJoint<ConfigSpaceT>::updateAccelerationDynamic(
 {
   //
   setAccelerationsStatic( getInvProjArtInertiaImplicit()
-        * (mTotalForce - getRelativeJacobianStatic().transpose()
-           *artInertia*math::AdInvT(this->getRelativeTransform(), spatialAcc)) );
+        * (mTotalForce - Kernels::projectForce(
+             artInertia, getRelativeJacobianStatic(),
+             math::AdInvT(this->getRelativeTransform(), spatialAcc))) );
 
   // Verification
   assert(!math::isNan(getAccelerationsStatic()));
@@ -2309,8 +2332,9 @@ void GenericJoint<ConfigSpaceT>::updateVelocityChangeDynamic(
   //
   mVelocityChanges
       = getInvProjArtInertia()
-      * (mTotalImpulse - getRelativeJacobianStatic().transpose()
-         *artInertia*math::AdInvT(this->getRelativeTransform(), velocityChange));
+      * (mTotalImpulse - Kernels::projectForce(
+           artInertia, getRelativeJacobianStatic(),
+           math::AdInvT(this->getRelativeTransform(), velocityChange)));
 
   // Verification
   assert(!math::isNan(mVelocityChanges));
@@ -2464,8 +2488,9 @@ void GenericJoint<ConfigSpaceT>::addChildBiasForceForInvMassMatrix(
 {
   // Compute beta
   Eigen::Vector6d beta = childBiasForce;
-  beta.noalias() += childArtInertia * getRelativeJacobianStatic()
-                    * getInvProjArtInertia() * mInvM_a;
+  beta += Kernels::multiplyInertia(
+      childArtInertia, getRelativeJacobianStatic(),
+      getInvProjArtInertia() * mInvM_a);
 
   // Verification
   assert(!math::isNan(beta));
@@ -2484,8 +2509,9 @@ void GenericJoint<ConfigSpaceT>::addChildBiasForceForInvAugMassMatrix(
 {
   // Compute beta
   Eigen::Vector6d beta = childBiasForce;
-  beta.noalias() += childArtInertia * getRelativeJacobianStatic()
-                    * getInvProjArtInertiaImplicit() * mInvM_a;
+  beta += Kernels::multiplyInertia(
+      childArtInertia, getRelativeJacobianStatic(),
+      getInvProjArtInertiaImplicit() * mInvM_a);
 
   // Verification
   assert(!math::isNan(beta));
@@ -2516,8 +2542,9 @@ void GenericJoint<ConfigSpaceT>::getInvMassMatrixSegment(
   //
   mInvMassMatrixSegment
       = getInvProjArtInertia()
-      * (mInvM_a - getRelativeJacobianStatic().transpose()
-         * artInertia * math::AdInvT(this->getRelativeTransform(), spatialAcc));
+      * (mInvM_a - Kernels::projectForce(
+           artInertia, getRelativeJacobianStatic(),
+           math::AdInvT(this->getRelativeTransform(), spatialAcc)));
 
   // Verification
   assert(!math::isNan(mInvMassMatrixSegment));
@@ -2540,8 +2567,9 @@ void GenericJoint<ConfigSpaceT>::getInvAugMassMatrixSegment(
   //
   mInvMassMatrixSegment
       = getInvProjArtInertiaImplicit()
-      * (mInvM_a - getRelativeJacobianStatic().transpose()
-         * artInertia * math::AdInvT(this->getRelativeTransform(), spatialAcc));
+      * (mInvM_a - Kernels::projectForce(
+           artInertia, getRelativeJacobianStatic(),
+           math::AdInvT(this->getRelativeTransform(), spatialAcc)));
 
   // Verification
   assert(!math::isNan(mInvMassMatrixSegment));
@@ -2570,6 +2598,44 @@ Eigen::VectorXd GenericJoint<ConfigSpaceT>::getSpatialToGeneralized(
   return getRelativeJacobianStatic().transpose() * spatial;
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getSpatialToGeneralizedSegment(
+    Eigen::VectorXd& generalized, const Eigen::Vector6d& spatial)
+{
+  generalized.segment<NumDofs>(mDofs[0]->mIndexInTree).noalias()
+      = getRelativeJacobianStatic().transpose() * spatial;
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getMassMatrixSegment(
+    Eigen::MatrixXd& massMat,
+    const std::size_t col,
+    const Eigen::Vector6d& spatialForce)
+{
+  massMat.block<NumDofs, 1>(mDofs[0]->mIndexInTree, col).noalias()
+      = getRelativeJacobianStatic().transpose() * spatialForce;
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getAugMassMatrixSegment(
+    Eigen::MatrixXd& augMassMat,
+    const std::size_t col,
+    const Eigen::Vector6d& spatialForce,
+    double timeStep)
+{
+  // Implicit joint damping and spring terms
+  const Vector implicitForce
+      = (timeStep * Base::mAspectProperties.mDampingCoefficients
+         + timeStep * timeStep * Base::mAspectProperties.mSpringStiffnesses)
+        .cwiseProduct(getAccelerationsStatic());
+
+  augMassMat.block<NumDofs, 1>(mDofs[0]->mIndexInTree, col)
+      = getRelativeJacobianStatic().transpose() * spatialForce + implicitForce;
+}
+
 } // namespace dynamics
 } // namespace dart
 
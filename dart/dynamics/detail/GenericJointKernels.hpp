@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_DETAIL_GENERICJOINTKERNELS_HPP_
+#define DART_DYNAMICS_DETAIL_GENERICJOINTKERNELS_HPP_
+
+#include <Eigen/Dense>
+
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+namespace dynamics {
+namespace detail {
+
+//==============================================================================
+/// Fixed-size kernels for the articulated body recursions of GenericJoint.
+///
+/// The kernel is selected at compile time from the number of DOFs of the
+/// configuration space. The primary template works for any number of DOFs and
+/// orders its products so that no 6x6 by 6xN product is formed when a
+/// matrix-vector product is enough.
+template <int NumDofs>
+struct GenericJointKernels
+{
+  using JacobianMatrix = Eigen::Matrix<double, 6, NumDofs>;
+  using Matrix = Eigen::Matrix<double, NumDofs, NumDofs>;
+  using Vector = Eigen::Matrix<double, NumDofs, 1>;
+
+  /// Return AI * J
+  static JacobianMatrix multiplyInertia(
+      const Eigen::Matrix6d& AI, const JacobianMatrix& J)
+  {
+    return AI * J;
+  }
+
+  /// Return J^T * AI * J
+  static Matrix projectInertia(
+      const Eigen::Matrix6d& AI, const JacobianMatrix& J)
+  {
+    const JacobianMatrix AIS = AI * J;
+    return J.transpose() * AIS;
+  }
+
+  /// Set PI to AI - AI * J * invProjAI * J^T * AI
+  static void complementInertia(
+      Eigen::Matrix6d& PI,
+      const Eigen::Matrix6d& AI,
+      const JacobianMatrix& J,
+      const Matrix& invProjAI)
+  {
+    const JacobianMatrix AIS = AI * J;
+    const JacobianMatrix AISInv = AIS * invProjAI;
+    PI = AI;
+    PI.noalias() -= AISInv * AIS.transpose();
+  }
+
+  /// Return J^T * AI * v
+  static Vector projectForce(
+      const Eigen::Matrix6d& AI,
+      const JacobianMatrix& J,
+      const Eigen::Vector6d& v)
+  {
+    const Eigen::Vector6d AIv = AI * v;
+    return J.transpose() * AIv;
+  }
+
+  /// Return AI * J * x
+  static Eigen::Vector6d multiplyInertia(
+      const Eigen::Matrix6d& AI, const JacobianMatrix& J, const Vector& x)
+  {
+    const Eigen::Vector6d Jx = J * x;
+    return AI * Jx;
+  }
+};
+
+//==============================================================================
+/// Kernels for single-DOF joints (RevoluteJoint, PrismaticJoint, ScrewJoint).
+///
+/// The Jacobian is a single spatial vector, so the projections reduce to dot
+/// products and a symmetric rank-one update. The Jacobian of a PrismaticJoint
+/// never has an angular part, and the Jacobian of a RevoluteJoint whose child
+/// frame lies on its axis has no linear part; only the nonzero half of the
+/// articulated inertia is touched in those cases.
+template <>
+struct GenericJointKernels<1>
+{
+  using JacobianMatrix = Eigen::Matrix<double, 6, 1>;
+  using Matrix = Eigen::Matrix<double, 1, 1>;
+  using Vector = Eigen::Matrix<double, 1, 1>;
+
+  /// Return AI * S
+  static Eigen::Vector6d multiplyInertia(
+      const Eigen::Matrix6d& AI, const Eigen::Vector6d& S)
+  {
+    if (isLinearZero(S))
+      return AI.leftCols<3>() * S.head<3>();
+
+    if (isAngularZero(S))
+      return AI.rightCols<3>() * S.tail<3>();
+
+    return AI * S;
+  }
+
+  /// Return S^T * AI * S
+  static Matrix projectInertia(
+      const Eigen::Matrix6d& AI, const Eigen::Vector6d& S)
+  {
+    Matrix projAI;
+    projAI(0, 0) = S.dot(multiplyInertia(AI, S));
+
+    return projAI;
+  }
+
+  /// Set PI to AI - AI * S * invProjAI * S^T * AI
+  static void complementInertia(
+      Eigen::Matrix6d& PI,
+      const Eigen::Matrix6d& AI,
+      const Eigen::Vector6d& S,
+      const Matrix& invProjAI)
+  {
+    const Eigen::Vector6d AIS = multiplyInertia(AI, S);
+    const double invProj = invProjAI(0, 0);
+
+    // Symmetric rank-one update; the strictly upper triangle is mirrored from
+    // the lower one.
+    for (int j = 0; j < 6; ++j)
+    {
+      const double scaled = invProj * AIS[j];
+
+      PI(j, j) = AI(j, j) - scaled * AIS[j];
+      for (int i = j + 1; i < 6; ++i)
+      {
+        PI(i, j) = AI(i, j) - scaled * AIS[i];
+        PI(j, i) = PI(i, j);
+      }
+    }
+  }
+
+  /// Return S^T * AI * v
+  static Vector projectForce(
+      const Eigen::Matrix6d& AI,
+      const Eigen::Vector6d& S,
+      const Eigen::Vector6d& v)
+  {
+    Vector force;
+
+    if (isLinearZero(S))
+      force[0] = S.head<3>().dot(AI.topRows<3>() * v);
+    else if (isAngularZero(S))
+      force[0] = S.tail<3>().dot(AI.bottomRows<3>() * v);
+    else
+      force[0] = S.dot(AI * v);
+
+    return force;
+  }
+
+  /// Return AI * S * x
+  static Eigen::Vector6d multiplyInertia(
+      const Eigen::Matrix6d& AI, const Eigen::Vector6d& S, const Vector& x)
+  {
+    return x[0] * multiplyInertia(AI, S);
+  }
+
+  /// Return true if the angular part of S is exactly zero
+  static bool isAngularZero(const Eigen::Vector6d& S)
+  {
+    return S[0] == 0.0 && S[1] == 0.0 && S[2] == 0.0;
+  }
+
+  /// Return true if the linear part of S is exactly zero
+  static bool isLinearZero(const Eigen::Vector6d& S)
+  {
+    return S[3] == 0.0 && S[4] == 0.0 && S[5] == 0.0;
+  }
+};
+
+} // namespace detail
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_DETAIL_GENERICJOINTKERNELS_HPP_
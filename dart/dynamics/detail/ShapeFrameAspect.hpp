@@ -33,6 +33,8 @@
 #ifndef DART_DYNAMICS_DETAIL_SHAPEFRAMEASPECT_HPP_
 #define DART_DYNAMICS_DETAIL_SHAPEFRAMEASPECT_HPP_
 
+#include <cstdint>
+
 #include <Eigen/Core>
 
 #include "dart/common/EmbeddedAspect.hpp"
@@ -79,8 +81,25 @@ struct CollisionAspectProperties
   /// This object is collidable if true
   bool mCollidable;
 
+  /// Collision categories that this object belongs to, one category per bit
+  std::uint32_t mCategoryBits;
+
+  /// Collision categories that this object can collide with. Two objects are
+  /// checked for collision only if the category bits of each object overlap
+  /// the mask bits of the other.
+  std::uint32_t mMaskBits;
+
+  /// Whether this object moves fast enough to tunnel through thin objects
+  /// within a time step. The constraint solver adds speculative contacts
+  /// between such objects and whatever they are about to hit.
+  bool mContinuousCollision;
+
   /// Constructor
-  CollisionAspectProperties(const bool collidable = true);
+  CollisionAspectProperties(
+      const bool collidable = true,
+      const std::uint32_t categoryBits = 0x1u,
+      const std::uint32_t maskBits = 0xFFFFFFFFu,
+      const bool continuousCollision = false);
 
   /// Destructor
   virtual ~CollisionAspectProperties() = default;
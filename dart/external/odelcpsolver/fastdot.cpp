@@ -23,9 +23,10 @@
 /* generated code, do not edit. */
 
 #include "dart/external/odelcpsolver/matrix.h"
+#include "dart/external/odelcpsolver/simd.h"
 
 
-dReal _dDot (const dReal *a, const dReal *b, int n)
+dReal _dDotScalar (const dReal *a, const dReal *b, int n)
 {  
   dReal p0,q0,m0,p1,q1,m1,sum;
   sum = 0;
@@ -23,6 +23,7 @@
 /* generated code, do not edit. */
 
 #include "dart/external/odelcpsolver/matrix.h"
+#include "dart/external/odelcpsolver/simd.h"
 
 /* solve L^T * x=b, with b containing 1 right hand side.
  * L is an n*n lower triangular matrix with ones on the diagonal.
@@ -32,7 +33,7 @@
  * this processes blocks of 4.
  */
 
-void _dSolveL1T (const dReal *L, dReal *B, int n, int lskip1)
+void _dSolveL1TScalar (const dReal *L, dReal *B, int n, int lskip1)
 {  
   /* declare variables - Z matrix, p and q vectors, etc */
   dReal Z11,m11,Z21,m21,Z31,m31,Z41,m41,p1,q1,p2,p3,p4,*ex;
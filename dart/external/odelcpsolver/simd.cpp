@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/external/odelcpsolver/simd.h"
+#include "dart/external/odelcpsolver/matrix.h"
+
+#if defined(dDOUBLE) && (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define dSIMD_AVX2 1
+#define dSIMD_AVX512 1
+#endif
+
+#if defined(dSIMD_AVX2)
+#include <immintrin.h>
+#endif
+
+
+typedef dReal (*dDotKernel) (const dReal *a, const dReal *b, int n);
+typedef void (*dSolveKernel) (const dReal *L, dReal *B, int n, int lskip1);
+
+/* sizes from which the vectorized kernels are used. inside dSolveLCP() the
+ * AVX2 kernels only pay off from about a hundred rows on, even though they
+ * are faster in isolation, and the AVX-512 kernels only on top of that from
+ * several hundred rows on. smaller calls go to the scalar or AVX2 kernels.
+ */
+#define dSIMD_DOT_MIN 128
+#define dSIMD_SOLVEL1_MIN 128
+#define dSIMD_SOLVEL1T_MIN 128
+#define dSIMD_DOT_AVX512_MIN 256
+#define dSIMD_SOLVE_AVX512_MIN 512
+
+/* the scalar kernels are selected until the static initializer at the end of
+ * this file has run, so that the solver also works during static
+ * initialization of other translation units. the wide kernels are used from
+ * the AVX-512 sizes on.
+ */
+static int simdLevel = dSimdLevelScalar;
+static dDotKernel dotKernel = &_dDotScalar;
+static dDotKernel dotWideKernel = &_dDotScalar;
+static dSolveKernel solveL1Kernel = &_dSolveL1Scalar;
+static dSolveKernel solveL1WideKernel = &_dSolveL1Scalar;
+static dSolveKernel solveL1TKernel = &_dSolveL1TScalar;
+static dSolveKernel solveL1TWideKernel = &_dSolveL1TScalar;
+
+
+/****************************************************************************/
+/* AVX2 */
+
+#if defined(dSIMD_AVX2)
+
+__attribute__((target("avx2,fma")))
+static inline dReal dotAVX2 (const dReal *a, const dReal *b, int n)
+{
+  __m256d s0 = _mm256_setzero_pd();
+  __m256d s1 = _mm256_setzero_pd();
+  int i = 0;
+  for (; i <= n-8; i += 8) {
+    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i), s0);
+    s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a+i+4), _mm256_loadu_pd(b+i+4), s1);
+  }
+  if (i <= n-4) {
+    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i), s0);
+    i += 4;
+  }
+  s0 = _mm256_add_pd(s0, s1);
+  __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s0),
+                         _mm256_extractf128_pd(s0, 1));
+  h = _mm_add_sd(h, _mm_unpackhi_pd(h, h));
+  dReal sum = _mm_cvtsd_f64(h);
+  for (; i < n; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+__attribute__((target("avx2,fma")))
+static dReal _dDotAVX2 (const dReal *a, const dReal *b, int n)
+{
+  return dotAVX2(a, b, n);
+}
+
+/* row i of X is B(i) minus the dot product of row i of L with the rows of X
+ * already computed.
+ */
+__attribute__((target("avx2,fma")))
+static void _dSolveL1AVX2 (const dReal *L, dReal *B, int n, int lskip1)
+{
+  for (int i = 1; i < n; ++i) {
+    B[i] -= dotAVX2(L + i*lskip1, B, i);
+  }
+}
+
+/* once X(k) is known, its contribution is removed from B(0..k-1) at once.
+ * this walks L by rows, which are contiguous, instead of by columns.
+ */
+__attribute__((target("avx2,fma")))
+static void _dSolveL1TAVX2 (const dReal *L, dReal *B, int n, int lskip1)
+{
+  for (int k = n-1; k > 0; --k) {
+    const dReal *ell = L + k*lskip1;
+    const dReal xk = B[k];
+    const __m256d x = _mm256_set1_pd(xk);
+    int j = 0;
+    for (; j <= k-4; j += 4) {
+      _mm256_storeu_pd(B+j, _mm256_fnmadd_pd(_mm256_loadu_pd(ell+j), x,
+                                             _mm256_loadu_pd(B+j)));
+    }
+    for (; j < k; ++j) B[j] -= ell[j] * xk;
+  }
+}
+
+#endif
+
+
+/****************************************************************************/
+/* AVX-512 */
+
+#if defined(dSIMD_AVX512)
+
+__attribute__((target("avx512f")))
+static inline __mmask8 tailMask (int r)
+{
+  return (__mmask8) ((1u << r) - 1u);
+}
+
+__attribute__((target("avx512f")))
+static inline dReal dotAVX512 (const dReal *a, const dReal *b, int n)
+{
+  __m512d s0 = _mm512_setzero_pd();
+  __m512d s1 = _mm512_setzero_pd();
+  int i = 0;
+  for (; i <= n-16; i += 16) {
+    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a+i), _mm512_loadu_pd(b+i), s0);
+    s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a+i+8), _mm512_loadu_pd(b+i+8), s1);
+  }
+  if (i <= n-8) {
+    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a+i), _mm512_loadu_pd(b+i), s0);
+    i += 8;
+  }
+  if (i < n) {
+    const __mmask8 m = tailMask(n-i);
+    s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, a+i),
+                         _mm512_maskz_loadu_pd(m, b+i), s1);
+  }
+  // the 512 bit extract/shuffle intrinsics trigger spurious uninitialized
+  // warnings in some GCC versions, so the final sum goes through memory
+  alignas(64) dReal lanes[8];
+  _mm512_store_pd(lanes, _mm512_add_pd(s0, s1));
+  return ((lanes[0] + lanes[4]) + (lanes[1] + lanes[5]))
+      + ((lanes[2] + lanes[6]) + (lanes[3] + lanes[7]));
+}
+
+__attribute__((target("avx512f")))
+static dReal _dDotAVX512 (const dReal *a, const dReal *b, int n)
+{
+  return dotAVX512(a, b, n);
+}
+
+__attribute__((target("avx512f")))
+static void _dSolveL1AVX512 (const dReal *L, dReal *B, int n, int lskip1)
+{
+  for (int i = 1; i < n; ++i) {
+    B[i] -= dotAVX512(L + i*lskip1, B, i);
+  }
+}
+
+__attribute__((target("avx512f")))
+static void _dSolveL1TAVX512 (const dReal *L, dReal *B, int n, int lskip1)
+{
+  for (int k = n-1; k > 0; --k) {
+    const dReal *ell = L + k*lskip1;
+    const __m512d x = _mm512_set1_pd(B[k]);
+    int j = 0;
+    for (; j <= k-8; j += 8) {
+      _mm512_storeu_pd(B+j, _mm512_fnmadd_pd(_mm512_loadu_pd(ell+j), x,
+                                             _mm512_loadu_pd(B+j)));
+    }
+    if (j < k) {
+      const __mmask8 m = tailMask(k-j);
+      _mm512_mask_storeu_pd(B+j, m, _mm512_fnmadd_pd(
+          _mm512_maskz_loadu_pd(m, ell+j), x, _mm512_maskz_loadu_pd(m, B+j)));
+    }
+  }
+}
+
+#endif
+
+
+/****************************************************************************/
+/* dispatch */
+
+int dGetMaxSimdLevel()
+{
+#if defined(dSIMD_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+#if defined(dSIMD_AVX512)
+    if (__builtin_cpu_supports("avx512f")) return dSimdLevelAVX512;
+#endif
+    return dSimdLevelAVX2;
+  }
+#endif
+  return dSimdLevelScalar;
+}
+
+
+int dGetSimdLevel()
+{
+  return simdLevel;
+}
+
+
+int dSetSimdLevel (int level)
+{
+  const int maxLevel = dGetMaxSimdLevel();
+  if (level > maxLevel) level = maxLevel;
+  if (level < dSimdLevelScalar) level = dSimdLevelScalar;
+
+  switch (level) {
+#if defined(dSIMD_AVX512)
+  case dSimdLevelAVX512:
+    dotKernel = &_dDotAVX2;
+    dotWideKernel = &_dDotAVX512;
+    solveL1Kernel = &_dSolveL1AVX2;
+    solveL1WideKernel = &_dSolveL1AVX512;
+    solveL1TKernel = &_dSolveL1TAVX2;
+    solveL1TWideKernel = &_dSolveL1TAVX512;
+    break;
+#endif
+#if defined(dSIMD_AVX2)
+  case dSimdLevelAVX2:
+    dotKernel = dotWideKernel = &_dDotAVX2;
+    solveL1Kernel = solveL1WideKernel = &_dSolveL1AVX2;
+    solveL1TKernel = solveL1TWideKernel = &_dSolveL1TAVX2;
+    break;
+#endif
+  default:
+    level = dSimdLevelScalar;
+    dotKernel = dotWideKernel = &_dDotScalar;
+    solveL1Kernel = solveL1WideKernel = &_dSolveL1Scalar;
+    solveL1TKernel = solveL1TWideKernel = &_dSolveL1TScalar;
+    break;
+  }
+
+  simdLevel = level;
+  return level;
+}
+
+
+const char* dGetSimdLevelName (int level)
+{
+  switch (level) {
+  case dSimdLevelAVX2: return "AVX2";
+  case dSimdLevelAVX512: return "AVX-512";
+  default: return "scalar";
+  }
+}
+
+
+dReal _dDot (const dReal *a, const dReal *b, int n)
+{
+  if (n < dSIMD_DOT_MIN) return _dDotScalar(a, b, n);
+  if (n < dSIMD_DOT_AVX512_MIN) return dotKernel(a, b, n);
+  return dotWideKernel(a, b, n);
+}
+
+
+void _dSolveL1 (const dReal *L, dReal *B, int n, int lskip1)
+{
+  if (n < dSIMD_SOLVEL1_MIN) _dSolveL1Scalar(L, B, n, lskip1);
+  else if (n < dSIMD_SOLVE_AVX512_MIN) solveL1Kernel(L, B, n, lskip1);
+  else solveL1WideKernel(L, B, n, lskip1);
+}
+
+
+void _dSolveL1T (const dReal *L, dReal *B, int n, int lskip1)
+{
+  if (n < dSIMD_SOLVEL1T_MIN) _dSolveL1TScalar(L, B, n, lskip1);
+  else if (n < dSIMD_SOLVE_AVX512_MIN) solveL1TKernel(L, B, n, lskip1);
+  else solveL1TWideKernel(L, B, n, lskip1);
+}
+
+
+static const int initialSimdLevel = dSetSimdLevel(dGetMaxSimdLevel());
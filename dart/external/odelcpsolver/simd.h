@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+
+vectorized versions of the kernels that dominate dSolveLCP(): the dot
+product used to update the incremental LDL^T factorization and the pN/AiC
+products, and the unit lower triangular solves L*x=b and L^T*x=b.
+
+the kernel used is selected at run time. on startup the widest instruction
+set supported by both the CPU and the compiler is used; dSetSimdLevel() can
+override that, e.g. to compare against the original scalar code. the scalar
+kernels are the unmodified ODE implementations. small problems, which are
+the common case for contact LCPs, always use the scalar kernels because the
+vectorized ones are slower there.
+
+the vectorized kernels are only available when dReal is double and the
+compiler targets x86. the sums are accumulated in a different order than in
+the scalar kernels, so results may differ in the last few bits.
+
+changing the level is not thread safe; do it before any solver runs.
+
+*/
+
+#ifndef _ODE_SIMD_H_
+#define _ODE_SIMD_H_
+
+#include "dart/external/odelcpsolver/common.h"
+
+enum dSimdLevel
+{
+  dSimdLevelScalar = 0,
+  dSimdLevelAVX2,     // AVX2 + FMA, 4 doubles per register
+  dSimdLevelAVX512    // AVX-512F, 8 doubles per register
+};
+
+/* return the widest level supported by this CPU and build. */
+int dGetMaxSimdLevel();
+
+/* return the level currently used by the kernels. */
+int dGetSimdLevel();
+
+/* select the level used by the kernels. levels above dGetMaxSimdLevel() are
+ * clamped to it. returns the level actually selected.
+ */
+int dSetSimdLevel (int level);
+
+/* return a printable name of a level, e.g. "AVX2". */
+const char* dGetSimdLevelName (int level);
+
+/* the original scalar kernels, see _dDot(), _dSolveL1() and _dSolveL1T(). */
+dReal _dDotScalar (const dReal *a, const dReal *b, int n);
+void _dSolveL1Scalar (const dReal *L, dReal *B, int n, int lskip1);
+void _dSolveL1TScalar (const dReal *L, dReal *B, int n, int lskip1);
+
+#endif
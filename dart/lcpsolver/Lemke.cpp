@@ -32,8 +32,10 @@
 
 #include "dart/lcpsolver/Lemke.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <vector>
 
 #include "dart/math/Helpers.hpp"
@@ -61,278 +63,458 @@ namespace lcpsolver {
 int Lemke(
     const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z)
 {
-  int n = _q.size();
+  LemkeSolver solver(LemkeSolver::Options(false));
+  return solver.solve(_M, _q, _z);
+}
+
+//==============================================================================
+LemkeSolver::Options::Options(
+    bool warmStart, bool splitBlocks, int maxIterations, int maxUpdates)
+  : mWarmStart(warmStart),
+    mSplitBlocks(splitBlocks),
+    mMaxIterations(maxIterations),
+    mMaxUpdates(maxUpdates)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LemkeSolver::LemkeSolver(const Options& options)
+  : mOptions(options),
+    mNumPivots(0),
+    mNumFactorizations(0),
+    mWarmStarted(false),
+    mNumEtas(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void LemkeSolver::setOptions(const Options& options)
+{
+  mOptions = options;
+}
+
+//==============================================================================
+const LemkeSolver::Options& LemkeSolver::getOptions() const
+{
+  return mOptions;
+}
+
+//==============================================================================
+int LemkeSolver::solve(
+    const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z)
+{
+  const int n = _q.size();
+
+  mNumPivots = 0;
+  mNumFactorizations = 0;
+  mWarmStarted = false;
+
+  if (mBasicZ.size() != static_cast<std::size_t>(n))
+    mBasicZ.assign(n, 0);
+
+  if (mOptions.mSplitBlocks && n > 1)
+  {
+    computeBlocks(_M);
+
+    if (mBlocks.size() > 1)
+    {
+      _z->setZero(n);
+
+      int err = 0;
+      for (const std::vector<int>& block : mBlocks)
+      {
+        const int m = block.size();
+        mBlockM.resize(m, m);
+        mBlockQ.resize(m);
+        mBlockBasicZ.resize(m);
+        for (int j = 0; j < m; ++j)
+        {
+          for (int i = 0; i < m; ++i)
+            mBlockM(i, j) = _M(block[i], block[j]);
+
+          mBlockQ[j] = _q[block[j]];
+          mBlockBasicZ[j] = mBasicZ[block[j]];
+        }
+
+        const int blockErr = solveDense(mBlockM, mBlockQ, mBlockZ, mBlockBasicZ);
+
+        for (int j = 0; j < m; ++j)
+        {
+          (*_z)[block[j]] = mBlockZ[j];
+          mBasicZ[block[j]] = mBlockBasicZ[j];
+        }
+
+        // Report the first failure, but keep solving the other blocks so that
+        // their warm start information stays up to date.
+        if (err == 0)
+          err = blockErr;
+      }
+
+      if (err != 0 && err != 3)
+        _z->setZero(n);
+
+      return err;
+    }
+  }
+
+  return solveDense(_M, _q, *_z, mBasicZ);
+}
+
+//==============================================================================
+void LemkeSolver::resetBasis()
+{
+  mBasicZ.clear();
+}
+
+//==============================================================================
+int LemkeSolver::getNumPivots() const
+{
+  return mNumPivots;
+}
+
+//==============================================================================
+int LemkeSolver::getNumFactorizations() const
+{
+  return mNumFactorizations;
+}
+
+//==============================================================================
+bool LemkeSolver::isWarmStarted() const
+{
+  return mWarmStarted;
+}
+
+//==============================================================================
+int LemkeSolver::solveDense(
+    const Eigen::MatrixXd& _M,
+    const Eigen::VectorXd& _q,
+    Eigen::VectorXd& _z,
+    std::vector<char>& _basicZ)
+{
+  const int n = _q.size();
 
   const double zer_tol = 1e-5;
   const double piv_tol = 1e-8;
-  int maxiter = 1000;
   int err = 0;
 
-  if (_q.minCoeff() >= 0)
-  {
-    // LOG(INFO) << "Trivial solution exists.";
-    *_z = Eigen::VectorXd::Zero(n);
-    return err;
-  }
+  _z.setZero(n);
 
-  // solve trivial case for n=1
-  //   if (n==1){
-  //     if (_M(0)>0){
-  //         *_z = (- _q(0)/_M(0) )*Eigen::VectorXd::Ones(n);
-  //         return err;
-  //     } else {
-  //         *_z = Eigen::VectorXd::Zero(n);
-  //         err = 4; // no solution
-  //         return err;
-  //     }
-  //   }
-
-  *_z = Eigen::VectorXd::Zero(2 * n);
-  int iter = 0;
-  // double theta = 0;
-  double ratio = 0;
-  int leaving = 0;
-  Eigen::VectorXd Be = Eigen::VectorXd::Constant(n, 1);
-  Eigen::VectorXd x = _q;
-  std::vector<int> bas;
-  std::vector<int> nonbas;
-
-  int t = 2 * n;
-  int entering = t;
-
-  bas.clear();
-  nonbas.clear();
-
-  // TODO: here suppose initial guess z0 is [0,0,0,...], this contradicts to
-  // ODE's w always initilized as 0
-  for (int i = 0; i < n; ++i)
+  if (n == 0 || _q.minCoeff() >= 0)
   {
-    nonbas.push_back(i);
+    // Trivial solution exists.
+    std::fill(_basicZ.begin(), _basicZ.end(), 0);
+    return err;
   }
 
-  Eigen::MatrixXd B = -Eigen::MatrixXd::Identity(n, n);
+  const int t = 2 * n;
+  mBasis.resize(n);
 
-  if (!bas.empty())
+  bool warmStarted = false;
+  if (mOptions.mWarmStart
+      && std::find(_basicZ.begin(), _basicZ.end(), 1) != _basicZ.end())
   {
-    Eigen::MatrixXd B_copy = B;
-    for (std::size_t i = 0; i < bas.size(); ++i)
-    {
-      B.col(i) = _M.col(bas[i]);
-    }
-    for (std::size_t i = 0; i < nonbas.size(); ++i)
+    // Use M for the columns of the previously basic z variables and -I for
+    // the rest
+    mBasisMatrix.resize(n, n);
+    for (int i = 0; i < n; ++i)
     {
-      B.col(bas.size() + i) = B_copy.col(nonbas[i]);
+      if (_basicZ[i])
+      {
+        mBasisMatrix.col(i) = _M.col(i);
+        mBasis[i] = i;
+      }
+      else
+      {
+        mBasisMatrix.col(i).setZero();
+        mBasisMatrix(i, i) = -1.0;
+        mBasis[i] = n + i;
+      }
     }
-    // TODO: check the condition number to return err = 3
-    Eigen::JacobiSVD<Eigen::MatrixXd> svd(B);
-    double cond = svd.singularValues()(0)
-                  / svd.singularValues()(svd.singularValues().size() - 1);
-    if (cond > 1e16)
+
+    factorizeBasis();
+    if (mLU.rcond() > 1e-12)
     {
-      (*_z) = Eigen::VectorXd::Zero(n);
-      err = 3;
-      return err;
+      solveBasis(_q, mX);
+      mX = -mX;
+      warmStarted = true;
     }
-    x = -B.householderQr().solve(_q);
   }
 
+  if (!warmStarted)
+  {
+    // TODO: here suppose initial guess z0 is [0,0,0,...], this contradicts to
+    // ODE's w always initilized as 0
+    mBasisMatrix = -Eigen::MatrixXd::Identity(n, n);
+    for (int i = 0; i < n; ++i)
+      mBasis[i] = n + i;
+    mX = _q;
+  }
+
+  int leaving = t;
+  int iter = 0;
+
   // Check if initial basis provides solution
-  if (x.minCoeff() >= 0)
+  if (mX.minCoeff() < 0)
   {
-    Eigen::VectorXd __z = Eigen::VectorXd::Zero(2 * n);
-    for (std::size_t i = 0; i < bas.size(); ++i)
+    // Determine initial leaving variable
+    int lvindex;
+    const double tval = -mX.minCoeff(&lvindex);
+    leaving = mBasis[lvindex];
+    mBasis[lvindex] = t; // pivoting in the artificial variable
+
+    mD = (mX.array() < 0).cast<double>().matrix();
+    mEnteringColumn.noalias() = -(mBasisMatrix * mD);
+    mX += tval * mD;
+    mX[lvindex] = tval;
+    mBasisMatrix.col(lvindex) = mEnteringColumn;
+    factorizeBasis();
+
+    int entering = t;
+    for (iter = 0; iter < mOptions.mMaxIterations; ++iter)
     {
-      (__z).row(bas[i]) = x.row(i);
+      if (leaving == t)
+      {
+        break;
+      }
+      else if (leaving < n)
+      {
+        entering = n + leaving;
+        mEnteringColumn.setZero(n);
+        mEnteringColumn[leaving] = -1;
+      }
+      else
+      {
+        entering = leaving - n;
+        mEnteringColumn = _M.col(entering);
+      }
+
+      solveBasis(mEnteringColumn, mD);
+
+      // Find new leaving variable
+      mCandidates.clear();
+      double theta = std::numeric_limits<double>::infinity();
+      for (int i = 0; i < n; ++i)
+      {
+        if (mD[i] > piv_tol)
+        {
+          mCandidates.push_back(i);
+          theta = std::min(theta, (mX[i] + zer_tol) / mD[i]);
+        }
+      }
+
+      if (mCandidates.empty()) // no new pivots - ray termination
+      {
+        err = 2;
+        break;
+      }
+
+      std::size_t numTies = 0;
+      for (const int i : mCandidates)
+      {
+        if (mX[i] / mD[i] <= theta)
+          mCandidates[numTies++] = i;
+      }
+      mCandidates.resize(numTies);
+
+      if (mCandidates.empty())
+      {
+        err = 4;
+        break;
+      }
+
+      // Always use artificial if possible
+      lvindex = -1;
+      for (const int i : mCandidates)
+      {
+        if (mBasis[i] == t)
+          lvindex = i;
+      }
+
+      if (lvindex == -1)
+      {
+        // Otherwise choose the first one with the largest pivot
+        lvindex = mCandidates[0];
+        theta = mD[lvindex];
+        for (const int i : mCandidates)
+        {
+          if (mD[i] - theta > piv_tol)
+          {
+            theta = mD[i];
+            lvindex = i;
+          }
+        }
+      }
+
+      leaving = mBasis[lvindex];
+
+      const double ratio = mX[lvindex] / mD[lvindex];
+
+      // Perform pivot
+      mX -= ratio * mD;
+      mX[lvindex] = ratio;
+      replaceBasisColumn(lvindex, mEnteringColumn, mD);
+      mBasis[lvindex] = entering;
+      ++mNumPivots;
     }
-    (*_z) = __z.head(n);
-    return err;
+
+    if (iter >= mOptions.mMaxIterations && leaving != t)
+      err = 1;
   }
 
-  // Determine initial leaving variable
-  Eigen::VectorXd minuxX = -x;
-  int lvindex;
-  double tval = minuxX.maxCoeff(&lvindex);
-  for (std::size_t i = 0; i < nonbas.size(); ++i)
+  if (err == 0)
   {
-    bas.push_back(nonbas[i] + n);
-  }
-  leaving = bas[lvindex];
+    for (int i = 0; i < n; ++i)
+    {
+      if (mBasis[i] < n)
+        _z[mBasis[i]] = mX[i];
+    }
 
-  bas[lvindex] = t; // pivoting in the artificial variable
+    if (!validate(_M, _z, _q))
+      err = 3;
+  }
 
-  Eigen::VectorXd U = Eigen::VectorXd::Zero(n);
-  for (int i = 0; i < n; ++i)
+  if (err != 0 && warmStarted)
   {
-    if (x[i] < 0)
-      U[i] = 1;
+    // The previous basis did not lead to a solution, so start over cold
+    std::fill(_basicZ.begin(), _basicZ.end(), 0);
+    return solveDense(_M, _q, _z, _basicZ);
   }
-  Be = -(B * U);
-  x += tval * U;
-  x[lvindex] = tval;
-  B.col(lvindex) = Be;
 
-  for (iter = 0; iter < maxiter; ++iter)
+  // Only the warm start that produced the returned solution counts
+  if (warmStarted)
+    mWarmStarted = true;
+
+  std::fill(_basicZ.begin(), _basicZ.end(), 0);
+  if (err == 0)
   {
-    if (leaving == t)
-    {
-      break;
-    }
-    else if (leaving < n)
-    {
-      entering = n + leaving;
-      Be = Eigen::VectorXd::Zero(n);
-      Be[leaving] = -1;
-    }
-    else
+    for (int i = 0; i < n; ++i)
     {
-      entering = leaving - n;
-      Be = _M.col(entering);
+      if (mBasis[i] < n)
+        _basicZ[mBasis[i]] = 1;
     }
+  }
+  else if (err != 3)
+  {
+    _z.setZero(n); // solve failed, return a 0 vector
+  }
 
-    Eigen::VectorXd d = B.householderQr().solve(Be);
+  return err;
+}
 
-    // Find new leaving variable
-    std::vector<int> j;
-    for (int i = 0; i < n; ++i)
-    {
-      if (d[i] > piv_tol)
-        j.push_back(i);
-    }
-    if (j.empty()) // no new pivots - ray termination
-    {
-      err = 2;
-      break;
-    }
+//==============================================================================
+void LemkeSolver::computeBlocks(const Eigen::MatrixXd& _M)
+{
+  const int n = _M.rows();
 
-    std::size_t jSize = j.size();
-    Eigen::VectorXd minRatio(jSize);
-    for (std::size_t i = 0; i < jSize; ++i)
-    {
-      minRatio[i] = (x[j[i]] + zer_tol) / d[j[i]];
-    }
-    double theta = minRatio.minCoeff();
+  // Find the connected components of the sparsity graph of M with a
+  // union-find over the variables
+  mBlockOf.resize(n);
+  for (int i = 0; i < n; ++i)
+    mBlockOf[i] = i;
 
-    std::vector<int> tmpJ;
-    std::vector<double> tmpd;
-    for (std::size_t i = 0; i < jSize; ++i)
+  auto findRoot = [this](int i)
+  {
+    while (mBlockOf[i] != i)
     {
-      if (x[j[i]] / d[j[i]] <= theta)
-      {
-        tmpJ.push_back(j[i]);
-        tmpd.push_back(d[j[i]]);
-      }
+      mBlockOf[i] = mBlockOf[mBlockOf[i]];
+      i = mBlockOf[i];
     }
+    return i;
+  };
 
-    //    if (tmpJ.empty())
-    //    {
-    //      LOG(WARNING) << "tmpJ should never be empty!!!";
-    //      LOG(WARNING) << "dumping data:";
-    //      LOG(WARNING) << "theta:" << theta;
-    //      for (int i = 0; i < jSize; ++i)
-    //      {
-    //        LOG(WARNING) << "x(" << j[i] << "): " << x[j[i]] << "d: " <<
-    //        d[j[i]];
-    //      }
-    //    }
-
-    j = tmpJ;
-    jSize = j.size();
-    if (jSize == 0)
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = j + 1; i < n; ++i)
     {
-      err = 4;
-      break;
-    }
-    lvindex = -1;
+      if (_M(i, j) == 0.0 && _M(j, i) == 0.0)
+        continue;
 
-    // Check if artificial among these
-    for (std::size_t i = 0; i < jSize; ++i)
-    {
-      if (bas[j[i]] == t)
-        lvindex = i;
+      const int rootI = findRoot(i);
+      const int rootJ = findRoot(j);
+      if (rootI != rootJ)
+        mBlockOf[std::max(rootI, rootJ)] = std::min(rootI, rootJ);
     }
+  }
 
-    if (lvindex != -1)
+  // Roots always have the smallest index of their block, so after pointing
+  // every variable directly at its root, one pass in increasing order is
+  // enough to number the blocks.
+  for (int i = 0; i < n; ++i)
+    mBlockOf[i] = findRoot(i);
+
+  for (std::vector<int>& block : mBlocks)
+    block.clear();
+
+  int numBlocks = 0;
+  for (int i = 0; i < n; ++i)
+  {
+    if (mBlockOf[i] == i)
     {
-      lvindex = j[lvindex]; // Always use artificial if possible
+      if (static_cast<int>(mBlocks.size()) <= numBlocks)
+        mBlocks.emplace_back();
+      mBlocks[numBlocks].push_back(i);
+      mBlockOf[i] = ~numBlocks;
+      ++numBlocks;
     }
     else
     {
-      theta = tmpd[0];
-      lvindex = 0;
-      for (std::size_t i = 0; i < jSize; ++i)
-      {
-        if (tmpd[i] - theta > piv_tol)
-        { // Bubble sorting
-          theta = tmpd[i];
-          lvindex = i;
-        }
-      }
-      lvindex = j[lvindex]; // choose the first if there are multiple
+      mBlocks[~mBlockOf[mBlockOf[i]]].push_back(i);
     }
-
-    leaving = bas[lvindex];
-
-    ratio = x[lvindex] / d[lvindex];
-
-    //    bool bDiverged = false;
-    //    for (int i = 0; i < n; ++i) {
-    //      if (isnan(x[i]) || isinf(x[i])) {
-    //        bDiverged = true;
-    //        break;
-    //      }
-    //    }
-    //    if (bDiverged) {
-    //      err = 4;
-    //      break;
-    //    }
-
-    // Perform pivot
-    x = x - ratio * d;
-    x[lvindex] = ratio;
-    B.col(lvindex) = Be;
-    bas[lvindex] = entering;
   }
 
-  if (iter >= maxiter && leaving != t)
+  mBlocks.resize(numBlocks);
+}
+
+//==============================================================================
+void LemkeSolver::factorizeBasis()
+{
+  const int n = mBasisMatrix.rows();
+
+  mLU.compute(mBasisMatrix);
+  ++mNumFactorizations;
+
+  mNumEtas = 0;
+  if (mEtaColumns.rows() != n || mEtaColumns.cols() != mOptions.mMaxUpdates)
   {
-    err = 1;
+    mEtaColumns.resize(n, mOptions.mMaxUpdates);
+    mEtaPositions.resize(mOptions.mMaxUpdates);
   }
+}
 
-  if (err == 0)
+//==============================================================================
+void LemkeSolver::solveBasis(
+    const Eigen::VectorXd& _b, Eigen::VectorXd& _d) const
+{
+  _d = mLU.solve(_b);
+
+  // B = B0 * E1 * ... * Ek, so apply the inverses of the eta matrices in the
+  // order that they were added
+  for (int k = 0; k < mNumEtas; ++k)
   {
-    for (std::size_t i = 0; i < bas.size(); ++i)
-    {
-      if (bas[i] < _z->size())
-      {
-        (*_z)[bas[i]] = x[i];
-      }
-    }
+    const int r = mEtaPositions[k];
+    const double dr = _d[r] / mEtaColumns(r, k);
+    _d.noalias() -= dr * mEtaColumns.col(k);
+    _d[r] = dr;
+  }
+}
 
-    Eigen::VectorXd __z = _z->head(n);
-    *_z = __z;
+//==============================================================================
+void LemkeSolver::replaceBasisColumn(
+    int _index, const Eigen::VectorXd& _column, const Eigen::VectorXd& _d)
+{
+  mBasisMatrix.col(_index) = _column;
 
-    if (!validate(_M, *_z, _q))
-    {
-      // _z = VectorXd::Zero(n);
-      err = 3;
-    }
-  }
-  else
+  if (mNumEtas >= mOptions.mMaxUpdates)
   {
-    *_z = Eigen::VectorXd::Zero(n); // solve failed, return a 0 vector
+    factorizeBasis();
+    return;
   }
 
-  //  if (err == 1)
-  //    LOG(ERROR) << "LCP Solver: Iterations exceeded limit";
-  //  else if (err == 2)
-  //    LOG(ERROR) << "LCP Solver: Unbounded ray";
-  //  else if (err == 3)
-  //    LOG(ERROR) << "LCP Solver: Solver converged with numerical issues. "
-  //               << "Validation failed.";
-  //  else if (err == 4)
-  //    LOG(ERROR) << "LCP Solver: Iteration diverged.";
-
-  return err;
+  mEtaColumns.col(mNumEtas) = _d;
+  mEtaPositions[mNumEtas] = _index;
+  ++mNumEtas;
 }
 
 //==============================================================================
@@ -33,6 +33,8 @@
 #ifndef DART_LCPSOLVER_LEMKE_HPP_
 #define DART_LCPSOLVER_LEMKE_HPP_
 
+#include <vector>
+
 #include <Eigen/Dense>
 
 namespace dart {
@@ -42,6 +44,150 @@ namespace lcpsolver {
 int Lemke(
     const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z);
 
+/// LemkeSolver solves the same LCPs as Lemke(), but keeps its workspace and
+/// the final basis of the previous solve so that it can be reused across
+/// calls, e.g. once per time step.
+///
+/// Instead of refactorizing the basis at every pivot, the LU factorization of
+/// the basis is updated in product form: each pivot replaces one column of
+/// the basis, which is a rank-one change that is applied as an eta matrix on
+/// top of the last factorization. The basis is refactorized after
+/// Options::mMaxUpdates pivots.
+class LemkeSolver
+{
+public:
+  struct Options
+  {
+    /// Start from the set of basic variables of the previous solve. If that
+    /// basis turns out to be singular or does not lead to a solution, the
+    /// solver falls back to a cold start.
+    bool mWarmStart;
+
+    /// Split the LCP into the independent diagonal blocks of M and solve each
+    /// of them separately. This pays off when the LCP was assembled from
+    /// several decoupled sets of constraints.
+    bool mSplitBlocks;
+
+    /// Maximum number of pivots per (block of the) LCP
+    int mMaxIterations;
+
+    /// Number of rank-one basis updates before the basis is refactorized
+    int mMaxUpdates;
+
+    Options(
+        bool warmStart = true,
+        bool splitBlocks = false,
+        int maxIterations = 1000,
+        int maxUpdates = 50);
+  };
+
+  /// Constructor
+  explicit LemkeSolver(const Options& options = Options());
+
+  /// Set the options of this solver
+  void setOptions(const Options& options);
+
+  /// Get the options of this solver
+  const Options& getOptions() const;
+
+  /// Solve the LCP w = M*z + q, w >= 0, z >= 0, w^T z = 0. The return value
+  /// uses the same error codes as Lemke().
+  int solve(
+      const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z);
+
+  /// Forget the basis of the previous solve so that the next solve starts
+  /// cold.
+  void resetBasis();
+
+  /// Number of pivots performed by the last solve
+  int getNumPivots() const;
+
+  /// Number of basis factorizations performed by the last solve
+  int getNumFactorizations() const;
+
+  /// Whether the solution of the last solve was found from a warm start, for
+  /// at least one block if the blocks are split
+  bool isWarmStarted() const;
+
+protected:
+  /// Solve a single LCP with the dense algorithm. _basicZ flags the z
+  /// variables to warm start from and receives the final basis.
+  int solveDense(
+      const Eigen::MatrixXd& _M,
+      const Eigen::VectorXd& _q,
+      Eigen::VectorXd& _z,
+      std::vector<char>& _basicZ);
+
+  /// Split the variables into the independent diagonal blocks of _M
+  void computeBlocks(const Eigen::MatrixXd& _M);
+
+  /// Factorize the current basis from scratch
+  void factorizeBasis();
+
+  /// Solve B*_d = _b using the current factorization and eta matrices
+  void solveBasis(const Eigen::VectorXd& _b, Eigen::VectorXd& _d) const;
+
+  /// Replace column _index of the basis with _column, where _d = B^{-1}
+  /// _column was computed with the old basis
+  void replaceBasisColumn(
+      int _index, const Eigen::VectorXd& _column, const Eigen::VectorXd& _d);
+
+  /// Options of this solver
+  Options mOptions;
+
+  /// Flags for the z variables that were basic at the end of the last solve
+  std::vector<char> mBasicZ;
+
+  /// Number of pivots of the last solve
+  int mNumPivots;
+
+  /// Number of basis factorizations of the last solve
+  int mNumFactorizations;
+
+  /// Whether the solution of the last solve was found from a warm start. It is
+  /// reset at the start of every solve.
+  bool mWarmStarted;
+
+  /// Current basis
+  Eigen::MatrixXd mBasisMatrix;
+
+  /// LU factorization of the basis at the time of the last refactorization
+  Eigen::PartialPivLU<Eigen::MatrixXd> mLU;
+
+  /// Eta columns of the basis updates since the last refactorization
+  Eigen::MatrixXd mEtaColumns;
+
+  /// Basis positions that were replaced by each eta column
+  std::vector<int> mEtaPositions;
+
+  /// Number of eta columns in use
+  int mNumEtas;
+
+  /// Variable (0..n-1 for z, n..2n-1 for w, 2n for the artificial variable)
+  /// at each position of the basis
+  std::vector<int> mBasis;
+
+  /// Candidate leaving positions of a pivot
+  std::vector<int> mCandidates;
+
+  /// Workspace vectors
+  Eigen::VectorXd mX;
+  Eigen::VectorXd mD;
+  Eigen::VectorXd mEnteringColumn;
+
+  /// Block index of each variable, used when splitting into blocks
+  std::vector<int> mBlockOf;
+
+  /// Variables of each block
+  std::vector<std::vector<int>> mBlocks;
+
+  /// Workspace for the LCP of a single block
+  Eigen::MatrixXd mBlockM;
+  Eigen::VectorXd mBlockQ;
+  Eigen::VectorXd mBlockZ;
+  std::vector<char> mBlockBasicZ;
+};
+
 /// \brief
 bool validate(
     const Eigen::MatrixXd& _M,
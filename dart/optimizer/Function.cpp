@@ -77,6 +77,23 @@ void Function::evalGradient(const Eigen::VectorXd& x, Eigen::VectorXd& grad) con
   evalGradient(x, tmpGrad);
 }
 
+//==============================================================================
+double Function::evalWithGradient(const Eigen::VectorXd& x,
+                                  Eigen::Map<Eigen::VectorXd> grad) const
+{
+  const double value = eval(x);
+  evalGradient(x, grad);
+  return value;
+}
+
+//==============================================================================
+double Function::evalWithGradient(const Eigen::VectorXd& x,
+                                  Eigen::VectorXd& grad) const
+{
+  Eigen::Map<Eigen::VectorXd> tmpGrad(grad.data(), grad.size());
+  return evalWithGradient(x, tmpGrad);
+}
+
 //==============================================================================
 void Function::evalHessian(
     const Eigen::VectorXd& /*_x*/,
@@ -71,6 +71,26 @@ public:
   /// for better performance.
   void evalGradient(const Eigen::VectorXd& x, Eigen::VectorXd& grad) const;
 
+  /// Evaluate the objective function and its gradient at the point x in a
+  /// single call, returning the value of the function and writing the gradient
+  /// into grad.
+  ///
+  /// The default implementation simply calls eval() followed by
+  /// evalGradient(). Functions whose value and gradient share expensive
+  /// intermediate results (e.g., a forward kinematics pass) should override
+  /// this so that those results are only computed once.
+  virtual double evalWithGradient(const Eigen::VectorXd& x,
+                                  Eigen::Map<Eigen::VectorXd> grad) const;
+
+  /// Evaluate the objective function and its gradient at the point x in a
+  /// single call.
+  ///
+  /// If you have a raw array that the gradient will be passed in, then use
+  /// evalWithGradient(const Eigen::VectorXd&, Eigen::Map<Eigen::VectorXd>)
+  /// for better performance.
+  double evalWithGradient(const Eigen::VectorXd& x,
+                          Eigen::VectorXd& grad) const;
+
   /// Evaluate and return the objective function at the point x
   virtual void evalHessian(
       const Eigen::VectorXd& x,
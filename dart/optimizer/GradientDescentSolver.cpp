@@ -160,23 +160,6 @@ bool GradientDescentSolver::solve()
         x += scale*(dx-x);
       }
 
-      // Check if the equality constraints are satsified
-      satisfied = true;
-      for(std::size_t i=0; i<problem->getNumEqConstraints(); ++i)
-      {
-        mEqConstraintCostCache[i] = problem->getEqConstraint(i)->eval(x);
-        if(std::abs(mEqConstraintCostCache[i]) > tol)
-          satisfied = false;
-      }
-
-      // Check if the inequality constraints are satisfied
-      for(std::size_t i=0; i<problem->getNumIneqConstraints(); ++i)
-      {
-        mIneqConstraintCostCache[i] = problem->getIneqConstraint(i)->eval(x);
-        if(mIneqConstraintCostCache[i] > std::abs(tol))
-          satisfied = false;
-      }
-
       dx.setZero();
       Eigen::Map<Eigen::VectorXd> dxMap(dx.data(), dim);
       Eigen::Map<Eigen::VectorXd> gradMap(grad.data(), dim);
@@ -185,13 +168,21 @@ bool GradientDescentSolver::solve()
       const FunctionPtr& objective = problem->getObjective();
       if(objective)
         objective->evalGradient(x, dxMap);
+
+      // Check if the equality constraints are satsified. Each constraint is
+      // evaluated together with its gradient, which lets functions such as the
+      // IK constraints share the work between the two.
+      satisfied = true;
       for(int i=0; i < static_cast<int>(problem->getNumEqConstraints()); ++i)
       {
+        mEqConstraintCostCache[i] =
+            problem->getEqConstraint(i)->evalWithGradient(x, gradMap);
+        if(std::abs(mEqConstraintCostCache[i]) > tol)
+          satisfied = false;
+
         if(std::abs(mEqConstraintCostCache[i]) < tol)
           continue;
 
-        problem->getEqConstraint(i)->evalGradient(x, gradMap);
-
         // Get the user-specified weight if available, otherwise use the default
         // weight value
         double weight = mGradientP.mEqConstraintWeights.size() > i?
@@ -205,8 +196,14 @@ bool GradientDescentSolver::solve()
         dx += weight * grad * math::sign(mEqConstraintCostCache[i]);
       }
 
+      // Check if the inequality constraints are satisfied. These are usually
+      // inactive, so their gradients are only evaluated when they are needed.
       for(int i=0; i < static_cast<int>(problem->getNumIneqConstraints()); ++i)
       {
+        mIneqConstraintCostCache[i] = problem->getIneqConstraint(i)->eval(x);
+        if(mIneqConstraintCostCache[i] > std::abs(tol))
+          satisfied = false;
+
         if(mIneqConstraintCostCache[i] < tol)
           continue;
 
@@ -0,0 +1,601 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/optimizer/LevenbergMarquardtSolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "dart/common/Console.hpp"
+#include "dart/math/Helpers.hpp"
+#include "dart/optimizer/Problem.hpp"
+
+namespace dart {
+namespace optimizer {
+
+//==============================================================================
+const std::string LevenbergMarquardtSolver::Type = "LevenbergMarquardtSolver";
+
+//==============================================================================
+LevenbergMarquardtSolver::Statistics::Statistics()
+  : mTermination(NOT_SOLVED),
+    mNumIterations(0),
+    mNumAcceptedSteps(0),
+    mNumRejectedSteps(0),
+    mNumResidualEvaluations(0),
+    mNumJacobianEvaluations(0),
+    mNumAttempts(0),
+    mInitialCost(0.0),
+    mFinalCost(0.0),
+    mFinalGradientNorm(0.0),
+    mFinalDamping(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::UniqueProperties::UniqueProperties(
+    double _initialDamping,
+    double _dampingFactor,
+    double _minDamping,
+    double _maxDamping,
+    double _gradientTolerance,
+    double _stepTolerance,
+    std::size_t _maxAttempts)
+  : mInitialDamping(_initialDamping),
+    mDampingFactor(_dampingFactor),
+    mMinDamping(_minDamping),
+    mMaxDamping(_maxDamping),
+    mGradientTolerance(_gradientTolerance),
+    mStepTolerance(_stepTolerance),
+    mMaxAttempts(_maxAttempts)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::Properties::Properties(
+    const Solver::Properties& _solverProperties,
+    const UniqueProperties& _lmProperties)
+  : Solver::Properties(_solverProperties),
+    UniqueProperties(_lmProperties)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::LevenbergMarquardtSolver(
+    const Properties& _properties)
+  : Solver(_properties),
+    mLMP(_properties),
+    mDamping(_properties.mInitialDamping)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::LevenbergMarquardtSolver(
+    std::shared_ptr<Problem> _problem)
+  : Solver(_problem),
+    mDamping(mLMP.mInitialDamping)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::~LevenbergMarquardtSolver()
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool LevenbergMarquardtSolver::solve()
+{
+  mStatistics = Statistics();
+
+  std::shared_ptr<Problem> problem = mProperties.mProblem;
+  if(nullptr == problem)
+  {
+    dtwarn << "[LevenbergMarquardtSolver::solve] Attempting to solve a nullptr "
+           << "problem! We will return false.\n";
+    return false;
+  }
+
+  const std::size_t dim = problem->getDimension();
+  if(dim == 0)
+  {
+    problem->setOptimalSolution(Eigen::VectorXd());
+    problem->setOptimumValue(0.0);
+    mStatistics.mTermination = SMALL_RESIDUAL;
+    return true;
+  }
+
+  Eigen::VectorXd x = problem->getInitialGuess();
+  assert(x.size() == static_cast<int>(dim));
+
+  bool solved = false;
+  std::size_t attempt = 0;
+  while(true)
+  {
+    ++mStatistics.mNumAttempts;
+    mStatistics.mTermination = iterate(*problem, x, attempt);
+    mStatistics.mFinalDamping = mDamping;
+
+    const bool converged = (SMALL_RESIDUAL == mStatistics.mTermination
+                            || SMALL_GRADIENT == mStatistics.mTermination
+                            || SMALL_STEP == mStatistics.mTermination);
+
+    solved = converged && checkConstraints(*problem, x);
+    if(solved)
+      break;
+
+    ++attempt;
+    if(mLMP.mMaxAttempts > 0 && attempt >= mLMP.mMaxAttempts)
+      break;
+
+    if(attempt-1 >= problem->getSeeds().size())
+      break;
+
+    x = problem->getSeed(attempt-1);
+  }
+
+  problem->setOptimalSolution(x);
+  if(problem->getObjective())
+    problem->setOptimumValue(problem->getObjective()->eval(x));
+  else
+    problem->setOptimumValue(0.0);
+
+  if(nullptr != mProperties.mOutStream && mProperties.mPrintFinalResult)
+  {
+    *mProperties.mOutStream
+        << "[LevenbergMarquardtSolver] Finished after "
+        << mStatistics.mNumIterations << " iterations ("
+        << mStatistics.mNumAcceptedSteps << " accepted | "
+        << mStatistics.mNumRejectedSteps << " rejected)\n"
+        << "cost: " << mStatistics.mFinalCost << " | "
+        << "gradient: " << mStatistics.mFinalGradientNorm << " | "
+        << (solved? "solved" : "not solved") << "\n"
+        << "x: " << x.transpose() << std::endl;
+  }
+
+  return solved;
+}
+
+//==============================================================================
+std::string LevenbergMarquardtSolver::getType() const
+{
+  return Type;
+}
+
+//==============================================================================
+std::shared_ptr<Solver> LevenbergMarquardtSolver::clone() const
+{
+  return std::make_shared<LevenbergMarquardtSolver>(
+        getLevenbergMarquardtProperties());
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setProperties(const Properties& _properties)
+{
+  Solver::setProperties(_properties);
+  setProperties(static_cast<const UniqueProperties&>(_properties));
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setProperties(
+    const UniqueProperties& _properties)
+{
+  mLMP = _properties;
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::Properties
+LevenbergMarquardtSolver::getLevenbergMarquardtProperties() const
+{
+  return Properties(getSolverProperties(), mLMP);
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::copy(const LevenbergMarquardtSolver& _other)
+{
+  if(this == &_other)
+    return;
+
+  setProperties(_other.getLevenbergMarquardtProperties());
+}
+
+//==============================================================================
+LevenbergMarquardtSolver& LevenbergMarquardtSolver::operator=(
+    const LevenbergMarquardtSolver& _other)
+{
+  copy(_other);
+  return *this;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setInitialDamping(double _damping)
+{
+  mLMP.mInitialDamping = std::abs(_damping);
+}
+
+//==============================================================================
+double LevenbergMarquardtSolver::getInitialDamping() const
+{
+  return mLMP.mInitialDamping;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setDampingFactor(double _factor)
+{
+  mLMP.mDampingFactor = _factor;
+}
+
+//==============================================================================
+double LevenbergMarquardtSolver::getDampingFactor() const
+{
+  return mLMP.mDampingFactor;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setGradientTolerance(double _tolerance)
+{
+  mLMP.mGradientTolerance = std::abs(_tolerance);
+}
+
+//==============================================================================
+double LevenbergMarquardtSolver::getGradientTolerance() const
+{
+  return mLMP.mGradientTolerance;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setStepTolerance(double _tolerance)
+{
+  mLMP.mStepTolerance = std::abs(_tolerance);
+}
+
+//==============================================================================
+double LevenbergMarquardtSolver::getStepTolerance() const
+{
+  return mLMP.mStepTolerance;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setMaxAttempts(std::size_t _maxAttempts)
+{
+  mLMP.mMaxAttempts = _maxAttempts;
+}
+
+//==============================================================================
+std::size_t LevenbergMarquardtSolver::getMaxAttempts() const
+{
+  return mLMP.mMaxAttempts;
+}
+
+//==============================================================================
+const LevenbergMarquardtSolver::Statistics&
+LevenbergMarquardtSolver::getLastStatistics() const
+{
+  return mStatistics;
+}
+
+//==============================================================================
+static const ResidualFunction* asResidualFunction(const FunctionPtr& _function)
+{
+  return dynamic_cast<const ResidualFunction*>(_function.get());
+}
+
+//==============================================================================
+static std::size_t getNumResiduals(const FunctionPtr& _function)
+{
+  const ResidualFunction* residual = asResidualFunction(_function);
+  return residual? residual->getResidualDimension() : 1u;
+}
+
+//==============================================================================
+static std::size_t getNumResiduals(const Problem& _problem)
+{
+  std::size_t numResiduals = 0;
+
+  if(_problem.getObjective())
+    numResiduals += getNumResiduals(_problem.getObjective());
+
+  for(std::size_t i=0; i < _problem.getNumEqConstraints(); ++i)
+    numResiduals += getNumResiduals(_problem.getEqConstraint(i));
+
+  // Inequality constraints are always treated as scalar functions
+  numResiduals += _problem.getNumIneqConstraints();
+
+  return numResiduals;
+}
+
+//==============================================================================
+double LevenbergMarquardtSolver::computeResidual(
+    const Problem& _problem, const Eigen::VectorXd& _x)
+{
+  ++mStatistics.mNumResidualEvaluations;
+
+  mResidual.resize(static_cast<int>(getNumResiduals(_problem)));
+
+  int row = 0;
+  const auto addFunction = [&](const FunctionPtr& _function, bool _inequality)
+  {
+    const ResidualFunction* residual =
+        _inequality? nullptr : asResidualFunction(_function);
+    if(residual)
+    {
+      const int rows = static_cast<int>(residual->getResidualDimension());
+      residual->evalResidual(
+            _x, Eigen::Map<Eigen::VectorXd>(mResidual.data() + row, rows));
+      row += rows;
+    }
+    else
+    {
+      const double value = _function->eval(_x);
+      mResidual[row] = (_inequality && value < 0.0)? 0.0 : value;
+      ++row;
+    }
+  };
+
+  if(_problem.getObjective())
+    addFunction(_problem.getObjective(), false);
+
+  for(std::size_t i=0; i < _problem.getNumEqConstraints(); ++i)
+    addFunction(_problem.getEqConstraint(i), false);
+
+  for(std::size_t i=0; i < _problem.getNumIneqConstraints(); ++i)
+    addFunction(_problem.getIneqConstraint(i), true);
+
+  assert(row == mResidual.size());
+
+  return 0.5 * mResidual.squaredNorm();
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::computeJacobian(
+    const Problem& _problem, const Eigen::VectorXd& _x)
+{
+  ++mStatistics.mNumJacobianEvaluations;
+
+  const int n = static_cast<int>(_x.size());
+  mJacobian.setZero(mResidual.size(), n);
+  mFunctionGradient.resize(n);
+
+  int row = 0;
+  const auto addFunction = [&](const FunctionPtr& _function, bool _inequality)
+  {
+    const ResidualFunction* residual =
+        _inequality? nullptr : asResidualFunction(_function);
+    if(residual)
+    {
+      const int rows = static_cast<int>(residual->getResidualDimension());
+      mFunctionJacobian.resize(rows, n);
+      residual->evalResidualJacobian(
+            _x, Eigen::Map<Eigen::MatrixXd>(mFunctionJacobian.data(), rows, n));
+      mJacobian.middleRows(row, rows) = mFunctionJacobian;
+      row += rows;
+    }
+    else
+    {
+      // An inactive inequality constraint contributes a zero residual, so its
+      // Jacobian row stays zero
+      if(!_inequality || mResidual[row] > 0.0)
+      {
+        _function->evalGradient(_x, mFunctionGradient);
+        mJacobian.row(row) = mFunctionGradient.transpose();
+      }
+      ++row;
+    }
+  };
+
+  if(_problem.getObjective())
+    addFunction(_problem.getObjective(), false);
+
+  for(std::size_t i=0; i < _problem.getNumEqConstraints(); ++i)
+    addFunction(_problem.getEqConstraint(i), false);
+
+  for(std::size_t i=0; i < _problem.getNumIneqConstraints(); ++i)
+    addFunction(_problem.getIneqConstraint(i), true);
+
+  assert(row == mResidual.size());
+}
+
+//==============================================================================
+bool LevenbergMarquardtSolver::checkConstraints(
+    const Problem& _problem, const Eigen::VectorXd& _x)
+{
+  const double tol = std::abs(mProperties.mTolerance);
+
+  for(std::size_t i=0; i < _problem.getNumEqConstraints(); ++i)
+  {
+    const FunctionPtr& constraint = _problem.getEqConstraint(i);
+    const ResidualFunction* residual = asResidualFunction(constraint);
+    if(residual)
+    {
+      const int rows = static_cast<int>(residual->getResidualDimension());
+      mFunctionResidual.resize(rows);
+      residual->evalResidual(
+            _x, Eigen::Map<Eigen::VectorXd>(mFunctionResidual.data(), rows));
+      if(mFunctionResidual.norm() > tol)
+        return false;
+    }
+    else if(std::abs(constraint->eval(_x)) > tol)
+    {
+      return false;
+    }
+  }
+
+  for(std::size_t i=0; i < _problem.getNumIneqConstraints(); ++i)
+  {
+    if(_problem.getIneqConstraint(i)->eval(_x) > tol)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::Termination LevenbergMarquardtSolver::iterate(
+    const Problem& _problem, Eigen::VectorXd& _x, std::size_t _attempt)
+{
+  const double tol = std::abs(mProperties.mTolerance);
+  const Eigen::VectorXd& lower = _problem.getLowerBounds();
+  const Eigen::VectorXd& upper = _problem.getUpperBounds();
+  const int n = static_cast<int>(_x.size());
+
+  for(int i=0; i < n; ++i)
+    _x[i] = math::clip(_x[i], lower[i], upper[i]);
+
+  mDamping = mLMP.mInitialDamping;
+
+  double cost = computeResidual(_problem, _x);
+  computeJacobian(_problem, _x);
+  mStatistics.mInitialCost = cost;
+
+  std::size_t stepCount = 0;
+  while(true)
+  {
+    mStatistics.mFinalCost = cost;
+    mGradient.noalias() = mJacobian.transpose() * mResidual;
+
+    // Prune the columns of variables that are on a bound and being pushed
+    // into it, which are held fixed, and of variables that no residual depends
+    // on at this point. The normal equations of the remaining columns are
+    // still dense.
+    mActiveColumns.clear();
+    double gradientNorm = 0.0;
+    for(int i=0; i < n; ++i)
+    {
+      if( (_x[i] <= lower[i] && mGradient[i] > 0.0)
+          || (_x[i] >= upper[i] && mGradient[i] < 0.0) )
+        continue;
+
+      gradientNorm = std::max(gradientNorm, std::abs(mGradient[i]));
+
+      if((mJacobian.col(i).array() == 0.0).all())
+        continue;
+
+      mActiveColumns.push_back(i);
+    }
+    mStatistics.mFinalGradientNorm = gradientNorm;
+
+    if(std::sqrt(2.0*cost) <= tol)
+      return SMALL_RESIDUAL;
+
+    if(gradientNorm <= mLMP.mGradientTolerance || mActiveColumns.empty())
+      return SMALL_GRADIENT;
+
+    const int k = static_cast<int>(mActiveColumns.size());
+    mReducedJacobian.resize(mJacobian.rows(), k);
+    mReducedGradient.resize(k);
+    for(int j=0; j < k; ++j)
+    {
+      mReducedJacobian.col(j) = mJacobian.col(mActiveColumns[j]);
+      mReducedGradient[j] = -mGradient[mActiveColumns[j]];
+    }
+
+    // Only the lower triangle of the normal matrix is computed and used
+    mNormalMatrix.setZero(k, k);
+    mNormalMatrix.selfadjointView<Eigen::Lower>().rankUpdate(
+          mReducedJacobian.transpose());
+
+    bool accepted = false;
+    while(!accepted)
+    {
+      if(mProperties.mNumMaxIterations > 0
+         && stepCount >= mProperties.mNumMaxIterations)
+        return MAX_ITERATIONS;
+
+      ++stepCount;
+      ++mStatistics.mNumIterations;
+
+      // Marquardt's scaling of the damping term makes the step invariant to
+      // the scaling of the individual variables
+      mDampedMatrix = mNormalMatrix;
+      for(int j=0; j < k; ++j)
+        mDampedMatrix(j,j) += mDamping * std::max(mNormalMatrix(j,j), 1e-9);
+
+      mLDLT.compute(mDampedMatrix);
+      mReducedStep = mLDLT.solve(mReducedGradient);
+
+      mTrialX = _x;
+      for(int j=0; j < k; ++j)
+      {
+        const int i = mActiveColumns[j];
+        mTrialX[i] = math::clip(mTrialX[i] + mReducedStep[j],
+                                lower[i], upper[i]);
+      }
+
+      const double stepNorm = (mTrialX - _x).norm();
+      if(stepNorm <= mLMP.mStepTolerance*(_x.norm() + mLMP.mStepTolerance))
+        return SMALL_STEP;
+
+      const double trialCost = computeResidual(_problem, mTrialX);
+      if(std::isfinite(trialCost) && trialCost < cost)
+      {
+        accepted = true;
+        ++mStatistics.mNumAcceptedSteps;
+
+        _x = mTrialX;
+        cost = trialCost;
+        computeJacobian(_problem, _x);
+
+        mDamping = std::max(mDamping / mLMP.mDampingFactor, mLMP.mMinDamping);
+      }
+      else
+      {
+        ++mStatistics.mNumRejectedSteps;
+
+        mDamping *= mLMP.mDampingFactor;
+        if(mDamping > mLMP.mMaxDamping)
+          return MAX_DAMPING;
+      }
+
+      if(nullptr != mProperties.mOutStream &&
+         mProperties.mIterationsPerPrint > 0 &&
+         stepCount%mProperties.mIterationsPerPrint == 0)
+      {
+        *mProperties.mOutStream
+            << "[LevenbergMarquardtSolver] Progress (attempt #"
+            << _attempt << " | iteration #" << stepCount << ")\n"
+            << "cost: " << cost << " | "
+            << "damping: " << mDamping << " | "
+            << (accepted? "step accepted | " : "step rejected | ")
+            << "x: " << _x.transpose() << std::endl;
+      }
+    }
+  }
+}
+
+} // namespace optimizer
+} // namespace dart
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_OPTIMIZER_LEVENBERGMARQUARDTSOLVER_HPP_
+#define DART_OPTIMIZER_LEVENBERGMARQUARDTSOLVER_HPP_
+
+#include <vector>
+
+#include "dart/optimizer/Solver.hpp"
+#include "dart/optimizer/ResidualFunction.hpp"
+
+namespace dart {
+namespace optimizer {
+
+/// LevenbergMarquardtSolver is a native damped Gauss-Newton solver for
+/// nonlinear least-squares problems with box constraints.
+///
+/// The objective and every constraint of the Problem are stacked into a single
+/// residual vector:
+/// - A ResidualFunction contributes its residual vector and residual Jacobian.
+/// - Any other Function f contributes the single residual f(x) with the
+///   gradient of f as its Jacobian row. For equality constraints this drives
+///   f(x) to zero. For objectives this minimizes |f(x)|, so it is only
+///   meaningful for non-negative cost functions.
+/// - An inequality constraint g(x) <= 0 contributes max(0, g(x)).
+///
+/// The lower and upper bounds of the Problem are enforced by projecting each
+/// step onto the box, and by excluding variables that sit on a bound (and are
+/// being pushed into it) from the normal equations.
+///
+/// Columns of the stacked Jacobian that are entirely zero are pruned from the
+/// normal equations as well, which helps when only some of the variables are
+/// involved at the current point. This is only column pruning: the Jacobian
+/// and the normal matrix of the remaining columns are dense and the normal
+/// matrix is factored with a dense LDLT, so the cost per iteration is cubic in
+/// the number of remaining variables.
+class LevenbergMarquardtSolver : public Solver
+{
+public:
+
+  static const std::string Type;
+
+  /// The reason that the last call to solve() stopped iterating
+  enum Termination
+  {
+    NOT_SOLVED = 0,   ///< solve() has not been called, or the Problem was null
+    SMALL_RESIDUAL,   ///< The residual norm fell below the tolerance
+    SMALL_GRADIENT,   ///< The (projected) gradient fell below its tolerance
+    SMALL_STEP,       ///< The step fell below its tolerance
+    MAX_DAMPING,      ///< No step could decrease the cost
+    MAX_ITERATIONS    ///< The iteration limit was reached
+  };
+
+  /// Convergence statistics of the last call to solve()
+  struct Statistics
+  {
+    /// Reason for stopping
+    Termination mTermination;
+
+    /// Total number of iterations (accepted and rejected steps) over all
+    /// attempts
+    std::size_t mNumIterations;
+
+    /// Number of steps that were accepted
+    std::size_t mNumAcceptedSteps;
+
+    /// Number of steps that were rejected because they did not reduce the cost
+    std::size_t mNumRejectedSteps;
+
+    /// Number of residual evaluations
+    std::size_t mNumResidualEvaluations;
+
+    /// Number of residual Jacobian evaluations
+    std::size_t mNumJacobianEvaluations;
+
+    /// Number of attempts (initial guess plus seeds) that were used
+    std::size_t mNumAttempts;
+
+    /// Cost 0.5*||r||^2 at the start of the last attempt
+    double mInitialCost;
+
+    /// Cost 0.5*||r||^2 at the returned solution
+    double mFinalCost;
+
+    /// Infinity norm of the projected gradient at the returned solution
+    double mFinalGradientNorm;
+
+    /// Damping value at the end of the last attempt
+    double mFinalDamping;
+
+    /// Default constructor
+    Statistics();
+  };
+
+  struct UniqueProperties
+  {
+    /// Damping value used for the first iteration of each attempt
+    double mInitialDamping;
+
+    /// Factor that the damping is multiplied by after a rejected step and
+    /// divided by after an accepted step
+    double mDampingFactor;
+
+    /// Smallest damping value that will be used
+    double mMinDamping;
+
+    /// Once the damping exceeds this value, the solver gives up on finding a
+    /// step that reduces the cost
+    double mMaxDamping;
+
+    /// The solver stops when the infinity norm of the projected gradient
+    /// J^T*r falls below this value
+    double mGradientTolerance;
+
+    /// The solver stops when the norm of the step falls below
+    /// mStepTolerance*(||x|| + mStepTolerance)
+    double mStepTolerance;
+
+    /// Number of attempts to make before quitting. The first attempt starts
+    /// from the initial guess of the Problem, and each following attempt
+    /// starts from the next seed of the Problem.
+    std::size_t mMaxAttempts;
+
+    UniqueProperties(
+        double _initialDamping = 1e-3,
+        double _dampingFactor = 10.0,
+        double _minDamping = 1e-12,
+        double _maxDamping = 1e12,
+        double _gradientTolerance = 1e-12,
+        double _stepTolerance = 1e-12,
+        std::size_t _maxAttempts = 1);
+  };
+
+  struct Properties : Solver::Properties, UniqueProperties
+  {
+    Properties(
+        const Solver::Properties& _solverProperties = Solver::Properties(),
+        const UniqueProperties& _lmProperties = UniqueProperties() );
+  };
+
+  /// Default constructor
+  explicit LevenbergMarquardtSolver(
+      const Properties& _properties = Properties());
+
+  /// Alternative constructor
+  explicit LevenbergMarquardtSolver(std::shared_ptr<Problem> _problem);
+
+  /// Destructor
+  virtual ~LevenbergMarquardtSolver();
+
+  /// Solve the Problem. Returns true if the solver converged and all the
+  /// constraints of the Problem are satisfied to within the tolerance.
+  bool solve() override;
+
+  // Documentation inherited
+  std::string getType() const override;
+
+  // Documentation inherited
+  std::shared_ptr<Solver> clone() const override;
+
+  /// Set the Properties of this LevenbergMarquardtSolver
+  void setProperties(const Properties& _properties);
+
+  /// Set the Properties of this LevenbergMarquardtSolver
+  void setProperties(const UniqueProperties& _properties);
+
+  /// Get the Properties of this LevenbergMarquardtSolver
+  Properties getLevenbergMarquardtProperties() const;
+
+  /// Copy the Properties of another LevenbergMarquardtSolver
+  void copy(const LevenbergMarquardtSolver& _other);
+
+  /// Copy the Properties of another LevenbergMarquardtSolver
+  LevenbergMarquardtSolver& operator=(const LevenbergMarquardtSolver& _other);
+
+  /// Set UniqueProperties::mInitialDamping
+  void setInitialDamping(double _damping);
+
+  /// Get UniqueProperties::mInitialDamping
+  double getInitialDamping() const;
+
+  /// Set UniqueProperties::mDampingFactor
+  void setDampingFactor(double _factor);
+
+  /// Get UniqueProperties::mDampingFactor
+  double getDampingFactor() const;
+
+  /// Set UniqueProperties::mGradientTolerance
+  void setGradientTolerance(double _tolerance);
+
+  /// Get UniqueProperties::mGradientTolerance
+  double getGradientTolerance() const;
+
+  /// Set UniqueProperties::mStepTolerance
+  void setStepTolerance(double _tolerance);
+
+  /// Get UniqueProperties::mStepTolerance
+  double getStepTolerance() const;
+
+  /// Set UniqueProperties::mMaxAttempts
+  void setMaxAttempts(std::size_t _maxAttempts);
+
+  /// Get UniqueProperties::mMaxAttempts
+  std::size_t getMaxAttempts() const;
+
+  /// Get the convergence statistics of the last call to solve()
+  const Statistics& getLastStatistics() const;
+
+protected:
+
+  /// Evaluate the stacked residual vector of the Problem at _x into mResidual
+  /// and return the cost 0.5*||r||^2
+  double computeResidual(const Problem& _problem, const Eigen::VectorXd& _x);
+
+  /// Evaluate the stacked residual Jacobian of the Problem at _x into
+  /// mJacobian. mResidual must already hold the residual vector at _x.
+  void computeJacobian(const Problem& _problem, const Eigen::VectorXd& _x);
+
+  /// Returns true if all the constraints of the Problem are satisfied at _x
+  bool checkConstraints(const Problem& _problem, const Eigen::VectorXd& _x);
+
+  /// Run one attempt starting from _x, which will be updated in place.
+  /// Returns the reason that the attempt stopped.
+  Termination iterate(const Problem& _problem, Eigen::VectorXd& _x,
+                      std::size_t _attempt);
+
+  /// LevenbergMarquardtSolver properties
+  UniqueProperties mLMP;
+
+  /// Statistics of the last solve
+  Statistics mStatistics;
+
+  /// Current damping value
+  double mDamping;
+
+  /// Stacked residual vector
+  Eigen::VectorXd mResidual;
+
+  /// Stacked residual Jacobian
+  Eigen::MatrixXd mJacobian;
+
+  /// Scratch space for the gradient of scalar functions and the residuals and
+  /// Jacobians of ResidualFunctions
+  Eigen::VectorXd mFunctionGradient;
+  Eigen::VectorXd mFunctionResidual;
+  Eigen::MatrixXd mFunctionJacobian;
+
+  /// Columns of the Jacobian that were not pruned, which are the variables
+  /// that take part in the normal equations
+  std::vector<int> mActiveColumns;
+
+  /// Workspace for the pruned normal equations
+  Eigen::MatrixXd mReducedJacobian;
+  Eigen::MatrixXd mNormalMatrix;
+  Eigen::MatrixXd mDampedMatrix;
+  Eigen::VectorXd mReducedGradient;
+  Eigen::VectorXd mReducedStep;
+  Eigen::LDLT<Eigen::MatrixXd> mLDLT;
+
+  /// Full gradient J^T*r
+  Eigen::VectorXd mGradient;
+
+  /// Trial configuration
+  Eigen::VectorXd mTrialX;
+};
+
+} // namespace optimizer
+} // namespace dart
+
+#endif // DART_OPTIMIZER_LEVENBERGMARQUARDTSOLVER_HPP_
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/optimizer/ResidualFunction.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace dart {
+namespace optimizer {
+
+//==============================================================================
+ResidualFunction::ResidualFunction(const std::string& name)
+  : Function(name)
+{
+  // Do nothing
+}
+
+//==============================================================================
+ResidualFunction::~ResidualFunction()
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ResidualFunction::evalResidualJacobian(
+    const Eigen::VectorXd& x, Eigen::Map<Eigen::MatrixXd> jacobian) const
+{
+  const int m = static_cast<int>(getResidualDimension());
+  const double sqrtEps = std::sqrt(std::numeric_limits<double>::epsilon());
+
+  mFiniteDifferenceResidualCache.resize(m);
+  evalResidual(x, Eigen::Map<Eigen::VectorXd>(
+                 mFiniteDifferenceResidualCache.data(), m));
+
+  mPerturbedCache = x;
+  mPerturbedResidualCache.resize(m);
+  Eigen::Map<Eigen::VectorXd> perturbed(mPerturbedResidualCache.data(), m);
+  for(int i=0; i < x.size(); ++i)
+  {
+    const double h = sqrtEps * std::max(1.0, std::abs(x[i]));
+    mPerturbedCache[i] = x[i] + h;
+    evalResidual(mPerturbedCache, perturbed);
+    jacobian.col(i) =
+        (mPerturbedResidualCache - mFiniteDifferenceResidualCache) / h;
+    mPerturbedCache[i] = x[i];
+  }
+}
+
+//==============================================================================
+double ResidualFunction::eval(const Eigen::VectorXd& x) const
+{
+  const int m = static_cast<int>(getResidualDimension());
+  mResidualCache.resize(m);
+  evalResidual(x, Eigen::Map<Eigen::VectorXd>(mResidualCache.data(), m));
+
+  return 0.5 * mResidualCache.squaredNorm();
+}
+
+//==============================================================================
+void ResidualFunction::evalGradient(
+    const Eigen::VectorXd& x, Eigen::Map<Eigen::VectorXd> grad) const
+{
+  evalWithGradient(x, grad);
+}
+
+//==============================================================================
+double ResidualFunction::evalWithGradient(
+    const Eigen::VectorXd& x, Eigen::Map<Eigen::VectorXd> grad) const
+{
+  const int m = static_cast<int>(getResidualDimension());
+  const int n = static_cast<int>(x.size());
+
+  mResidualCache.resize(m);
+  evalResidual(x, Eigen::Map<Eigen::VectorXd>(mResidualCache.data(), m));
+  const double value = 0.5 * mResidualCache.squaredNorm();
+
+  mJacobianCache.resize(m, n);
+  evalResidualJacobian(
+        x, Eigen::Map<Eigen::MatrixXd>(mJacobianCache.data(), m, n));
+
+  grad.noalias() = mJacobianCache.transpose() * mResidualCache;
+
+  return value;
+}
+
+}  // namespace optimizer
+}  // namespace dart
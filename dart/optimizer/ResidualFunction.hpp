@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_OPTIMIZER_RESIDUALFUNCTION_HPP_
+#define DART_OPTIMIZER_RESIDUALFUNCTION_HPP_
+
+#include "dart/optimizer/Function.hpp"
+
+namespace dart {
+namespace optimizer {
+
+/// ResidualFunction is a Function that is defined by a vector of residuals
+/// r(x). Least-squares solvers (such as LevenbergMarquardtSolver) work
+/// directly with the residuals and their Jacobian, which carries much more
+/// information than the scalar value and gradient.
+///
+/// By default, eval() returns 0.5*||r(x)||^2 and evalGradient() returns
+/// J(x)^T * r(x) so that the Function can still be used by any other Solver.
+/// Derived classes may override those to provide a different scalarization.
+class ResidualFunction : public Function
+{
+public:
+  /// Constructor
+  explicit ResidualFunction(const std::string& name = "residual_function");
+
+  /// Destructor
+  virtual ~ResidualFunction();
+
+  /// Get the number of residuals produced by this Function
+  virtual std::size_t getResidualDimension() const = 0;
+
+  /// Evaluate the residual vector at the point x. The residual map will have
+  /// getResidualDimension() entries.
+  virtual void evalResidual(const Eigen::VectorXd& x,
+                            Eigen::Map<Eigen::VectorXd> residual) const = 0;
+
+  /// Evaluate the Jacobian of the residual vector at the point x. The map will
+  /// have getResidualDimension() rows and x.size() columns.
+  ///
+  /// The default implementation uses forward finite differences, which costs
+  /// one evalResidual() call per dimension of x. Override this whenever an
+  /// analytical Jacobian is available.
+  virtual void evalResidualJacobian(const Eigen::VectorXd& x,
+                                    Eigen::Map<Eigen::MatrixXd> jacobian) const;
+
+  /// Returns 0.5*||r(x)||^2
+  double eval(const Eigen::VectorXd& x) const override;
+
+  /// Returns J(x)^T * r(x)
+  void evalGradient(const Eigen::VectorXd& x,
+                    Eigen::Map<Eigen::VectorXd> grad) const override;
+
+  /// Returns 0.5*||r(x)||^2 and J(x)^T * r(x), evaluating the residuals only
+  /// once
+  double evalWithGradient(const Eigen::VectorXd& x,
+                          Eigen::Map<Eigen::VectorXd> grad) const override;
+
+protected:
+  /// Cache for the residual vector
+  mutable Eigen::VectorXd mResidualCache;
+
+  /// Cache for the residual Jacobian
+  mutable Eigen::MatrixXd mJacobianCache;
+
+  /// Cache for the unperturbed residual used by finite differences
+  mutable Eigen::VectorXd mFiniteDifferenceResidualCache;
+
+  /// Cache for the perturbed configuration used by finite differences
+  mutable Eigen::VectorXd mPerturbedCache;
+
+  /// Cache for the perturbed residual used by finite differences
+  mutable Eigen::VectorXd mPerturbedResidualCache;
+};
+
+using ResidualFunctionPtr = std::shared_ptr<ResidualFunction>;
+
+}  // namespace optimizer
+}  // namespace dart
+
+#endif  // DART_OPTIMIZER_RESIDUALFUNCTION_HPP_
@@ -38,15 +38,23 @@
 
 #include "dart/simulation/World.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "dart/common/Console.hpp"
 #include "dart/integration/SemiImplicitEulerIntegrator.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/CollisionGroup.hpp"
+#include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/CollisionResult.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
 
 namespace dart {
 namespace simulation {
@@ -64,6 +72,14 @@ World::World(const std::string& _name)
     mNameMgrForSimpleFrames("World::SimpleFrame | " + _name, "frame"),
     mGravity(0.0, 0.0, -9.81),
     mTimeStep(0.001),
+    mIsUsingAdaptiveTimeStep(false),
+    mMaxContactError(1e-3),
+    mMinTimeStep(1e-5),
+    mCurrentTimeStep(mTimeStep),
+    mIsSleepingEnabled(false),
+    mSleepKineticEnergy(1e-4),
+    mNumStepsToSleep(60u),
+    mNextSleepingIsland(0u),
     mTime(0.0),
     mFrame(0),
     mConstraintSolver(new constraint::ConstraintSolver(mTimeStep)),
@@ -98,10 +114,17 @@ WorldPtr World::clone() const
   worldClone->getConstraintSolver()->setCollisionDetector(
       cd->cloneWithoutCollisionObjects());
 
+  worldClone->setAdaptiveTimeStep(
+        mIsUsingAdaptiveTimeStep, mMaxContactError, mMinTimeStep);
+  worldClone->setSleepingEnabled(
+        mIsSleepingEnabled, mSleepKineticEnergy, mNumStepsToSleep);
+
   // Clone and add each Skeleton
   for(std::size_t i=0; i<mSkeletons.size(); ++i)
   {
-    worldClone->addSkeleton(mSkeletons[i]->clone());
+    dynamics::SkeletonPtr skelClone = mSkeletons[i]->clone();
+    worldClone->addSkeleton(skelClone);
+    worldClone->setNumSubSteps(skelClone, mNumSubSteps[i]);
   }
 
   // Clone and add each SimpleFrame
@@ -134,13 +157,10 @@ void World::setTimeStep(double _timeStep)
   assert(_timeStep > 0.0 && "Invalid timestep.");
 
   mTimeStep = _timeStep;
-//  mConstraintHandler->setTimeStep(_timeStep);
+  mCurrentTimeStep = _timeStep;
   mConstraintSolver->setTimeStep(_timeStep);
-  for (std::vector<dynamics::SkeletonPtr>::iterator it = mSkeletons.begin();
-       it != mSkeletons.end(); ++it)
-  {
-    (*it)->setTimeStep(_timeStep);
-  }
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+    mSkeletons[i]->setTimeStep(_timeStep / mNumSubSteps[i]);
 }
 
 //==============================================================================
@@ -149,6 +169,205 @@ double World::getTimeStep() const
   return mTimeStep;
 }
 
+//==============================================================================
+void World::setNumSubSteps(const dynamics::SkeletonPtr& _skeleton,
+                           std::size_t _numSubSteps)
+{
+  if (_numSubSteps == 0u)
+  {
+    dtwarn << "[World::setNumSubSteps] Attempting to set the number of "
+           << "sub-steps to zero. The number of sub-steps must be at least "
+           << "one.\n";
+    return;
+  }
+
+  const auto it = std::find(mSkeletons.begin(), mSkeletons.end(), _skeleton);
+  if (it == mSkeletons.end())
+  {
+    dtwarn << "[World::setNumSubSteps] Skeleton ["
+           << (_skeleton ? _skeleton->getName() : "nullptr")
+           << "] is not in the world.\n";
+    return;
+  }
+
+  mNumSubSteps[it - mSkeletons.begin()] = _numSubSteps;
+  updateTimeSteps();
+}
+
+//==============================================================================
+std::size_t World::getNumSubSteps(
+    const dynamics::ConstSkeletonPtr& _skeleton) const
+{
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    if (mSkeletons[i] == _skeleton)
+      return mNumSubSteps[i];
+  }
+
+  return 0u;
+}
+
+//==============================================================================
+void World::setAdaptiveTimeStep(bool _adaptive, double _maxContactError,
+                                double _minTimeStep)
+{
+  assert(_maxContactError > 0.0 && "Invalid contact error.");
+  assert(_minTimeStep > 0.0 && "Invalid timestep.");
+
+  mIsUsingAdaptiveTimeStep = _adaptive;
+  mMaxContactError = _maxContactError;
+  mMinTimeStep = _minTimeStep;
+
+  if (!mIsUsingAdaptiveTimeStep && mCurrentTimeStep != mTimeStep)
+  {
+    mCurrentTimeStep = mTimeStep;
+    updateTimeSteps();
+  }
+}
+
+//==============================================================================
+bool World::isUsingAdaptiveTimeStep() const
+{
+  return mIsUsingAdaptiveTimeStep;
+}
+
+//==============================================================================
+double World::getCurrentTimeStep() const
+{
+  return mCurrentTimeStep;
+}
+
+namespace {
+
+//==============================================================================
+/// Ignores the pairs of CollisionObjects that both belong to immobile
+/// Skeletons, which includes the sleeping ones, and hands the other pairs to
+/// the filter that was in use before sleeping was enabled
+class SleepingCollisionFilter : public collision::CollisionFilter
+{
+public:
+  SleepingCollisionFilter(
+      const std::shared_ptr<collision::CollisionFilter>& _filter)
+    : mFilter(_filter)
+  {
+    // Do nothing
+  }
+
+  bool ignoresCollision(
+      const collision::CollisionObject* _object1,
+      const collision::CollisionObject* _object2) const override
+  {
+    if (!isMobile(_object1) && !isMobile(_object2))
+      return true;
+
+    return mFilter && mFilter->ignoresCollision(_object1, _object2);
+  }
+
+  static bool isMobile(const collision::CollisionObject* _object)
+  {
+    const dynamics::ShapeNode* shapeNode
+        = _object->getShapeFrame()->asShapeNode();
+    if (nullptr == shapeNode)
+      return true;
+
+    // A Skeleton without DOFs cannot move even if it is flagged as mobile
+    const dynamics::ConstSkeletonPtr skel = shapeNode->getSkeleton();
+    return nullptr == skel || (skel->isMobile() && skel->getNumDofs() > 0u);
+  }
+
+  std::shared_ptr<collision::CollisionFilter> mFilter;
+};
+
+} // anonymous namespace
+
+//==============================================================================
+void World::setSleepingEnabled(bool _enabled, double _kineticEnergy,
+                               std::size_t _numSteps)
+{
+  assert(_kineticEnergy >= 0.0 && "Invalid kinetic energy.");
+
+  mSleepKineticEnergy = _kineticEnergy;
+  mNumStepsToSleep = _numSteps;
+
+  if (_enabled == mIsSleepingEnabled)
+    return;
+
+  mIsSleepingEnabled = _enabled;
+
+  collision::CollisionOption& option = mConstraintSolver->getCollisionOption();
+  if (mIsSleepingEnabled)
+  {
+    mSleepingCollisionFilter
+        = std::make_shared<SleepingCollisionFilter>(option.collisionFilter);
+    option.collisionFilter = mSleepingCollisionFilter;
+    return;
+  }
+
+  // Put back the filter that was wrapped, unless the filter has been replaced
+  // in the meantime
+  if (option.collisionFilter == mSleepingCollisionFilter)
+  {
+    option.collisionFilter = static_cast<SleepingCollisionFilter*>(
+          mSleepingCollisionFilter.get())->mFilter;
+  }
+  mSleepingCollisionFilter.reset();
+
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    mIsSleeping[i] = false;
+    mNumRestingSteps[i] = 0u;
+  }
+}
+
+//==============================================================================
+bool World::isSleepingEnabled() const
+{
+  return mIsSleepingEnabled;
+}
+
+//==============================================================================
+bool World::isSleeping(const dynamics::ConstSkeletonPtr& _skeleton) const
+{
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    if (mSkeletons[i] == _skeleton)
+      return mIsSleeping[i];
+  }
+
+  return false;
+}
+
+//==============================================================================
+void World::wakeUp(const dynamics::SkeletonPtr& _skeleton)
+{
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    if (mSkeletons[i] == _skeleton)
+    {
+      wakeUpIsland(i);
+      return;
+    }
+  }
+}
+
+//==============================================================================
+void World::wakeUpIsland(std::size_t _index)
+{
+  mNumRestingSteps[_index] = 0u;
+  if (!mIsSleeping[_index])
+    return;
+
+  const std::size_t island = mSleepingIslands[_index];
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    if (mIsSleeping[i] && mSleepingIslands[i] == island)
+    {
+      mIsSleeping[i] = false;
+      mNumRestingSteps[i] = 0u;
+    }
+  }
+}
+
 //==============================================================================
 void World::reset()
 {
@@ -156,48 +375,170 @@ void World::reset()
   mFrame = 0;
   mRecording->clear();
   mConstraintSolver->clearLastCollisionResult();
+
+  if (mCurrentTimeStep != mTimeStep)
+  {
+    mCurrentTimeStep = mTimeStep;
+    updateTimeSteps();
+  }
 }
 
 //==============================================================================
-void World::step(bool _resetCommand)
+static std::size_t computeLeastCommonMultiple(std::size_t _a, std::size_t _b)
 {
-  // Integrate velocity for unconstrained skeletons
-  for (auto& skel : mSkeletons)
+  std::size_t gcd = _a;
+  std::size_t remainder = _b;
+  while (remainder != 0u)
   {
-    if (!skel->isMobile())
-      continue;
+    const std::size_t next = gcd % remainder;
+    gcd = remainder;
+    remainder = next;
+  }
+
+  return _a / gcd * _b;
+}
+
+//==============================================================================
+static bool isDisturbed(const dynamics::Skeleton& _skel)
+{
+  if (!_skel.getForces().isZero(0.0) || !_skel.getCommands().isZero(0.0)
+      || !_skel.getVelocities().isZero(0.0))
+    return true;
+
+  for (std::size_t i = 0; i < _skel.getNumBodyNodes(); ++i)
+  {
+    if (!_skel.getBodyNode(i)->getExternalForceLocal().isZero(0.0))
+      return true;
+  }
+
+  return false;
+}
 
-    skel->computeForwardDynamics();
-    skel->integrateVelocities(mTimeStep);
+//==============================================================================
+void World::step(bool _resetCommand)
+{
+  if (mIsSleepingEnabled)
+  {
+    for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+    {
+      if (mIsSleeping[i] && isDisturbed(*mSkeletons[i]))
+        wakeUpIsland(i);
+    }
   }
 
-  // Detect activated constraints and compute constraint impulses
-  mConstraintSolver->solve();
+  // Every Skeleton takes a sub-step each numMicroSteps / mNumSubSteps[i]
+  // micro-steps
+  std::size_t numMicroSteps = 1u;
+  for (const std::size_t numSubSteps : mNumSubSteps)
+    numMicroSteps = computeLeastCommonMultiple(numMicroSteps, numSubSteps);
 
-  // Compute velocity changes given constraint impulses
-  for (auto& skel : mSkeletons)
+  std::vector<bool> isSubStepping(mSkeletons.size());
+  std::vector<std::size_t> rates;
+  std::vector<dynamics::Skeleton*> waiting;
+  for (std::size_t k = 0; k < numMicroSteps; ++k)
   {
-    if (!skel->isMobile())
+    rates.clear();
+    for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+    {
+      const bool isStarting = k % (numMicroSteps / mNumSubSteps[i]) == 0u;
+      if (isStarting)
+        rates.push_back(mNumSubSteps[i]);
+
+      isSubStepping[i]
+          = isStarting && mSkeletons[i]->isMobile() && !mIsSleeping[i];
+    }
+
+    // No sub-step starts at this micro-step
+    if (rates.empty())
       continue;
 
-    if (skel->isImpulseApplied())
+    std::sort(rates.begin(), rates.end(), std::greater<std::size_t>());
+    rates.erase(std::unique(rates.begin(), rates.end()), rates.end());
+
+    // The skeletons that share a sub-step length are advanced and solved
+    // together for that length, so that their constraint impulses are scaled
+    // for the time step they are integrated over. The other skeletons are
+    // held still meanwhile, and the sleeping ones do not respond at all.
+    for (const std::size_t rate : rates)
     {
-      skel->computeImpulseForwardDynamics();
-      skel->setImpulseApplied(false);
+      const double constraintTimeStep = mCurrentTimeStep / rate;
+      if (mConstraintSolver->getTimeStep() != constraintTimeStep)
+        mConstraintSolver->setTimeStep(constraintTimeStep);
+
+      // Integrate velocity for unconstrained skeletons, and hold the others
+      // still
+      waiting.clear();
+      for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+      {
+        dynamics::Skeleton* skel = mSkeletons[i].get();
+        if (!skel->isMobile())
+          continue;
+
+        if (!isSubStepping[i] || mNumSubSteps[i] != rate)
+        {
+          skel->setMobile(false);
+          waiting.push_back(skel);
+          continue;
+        }
+
+        skel->computeForwardDynamics();
+        skel->integrateVelocities(constraintTimeStep);
+      }
+
+      // Detect activated constraints and compute constraint impulses
+      mConstraintSolver->solve();
+
+      for (dynamics::Skeleton* skel : waiting)
+      {
+        skel->setMobile(true);
+        if (skel->isImpulseApplied())
+        {
+          skel->clearConstraintImpulses();
+          skel->setImpulseApplied(false);
+        }
+      }
+
+      // Compute velocity changes given constraint impulses
+      for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+      {
+        dynamics::Skeleton* skel = mSkeletons[i].get();
+        if (!isSubStepping[i] || mNumSubSteps[i] != rate
+            || !skel->isImpulseApplied())
+          continue;
+
+        skel->computeImpulseForwardDynamics();
+        skel->setImpulseApplied(false);
+      }
     }
 
-    skel->integratePositions(mTimeStep);
+    for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+    {
+      if (isSubStepping[i])
+        mSkeletons[i]->integratePositions(mCurrentTimeStep / mNumSubSteps[i]);
+    }
+  }
 
-    if (_resetCommand)
+  if (_resetCommand)
+  {
+    for (auto& skel : mSkeletons)
     {
+      if (!skel->isMobile())
+        continue;
+
       skel->clearInternalForces();
       skel->clearExternalForces();
       skel->resetCommands();
     }
   }
 
-  mTime += mTimeStep;
+  mTime += mCurrentTimeStep;
   mFrame++;
+
+  if (mIsSleepingEnabled)
+    updateSleeping();
+
+  if (mIsUsingAdaptiveTimeStep)
+    adaptTimeStep();
 }
 
 //==============================================================================
@@ -310,7 +651,11 @@ std::string World::addSkeleton(const dynamics::SkeletonPtr& _skeleton)
   _skeleton->setName(mNameMgrForSkeletons.issueNewNameAndAdd(
                        _skeleton->getName(), _skeleton));
 
-  _skeleton->setTimeStep(mTimeStep);
+  mNumSubSteps.push_back(1u);
+  mNumRestingSteps.push_back(0u);
+  mIsSleeping.push_back(false);
+  mSleepingIslands.push_back(0u);
+  _skeleton->setTimeStep(mCurrentTimeStep);
   _skeleton->setGravity(mGravity);
 
   mIndices.push_back(mIndices.back() + _skeleton->getNumDofs());
@@ -351,6 +696,9 @@ void World::removeSkeleton(const dynamics::SkeletonPtr& _skeleton)
     return;
   }
 
+  // The Skeletons that fell asleep on _skeleton may have lost their support
+  wakeUpIsland(index);
+
   // Update mIndices.
   for (std::size_t i = index+1; i < mSkeletons.size() - 1; ++i)
     mIndices[i] = mIndices[i+1] - _skeleton->getNumDofs();
@@ -362,6 +710,10 @@ void World::removeSkeleton(const dynamics::SkeletonPtr& _skeleton)
   // Remove _skeleton from mSkeletons
   mSkeletons.erase(remove(mSkeletons.begin(), mSkeletons.end(), _skeleton),
                    mSkeletons.end());
+  mNumSubSteps.erase(mNumSubSteps.begin() + index);
+  mNumRestingSteps.erase(mNumRestingSteps.begin() + index);
+  mIsSleeping.erase(mIsSleeping.begin() + index);
+  mSleepingIslands.erase(mSleepingIslands.begin() + index);
 
   // Disconnect the name change monitor
   mNameConnectionsForSkeletons[index].disconnect();
@@ -656,6 +1008,201 @@ void World::handleSimpleFrameNameChange(const dynamics::Entity* _entity)
   }
 }
 
+//==============================================================================
+void World::updateTimeSteps()
+{
+  mConstraintSolver->setTimeStep(mCurrentTimeStep);
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    const double timeStep = mCurrentTimeStep / mNumSubSteps[i];
+    if (mSkeletons[i]->getTimeStep() != timeStep)
+      mSkeletons[i]->setTimeStep(timeStep);
+  }
+}
+
+//==============================================================================
+static Eigen::Vector3d getContactVelocity(
+    const collision::CollisionObject* _object, const Eigen::Vector3d& _point)
+{
+  const dynamics::ShapeNode* shapeNode
+      = _object->getShapeFrame()->asShapeNode();
+  if (nullptr == shapeNode)
+    return Eigen::Vector3d::Zero();
+
+  const dynamics::BodyNode* bodyNode = shapeNode->getBodyNodePtr();
+  return bodyNode->getLinearVelocity(
+        bodyNode->getWorldTransform().inverse() * _point);
+}
+
+//==============================================================================
+void World::adaptTimeStep()
+{
+  // The error of a contact is how deep it penetrates, plus how much deeper it
+  // would get over another step at the current approach velocity
+  const collision::CollisionResult& result = getLastCollisionResult();
+  double maxError = 0.0;
+  for (std::size_t i = 0; i < result.getNumContacts(); ++i)
+  {
+    const collision::Contact& contact = result.getContact(i);
+    const Eigen::Vector3d relativeVelocity
+        = getContactVelocity(contact.collisionObject1, contact.point)
+        - getContactVelocity(contact.collisionObject2, contact.point);
+    const double approachVelocity
+        = std::max(0.0, -relativeVelocity.dot(contact.normal));
+
+    maxError = std::max(maxError, contact.penetrationDepth
+                        + mCurrentTimeStep * approachVelocity);
+  }
+
+  double timeStep = mCurrentTimeStep;
+  if (maxError > mMaxContactError)
+    timeStep = std::max(0.5 * timeStep, mMinTimeStep);
+  else if (maxError < 0.25 * mMaxContactError)
+    timeStep = std::min(2.0 * timeStep, mTimeStep);
+
+  if (timeStep != mCurrentTimeStep)
+  {
+    mCurrentTimeStep = timeStep;
+    updateTimeSteps();
+  }
+}
+
+//==============================================================================
+static std::size_t findIslandRoot(std::vector<std::size_t>& _parents,
+                                  std::size_t _index)
+{
+  while (_parents[_index] != _index)
+  {
+    _parents[_index] = _parents[_parents[_index]];
+    _index = _parents[_index];
+  }
+
+  return _index;
+}
+
+//==============================================================================
+void World::updateSleeping()
+{
+  const std::size_t numSkeletons = mSkeletons.size();
+  const std::size_t invalid = numSkeletons;
+
+  std::unordered_map<const dynamics::Skeleton*, std::size_t> indices;
+  std::vector<bool> isAwake(numSkeletons);
+  std::vector<std::size_t> parents(numSkeletons);
+  for (std::size_t i = 0; i < numSkeletons; ++i)
+  {
+    indices[mSkeletons[i].get()] = i;
+    parents[i] = i;
+    // Skeletons without DOFs act like immobile ones: they neither sleep nor
+    // join islands, so that a fixed ground does not merge everything on it
+    isAwake[i] = mSkeletons[i]->isMobile() && mSkeletons[i]->getNumDofs() > 0u
+        && !mIsSleeping[i];
+    if (!isAwake[i])
+      continue;
+
+    if (mSkeletons[i]->computeKineticEnergy() < mSleepKineticEnergy)
+      ++mNumRestingSteps[i];
+    else
+      mNumRestingSteps[i] = 0u;
+  }
+
+  auto getIndex = [&](const collision::CollisionObject* _object)
+  {
+    const dynamics::ShapeNode* shapeNode
+        = _object->getShapeFrame()->asShapeNode();
+    if (nullptr == shapeNode)
+      return invalid;
+
+    const auto it = indices.find(shapeNode->getSkeleton().get());
+    return it == indices.end() ? invalid : it->second;
+  };
+
+  // Join the awake Skeletons that touch or are constrained together into
+  // islands, and wake up the sleeping Skeletons that touch awake ones that have
+  // not rested long enough to sleep. The kinetic energy is not enough to tell,
+  // because the constraint impulses may already have stopped a Skeleton that
+  // ran into a sleeping one.
+  auto join = [&](std::size_t _index1, std::size_t _index2)
+  {
+    if (_index1 == invalid || _index2 == invalid)
+      return;
+
+    if (isAwake[_index1] && isAwake[_index2])
+    {
+      parents[findIslandRoot(parents, _index1)]
+          = findIslandRoot(parents, _index2);
+    }
+    else if (isAwake[_index1] && mIsSleeping[_index2])
+    {
+      if (mNumRestingSteps[_index1] < mNumStepsToSleep)
+        wakeUpIsland(_index2);
+    }
+    else if (isAwake[_index2] && mIsSleeping[_index1])
+    {
+      if (mNumRestingSteps[_index2] < mNumStepsToSleep)
+        wakeUpIsland(_index1);
+    }
+  };
+
+  const collision::CollisionResult& result = getLastCollisionResult();
+  for (std::size_t i = 0; i < result.getNumContacts(); ++i)
+  {
+    const collision::Contact& contact = result.getContact(i);
+    join(getIndex(contact.collisionObject1),
+         getIndex(contact.collisionObject2));
+  }
+
+  // Constraints that do not report their Skeletons cannot join islands
+  std::vector<dynamics::Skeleton*> constrainedSkeletons;
+  for (std::size_t i = 0; i < mConstraintSolver->getNumConstraints(); ++i)
+  {
+    constrainedSkeletons.clear();
+    if (!mConstraintSolver->getConstraint(i)->collectReactiveSkeletons(
+          constrainedSkeletons))
+      continue;
+
+    for (std::size_t j = 1; j < constrainedSkeletons.size(); ++j)
+    {
+      const auto it1 = indices.find(constrainedSkeletons[0]);
+      const auto it2 = indices.find(constrainedSkeletons[j]);
+      if (it1 != indices.end() && it2 != indices.end())
+        join(it1->second, it2->second);
+    }
+  }
+
+  // An island rests for as long as its most restless Skeleton does
+  std::vector<std::size_t> numRestingSteps(
+        numSkeletons, std::numeric_limits<std::size_t>::max());
+  for (std::size_t i = 0; i < numSkeletons; ++i)
+  {
+    if (!isAwake[i])
+      continue;
+
+    std::size_t& islandSteps = numRestingSteps[findIslandRoot(parents, i)];
+    islandSteps = std::min(islandSteps, mNumRestingSteps[i]);
+  }
+
+  // Each island that falls asleep gets an identifier from the next free one
+  // on, so that its Skeletons can be woken up together
+  std::vector<std::size_t> sleepingIslands(numSkeletons, invalid);
+  for (std::size_t i = 0; i < numSkeletons; ++i)
+  {
+    if (!isAwake[i])
+      continue;
+
+    const std::size_t root = findIslandRoot(parents, i);
+    if (numRestingSteps[root] < mNumStepsToSleep)
+      continue;
+
+    if (sleepingIslands[root] == invalid)
+      sleepingIslands[root] = mNextSleepingIsland++;
+
+    mIsSleeping[i] = true;
+    mSleepingIslands[i] = sleepingIslands[root];
+    mSkeletons[i]->resetVelocities();
+    mSkeletons[i]->resetAccelerations();
+  }
+}
 
 }  // namespace simulation
 }  // namespace dart
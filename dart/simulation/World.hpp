@@ -69,6 +69,7 @@ class ConstraintSolver;
 
 namespace collision {
 class CollisionResult;
+class CollisionFilter;
 } // namespace collision
 
 namespace simulation {
@@ -124,6 +125,66 @@ public:
   /// Get time step
   double getTimeStep() const;
 
+  /// Advance _skeleton in _numSubSteps equal sub-steps during every step()
+  /// instead of a single one, so that a stiff Skeleton can run at a finer rate
+  /// than the rest of the World. The World runs as many micro-steps as the
+  /// least common multiple of the sub-step counts, and each Skeleton is only
+  /// advanced on the micro-steps where one of its sub-steps starts. The
+  /// constraints are solved separately for each sub-step length that starts at
+  /// a micro-step, with the Skeletons of the other lengths held immobile, so
+  /// the constraints that couple Skeletons of different rates treat the other
+  /// one as a moving obstacle. All the Skeletons synchronize at the end of
+  /// every step(). Skeletons that are tied together by constraints should use
+  /// the same number of sub-steps.
+  void setNumSubSteps(const dynamics::SkeletonPtr& _skeleton,
+                      std::size_t _numSubSteps);
+
+  /// Get the number of sub-steps that _skeleton takes during every step(), or
+  /// 0 if _skeleton is not in this World
+  std::size_t getNumSubSteps(
+      const dynamics::ConstSkeletonPtr& _skeleton) const;
+
+  /// Let the World pick the length of each step() between _minTimeStep and
+  /// getTimeStep(). After every step, the contacts are checked for how far
+  /// they penetrate plus how far they would keep approaching over another
+  /// step. The time step is halved while that error exceeds _maxContactError,
+  /// and doubled back toward getTimeStep() once it falls well below it.
+  void setAdaptiveTimeStep(bool _adaptive, double _maxContactError = 1e-3,
+                           double _minTimeStep = 1e-5);
+
+  /// Return true if the World picks the length of each step()
+  bool isUsingAdaptiveTimeStep() const;
+
+  /// Get the length of time that the next step() will advance the World by.
+  /// This is always getTimeStep() unless setAdaptiveTimeStep(true) is used.
+  double getCurrentTimeStep() const;
+
+  /// Let islands of resting Skeletons fall asleep. An island is a set of
+  /// mobile Skeletons that touch each other or are coupled by the constraints
+  /// of the constraint solver, and it falls asleep once the kinetic energy of every Skeleton in it has stayed below _kineticEnergy
+  /// for _numSteps steps. Sleeping Skeletons skip their dynamics and
+  /// integration, and are treated as immobile by the constraint solver, which
+  /// also stops checking collisions between pairs of immobile Skeletons. A
+  /// sleeping Skeleton wakes up when it has joint forces, commands, external
+  /// forces or velocities at the start of a step, when an awake Skeleton that
+  /// has not rested for _numSteps steps touches it, or when wakeUp() is
+  /// called, and the rest of its island wakes up with it. Call wakeUp() after
+  /// moving a sleeping Skeleton by setting its positions. Removing a sleeping
+  /// Skeleton wakes up the rest of its island. Skeletons without DOFs never
+  /// sleep and do not join islands.
+  void setSleepingEnabled(bool _enabled, double _kineticEnergy = 1e-4,
+                          std::size_t _numSteps = 60u);
+
+  /// Return true if resting Skeletons are allowed to fall asleep
+  bool isSleepingEnabled() const;
+
+  /// Return true if _skeleton is asleep
+  bool isSleeping(const dynamics::ConstSkeletonPtr& _skeleton) const;
+
+  /// Wake _skeleton and the island it fell asleep with up if it is asleep, and
+  /// restart its count of resting steps
+  void wakeUp(const dynamics::SkeletonPtr& _skeleton);
+
   //--------------------------------------------------------------------------
   // Structural Properties
   //--------------------------------------------------------------------------
@@ -241,6 +302,22 @@ protected:
   /// Register when a SimpleFrame's name is changed
   void handleSimpleFrameNameChange(const dynamics::Entity* _entity);
 
+  /// Update the time steps of the constraint solver and of the Skeletons to
+  /// match mCurrentTimeStep and the sub-step counts
+  void updateTimeSteps();
+
+  /// Pick mCurrentTimeStep for the next step from the contact errors of the
+  /// last one
+  void adaptTimeStep();
+
+  /// Wake up the index-th Skeleton in mSkeletons and the island it fell asleep
+  /// with
+  void wakeUpIsland(std::size_t _index);
+
+  /// Wake up the sleeping Skeletons that were touched by moving ones, and put
+  /// the islands that have rested long enough to sleep
+  void updateSleeping();
+
   /// Name of this World
   std::string mName;
 
@@ -282,6 +359,47 @@ protected:
   /// Simulation time step
   double mTimeStep;
 
+  /// Number of sub-steps that each Skeleton in mSkeletons takes per step
+  std::vector<std::size_t> mNumSubSteps;
+
+  /// True if the length of each step is picked from the contact errors
+  bool mIsUsingAdaptiveTimeStep;
+
+  /// Largest contact error that adaptive time stepping tolerates
+  double mMaxContactError;
+
+  /// Shortest time step that adaptive time stepping may pick
+  double mMinTimeStep;
+
+  /// Length of the next step. This equals mTimeStep unless adaptive time
+  /// stepping has shortened it.
+  double mCurrentTimeStep;
+
+  /// True if resting islands of Skeletons are allowed to fall asleep
+  bool mIsSleepingEnabled;
+
+  /// Kinetic energy below which a Skeleton counts as resting
+  double mSleepKineticEnergy;
+
+  /// Number of steps that an island must rest before it falls asleep
+  std::size_t mNumStepsToSleep;
+
+  /// Number of consecutive steps that each Skeleton in mSkeletons has rested
+  std::vector<std::size_t> mNumRestingSteps;
+
+  /// Whether each Skeleton in mSkeletons is asleep
+  std::vector<bool> mIsSleeping;
+
+  /// Island that each sleeping Skeleton in mSkeletons fell asleep with
+  std::vector<std::size_t> mSleepingIslands;
+
+  /// Identifier of the next island that falls asleep
+  std::size_t mNextSleepingIsland;
+
+  /// Collision filter that the constraint solver uses while sleeping is
+  /// enabled. It wraps the filter that was in use before.
+  std::shared_ptr<collision::CollisionFilter> mSleepingCollisionFilter;
+
   /// Current simulation time
   double mTime;
 
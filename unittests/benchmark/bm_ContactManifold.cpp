@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures how contact manifold reduction in ConstraintSolver changes the size
+// of the LCPs and the time of World::step() for grids of boxes resting on the
+// ground. The boxes are rotated about the vertical axis so that their contact
+// polygons are not aligned with the ground.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "dart/config.hpp"
+#include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/collision/fcl/FCLCollisionDetector.hpp"
+#if HAVE_BULLET
+#include "dart/collision/bullet/BulletCollisionDetector.hpp"
+#endif
+#include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+#include "dart/simulation/World.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+using namespace dart::simulation;
+
+//==============================================================================
+static SkeletonPtr createBox(const Eigen::Vector3d& position, double angle)
+{
+  auto box = Skeleton::create();
+  auto pair = box->createJointAndBodyNodePair<FreeJoint>();
+  pair.second->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.2)));
+
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = position;
+  tf.linear() = Eigen::AngleAxisd(angle, Eigen::Vector3d::UnitZ())
+      .toRotationMatrix();
+  pair.first->setTransform(tf);
+
+  return box;
+}
+
+//==============================================================================
+static WorldPtr createWorld(std::size_t numBoxesPerSide)
+{
+  auto world = World::create();
+
+  auto ground = Skeleton::create("ground");
+  auto body = ground->createJointAndBodyNodePair<WeldJoint>().second;
+  body->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d(100.0, 100.0, 0.2)));
+  body->getParentJoint()->setTransformFromParentBodyNode(
+        Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.0, -0.1)));
+  world->addSkeleton(ground);
+
+  std::srand(0);
+  for (std::size_t i = 0; i < numBoxesPerSide; ++i)
+  {
+    for (std::size_t j = 0; j < numBoxesPerSide; ++j)
+    {
+      const double angle = static_cast<double>(std::rand()) / RAND_MAX;
+      world->addSkeleton(createBox(
+          Eigen::Vector3d(0.5 * i, 0.5 * j, 0.099), angle));
+    }
+  }
+
+  return world;
+}
+
+//==============================================================================
+static void benchmark(
+    const std::string& name,
+    const std::shared_ptr<collision::CollisionDetector>& cd,
+    std::size_t numBoxesPerSide,
+    std::size_t numSteps)
+{
+  for (const bool reduction : {false, true})
+  {
+    auto world = createWorld(numBoxesPerSide);
+    auto solver = world->getConstraintSolver();
+    solver->setCollisionDetector(cd->cloneWithoutCollisionObjects());
+    solver->setContactManifoldReductionEnabled(reduction);
+
+    double time = 0.0;
+    double numContacts = 0.0;
+    double lcpDimension = 0.0;
+    for (std::size_t i = 0; i < numSteps; ++i)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      world->step();
+      const auto end = std::chrono::steady_clock::now();
+      time += std::chrono::duration<double, std::micro>(end - start).count();
+
+      numContacts += solver->getLastCollisionResult().getNumContacts();
+      for (std::size_t j = 0; j < solver->getNumConstrainedGroups(); ++j)
+        lcpDimension += solver->getConstrainedGroup(j).getTotalDimension();
+    }
+
+    // The boxes should stay where they were put whether or not the contacts
+    // are reduced
+    double height = 0.0;
+    for (std::size_t i = 1; i < world->getNumSkeletons(); ++i)
+    {
+      height += world->getSkeleton(i)->getBodyNode(0)
+          ->getWorldTransform().translation()[2];
+    }
+    height /= static_cast<double>(world->getNumSkeletons() - 1u);
+
+    const double n = static_cast<double>(numSteps);
+    std::cout << "    " << name << (reduction ? " (reduced):" : "          :")
+              << " step " << time / n << " us, contacts " << numContacts / n
+              << ", LCP dimension " << lcpDimension / n << ", mean height "
+              << height << "\n";
+  }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::size_t numSteps = 200;
+  if (argc > 1)
+    numSteps = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  for (const std::size_t numBoxesPerSide : {1u, 4u, 8u})
+  {
+    std::cout << numBoxesPerSide * numBoxesPerSide << " boxes\n";
+
+    auto fcl = collision::FCLCollisionDetector::create();
+    fcl->setPrimitiveShapeType(collision::FCLCollisionDetector::MESH);
+    benchmark("fcl (mesh)", fcl, numBoxesPerSide, numSteps);
+
+#if HAVE_BULLET
+    benchmark("bullet    ", collision::BulletCollisionDetector::create(),
+              numBoxesPerSide, numSteps);
+#endif
+
+    benchmark("dart      ", collision::DARTCollisionDetector::create(),
+              numBoxesPerSide, numSteps);
+  }
+
+  std::cout << std::flush;
+  return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Times ODE's Dantzig LCP solver, as used by DantzigLCPSolver, with each of
+// the kernel instruction sets that this CPU supports. The LCPs are the
+// frictional contact LCPs of stacks of free-floating boxes: four corner
+// contacts between every box and whatever it is resting on, each with one
+// normal and two friction directions.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/external/odelcpsolver/lcp.h"
+#include "dart/external/odelcpsolver/simd.h"
+
+using namespace dart;
+using namespace dart::dynamics;
+
+//==============================================================================
+struct ContactLCP
+{
+  int mN;
+  int mNSkip;
+  std::vector<double> mA;
+  std::vector<double> mB;
+  std::vector<double> mLo;
+  std::vector<double> mHi;
+  std::vector<int> mFIndex;
+};
+
+//==============================================================================
+static SkeletonPtr createStack(std::size_t numBoxes, double x)
+{
+  SkeletonPtr stack = Skeleton::create();
+  for(std::size_t i=0; i < numBoxes; ++i)
+  {
+    BodyNode* box
+        = stack->createJointAndBodyNodePair<FreeJoint>(nullptr).second;
+    box->setMass(1.0);
+
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() = Eigen::Vector3d(x, 0.0, 0.5 + static_cast<double>(i));
+    FreeJoint::setTransform(box, tf);
+  }
+
+  return stack;
+}
+
+//==============================================================================
+/// Assemble the contact LCP of a set of stacks in the layout dSolveLCP()
+/// expects. Each stack is its own Skeleton, so A is block diagonal with one
+/// block per stack, the way a ConstrainedGroup of touching stacks would be.
+static void assembleLCP(
+    const std::vector<SkeletonPtr>& stacks, double dt, double mu,
+    ContactLCP& lcp)
+{
+  int n = 0;
+  for(const SkeletonPtr& stack : stacks)
+    n += 12*static_cast<int>(stack->getNumBodyNodes());
+
+  lcp.mN = n;
+  lcp.mNSkip = dPAD(n);
+  lcp.mA.assign(static_cast<std::size_t>(n*lcp.mNSkip), 0.0);
+  lcp.mB.assign(static_cast<std::size_t>(n), 0.0);
+  lcp.mLo.assign(static_cast<std::size_t>(n), 0.0);
+  lcp.mHi.assign(static_cast<std::size_t>(n), 0.0);
+  lcp.mFIndex.assign(static_cast<std::size_t>(n), -1);
+
+  int offset = 0;
+  for(const SkeletonPtr& stack : stacks)
+  {
+    const int nRows = 12*static_cast<int>(stack->getNumBodyNodes());
+    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(nRows, stack->getNumDofs());
+
+    int row = 0;
+    for(std::size_t i=0; i < stack->getNumBodyNodes(); ++i)
+    {
+      const BodyNode* box = stack->getBodyNode(i);
+      const BodyNode* below = (i > 0)? stack->getBodyNode(i-1) : nullptr;
+      for(std::size_t c=0; c < 4; ++c)
+      {
+        const Eigen::Vector3d corner((c%2 == 0)? 0.5 : -0.5,
+                                     (c/2 == 0)? 0.5 : -0.5, -0.5);
+        Eigen::MatrixXd Jc = stack->getLinearJacobian(box, corner);
+        if(below)
+        {
+          const Eigen::Vector3d p = below->getWorldTransform().inverse()
+              * (box->getWorldTransform() * corner);
+          Jc -= stack->getLinearJacobian(below, p);
+        }
+
+        // Normal first, then the two friction directions, as ContactConstraint
+        // orders them
+        J.row(row) = Jc.row(2);
+        J.row(row + 1) = Jc.row(0);
+        J.row(row + 2) = Jc.row(1);
+
+        const int index = offset + row;
+        lcp.mLo[index] = 0.0;
+        lcp.mHi[index] = dInfinity;
+        for(int k=1; k < 3; ++k)
+        {
+          lcp.mLo[index + k] = -mu;
+          lcp.mHi[index + k] = mu;
+          lcp.mFIndex[index + k] = index;
+        }
+
+        row += 3;
+      }
+    }
+
+    stack->computeForwardDynamics();
+
+    // Constraint force mixing, as the constraint solver does
+    const Eigen::MatrixXd A = J * stack->getInvMassMatrix() * J.transpose()
+        + 1e-4 * Eigen::MatrixXd::Identity(nRows, nRows);
+    const Eigen::VectorXd b
+        = -J * (stack->getVelocities() + dt * stack->getAccelerations());
+
+    for(int i=0; i < nRows; ++i)
+    {
+      for(int j=0; j < nRows; ++j)
+        lcp.mA[(offset + i)*lcp.mNSkip + offset + j] = A(i, j);
+      lcp.mB[offset + i] = b[i];
+    }
+
+    offset += nRows;
+  }
+}
+
+//==============================================================================
+/// Solve all the LCPs and return the average time per solve in microseconds.
+/// dSolveLCP() overwrites its inputs, so every solve works on a copy.
+static double solveAll(
+    const std::vector<ContactLCP>& lcps,
+    std::vector<std::vector<double>>& solutions)
+{
+  solutions.resize(lcps.size());
+
+  double total = 0.0;
+  for(std::size_t i=0; i < lcps.size(); ++i)
+  {
+    ContactLCP lcp = lcps[i];
+    std::vector<double>& x = solutions[i];
+    x.assign(static_cast<std::size_t>(lcp.mN), 0.0);
+    std::vector<double> w(static_cast<std::size_t>(lcp.mN), 0.0);
+
+    const auto start = std::chrono::steady_clock::now();
+    dSolveLCP(lcp.mN, lcp.mA.data(), x.data(), lcp.mB.data(), w.data(), 0,
+              lcp.mLo.data(), lcp.mHi.data(), lcp.mFIndex.data());
+    const auto end = std::chrono::steady_clock::now();
+
+    total += std::chrono::duration<double, std::micro>(end - start).count();
+  }
+
+  return total / static_cast<double>(lcps.size());
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::size_t numFrames = 20;
+  if(argc > 1)
+    numFrames = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  const double dt = 1e-3;
+  const double mu = 0.5;
+  const std::size_t sizes[][2] = {{1, 3}, {2, 5}, {4, 5}, {8, 5}, {8, 10}};
+  const int initialLevel = dGetSimdLevel();
+
+  std::cout << "Widest supported kernels: "
+            << dGetSimdLevelName(dGetMaxSimdLevel()) << "\n";
+
+  for(const auto& size : sizes)
+  {
+    const std::size_t numStacks = size[0];
+    const std::size_t numBoxes = size[1];
+
+    std::vector<SkeletonPtr> stacks;
+    for(std::size_t i=0; i < numStacks; ++i)
+      stacks.push_back(createStack(numBoxes, 2.0*static_cast<double>(i)));
+
+    std::srand(0);
+    std::vector<ContactLCP> lcps(numFrames);
+    for(ContactLCP& lcp : lcps)
+    {
+      for(const SkeletonPtr& stack : stacks)
+      {
+        stack->setVelocities(
+              0.05*Eigen::VectorXd::Random(stack->getNumDofs()));
+      }
+      assembleLCP(stacks, dt, mu, lcp);
+    }
+
+    std::cout << numStacks << " stack(s) of " << numBoxes << " boxes, "
+              << lcps.front().mN << " rows, " << numFrames << " frames\n";
+
+    std::vector<std::vector<double>> reference;
+    for(int level = dSimdLevelScalar; level <= dGetMaxSimdLevel(); ++level)
+    {
+      dSetSimdLevel(level);
+
+      std::vector<std::vector<double>> solutions;
+      const double time = solveAll(lcps, solutions);
+      if(level == dSimdLevelScalar)
+        reference = solutions;
+
+      double maxDiff = 0.0;
+      for(std::size_t i=0; i < solutions.size(); ++i)
+      {
+        for(std::size_t j=0; j < solutions[i].size(); ++j)
+        {
+          maxDiff = std::max(
+                maxDiff, std::abs(solutions[i][j] - reference[i][j]));
+        }
+      }
+
+      std::cout << "  " << dGetSimdLevelName(level) << ": " << time
+                << " us/solve";
+      if(level != dSimdLevelScalar)
+        std::cout << " (max |x - x_scalar| = " << maxDiff << ")";
+      std::cout << "\n";
+    }
+  }
+
+  dSetSimdLevel(initialLevel);
+
+  std::cout << std::flush;
+  return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compares the signed distance queries of the collision detectors that
+// support them on scenes of randomly placed primitive shapes. Every query
+// shuffles the shapes a little, the way consecutive time steps of a
+// simulation would. Both the distance within a single group and the distance
+// between two groups are timed.
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dart/config.hpp"
+#include "dart/collision/CollisionGroup.hpp"
+#include "dart/collision/DistanceOption.hpp"
+#include "dart/collision/DistanceResult.hpp"
+#include "dart/collision/fcl/FCLCollisionDetector.hpp"
+#if HAVE_ODE
+#include "dart/collision/ode/OdeCollisionDetector.hpp"
+#endif
+#if HAVE_BULLET
+#include "dart/collision/bullet/BulletCollisionDetector.hpp"
+#endif
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/CapsuleShape.hpp"
+#include "dart/dynamics/CylinderShape.hpp"
+#include "dart/dynamics/SimpleFrame.hpp"
+#include "dart/dynamics/SphereShape.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+using namespace dart::collision;
+
+//==============================================================================
+static std::vector<SimpleFramePtr> createFrames(std::size_t numFrames)
+{
+  std::vector<SimpleFramePtr> frames;
+  for(std::size_t i=0; i < numFrames; ++i)
+  {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    switch(i % 4)
+    {
+      case 0:
+        frame->setShape(std::make_shared<SphereShape>(0.2));
+        break;
+      case 1:
+        frame->setShape(std::make_shared<BoxShape>(
+                          Eigen::Vector3d(0.3, 0.2, 0.4)));
+        break;
+      case 2:
+        frame->setShape(std::make_shared<CapsuleShape>(0.1, 0.4));
+        break;
+      default:
+        frame->setShape(std::make_shared<CylinderShape>(0.15, 0.3));
+    }
+    frames.push_back(frame);
+  }
+
+  return frames;
+}
+
+//==============================================================================
+static void shuffle(const std::vector<SimpleFramePtr>& frames, double extent)
+{
+  for(const auto& frame : frames)
+  {
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() = extent * Eigen::Vector3d::Random();
+    const Eigen::Vector4d q = Eigen::Vector4d::Random().normalized();
+    tf.linear()
+        = Eigen::Quaterniond(q[0], q[1], q[2], q[3]).toRotationMatrix();
+    frame->setRelativeTransform(tf);
+  }
+}
+
+//==============================================================================
+static void benchmark(
+    const std::string& name,
+    const std::shared_ptr<CollisionDetector>& cd,
+    const std::vector<SimpleFramePtr>& frames,
+    double extent,
+    std::size_t numQueries)
+{
+  auto group = cd->createCollisionGroup();
+  auto group1 = cd->createCollisionGroup();
+  auto group2 = cd->createCollisionGroup();
+  for(std::size_t i=0; i < frames.size(); ++i)
+  {
+    group->addShapeFrame(frames[i].get());
+    if(i % 2 == 0)
+      group1->addShapeFrame(frames[i].get());
+    else
+      group2->addShapeFrame(frames[i].get());
+  }
+
+  DistanceOption option(true, -1e+3, nullptr);
+  DistanceResult result;
+
+  double times[2] = {0.0, 0.0};
+  double distances[2] = {0.0, 0.0};
+
+  std::srand(0);
+  for(std::size_t i=0; i < numQueries; ++i)
+  {
+    shuffle(frames, extent);
+
+    auto start = std::chrono::steady_clock::now();
+    distances[0] += group->distance(option, &result);
+    auto end = std::chrono::steady_clock::now();
+    times[0] += std::chrono::duration<double, std::micro>(end - start).count();
+
+    start = std::chrono::steady_clock::now();
+    distances[1] += group1->distance(group2.get(), option, &result);
+    end = std::chrono::steady_clock::now();
+    times[1] += std::chrono::duration<double, std::micro>(end - start).count();
+  }
+
+  const double n = static_cast<double>(numQueries);
+  std::cout << "    " << name << ": group " << times[0] / n
+            << " us (mean distance " << distances[0] / n << "), group-group "
+            << times[1] / n << " us (mean distance " << distances[1] / n
+            << ")\n";
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::size_t numQueries = 100;
+  if(argc > 1)
+    numQueries = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  for(const std::size_t numFrames : {8u, 32u, 128u})
+  {
+    // Keep the density of the shapes roughly the same across the scenes
+    const double extent = 0.5 * std::cbrt(static_cast<double>(numFrames));
+    const auto frames = createFrames(numFrames);
+
+    std::cout << numFrames << " shapes\n";
+
+    auto fclPrimitive = FCLCollisionDetector::create();
+    fclPrimitive->setPrimitiveShapeType(FCLCollisionDetector::PRIMITIVE);
+    benchmark("fcl (primitive)", fclPrimitive, frames, extent, numQueries);
+
+    auto fclMesh = FCLCollisionDetector::create();
+    fclMesh->setPrimitiveShapeType(FCLCollisionDetector::MESH);
+    benchmark("fcl (mesh)     ", fclMesh, frames, extent, numQueries);
+
+#if HAVE_ODE
+    benchmark("ode            ", OdeCollisionDetector::create(), frames,
+              extent, numQueries);
+#endif
+
+#if HAVE_BULLET
+    benchmark("bullet         ", BulletCollisionDetector::create(), frames,
+              extent, numQueries);
+#endif
+  }
+
+  std::cout << std::flush;
+  return 0;
+}
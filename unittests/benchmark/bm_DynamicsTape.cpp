@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compares Skeleton::computeForwardDynamics() with and without a
+// DynamicsTape on serial chains and on a branching, humanoid-sized tree.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+
+//==============================================================================
+static BodyNode* addLink(const SkeletonPtr& skel, BodyNode* parent,
+                         std::size_t index)
+{
+  RevoluteJoint::Properties joint;
+  joint.mAxis = Eigen::Vector3d::Unit(index % 3);
+  joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0.0, 0.0, 0.3);
+  joint.mDampingCoefficients[0] = 0.1;
+
+  BodyNode* bn = skel->createJointAndBodyNodePair<RevoluteJoint>(
+        parent, joint).second;
+  bn->setMass(1.0);
+  return bn;
+}
+
+//==============================================================================
+static SkeletonPtr createChain(std::size_t numLinks)
+{
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* parent = nullptr;
+  for(std::size_t i = 0; i < numLinks; ++i)
+    parent = addLink(skel, parent, i);
+
+  return skel;
+}
+
+//==============================================================================
+static SkeletonPtr createHumanoidLike()
+{
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* pelvis = skel->createJointAndBodyNodePair<FreeJoint>().second;
+
+  const std::size_t lengths[] = {7, 7, 7, 7, 3};
+  for(const std::size_t length : lengths)
+  {
+    BodyNode* parent = pelvis;
+    for(std::size_t i = 0; i < length; ++i)
+      parent = addLink(skel, parent, i);
+  }
+
+  return skel;
+}
+
+//==============================================================================
+static double timeForwardDynamics(const SkeletonPtr& skel,
+                                  std::size_t numIterations)
+{
+  std::srand(0);
+  const auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < numIterations; ++i)
+  {
+    skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+    skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+    skel->computeForwardDynamics();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count()
+      / static_cast<double>(numIterations);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::size_t numIterations = 2000;
+  if(argc > 1)
+    numIterations = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  const std::pair<std::string, SkeletonPtr> skeletons[] = {
+    {"chain of 7", createChain(7)},
+    {"chain of 30", createChain(30)},
+    {"humanoid-like tree", createHumanoidLike()}
+  };
+
+  for(const auto& entry : skeletons)
+  {
+    const SkeletonPtr& skel = entry.second;
+
+    skel->setUseDynamicsTape(false);
+    const double regular = timeForwardDynamics(skel, numIterations);
+    const Eigen::VectorXd expected = skel->getAccelerations();
+
+    skel->setUseDynamicsTape(true);
+    const double taped = timeForwardDynamics(skel, numIterations);
+    const double difference
+        = (expected - skel->getAccelerations()).cwiseAbs().maxCoeff();
+
+    std::cout << entry.first << " (" << skel->getNumDofs() << " DOFs)\n"
+              << "  BodyNode recursions: " << regular << " us/call\n"
+              << "  DynamicsTape:        " << taped << " us/call\n"
+              << "  max difference:      " << difference << "\n";
+  }
+
+  std::cout << std::flush;
+  return 0;
+}
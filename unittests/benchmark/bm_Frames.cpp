@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Timings of setPositions() -> getWorldTransform() round trips, which are
+// dominated by the invalidation of the Frame graph for small queries. Each
+// Skeleton is timed when only the last BodyNode is queried and when every
+// BodyNode is queried, and with setPositions() compared against setting each
+// DegreeOfFreedom one at a time. Invalidation still walks the child Entities
+// of each Frame; there are no per-Skeleton dirty bitsets or version numbers.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+
+// Accumulated so that the compiler cannot drop the timed work
+static double sink = 0.0;
+
+//==============================================================================
+template <typename Function>
+static double timeCall(Function f, std::size_t numIterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < numIterations; ++i)
+    f();
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count()
+      / static_cast<double>(numIterations);
+}
+
+//==============================================================================
+template <typename JointType>
+static SkeletonPtr createChain(std::size_t numLinks)
+{
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* parent = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  for(std::size_t i = 1; i < numLinks; ++i)
+  {
+    typename JointType::Properties joint;
+    joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0.0, 0.0, 0.3);
+    parent = skel->createJointAndBodyNodePair<JointType>(parent, joint).second;
+  }
+
+  // Every BodyNode carries a visual and a collision shape, which are the child
+  // Frames that get invalidated along with it.
+  const ShapePtr box
+      = std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1));
+  for(std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+  {
+    skel->getBodyNode(i)->createShapeNodeWith<VisualAspect>(box);
+    skel->getBodyNode(i)->createShapeNodeWith<CollisionAspect>(box);
+  }
+
+  return skel;
+}
+
+//==============================================================================
+static void benchmarkChain(const std::string& name, const SkeletonPtr& skel,
+                           std::size_t numIterations)
+{
+  std::srand(0);
+  const std::size_t dofs = skel->getNumDofs();
+  const std::size_t numBodies = skel->getNumBodyNodes();
+  const BodyNode* tip = skel->getBodyNode(numBodies - 1);
+  Eigen::VectorXd q = Eigen::VectorXd::Random(dofs);
+
+  const double tipWhole = timeCall([&]() {
+    q[0] += 1e-3;
+    skel->setPositions(q);
+    sink += tip->getWorldTransform().translation()[0];
+  }, numIterations);
+
+  const double tipPerDof = timeCall([&]() {
+    q[0] += 1e-3;
+    for(std::size_t i = 0; i < dofs; ++i)
+      skel->setPosition(i, q[i]);
+    sink += tip->getWorldTransform().translation()[0];
+  }, numIterations);
+
+  const double allWhole = timeCall([&]() {
+    q[0] += 1e-3;
+    skel->setPositions(q);
+    for(std::size_t i = 0; i < numBodies; ++i)
+      sink += skel->getBodyNode(i)->getWorldTransform().translation()[0];
+  }, numIterations);
+
+  const double allPerDof = timeCall([&]() {
+    q[0] += 1e-3;
+    for(std::size_t i = 0; i < dofs; ++i)
+      skel->setPosition(i, q[i]);
+    for(std::size_t i = 0; i < numBodies; ++i)
+      sink += skel->getBodyNode(i)->getWorldTransform().translation()[0];
+  }, numIterations);
+
+  const double unchanged = timeCall([&]() {
+    skel->setPositions(q);
+    sink += tip->getWorldTransform().translation()[0];
+  }, numIterations);
+
+  std::cout << name << " chain of " << numBodies << " (" << dofs
+            << " DOFs, us/round trip, per DOF -> setPositions)\n"
+            << "  tip transform:        " << tipPerDof << " -> " << tipWhole
+            << "\n"
+            << "  all transforms:       " << allPerDof << " -> " << allWhole
+            << "\n"
+            << "  unchanged positions:  " << unchanged << "\n";
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::size_t numIterations = 10000;
+  if(argc > 1)
+    numIterations = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  benchmarkChain("RevoluteJoint", createChain<RevoluteJoint>(40),
+                 numIterations);
+  benchmarkChain("BallJoint", createChain<BallJoint>(40), numIterations);
+  benchmarkChain("FreeJoint", createChain<FreeJoint>(40), numIterations);
+
+  std::cout << "(checksum " << sink << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Per joint type timings of the articulated body kernels of GenericJoint and
+// of the recursive algorithms that use them. The first section compares each
+// kernel with the plain Eigen expression it replaces; the second one times
+// forward dynamics and mass matrix computations on chains made of a single
+// joint type.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+
+// Accumulated so that the compiler cannot drop the timed work
+static double sink = 0.0;
+
+//==============================================================================
+template <typename Function>
+static double timeCall(Function f, std::size_t numIterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < numIterations; ++i)
+    f();
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count()
+      / static_cast<double>(numIterations);
+}
+
+//==============================================================================
+template <int NumDofs>
+static void benchmarkKernels(const std::string& name,
+                             const Eigen::Matrix<double, 6, NumDofs>& J,
+                             std::size_t numIterations)
+{
+  using Kernels = dynamics::detail::GenericJointKernels<NumDofs>;
+  using Matrix = Eigen::Matrix<double, NumDofs, NumDofs>;
+  using Vector = Eigen::Matrix<double, NumDofs, 1>;
+
+  const Eigen::Matrix6d R = Eigen::Matrix6d::Random();
+  const Eigen::Matrix6d AI
+      = R * R.transpose() + Eigen::Matrix6d::Identity();
+  const Matrix invProjAI = (J.transpose() * AI * J).inverse();
+  const Eigen::Vector6d v = Eigen::Vector6d::Random();
+  const Vector x = Vector::Random();
+
+  const double naiveProject = timeCall([&]() {
+    const Matrix projAI = J.transpose() * AI * J;
+    sink += projAI(0, 0);
+  }, numIterations);
+  const double kernelProject = timeCall([&]() {
+    sink += Kernels::projectInertia(AI, J)(0, 0);
+  }, numIterations);
+
+  const double naiveComplement = timeCall([&]() {
+    const Eigen::Matrix<double, 6, NumDofs> AIS = AI * J;
+    Eigen::Matrix6d PI = AI;
+    PI.noalias() -= AIS * invProjAI * AIS.transpose();
+    sink += PI(5, 0);
+  }, numIterations);
+  const double kernelComplement = timeCall([&]() {
+    Eigen::Matrix6d PI;
+    Kernels::complementInertia(PI, AI, J, invProjAI);
+    sink += PI(5, 0);
+  }, numIterations);
+
+  const double naiveForce = timeCall([&]() {
+    const Vector force = J.transpose() * AI * v;
+    sink += force[0];
+  }, numIterations);
+  const double kernelForce = timeCall([&]() {
+    sink += Kernels::projectForce(AI, J, v)[0];
+  }, numIterations);
+
+  const double naiveBias = timeCall([&]() {
+    const Eigen::Vector6d bias = AI * J * invProjAI * x;
+    sink += bias[0];
+  }, numIterations);
+  const double kernelBias = timeCall([&]() {
+    sink += Kernels::multiplyInertia(AI, J, Vector(invProjAI * x))[0];
+  }, numIterations);
+
+  std::cout << name << " (ns/call, plain Eigen -> kernel)\n"
+            << "  J^T AI J:               " << naiveProject << " -> "
+            << kernelProject << "\n"
+            << "  AI - AIS inv(P) AIS^T:  " << naiveComplement << " -> "
+            << kernelComplement << "\n"
+            << "  J^T AI v:               " << naiveForce << " -> "
+            << kernelForce << "\n"
+            << "  AI J inv(P) x:          " << naiveBias << " -> "
+            << kernelBias << "\n";
+}
+
+//==============================================================================
+template <typename JointType>
+static SkeletonPtr createChain(std::size_t numLinks)
+{
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* parent = nullptr;
+  for(std::size_t i = 0; i < numLinks; ++i)
+  {
+    typename JointType::Properties joint;
+    joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0.0, 0.0, 0.3);
+
+    // Zero-DOF chains hang from a free root so that there is something to
+    // simulate
+    BodyNode* bn = nullptr;
+    if(JointType::getStaticType() == WeldJoint::getStaticType() && !parent)
+      bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+    else
+      bn = skel->createJointAndBodyNodePair<JointType>(parent, joint).second;
+
+    bn->setMass(1.0);
+    parent = bn;
+  }
+
+  return skel;
+}
+
+//==============================================================================
+static void benchmarkChain(const std::string& name, const SkeletonPtr& skel,
+                           std::size_t numIterations)
+{
+  std::srand(0);
+  const std::size_t dofs = skel->getNumDofs();
+
+  const double forward = timeCall([&]() {
+    skel->setPositions(Eigen::VectorXd::Random(dofs));
+    skel->setVelocities(Eigen::VectorXd::Random(dofs));
+    skel->computeForwardDynamics();
+    sink += skel->getAcceleration(0);
+  }, numIterations) * 1e-3;
+
+  const double massMatrix = timeCall([&]() {
+    skel->setPositions(Eigen::VectorXd::Random(dofs));
+    sink += skel->getMassMatrix()(0, 0);
+  }, numIterations) * 1e-3;
+
+  const double invMassMatrix = timeCall([&]() {
+    skel->setPositions(Eigen::VectorXd::Random(dofs));
+    sink += skel->getInvMassMatrix()(0, 0);
+  }, numIterations) * 1e-3;
+
+  std::cout << name << " chain of " << skel->getNumBodyNodes() << " ("
+            << dofs << " DOFs, us/call)\n"
+            << "  forward dynamics:    " << forward << "\n"
+            << "  mass matrix:         " << massMatrix << "\n"
+            << "  inverse mass matrix: " << invMassMatrix << "\n";
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::size_t numIterations = 1000;
+  if(argc > 1)
+    numIterations = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  // Kernels: a revolute joint whose child frame lies on its axis, a prismatic
+  // joint, a revolute joint with an offset child frame, and ball and free
+  // joints with an offset child frame.
+  const std::size_t kernelIterations = 1000 * numIterations;
+  Eigen::Isometry3d offset = Eigen::Isometry3d::Identity();
+  offset.translation() = Eigen::Vector3d(0.1, -0.2, 0.3);
+
+  benchmarkKernels<1>("RevoluteJoint",
+      math::AdTAngular(Eigen::Isometry3d::Identity(), Eigen::Vector3d::UnitZ()),
+      kernelIterations);
+  benchmarkKernels<1>("PrismaticJoint",
+      math::AdTLinear(offset, Eigen::Vector3d::UnitZ()), kernelIterations);
+  benchmarkKernels<1>("RevoluteJoint (offset)",
+      math::AdTAngular(offset, Eigen::Vector3d::UnitZ()), kernelIterations);
+
+  Eigen::Matrix<double, 6, 3> ballJacobian;
+  ballJacobian << Eigen::Matrix3d::Identity(), Eigen::Matrix3d::Zero();
+  benchmarkKernels<3>("BallJoint",
+      math::AdTJacFixed(offset, ballJacobian), kernelIterations);
+  benchmarkKernels<6>("FreeJoint",
+      math::AdTJacFixed(offset, Eigen::Matrix6d::Identity()),
+      kernelIterations);
+
+  // Recursive algorithms on chains of a single joint type
+  benchmarkChain("RevoluteJoint", createChain<RevoluteJoint>(20), numIterations);
+  benchmarkChain("PrismaticJoint", createChain<PrismaticJoint>(20),
+                 numIterations);
+  benchmarkChain("BallJoint", createChain<BallJoint>(20), numIterations);
+  benchmarkChain("FreeJoint", createChain<FreeJoint>(20), numIterations);
+  benchmarkChain("WeldJoint", createChain<WeldJoint>(20), numIterations);
+
+  std::cout << "(checksum " << sink << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compares HierarchicalIK::computeNullSpaces() against the straightforward
+// implementation that scatters every module's Jacobian into a full-width
+// matrix and takes its SVD on every call.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/HierarchicalIK.hpp"
+#include "dart/dynamics/InverseKinematics.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/math/Geometry.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+
+//==============================================================================
+static SkeletonPtr createHumanoidLikeRobot()
+{
+  SkeletonPtr robot = Skeleton::create("humanoid");
+  BodyNode* pelvis = robot->createJointAndBodyNodePair<FreeJoint>().second;
+
+  // Two legs, two arms, and a neck, giving 6 + 4*8 + 2 = 40 DOFs
+  const std::size_t lengths[] = {8, 8, 8, 8, 2};
+  for(std::size_t i=0; i < 5; ++i)
+  {
+    BodyNode* parent = pelvis;
+    for(std::size_t j=0; j < lengths[i]; ++j)
+    {
+      RevoluteJoint::Properties joint;
+      joint.mAxis = Eigen::Vector3d::Unit(j%3);
+      joint.mT_ParentBodyToJoint.translation() =
+          (j == 0)? Eigen::Vector3d(0.2*std::cos(i), 0.2*std::sin(i), 0.0)
+                  : Eigen::Vector3d(0.0, 0.0, 0.25);
+      parent = robot->createJointAndBodyNodePair<RevoluteJoint>(
+            parent, joint).second;
+    }
+  }
+
+  return robot;
+}
+
+//==============================================================================
+static void computeReferenceNullSpaces(
+    const HierarchicalIK& hik, std::vector<Eigen::MatrixXd>& nullSpaces)
+{
+  const std::size_t nDofs = hik.getSkeleton()->getNumDofs();
+  const IKHierarchy& hierarchy = hik.getIKHierarchy();
+  nullSpaces.resize(hierarchy.size());
+
+  Eigen::MatrixXd fullJ(6, nDofs);
+  Eigen::MatrixXd N;
+  Eigen::JacobiSVD<Eigen::MatrixXd> svd;
+  for(std::size_t i=0; i < hierarchy.size(); ++i)
+  {
+    Eigen::MatrixXd& NS = nullSpaces[i];
+    if(i == 0)
+      NS = Eigen::MatrixXd::Identity(nDofs, nDofs);
+    else
+      NS = nullSpaces[i-1];
+
+    for(const std::shared_ptr<InverseKinematics>& ik : hierarchy[i])
+    {
+      if(!ik->isActive())
+        continue;
+
+      const math::Jacobian& J = ik->computeJacobian();
+      const std::vector<std::size_t>& dofs = ik->getDofs();
+      fullJ.setZero();
+      for(std::size_t d=0; d < dofs.size(); ++d)
+        fullJ.col(dofs[d]) = J.col(d);
+
+      svd.compute(fullJ, Eigen::ComputeFullV);
+      math::extractNullSpace(svd, N);
+      if(N.cols() > 0)
+        NS *= N * N.transpose();
+      else
+        NS.setZero();
+    }
+  }
+}
+
+//==============================================================================
+template <typename Func>
+static double timeInMicroseconds(std::size_t numIterations, Func func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for(std::size_t i=0; i < numIterations; ++i)
+    func(i);
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count()
+      / static_cast<double>(numIterations);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::size_t numIterations = 200;
+  if(argc > 1)
+    numIterations = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  SkeletonPtr robot = createHumanoidLikeRobot();
+
+  // Five hierarchy levels: feet, hands, head, then two mid-limb targets
+  const std::size_t levels[][2] = {{8, 0}, {16, 0}, {24, 1}, {32, 1},
+                                   {34, 2}, {4, 3}, {20, 4}};
+  for(const auto& entry : levels)
+  {
+    robot->getBodyNode(entry[0])->getIK(true)->setHierarchyLevel(entry[1]);
+  }
+
+  const std::shared_ptr<WholeBodyIK>& ik = robot->getIK(true);
+  const std::size_t nDofs = robot->getNumDofs();
+
+  std::vector<Eigen::VectorXd> configurations(numIterations);
+  for(Eigen::VectorXd& q : configurations)
+    q = Eigen::VectorXd::Random(nDofs);
+
+  // Sanity check that both implementations agree
+  std::vector<Eigen::MatrixXd> reference;
+  double maxError = 0.0;
+  for(std::size_t i=0; i < std::min<std::size_t>(10, numIterations); ++i)
+  {
+    robot->setPositions(configurations[i]);
+    computeReferenceNullSpaces(*ik, reference);
+    const std::vector<Eigen::MatrixXd>& nullSpaces = ik->computeNullSpaces();
+    for(std::size_t j=0; j < reference.size(); ++j)
+    {
+      maxError = std::max(
+            maxError, (reference[j] - nullSpaces[j]).cwiseAbs().maxCoeff());
+    }
+  }
+
+  const double referenceTime = timeInMicroseconds(numIterations,
+    [&](std::size_t i)
+  {
+    robot->setPositions(configurations[i]);
+    computeReferenceNullSpaces(*ik, reference);
+  });
+
+  const double fullTime = timeInMicroseconds(numIterations,
+    [&](std::size_t i)
+  {
+    robot->setPositions(configurations[i]);
+    ik->computeNullSpaces();
+  });
+
+  // Only move the last joint of one arm, so most of the cached row spaces can
+  // be reused.
+  const double partialTime = timeInMicroseconds(numIterations,
+    [&](std::size_t i)
+  {
+    robot->getDof(37)->setPosition(configurations[i][37]);
+    ik->computeNullSpaces();
+  });
+
+  std::cout << "HierarchicalIK null spaces (" << nDofs << " DOFs, "
+            << ik->getIKHierarchy().size() << " levels, "
+            << numIterations << " iterations)\n"
+            << "  max difference from reference: " << maxError << "\n"
+            << "  reference (dense SVD):          " << referenceTime
+            << " us/call\n"
+            << "  row space QR, all modules moved: " << fullTime
+            << " us/call\n"
+            << "  row space QR, one joint moved:   " << partialTime
+            << " us/call\n"
+            << "  unchanged configuration:         "
+            << timeInMicroseconds(numIterations, [&](std::size_t)
+               { ik->computeNullSpaces(); })
+            << " us/call" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compares how stiff springs can get before a simulation stepped with a given
+// time step blows up, with and without the linearly implicit treatment of the
+// springs. Joint springs are either handled by the forward dynamics, which
+// treats them implicitly, or applied explicitly as joint forces. The edge
+// springs of a SoftBodyNode are compared with Skeleton::setUseImplicitEuler()
+// turned off and on.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/PointMass.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/SoftBodyNode.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+
+// Length of simulated time for every run
+static const double Duration = 1.0;
+
+//==============================================================================
+struct Run
+{
+  bool mStable;
+  double mMicrosecondsPerStep;
+};
+
+//==============================================================================
+static SkeletonPtr createChain(std::size_t numLinks, double stiffness)
+{
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* parent = nullptr;
+  for(std::size_t i = 0; i < numLinks; ++i)
+  {
+    RevoluteJoint::Properties joint;
+    joint.mAxis = Eigen::Vector3d::UnitY();
+    joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0.0, 0.0, 0.1);
+    joint.mSpringStiffnesses[0] = stiffness;
+
+    parent = skel->createJointAndBodyNodePair<RevoluteJoint>(
+          parent, joint).second;
+    parent->setMass(0.1);
+  }
+
+  return skel;
+}
+
+//==============================================================================
+static Run simulateChain(double stiffness, double timeStep, bool implicit)
+{
+  const std::size_t numLinks = 10;
+  SkeletonPtr skel = createChain(numLinks, implicit ? stiffness : 0.0);
+  skel->setGravity(Eigen::Vector3d::Zero());
+  skel->setTimeStep(timeStep);
+  skel->setPositions(Eigen::VectorXd::Constant(numLinks, 0.5));
+
+  const std::size_t numSteps = static_cast<std::size_t>(Duration / timeStep);
+  bool stable = true;
+  const auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < numSteps && stable; ++i)
+  {
+    if(!implicit)
+      skel->setForces(-stiffness * skel->getPositions());
+
+    skel->computeForwardDynamics();
+    skel->integrateVelocities(timeStep);
+    skel->integratePositions(timeStep);
+
+    // Without damping the springs can only exchange the initial energy, so a
+    // growing amplitude means the integration is unstable
+    const double amplitude = skel->getPositions().cwiseAbs().maxCoeff();
+    stable = std::isfinite(amplitude) && amplitude < 10.0;
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  return {stable, std::chrono::duration<double, std::micro>(end - start).count()
+                  / static_cast<double>(numSteps)};
+}
+
+//==============================================================================
+static Run simulateSoftBox(double edgeStiffness, double timeStep,
+                           bool implicit)
+{
+  SkeletonPtr skel = Skeleton::create();
+  SoftBodyNode::Properties properties(
+        BodyNode::AspectProperties("soft box"),
+        SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d(0.3, 0.3, 0.3), Eigen::Isometry3d::Identity(),
+          Eigen::Vector3i(6, 6, 6), 1.0, 100.0, edgeStiffness, 0.0));
+  SoftBodyNode* body = skel->createJointAndBodyNodePair<
+      WeldJoint, SoftBodyNode>(nullptr, WeldJoint::Properties(),
+                               properties).second;
+  skel->setTimeStep(timeStep);
+  skel->setUseImplicitEuler(implicit);
+
+  std::srand(0);
+  for(std::size_t i = 0; i < body->getNumPointMasses(); ++i)
+    body->getPointMass(i)->setPositions(0.01 * Eigen::Vector3d::Random());
+
+  const std::size_t numSteps = static_cast<std::size_t>(Duration / timeStep);
+  bool stable = true;
+  const auto start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < numSteps && stable; ++i)
+  {
+    skel->computeForwardDynamics();
+    skel->integrateVelocities(timeStep);
+    skel->integratePositions(timeStep);
+
+    // The box is 0.3 across, so a PointMass that travels farther than that
+    // from its rest position has blown up
+    double displacement = 0.0;
+    for(std::size_t j = 0; j < body->getNumPointMasses(); ++j)
+    {
+      displacement = std::max(
+            displacement,
+            body->getPointMass(j)->getPositions().cwiseAbs().maxCoeff());
+    }
+    stable = std::isfinite(displacement) && displacement < 0.3;
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  return {stable, std::chrono::duration<double, std::micro>(end - start).count()
+                  / static_cast<double>(numSteps)};
+}
+
+//==============================================================================
+static void print(const Run& run)
+{
+  std::cout << (run.mStable ? "stable  " : "UNSTABLE") << " ("
+            << run.mMicrosecondsPerStep << " us/step)";
+}
+
+//==============================================================================
+int main()
+{
+  const double timeSteps[] = {1e-4, 5e-4, 1e-3, 2e-3};
+
+  std::cout << "Joint springs on a chain of 10 revolute joints\n";
+  for(const double stiffness : {1e2, 1e3, 1e4, 1e5})
+  {
+    for(const double timeStep : timeSteps)
+    {
+      std::cout << "  k = " << stiffness << ", dt = " << timeStep << "\n"
+                << "    explicit: ";
+      print(simulateChain(stiffness, timeStep, false));
+      std::cout << "\n    implicit: ";
+      print(simulateChain(stiffness, timeStep, true));
+      std::cout << "\n";
+    }
+  }
+
+  std::cout << "Edge springs of a soft box\n";
+  for(const double stiffness : {1e2, 1e3, 1e4, 1e5})
+  {
+    for(const double timeStep : timeSteps)
+    {
+      std::cout << "  ke = " << stiffness << ", dt = " << timeStep << "\n"
+                << "    vertex springs only: ";
+      print(simulateSoftBox(stiffness, timeStep, false));
+      std::cout << "\n    implicit Euler:      ";
+      print(simulateSoftBox(stiffness, timeStep, true));
+      std::cout << "\n";
+    }
+  }
+
+  std::cout << std::flush;
+  return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Replays the LCPs recorded with ConstraintSolver::startLCPCapture() through
+// each LCP solver, and reports the solve time, the number of iterations and
+// the residual of each. The Dantzig solver is run once for every instruction
+// set its kernels support.
+//
+// Usage: bm_LCPReplay [trace files...]
+//
+// Without arguments, a trace is first recorded from a scene of stacked boxes
+// to bm_LCPReplay.trace in the working directory.
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/common/Memory.hpp"
+#include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/constraint/DantzigLCPSolver.hpp"
+#include "dart/constraint/LCPTrace.hpp"
+#include "dart/constraint/PGSLCPSolver.hpp"
+#include "dart/constraint/SparsePGSLCPSolver.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+#include "dart/external/odelcpsolver/simd.h"
+#include "dart/simulation/World.hpp"
+
+using namespace dart;
+using namespace dart::constraint;
+using namespace dart::dynamics;
+using namespace dart::simulation;
+
+//==============================================================================
+struct ReplaySolver
+{
+  std::string mName;
+  std::unique_ptr<LCPSolver> mSolver;
+
+  /// Instruction set of the kernels of ODE's LCP solver to use
+  int mSimdLevel;
+};
+
+//==============================================================================
+struct Statistics
+{
+  std::size_t mNumProblems = 0u;
+  double mTime = 0.0;
+  double mNumIterations = 0.0;
+  double mMaxResidual = 0.0;
+  double mResidual = 0.0;
+
+  void add(const LCPProblem& _problem)
+  {
+    const double residual = _problem.computeResidual();
+    ++mNumProblems;
+    mTime += _problem.mSolveTime;
+    mNumIterations += static_cast<double>(_problem.mNumIterations);
+    mMaxResidual = std::max(mMaxResidual, residual);
+    mResidual += residual;
+  }
+
+  void print(const std::string& _name) const
+  {
+    std::cout << "  " << std::left << std::setw(24) << _name << std::right;
+    if (mNumProblems == 0u)
+    {
+      std::cout << "not supported\n";
+      return;
+    }
+
+    const double n = static_cast<double>(mNumProblems);
+    std::cout << std::setw(10) << 1e+6 * mTime / n << " us/solve, "
+              << std::setw(6) << mNumIterations / n << " iterations, "
+              << "residual " << mResidual / n << " (max " << mMaxResidual
+              << ")\n";
+  }
+};
+
+//==============================================================================
+static SkeletonPtr createBox(const Eigen::Vector3d& position)
+{
+  auto box = Skeleton::create();
+  auto pair = box->createJointAndBodyNodePair<FreeJoint>();
+  pair.second->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.2)));
+
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = position;
+  pair.first->setTransform(tf);
+
+  return box;
+}
+
+//==============================================================================
+/// Record the LCPs of a few stacks of boxes settling on the ground
+static bool recordTrace(const std::string& _fileName)
+{
+  auto world = World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+        collision::DARTCollisionDetector::create());
+
+  auto ground = Skeleton::create("ground");
+  auto body = ground->createJointAndBodyNodePair<WeldJoint>().second;
+  body->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d(10.0, 10.0, 0.2)));
+  body->getParentJoint()->setTransformFromParentBodyNode(
+        Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.0, -0.1)));
+  world->addSkeleton(ground);
+
+  const std::size_t numStacks = 3u;
+  const std::size_t numBoxes = 5u;
+  for (std::size_t i = 0; i < numStacks; ++i)
+  {
+    for (std::size_t j = 0; j < numBoxes; ++j)
+    {
+      world->addSkeleton(createBox(Eigen::Vector3d(
+          0.5 * static_cast<double>(i), 0.0,
+          0.099 + 0.199 * static_cast<double>(j))));
+    }
+  }
+
+  if (!world->getConstraintSolver()->startLCPCapture(_fileName))
+    return false;
+
+  for (std::size_t i = 0; i < 200u; ++i)
+    world->step();
+
+  world->getConstraintSolver()->stopLCPCapture();
+  return true;
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> fileNames(argv + 1, argv + argc);
+  if (fileNames.empty())
+  {
+    fileNames.push_back("bm_LCPReplay.trace");
+    std::cout << "Recording " << fileNames.back() << "\n";
+    if (!recordTrace(fileNames.back()))
+      return 1;
+  }
+
+  const int initialLevel = dGetSimdLevel();
+
+  for (const auto& fileName : fileNames)
+  {
+    LCPTraceReader reader(fileName);
+    if (!reader.isOpen())
+      return 1;
+
+    std::vector<LCPProblem> problems;
+    LCPProblem problem;
+    std::size_t maxDimension = 0u;
+    double dimension = 0.0;
+    while (reader.read(problem))
+    {
+      problems.push_back(problem);
+      maxDimension = std::max(maxDimension, problem.getDimension());
+      dimension += static_cast<double>(problem.getDimension());
+    }
+
+    std::cout << fileName << ": " << problems.size() << " LCPs";
+    if (!problems.empty())
+    {
+      std::cout << " of " << dimension / static_cast<double>(problems.size())
+                << " rows on average (max " << maxDimension << ")";
+    }
+    std::cout << "\n";
+
+    Statistics recorded;
+    for (const auto& lcp : problems)
+      recorded.add(lcp);
+    recorded.print("recorded");
+
+    std::vector<ReplaySolver> solvers;
+    solvers.push_back({"PGS", common::make_unique<PGSLCPSolver>(1e-3),
+                       initialLevel});
+    solvers.push_back({"sparse PGS",
+                       common::make_unique<SparsePGSLCPSolver>(1e-3),
+                       initialLevel});
+    for (int level = dSimdLevelScalar; level <= dGetMaxSimdLevel(); ++level)
+    {
+      solvers.push_back({std::string("Dantzig, ") + dGetSimdLevelName(level),
+                         common::make_unique<DantzigLCPSolver>(1e-3), level});
+    }
+
+    for (const auto& solver : solvers)
+    {
+      dSetSimdLevel(solver.mSimdLevel);
+
+      Statistics statistics;
+      for (const auto& lcp : problems)
+      {
+        LCPProblem replayed = lcp;
+        if (solver.mSolver->solveLCP(replayed))
+          statistics.add(replayed);
+      }
+      statistics.print(solver.mName);
+    }
+  }
+
+  dSetSimdLevel(initialLevel);
+
+  std::cout << std::flush;
+  return 0;
+}
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compares the previous dense Lemke implementation with LemkeSolver on
+// contact LCPs assembled from stacks of free-floating boxes. Each "frame"
+// nudges the boxes a little, the way consecutive time steps of a simulation
+// would, so that warm starting has something to reuse.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/lcpsolver/Lemke.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+
+//==============================================================================
+// The implementation of lcpsolver::Lemke() before LemkeSolver was introduced
+static int legacyLemke(
+    const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z)
+{
+  int n = _q.size();
+
+  const double zer_tol = 1e-5;
+  const double piv_tol = 1e-8;
+  int maxiter = 1000;
+  int err = 0;
+
+  if (_q.minCoeff() >= 0)
+  {
+    *_z = Eigen::VectorXd::Zero(n);
+    return err;
+  }
+
+  *_z = Eigen::VectorXd::Zero(2 * n);
+  int iter = 0;
+  double ratio = 0;
+  int leaving = 0;
+  Eigen::VectorXd Be = Eigen::VectorXd::Constant(n, 1);
+  Eigen::VectorXd x = _q;
+  std::vector<int> bas;
+  std::vector<int> nonbas;
+
+  int t = 2 * n;
+  int entering = t;
+
+  bas.clear();
+  nonbas.clear();
+
+  for (int i = 0; i < n; ++i)
+  {
+    nonbas.push_back(i);
+  }
+
+  Eigen::MatrixXd B = -Eigen::MatrixXd::Identity(n, n);
+
+  if (!bas.empty())
+  {
+    Eigen::MatrixXd B_copy = B;
+    for (std::size_t i = 0; i < bas.size(); ++i)
+    {
+      B.col(i) = _M.col(bas[i]);
+    }
+    for (std::size_t i = 0; i < nonbas.size(); ++i)
+    {
+      B.col(bas.size() + i) = B_copy.col(nonbas[i]);
+    }
+    Eigen::JacobiSVD<Eigen::MatrixXd> svd(B);
+    double cond = svd.singularValues()(0)
+                  / svd.singularValues()(svd.singularValues().size() - 1);
+    if (cond > 1e16)
+    {
+      (*_z) = Eigen::VectorXd::Zero(n);
+      err = 3;
+      return err;
+    }
+    x = -B.householderQr().solve(_q);
+  }
+
+  if (x.minCoeff() >= 0)
+  {
+    Eigen::VectorXd __z = Eigen::VectorXd::Zero(2 * n);
+    for (std::size_t i = 0; i < bas.size(); ++i)
+    {
+      (__z).row(bas[i]) = x.row(i);
+    }
+    (*_z) = __z.head(n);
+    return err;
+  }
+
+  Eigen::VectorXd minuxX = -x;
+  int lvindex;
+  double tval = minuxX.maxCoeff(&lvindex);
+  for (std::size_t i = 0; i < nonbas.size(); ++i)
+  {
+    bas.push_back(nonbas[i] + n);
+  }
+  leaving = bas[lvindex];
+
+  bas[lvindex] = t; // pivoting in the artificial variable
+
+  Eigen::VectorXd U = Eigen::VectorXd::Zero(n);
+  for (int i = 0; i < n; ++i)
+  {
+    if (x[i] < 0)
+      U[i] = 1;
+  }
+  Be = -(B * U);
+  x += tval * U;
+  x[lvindex] = tval;
+  B.col(lvindex) = Be;
+
+  for (iter = 0; iter < maxiter; ++iter)
+  {
+    if (leaving == t)
+    {
+      break;
+    }
+    else if (leaving < n)
+    {
+      entering = n + leaving;
+      Be = Eigen::VectorXd::Zero(n);
+      Be[leaving] = -1;
+    }
+    else
+    {
+      entering = leaving - n;
+      Be = _M.col(entering);
+    }
+
+    Eigen::VectorXd d = B.householderQr().solve(Be);
+
+    std::vector<int> j;
+    for (int i = 0; i < n; ++i)
+    {
+      if (d[i] > piv_tol)
+        j.push_back(i);
+    }
+    if (j.empty()) // no new pivots - ray termination
+    {
+      err = 2;
+      break;
+    }
+
+    std::size_t jSize = j.size();
+    Eigen::VectorXd minRatio(jSize);
+    for (std::size_t i = 0; i < jSize; ++i)
+    {
+      minRatio[i] = (x[j[i]] + zer_tol) / d[j[i]];
+    }
+    double theta = minRatio.minCoeff();
+
+    std::vector<int> tmpJ;
+    std::vector<double> tmpd;
+    for (std::size_t i = 0; i < jSize; ++i)
+    {
+      if (x[j[i]] / d[j[i]] <= theta)
+      {
+        tmpJ.push_back(j[i]);
+        tmpd.push_back(d[j[i]]);
+      }
+    }
+
+    j = tmpJ;
+    jSize = j.size();
+    if (jSize == 0)
+    {
+      err = 4;
+      break;
+    }
+    lvindex = -1;
+
+    for (std::size_t i = 0; i < jSize; ++i)
+    {
+      if (bas[j[i]] == t)
+        lvindex = i;
+    }
+
+    if (lvindex != -1)
+    {
+      lvindex = j[lvindex]; // Always use artificial if possible
+    }
+    else
+    {
+      theta = tmpd[0];
+      lvindex = 0;
+      for (std::size_t i = 0; i < jSize; ++i)
+      {
+        if (tmpd[i] - theta > piv_tol)
+        { // Bubble sorting
+          theta = tmpd[i];
+          lvindex = i;
+        }
+      }
+      lvindex = j[lvindex]; // choose the first if there are multiple
+    }
+
+    leaving = bas[lvindex];
+
+    ratio = x[lvindex] / d[lvindex];
+
+    x = x - ratio * d;
+    x[lvindex] = ratio;
+    B.col(lvindex) = Be;
+    bas[lvindex] = entering;
+  }
+
+  if (iter >= maxiter && leaving != t)
+  {
+    err = 1;
+  }
+
+  if (err == 0)
+  {
+    for (std::size_t i = 0; i < bas.size(); ++i)
+    {
+      if (bas[i] < _z->size())
+      {
+        (*_z)[bas[i]] = x[i];
+      }
+    }
+
+    Eigen::VectorXd __z = _z->head(n);
+    *_z = __z;
+
+    if (!lcpsolver::validate(_M, *_z, _q))
+    {
+      err = 3;
+    }
+  }
+  else
+  {
+    *_z = Eigen::VectorXd::Zero(n); // solve failed, return a 0 vector
+  }
+
+  return err;
+}
+
+//==============================================================================
+struct ContactLCP
+{
+  Eigen::MatrixXd mA;
+  Eigen::VectorXd mB;
+};
+
+//==============================================================================
+static SkeletonPtr createStack(std::size_t numBoxes, double x)
+{
+  SkeletonPtr stack = Skeleton::create();
+  for(std::size_t i=0; i < numBoxes; ++i)
+  {
+    BodyNode* box
+        = stack->createJointAndBodyNodePair<FreeJoint>(nullptr).second;
+    box->setMass(1.0);
+
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() = Eigen::Vector3d(x, 0.0, 0.5 + static_cast<double>(i));
+    FreeJoint::setTransform(box, tf);
+  }
+
+  return stack;
+}
+
+//==============================================================================
+/// Assemble the normal-only contact LCP of a set of stacks, with four corner
+/// contacts between every box and whatever it is resting on. Each stack is its
+/// own Skeleton, so the LCP is block diagonal with one block per stack.
+static void assembleLCP(
+    const std::vector<SkeletonPtr>& stacks, double dt, ContactLCP& lcp)
+{
+  std::size_t numContacts = 0;
+  for(const SkeletonPtr& stack : stacks)
+    numContacts += 4*stack->getNumBodyNodes();
+
+  lcp.mA.setZero(numContacts, numContacts);
+  lcp.mB.setZero(numContacts);
+
+  std::size_t offset = 0;
+  for(const SkeletonPtr& stack : stacks)
+  {
+    const std::size_t nContacts = 4*stack->getNumBodyNodes();
+    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(nContacts, stack->getNumDofs());
+
+    std::size_t row = 0;
+    for(std::size_t i=0; i < stack->getNumBodyNodes(); ++i)
+    {
+      const BodyNode* box = stack->getBodyNode(i);
+      const BodyNode* below = (i > 0)? stack->getBodyNode(i-1) : nullptr;
+      for(std::size_t c=0; c < 4; ++c)
+      {
+        const Eigen::Vector3d corner((c%2 == 0)? 0.5 : -0.5,
+                                     (c/2 == 0)? 0.5 : -0.5, -0.5);
+        J.row(row) = stack->getLinearJacobian(box, corner).row(2);
+        if(below)
+        {
+          const Eigen::Vector3d p = below->getWorldTransform().inverse()
+              * (box->getWorldTransform() * corner);
+          J.row(row) -= stack->getLinearJacobian(below, p).row(2);
+        }
+        ++row;
+      }
+    }
+
+    stack->computeForwardDynamics();
+
+    // Constraint force mixing, as the constraint solver does, keeps the
+    // redundant corner contacts well-posed
+    lcp.mA.block(offset, offset, nContacts, nContacts)
+        = J * stack->getInvMassMatrix() * J.transpose()
+          + 1e-4 * Eigen::MatrixXd::Identity(nContacts, nContacts);
+    lcp.mB.segment(offset, nContacts)
+        = J * (stack->getVelocities() + dt * stack->getAccelerations());
+
+    offset += nContacts;
+  }
+}
+
+//==============================================================================
+static double timeInMicroseconds(
+    const std::vector<ContactLCP>& lcps,
+    int (*solve)(const ContactLCP&, void*), void* data, int& failures)
+{
+  failures = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for(const ContactLCP& lcp : lcps)
+  {
+    if(solve(lcp, data) != 0)
+      ++failures;
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count()
+      / static_cast<double>(lcps.size());
+}
+
+//==============================================================================
+static int solveLegacy(const ContactLCP& lcp, void*)
+{
+  Eigen::VectorXd z;
+  return legacyLemke(lcp.mA, lcp.mB, &z);
+}
+
+//==============================================================================
+static int solveWithSolver(const ContactLCP& lcp, void* data)
+{
+  Eigen::VectorXd z;
+  return static_cast<lcpsolver::LemkeSolver*>(data)->solve(lcp.mA, lcp.mB, &z);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::size_t numFrames = 50;
+  if(argc > 1)
+    numFrames = static_cast<std::size_t>(std::atoi(argv[1]));
+
+  const double dt = 1e-3;
+  const std::size_t sizes[][2] = {{1, 3}, {2, 4}, {4, 4}, {6, 5}};
+
+  for(const auto& size : sizes)
+  {
+    const std::size_t numStacks = size[0];
+    const std::size_t numBoxes = size[1];
+
+    std::vector<SkeletonPtr> stacks;
+    for(std::size_t i=0; i < numStacks; ++i)
+      stacks.push_back(createStack(numBoxes, 2.0*static_cast<double>(i)));
+
+    std::srand(0);
+    std::vector<ContactLCP> lcps(numFrames);
+    for(ContactLCP& lcp : lcps)
+    {
+      for(const SkeletonPtr& stack : stacks)
+      {
+        stack->setVelocities(
+              0.05*Eigen::VectorXd::Random(stack->getNumDofs()));
+      }
+      assembleLCP(stacks, dt, lcp);
+    }
+
+    int failures[4];
+    double times[4];
+    times[0] = timeInMicroseconds(lcps, &solveLegacy, nullptr, failures[0]);
+
+    lcpsolver::LemkeSolver cold(lcpsolver::LemkeSolver::Options(false));
+    times[1] = timeInMicroseconds(lcps, &solveWithSolver, &cold, failures[1]);
+
+    lcpsolver::LemkeSolver warm(lcpsolver::LemkeSolver::Options(true));
+    times[2] = timeInMicroseconds(lcps, &solveWithSolver, &warm, failures[2]);
+
+    lcpsolver::LemkeSolver split(lcpsolver::LemkeSolver::Options(true, true));
+    times[3] = timeInMicroseconds(lcps, &solveWithSolver, &split, failures[3]);
+
+    const char* names[] = {"legacy Lemke()", "LemkeSolver, cold",
+                           "LemkeSolver, warm start",
+                           "LemkeSolver, warm start + blocks"};
+
+    std::cout << numStacks << " stack(s) of " << numBoxes << " boxes, "
+              << lcps.front().mB.size() << " contacts, "
+              << numFrames << " frames\n";
+    for(std::size_t i=0; i < 4; ++i)
+    {
+      std::cout << "  " << names[i] << ": " << times[i] << " us/solve";
+      if(failures[i] > 0)
+        std::cout << " (" << failures[i] << " failures)";
+      std::cout << "\n";
+    }
+  }
+
+  std::cout << std::flush;
+  return 0;
+}
@@ -619,6 +619,65 @@ TEST_F(COLLISION, SimpleFrames)
   testSimpleFrames(dart);
 }
 
+//==============================================================================
+void testMovedShapeFrames(const std::shared_ptr<CollisionDetector>& cd)
+{
+  auto simpleFrame1 = SimpleFrame::createShared(Frame::World());
+  auto simpleFrame2 = SimpleFrame::createShared(Frame::World());
+  auto simpleFrame3 = SimpleFrame::createShared(Frame::World());
+
+  simpleFrame1->setShape(std::make_shared<SphereShape>(0.5));
+  simpleFrame2->setShape(std::make_shared<SphereShape>(0.5));
+  simpleFrame3->setShape(std::make_shared<SphereShape>(0.5));
+
+  simpleFrame1->setTranslation(Eigen::Vector3d::Zero());
+  simpleFrame2->setTranslation(Eigen::Vector3d(2.0, 0.0, 0.0));
+  simpleFrame3->setTranslation(Eigen::Vector3d(4.0, 0.0, 0.0));
+
+  // Both groups share the collision object of simpleFrame2
+  auto group12 = cd->createCollisionGroup(
+        simpleFrame1.get(), simpleFrame2.get());
+  auto group23 = cd->createCollisionGroup(
+        simpleFrame2.get(), simpleFrame3.get());
+
+  EXPECT_FALSE(group12->collide());
+  EXPECT_FALSE(group23->collide());
+
+  // Nothing moved
+  EXPECT_FALSE(group12->collide());
+  EXPECT_FALSE(group23->collide());
+
+  // The engine data of simpleFrame2 is updated through group23 first, which
+  // must not hide the change from group12
+  simpleFrame2->setTranslation(Eigen::Vector3d(3.5, 0.0, 0.0));
+  EXPECT_TRUE(group23->collide());
+  EXPECT_FALSE(group12->collide());
+
+  simpleFrame2->setTranslation(Eigen::Vector3d(0.5, 0.0, 0.0));
+  EXPECT_TRUE(group12->collide());
+  EXPECT_FALSE(group23->collide());
+  EXPECT_TRUE(group12->collide());
+
+  // Moving a frame that only one group contains
+  simpleFrame1->setTranslation(Eigen::Vector3d(-2.0, 0.0, 0.0));
+  EXPECT_FALSE(group12->collide());
+}
+
+//==============================================================================
+TEST_F(COLLISION, MovedShapeFrames)
+{
+  auto fcl = FCLCollisionDetector::create();
+  testMovedShapeFrames(fcl);
+
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testMovedShapeFrames(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testMovedShapeFrames(dart);
+}
+
 //==============================================================================
 void testSphereSphere(const std::shared_ptr<CollisionDetector>& cd,
                       double tol = 1e-12)
@@ -718,6 +777,84 @@ void testSphereSphere(const std::shared_ptr<CollisionDetector>& cd,
   // detector. More comprehensive tests need to be added.
 }
 
+//==============================================================================
+TEST_F(COLLISION, ContactPairs)
+{
+  auto simpleFrame1 = SimpleFrame::createShared(Frame::World());
+  auto simpleFrame2 = SimpleFrame::createShared(Frame::World());
+  auto simpleFrame3 = SimpleFrame::createShared(Frame::World());
+
+  simpleFrame1->setShape(std::make_shared<SphereShape>(0.5));
+  simpleFrame2->setShape(std::make_shared<SphereShape>(0.5));
+  simpleFrame3->setShape(std::make_shared<SphereShape>(0.5));
+
+  std::shared_ptr<CollisionDetector> cd = DARTCollisionDetector::create();
+  auto group = cd->createCollisionGroup(
+        simpleFrame1.get(), simpleFrame2.get(), simpleFrame3.get());
+  auto object1 = group->getCollisionObject(simpleFrame1.get());
+  auto object2 = group->getCollisionObject(simpleFrame2.get());
+  auto object3 = group->getCollisionObject(simpleFrame3.get());
+
+  // Consecutive contacts between the same objects form one pair, whichever
+  // order the objects are in
+  CollisionResult result;
+  Contact contact;
+  contact.collisionObject1 = object1;
+  contact.collisionObject2 = object2;
+  result.addContact(contact);
+  contact.collisionObject1 = object2;
+  contact.collisionObject2 = object1;
+  result.addContact(contact);
+  contact.collisionObject2 = object3;
+  result.addContact(contact);
+
+  ASSERT_EQ(result.getNumContactPairs(), 2u);
+  EXPECT_EQ(result.getContactPairBegin(0), 0u);
+  EXPECT_EQ(result.getContactPairEnd(0), 2u);
+  EXPECT_EQ(result.getContactPairBegin(1), 2u);
+  EXPECT_EQ(result.getContactPairEnd(1), 3u);
+  EXPECT_TRUE(result.inCollision(simpleFrame1.get()));
+  EXPECT_TRUE(result.inCollision(simpleFrame3.get()));
+  EXPECT_EQ(result.getCollidingShapeFrames().size(), 3u);
+
+  // The colliding ShapeFrames are updated as contacts are added, and cleared
+  // with the contacts
+  result.clear();
+  EXPECT_EQ(result.getNumContactPairs(), 0u);
+  EXPECT_FALSE(result.inCollision(simpleFrame1.get()));
+  contact.collisionObject1 = object1;
+  contact.collisionObject2 = object2;
+  result.addContact(contact);
+  EXPECT_TRUE(result.inCollision(simpleFrame1.get()));
+  EXPECT_FALSE(result.inCollision(simpleFrame3.get()));
+
+  // The collision detector reports the contacts of each pair together
+  simpleFrame2->setTranslation(Eigen::Vector3d(0.9, 0.0, 0.0));
+  simpleFrame3->setTranslation(Eigen::Vector3d(1.8, 0.0, 0.0));
+  result.clear();
+  CollisionOption option;
+  EXPECT_TRUE(group->collide(option, &result));
+  ASSERT_EQ(result.getNumContactPairs(), 2u);
+  for (auto i = 0u; i < result.getNumContactPairs(); ++i)
+  {
+    const auto& first = result.getContact(result.getContactPairBegin(i));
+    for (auto j = result.getContactPairBegin(i);
+         j < result.getContactPairEnd(i); ++j)
+    {
+      EXPECT_EQ(result.getContact(j).collisionObject1, first.collisionObject1);
+      EXPECT_EQ(result.getContact(j).collisionObject2, first.collisionObject2);
+    }
+  }
+  EXPECT_EQ(result.getCollidingShapeFrames().size(), 3u);
+
+  // The colliding ShapeFrames are resolved while the contacts are added, so
+  // they can still be queried once the collision objects are gone
+  group.reset();
+  EXPECT_TRUE(result.inCollision(simpleFrame1.get()));
+  EXPECT_TRUE(result.inCollision(simpleFrame3.get()));
+  EXPECT_EQ(result.getCollidingShapeFrames().size(), 3u);
+}
+
 //==============================================================================
 TEST_F(COLLISION, SphereSphere)
 {
@@ -1153,10 +1290,12 @@ void testFilter(const std::shared_ptr<CollisionDetector>& cd)
   auto shape = std::make_shared<BoxShape>(Eigen::Vector3d(1, 1, 1));
   auto pair0 = skel->createJointAndBodyNodePair<RevoluteJoint>(nullptr);
   auto* body0 = pair0.second;
-  body0->createShapeNodeWith<VisualAspect, CollisionAspect>(shape);
+  auto* shapeNode0
+      = body0->createShapeNodeWith<VisualAspect, CollisionAspect>(shape);
   auto pair1 = body0->createChildJointAndBodyNodePair<RevoluteJoint>();
   auto* body1 = pair1.second;
-  body1->createShapeNodeWith<VisualAspect, CollisionAspect>(shape);
+  auto* shapeNode1
+      = body1->createShapeNodeWith<VisualAspect, CollisionAspect>(shape);
 
   // Create a world and add the created skeleton
   auto world = std::make_shared<simulation::World>();
@@ -1212,6 +1351,23 @@ void testFilter(const std::shared_ptr<CollisionDetector>& cd)
   EXPECT_FALSE(group->collide(option));
   bodyNodeFilter->removeAllBodyNodePairsFromBlackList();
   EXPECT_TRUE(group->collide(option));
+
+  // Test collision category and mask bits, which apply with or without filter
+  auto* collisionAspect0 = shapeNode0->getCollisionAspect();
+  auto* collisionAspect1 = shapeNode1->getCollisionAspect();
+  EXPECT_EQ(collisionAspect0->getCategoryBits(), 0x1u);
+  EXPECT_EQ(collisionAspect0->getMaskBits(), 0xFFFFFFFFu);
+  collisionAspect0->setCategoryBits(0x2u);
+  collisionAspect1->setMaskBits(~0x2u);
+  EXPECT_FALSE(group->collide());
+  EXPECT_FALSE(group->collide(option));
+  collisionAspect1->setMaskBits(0x2u);
+  EXPECT_TRUE(group->collide());
+  collisionAspect0->setMaskBits(0x2u);
+  EXPECT_FALSE(group->collide());
+  collisionAspect1->setCategoryBits(0x3u);
+  EXPECT_TRUE(group->collide());
+  EXPECT_TRUE(group->collide(option));
 }
 
 //==============================================================================
@@ -1430,6 +1586,87 @@ TEST_F(COLLISION, CollisionOfPrescribedJoints)
   }
 }
 
+//==============================================================================
+SkeletonPtr createThrownBall(bool continuousCollision)
+{
+  auto ball = Skeleton::create("ball");
+  auto pair = ball->createJointAndBodyNodePair<FreeJoint>();
+  auto joint = pair.first;
+  auto body = pair.second;
+
+  auto shapeNode = body->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<SphereShape>(0.05));
+  shapeNode->getCollisionAspect()->setContinuousCollision(continuousCollision);
+
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = Eigen::Vector3d(-0.5, 0.0, 0.0);
+  joint->setTransform(tf);
+  joint->setLinearVelocity(Eigen::Vector3d(200.0, 0.0, 0.0));
+
+  return ball;
+}
+
+//==============================================================================
+WorldPtr createThinWallWorld(const SkeletonPtr& ball)
+{
+  auto wall = Skeleton::create("wall");
+  auto body = wall->createJointAndBodyNodePair<WeldJoint>().second;
+  body->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d(0.02, 1.0, 1.0)));
+
+  auto world = World::create();
+  world->setGravity(Eigen::Vector3d::Zero());
+  world->setTimeStep(1e-3);
+  world->getConstraintSolver()->setCollisionDetector(
+        FCLCollisionDetector::create());
+  world->addSkeleton(wall);
+  world->addSkeleton(ball);
+
+  return world;
+}
+
+//==============================================================================
+TEST_F(COLLISION, ContinuousCollision)
+{
+  // The ball travels 0.2 per step, which is more than the thickness of the
+  // wall plus the diameter of the ball, so the discrete collision detection
+  // never sees them overlapping.
+  auto discreteBall = createThrownBall(false);
+  auto discreteWorld = createThinWallWorld(discreteBall);
+  for (auto i = 0u; i < 10u; ++i)
+    discreteWorld->step();
+  EXPECT_GT(discreteBall->getBodyNode(0)->getWorldTransform().translation()[0],
+            0.01);
+
+  auto continuousBall = createThrownBall(true);
+  auto continuousWorld = createThinWallWorld(continuousBall);
+  for (auto i = 0u; i < 10u; ++i)
+  {
+    continuousWorld->step();
+    EXPECT_LT(
+        continuousBall->getBodyNode(0)->getWorldTransform().translation()[0],
+        -0.01);
+
+    // The speculative contacts only become contact constraints, so the ball
+    // is not reported as colliding with the wall it has not reached yet
+    const auto& result = continuousWorld->getLastCollisionResult();
+    for (auto j = 0u; j < result.getNumContacts(); ++j)
+      EXPECT_GE(result.getContact(j).penetrationDepth, 0.0);
+  }
+  EXPECT_LT(continuousBall->getBodyNode(0)->getLinearVelocity()[0], 1.0);
+
+  // The DART collision detector has no distance queries, so continuous
+  // collision is ignored with it
+  auto dartBall = createThrownBall(true);
+  auto dartWorld = createThinWallWorld(dartBall);
+  dartWorld->getConstraintSolver()->setCollisionDetector(
+        DARTCollisionDetector::create());
+  for (auto i = 0u; i < 10u; ++i)
+    dartWorld->step();
+  EXPECT_GT(dartBall->getBodyNode(0)->getWorldTransform().translation()[0],
+            0.01);
+}
+
 //==============================================================================
 TEST_F(COLLISION, Factory)
 {
@@ -30,7 +30,12 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
 #include <Eigen/Dense>
 #include <gtest/gtest.h>
@@ -41,7 +46,15 @@
 #include "dart/math/Geometry.hpp"
 #include "dart/math/Helpers.hpp"
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/constraint/BallJointConstraint.hpp"
+#include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/constraint/DantzigLCPSolver.hpp"
+#include "dart/constraint/LCPTrace.hpp"
+#include "dart/constraint/PGSLCPSolver.hpp"
+#include "dart/constraint/SparsePGSLCPSolver.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/simulation/World.hpp"
 #include "dart/io/SkelParser.hpp"
@@ -230,3 +243,320 @@ TEST_F(ConstraintTest, SingleContactTest)
 
   SingleContactTest(getList()[0]);
 }
+
+//==============================================================================
+TEST(ConstraintSolver, ConstrainedGroups)
+{
+  using namespace dart::constraint;
+
+  ConstraintSolver solver(1e-3);
+  solver.setCollisionDetector(dart::collision::DARTCollisionDetector::create());
+
+  std::vector<SkeletonPtr> skels;
+  for (std::size_t i = 0; i < 7; ++i)
+  {
+    skels.push_back(createObject(Eigen::Vector3d(i, 0.0, 0.0)));
+    solver.addSkeleton(skels.back());
+  }
+
+  auto connect = [&](std::size_t _a, std::size_t _b)
+  {
+    solver.addConstraint(std::make_shared<BallJointConstraint>(
+        skels[_a]->getBodyNode(0), skels[_b]->getBodyNode(0),
+        Eigen::Vector3d(0.5 * (_a + _b), 0.0, 0.0)));
+  };
+
+  // {0, 1} and {2, 3, 4, 5} are each tied together, and 6 is left alone. The
+  // unions are merged in an order that leaves skeleton 4 pointing at a parent
+  // that is not the root of its union.
+  connect(0, 1);
+  connect(5, 4);
+  connect(4, 5);
+  connect(2, 3);
+  connect(3, 5);
+
+  for (std::size_t step = 0; step < 2; ++step)
+  {
+    solver.solve();
+
+    ASSERT_EQ(solver.getNumConstrainedGroups(), 2u);
+    EXPECT_EQ(solver.getConstrainedGroup(0).getNumConstraints(), 4u);
+    EXPECT_EQ(solver.getConstrainedGroup(1).getNumConstraints(), 1u);
+  }
+}
+
+//==============================================================================
+std::size_t getNumConstraints(const dart::constraint::ConstraintSolver& solver)
+{
+  std::size_t numConstraints = 0u;
+  for (std::size_t i = 0; i < solver.getNumConstrainedGroups(); ++i)
+    numConstraints += solver.getConstrainedGroup(i).getNumConstraints();
+
+  return numConstraints;
+}
+
+//==============================================================================
+TEST(ConstraintSolver, ContactManifoldReduction)
+{
+  using namespace dart::constraint;
+
+  // A box rotated about the normal sinks slightly into the ground, so the
+  // contact polygon is an octagon. The default collision detector uses meshes
+  // for primitive shapes, which reports even more contacts than that.
+  auto ground = createGround(Eigen::Vector3d(4.0, 4.0, 0.2),
+                             Eigen::Vector3d(0.0, 0.0, -0.1));
+  const double angle = 0.25 * dart::math::constantsd::pi();
+  auto box = createBox(Eigen::Vector3d(0.5, 0.5, 0.5),
+                       Eigen::Vector3d(0.0, 0.0, 0.245),
+                       Eigen::Vector3d(0.0, 0.0, angle));
+
+  ConstraintSolver solver(1e-3);
+  solver.addSkeleton(ground);
+  solver.addSkeleton(box);
+  EXPECT_FALSE(solver.isContactManifoldReductionEnabled());
+
+  solver.solve();
+  const auto numContacts = solver.getLastCollisionResult().getNumContacts();
+  EXPECT_GT(getNumConstraints(solver), 4u);
+
+  solver.setContactManifoldReductionEnabled(true);
+  EXPECT_TRUE(solver.isContactManifoldReductionEnabled());
+
+  // The collision result itself is left as it is
+  solver.solve();
+  EXPECT_EQ(solver.getLastCollisionResult().getNumContacts(), numContacts);
+  EXPECT_GE(getNumConstraints(solver), 3u);
+  EXPECT_LE(getNumConstraints(solver), 4u);
+}
+
+//==============================================================================
+TEST(ConstraintSolver, PersistentJointConstraints)
+{
+  using namespace dart::constraint;
+
+  auto skel = Skeleton::create();
+  auto joint = skel->createJointAndBodyNodePair<RevoluteJoint>().first;
+  joint->setPositionLimitEnforced(true);
+  joint->setPositionLowerLimit(0, 0.0);
+  joint->setPositionUpperLimit(0, 1.0);
+  joint->setPosition(0, -0.1);
+
+  ConstraintSolver solver(1e-3);
+  solver.addSkeleton(skel);
+
+  // The joint limit constraint is kept across steps
+  solver.solve();
+  ASSERT_EQ(solver.getNumConstrainedGroups(), 1u);
+  const auto constraint = solver.getConstrainedGroup(0).getConstraint(0);
+  solver.solve();
+  ASSERT_EQ(solver.getNumConstrainedGroups(), 1u);
+  EXPECT_EQ(solver.getConstrainedGroup(0).getConstraint(0), constraint);
+
+  // Changing the joint properties recreates the constraints
+  joint->setPositionLowerLimit(0, -1.0);
+  solver.solve();
+  EXPECT_EQ(solver.getNumConstrainedGroups(), 0u);
+
+  joint->setPositionUpperLimit(0, -0.5);
+  solver.solve();
+  EXPECT_EQ(solver.getNumConstrainedGroups(), 1u);
+
+  joint->setPositionLimitEnforced(false);
+  solver.solve();
+  EXPECT_EQ(solver.getNumConstrainedGroups(), 0u);
+
+  joint->setPositionLimitEnforced(true);
+  joint->setActuatorType(Joint::LOCKED);
+  solver.solve();
+  EXPECT_EQ(solver.getNumConstrainedGroups(), 0u);
+}
+
+//==============================================================================
+TEST(ConstraintSolver, SparsePGSLCPSolver)
+{
+  using namespace dart::constraint;
+
+  // A stack of boxes where each contact couples at most two boxes
+  const std::size_t numBoxes = 5u;
+  ConstraintSolver solver(1e-3);
+  solver.setCollisionDetector(dart::collision::DARTCollisionDetector::create());
+  solver.addSkeleton(createGround(Eigen::Vector3d(4.0, 4.0, 0.2),
+                                  Eigen::Vector3d(0.0, 0.0, -0.1)));
+
+  std::vector<SkeletonPtr> boxes;
+  for (std::size_t i = 0; i < numBoxes; ++i)
+  {
+    boxes.push_back(createBox(Eigen::Vector3d::Constant(0.5),
+                              Eigen::Vector3d(0.0, 0.0, 0.245 + 0.49 * i)));
+    solver.addSkeleton(boxes.back());
+  }
+
+  // Both solvers run the same iterations, so they find the same impulses
+  std::vector<Eigen::Vector6d> impulses;
+  solver.setLCPSolver(dart::common::make_unique<PGSLCPSolver>(1e-3));
+  solver.solve();
+  for (const auto& box : boxes)
+    impulses.push_back(box->getBodyNode(0)->getConstraintImpulse());
+
+  auto sparseSolver = new SparsePGSLCPSolver(1e-3);
+  solver.setLCPSolver(std::unique_ptr<LCPSolver>(sparseSolver));
+  solver.solve();
+  for (std::size_t i = 0; i < numBoxes; ++i)
+  {
+    EXPECT_FALSE(impulses[i].isZero());
+    EXPECT_TRUE(equals(boxes[i]->getBodyNode(0)->getConstraintImpulse(),
+                       impulses[i], 1e-10));
+  }
+
+  ASSERT_EQ(solver.getNumConstrainedGroups(), 1u);
+  const auto numConstraints = solver.getConstrainedGroup(0).getNumConstraints();
+  EXPECT_GT(numConstraints, numBoxes);
+  EXPECT_LT(sparseSolver->getNumBlocks(), numConstraints * numConstraints);
+}
+
+//==============================================================================
+TEST(ConstraintSolver, LCPCapture)
+{
+  using namespace dart::constraint;
+
+  const std::size_t numBoxes = 3u;
+  ConstraintSolver solver(1e-3);
+  solver.setCollisionDetector(dart::collision::DARTCollisionDetector::create());
+  solver.addSkeleton(createGround(Eigen::Vector3d(4.0, 4.0, 0.2),
+                                  Eigen::Vector3d(0.0, 0.0, -0.1)));
+  for (std::size_t i = 0; i < numBoxes; ++i)
+  {
+    solver.addSkeleton(createBox(Eigen::Vector3d::Constant(0.5),
+                                 Eigen::Vector3d(0.0, 0.0, 0.245 + 0.49 * i)));
+  }
+
+  const std::string fileName = "test_Constraint_LCPCapture.trace";
+  ASSERT_TRUE(solver.startLCPCapture(fileName));
+  EXPECT_TRUE(solver.isCapturingLCPs());
+
+  const std::size_t numSolves = 3u;
+  for (std::size_t i = 0; i < numSolves; ++i)
+    solver.solve();
+
+  // The trace follows the solver when it is replaced
+  solver.setLCPSolver(dart::common::make_unique<PGSLCPSolver>(1e-3));
+  EXPECT_TRUE(solver.isCapturingLCPs());
+  solver.solve();
+
+  solver.stopLCPCapture();
+  EXPECT_FALSE(solver.isCapturingLCPs());
+  solver.solve();
+
+  LCPTraceReader reader(fileName);
+  ASSERT_TRUE(reader.isOpen());
+
+  std::vector<LCPProblem> problems;
+  LCPProblem problem;
+  while (reader.read(problem))
+    problems.push_back(problem);
+  ASSERT_EQ(problems.size(), numSolves + 1u);
+
+  DantzigLCPSolver dantzig(1e-3);
+  PGSLCPSolver pgs(1e-3);
+  SparsePGSLCPSolver sparsePGS(1e-3);
+  for (std::size_t i = 0; i < problems.size(); ++i)
+  {
+    const LCPProblem& recorded = problems[i];
+    EXPECT_GT(recorded.getDimension(), 0u);
+    EXPECT_TRUE(recorded.mA.isApprox(recorded.mA.transpose()));
+    EXPECT_GE(recorded.mSolveTime, 0.0);
+
+    // Replaying a problem through the solver that recorded it reproduces the
+    // recorded solution
+    LCPProblem replayed = recorded;
+    if (i < numSolves)
+    {
+      EXPECT_LT(recorded.computeResidual(), 1e-6);
+      EXPECT_EQ(recorded.mNumIterations, 0u);
+      ASSERT_TRUE(dantzig.solveLCP(replayed));
+    }
+    else
+    {
+      EXPECT_GT(recorded.mNumIterations, 0u);
+      ASSERT_TRUE(pgs.solveLCP(replayed));
+    }
+    EXPECT_TRUE(equals(replayed.mX, recorded.mX, 1e-12));
+    EXPECT_EQ(replayed.mNumIterations, recorded.mNumIterations);
+
+    // The sparse PGS solver runs the same iterations as the dense one
+    LCPProblem dense = recorded;
+    LCPProblem sparse = recorded;
+    ASSERT_TRUE(pgs.solveLCP(dense));
+    ASSERT_TRUE(sparsePGS.solveLCP(sparse));
+    EXPECT_TRUE(equals(sparse.mX, dense.mX, 1e-12));
+    EXPECT_EQ(sparse.mNumIterations, dense.mNumIterations);
+    EXPECT_LT(sparsePGS.getNumBlocks(),
+              recorded.getDimension() * recorded.getDimension());
+  }
+
+  std::remove(fileName.c_str());
+}
+
+//==============================================================================
+TEST(ConstraintSolver, LCPTraceCorruption)
+{
+  using namespace dart::constraint;
+
+  const double A[] = {2.0, 1.0, 1.0, 2.0};
+  const double x[] = {0.0, 0.0};
+  const double b[] = {1.0, 1.0};
+  const double lo[] = {0.0, -1.0};
+  const double hi[] = {1e+10, 1.0};
+  const int findex[] = {-1, 0};
+  LCPProblem problem;
+  problem.setProblem(2u, 2u, A, x, b, lo, hi, findex);
+
+  const std::string fileName = "test_Constraint_LCPTraceCorruption.trace";
+  {
+    LCPTraceWriter writer(fileName);
+    ASSERT_TRUE(writer.isOpen());
+    writer.write(problem);
+  }
+
+  std::string trace;
+  {
+    std::ifstream file(fileName, std::ios::binary);
+    trace.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  }
+
+  // The problem is preceded by the header and stores the dimension, the
+  // iteration count, the solve time, five vectors, the friction indices and
+  // the upper triangle of the matrix
+  const std::size_t problemSize = 4u + 4u + 8u + 5u * 16u + 8u + 3u * 8u;
+  ASSERT_GT(trace.size(), problemSize);
+  const std::size_t dimensionOffset = trace.size() - problemSize;
+  const std::size_t findexOffset = dimensionOffset + 4u + 4u + 8u + 5u * 16u;
+
+  const auto readCorrupted = [&](std::size_t offset, std::int32_t value)
+  {
+    std::string corrupted = trace;
+    std::memcpy(&corrupted[offset], &value, sizeof(value));
+    {
+      std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+      file.write(corrupted.data(),
+                 static_cast<std::streamsize>(corrupted.size()));
+    }
+
+    LCPTraceReader reader(fileName);
+    EXPECT_TRUE(reader.isOpen());
+    LCPProblem read;
+    return reader.read(read);
+  };
+
+  EXPECT_TRUE(readCorrupted(dimensionOffset, 2));
+  EXPECT_TRUE(readCorrupted(findexOffset, -1));
+
+  // A dimension that the rest of the trace cannot hold is rejected before
+  // anything is allocated for it, and so are friction indices below -1
+  EXPECT_FALSE(readCorrupted(dimensionOffset, 3));
+  EXPECT_FALSE(readCorrupted(dimensionOffset, 0x7fffffff));
+  EXPECT_FALSE(readCorrupted(findexOffset, -2));
+
+  std::remove(fileName.c_str());
+}
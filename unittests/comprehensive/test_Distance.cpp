@@ -33,6 +33,9 @@
 #include <gtest/gtest.h>
 #include "dart/dart.hpp"
 #include "dart/collision/fcl/fcl.hpp"
+#if HAVE_ODE
+  #include "dart/collision/ode/ode.hpp"
+#endif
 #if HAVE_BULLET
   #include "dart/collision/bullet/bullet.hpp"
 #endif
@@ -292,3 +295,148 @@ TEST(Distance, SphereSphere)
   auto dart = DARTCollisionDetector::create();
   testSphereSphere(dart);
 }
+
+//==============================================================================
+void testBoxSphere(const std::shared_ptr<CollisionDetector>& cd,
+                   double tol = 1e-6)
+{
+  auto sphereFrame = SimpleFrame::createShared(Frame::World());
+  auto boxFrame1 = SimpleFrame::createShared(Frame::World());
+  auto boxFrame2 = SimpleFrame::createShared(Frame::World());
+
+  sphereFrame->setShape(std::make_shared<SphereShape>(0.5));
+  boxFrame1->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  boxFrame2->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+
+  auto group = cd->createCollisionGroup(
+        sphereFrame.get(), boxFrame1.get(), boxFrame2.get());
+  auto sphereGroup = cd->createCollisionGroup(sphereFrame.get());
+  auto boxGroup = cd->createCollisionGroup(boxFrame1.get(), boxFrame2.get());
+
+  collision::DistanceOption option;
+  option.enableNearestPoints = true;
+  option.distanceLowerBound = -std::numeric_limits<double>::infinity();
+  collision::DistanceResult result;
+
+  // The sphere is closer to the first box than the boxes are to each other
+  sphereFrame->setTranslation(Eigen::Vector3d::Zero());
+  boxFrame1->setTranslation(Eigen::Vector3d(2.0, 0.0, 0.0));
+  boxFrame2->setTranslation(Eigen::Vector3d(0.0, 4.0, 0.0));
+
+  EXPECT_NEAR(group->distance(option, &result), 1.0, tol);
+  EXPECT_TRUE(result.found());
+  EXPECT_NEAR(result.minDistance, 1.0, tol);
+  if (result.shapeFrame1 == sphereFrame.get())
+  {
+    EXPECT_EQ(result.shapeFrame2, boxFrame1.get());
+    EXPECT_TRUE(equals(result.nearestPoint1, Eigen::Vector3d(0.5, 0, 0), tol));
+    EXPECT_TRUE(equals(result.nearestPoint2, Eigen::Vector3d(1.5, 0, 0), tol));
+  }
+  else
+  {
+    EXPECT_EQ(result.shapeFrame1, boxFrame1.get());
+    EXPECT_EQ(result.shapeFrame2, sphereFrame.get());
+    EXPECT_TRUE(equals(result.nearestPoint1, Eigen::Vector3d(1.5, 0, 0), tol));
+    EXPECT_TRUE(equals(result.nearestPoint2, Eigen::Vector3d(0.5, 0, 0), tol));
+  }
+
+  EXPECT_NEAR(sphereGroup->distance(boxGroup.get(), option, &result), 1.0, tol);
+  EXPECT_EQ(result.shapeFrame1, sphereFrame.get());
+  EXPECT_EQ(result.shapeFrame2, boxFrame1.get());
+
+  // Penetration gives negative distance unless clamped by the lower bound
+  boxFrame1->setTranslation(Eigen::Vector3d(0.75, 0.0, 0.0));
+  EXPECT_NEAR(group->distance(option, &result), -0.25, tol);
+  EXPECT_NEAR(result.unclampedMinDistance, -0.25, tol);
+
+  option.distanceLowerBound = 0.0;
+  EXPECT_DOUBLE_EQ(group->distance(option, &result), 0.0);
+  EXPECT_DOUBLE_EQ(result.minDistance, 0.0);
+  EXPECT_LE(result.unclampedMinDistance, 0.0);
+}
+
+//==============================================================================
+TEST(Distance, BoxSphere)
+{
+#if HAVE_ODE
+  auto ode = OdeCollisionDetector::create();
+  testBoxSphere(ode);
+#endif
+
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testBoxSphere(bullet);
+#endif
+}
+
+//==============================================================================
+void testManySpheres(const std::shared_ptr<CollisionDetector>& cd,
+                     double tol = 1e-6)
+{
+  const auto numSpheres = 100u;
+  const auto radius = 0.1;
+
+  std::vector<SimpleFramePtr> frames;
+  auto group = cd->createCollisionGroup();
+  auto group1 = cd->createCollisionGroup();
+  auto group2 = cd->createCollisionGroup();
+  for (auto i = 0u; i < numSpheres; ++i)
+  {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    frame->setShape(std::make_shared<SphereShape>(radius));
+    frame->setTranslation(math::randomVector<3>(0.0, 10.0));
+    frames.push_back(frame);
+
+    group->addShapeFrame(frame.get());
+    if (i % 2u == 0u)
+      group1->addShapeFrame(frame.get());
+    else
+      group2->addShapeFrame(frame.get());
+  }
+
+  // Brute-force minimum distances over all the pairs and over the pairs
+  // between the two halves
+  auto minDistance = std::numeric_limits<double>::infinity();
+  auto minDistance12 = std::numeric_limits<double>::infinity();
+  for (auto i = 0u; i < numSpheres; ++i)
+  {
+    for (auto j = i + 1u; j < numSpheres; ++j)
+    {
+      const auto distance = (frames[i]->getWorldTransform().translation()
+          - frames[j]->getWorldTransform().translation()).norm() - 2.0 * radius;
+
+      minDistance = std::min(minDistance, distance);
+      if ((i + j) % 2u == 1u)
+        minDistance12 = std::min(minDistance12, distance);
+    }
+  }
+
+  collision::DistanceOption option;
+  option.distanceLowerBound = -std::numeric_limits<double>::infinity();
+  collision::DistanceResult result;
+
+  EXPECT_NEAR(group->distance(option, &result), minDistance, tol);
+  EXPECT_TRUE(result.found());
+  EXPECT_NEAR(group1->distance(group2.get(), option, &result), minDistance12,
+              tol);
+  EXPECT_TRUE(result.found());
+
+  // The search starts from the lower bound but doesn't stop there
+  option.distanceLowerBound = 0.5 * minDistance;
+  EXPECT_NEAR(group->distance(option, &result),
+              std::max(minDistance, option.distanceLowerBound), tol);
+}
+
+//==============================================================================
+TEST(Distance, ManySpheres)
+{
+#if HAVE_ODE
+  auto ode = OdeCollisionDetector::create();
+  testManySpheres(ode);
+#endif
+
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testManySpheres(bullet);
+#endif
+}
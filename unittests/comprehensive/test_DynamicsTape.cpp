@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/DynamicsTape.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/UniversalJoint.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+#include "dart/math/Helpers.hpp"
+
+#include "TestHelpers.hpp"
+
+using namespace dart;
+using namespace dart::dynamics;
+
+//==============================================================================
+template <class JointType>
+BodyNode* addBody(const SkeletonPtr& skel, BodyNode* parent)
+{
+  typename JointType::Properties joint;
+  joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d::Random();
+  joint.mT_ParentBodyToJoint.rotate(
+        Eigen::AngleAxisd(math::random(-1.0, 1.0), Eigen::Vector3d::UnitX()));
+  joint.mT_ChildBodyToJoint.translation() = Eigen::Vector3d::Random();
+
+  BodyNode* bn = skel->createJointAndBodyNodePair<JointType>(
+        parent, joint).second;
+
+  Joint* j = bn->getParentJoint();
+  for(std::size_t i = 0; i < j->getNumDofs(); ++i)
+  {
+    j->setSpringStiffness(i, math::random(0.0, 5.0));
+    j->setDampingCoefficient(i, math::random(0.0, 2.0));
+    j->setRestPosition(i, math::random(-0.5, 0.5));
+  }
+
+  const Eigen::Vector3d com = 0.1 * Eigen::Vector3d::Random();
+  bn->setInertia(dynamics::Inertia(math::random(0.5, 2.0), com,
+                         Eigen::Matrix3d::Identity()
+                         * math::random(0.1, 1.0)));
+  bn->addExtForce(Eigen::Vector3d::Random(), com);
+
+  return bn;
+}
+
+//==============================================================================
+SkeletonPtr createMixedSkeleton()
+{
+  SkeletonPtr skel = Skeleton::create();
+
+  BodyNode* root = addBody<FreeJoint>(skel, nullptr);
+  BodyNode* a = addBody<RevoluteJoint>(skel, root);
+  BodyNode* b = addBody<PrismaticJoint>(skel, a);
+  BodyNode* c = addBody<BallJoint>(skel, b);
+  addBody<WeldJoint>(skel, c)->setGravityMode(false);
+  BodyNode* d = addBody<UniversalJoint>(skel, root);
+  addBody<RevoluteJoint>(skel, d)->getParentJoint()->setActuatorType(
+        Joint::PASSIVE);
+  addBody<RevoluteJoint>(skel, a);
+
+  // A second tree
+  addBody<RevoluteJoint>(skel, addBody<RevoluteJoint>(skel, nullptr));
+
+  return skel;
+}
+
+//==============================================================================
+void randomizeState(const SkeletonPtr& skel)
+{
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setCommands(Eigen::VectorXd::Random(skel->getNumDofs()));
+}
+
+//==============================================================================
+/// Skeleton::setState() does not reach the Joints of a cloned Skeleton, so the
+/// state is copied one quantity at a time.
+void copyState(const SkeletonPtr& from, const SkeletonPtr& to)
+{
+  to->setPositions(from->getPositions());
+  to->setVelocities(from->getVelocities());
+  to->setCommands(from->getCommands());
+}
+
+//==============================================================================
+TEST(DynamicsTape, ForwardDynamics)
+{
+  std::srand(0);
+  SkeletonPtr skel = createMixedSkeleton();
+  SkeletonPtr taped = skel->clone();
+  taped->setUseDynamicsTape(true);
+  EXPECT_TRUE(taped->isUsingDynamicsTape());
+
+  for(std::size_t trial = 0; trial < 10; ++trial)
+  {
+    randomizeState(skel);
+    copyState(skel, taped);
+
+    skel->computeForwardDynamics();
+    taped->computeForwardDynamics();
+
+    EXPECT_TRUE(equals(skel->getAccelerations(), taped->getAccelerations(),
+                       1e-8));
+    EXPECT_TRUE(equals(skel->getForces(), taped->getForces(), 1e-12));
+
+    for(std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+    {
+      EXPECT_TRUE(equals(skel->getBodyNode(i)->getSpatialAcceleration(),
+                         taped->getBodyNode(i)->getSpatialAcceleration(),
+                         1e-8));
+      EXPECT_TRUE(equals(skel->getBodyNode(i)->getBodyForce(),
+                         taped->getBodyNode(i)->getBodyForce(), 1e-8));
+    }
+  }
+
+  // Changing properties must be picked up by the tape
+  for(const SkeletonPtr& s : {skel, taped})
+  {
+    s->getBodyNode(2)->setMass(3.0);
+    s->getJoint(1)->setDampingCoefficient(0, 4.0);
+    s->getJoint(3)->setTransformFromParentBodyNode(
+          Eigen::Isometry3d(Eigen::Translation3d(0.1, 0.2, 0.3)));
+    s->computeForwardDynamics();
+  }
+  EXPECT_TRUE(equals(skel->getAccelerations(), taped->getAccelerations(),
+                     1e-8));
+
+  // Structural changes too. Both Skeletons get the same random body.
+  for(const SkeletonPtr& s : {skel, taped})
+  {
+    std::srand(2);
+    addBody<RevoluteJoint>(s, s->getBodyNode(3));
+    s->setCommands(Eigen::VectorXd::Zero(s->getNumDofs()));
+    s->computeForwardDynamics();
+  }
+  EXPECT_TRUE(equals(skel->getAccelerations(), taped->getAccelerations(),
+                     1e-8));
+}
+
+//==============================================================================
+TEST(DynamicsTape, InertiaChanges)
+{
+  std::srand(3);
+  SkeletonPtr skel = createMixedSkeleton();
+  SkeletonPtr taped = skel->clone();
+  taped->setUseDynamicsTape(true);
+  randomizeState(skel);
+  copyState(skel, taped);
+
+  // Record the tape before any of the inertia changes
+  taped->computeForwardDynamics();
+
+  // Each setter on its own must be picked up by the tape
+  for(int change = 0; change < 3; ++change)
+  {
+    for(const SkeletonPtr& s : {skel, taped})
+    {
+      BodyNode* bn = s->getBodyNode(2);
+      if(change == 0)
+        bn->setMass(4.0);
+      else if(change == 1)
+        bn->setMomentOfInertia(0.5, 0.6, 0.7);
+      else
+        bn->setLocalCOM(Eigen::Vector3d(0.1, -0.2, 0.05));
+
+      s->computeForwardDynamics();
+    }
+
+    EXPECT_TRUE(equals(skel->getAccelerations(), taped->getAccelerations(),
+                       1e-8)) << "change #" << change;
+  }
+}
+
+//==============================================================================
+TEST(DynamicsTape, InverseDynamics)
+{
+  std::srand(1);
+  SkeletonPtr skel = createMixedSkeleton();
+  DynamicsTape tape;
+
+  for(std::size_t trial = 0; trial < 10; ++trial)
+  {
+    randomizeState(skel);
+    skel->setAccelerations(Eigen::VectorXd::Random(skel->getNumDofs()));
+
+    for(int flags = 0; flags < 8; ++flags)
+    {
+      const bool ext = (flags & 1) != 0;
+      const bool damping = (flags & 2) != 0;
+      const bool spring = (flags & 4) != 0;
+
+      ASSERT_TRUE(tape.computeInverseDynamics(*skel, ext, damping, spring));
+      skel->computeInverseDynamics(ext, damping, spring);
+      EXPECT_TRUE(equals(skel->getForces(), tape.getForces(), 1e-8));
+    }
+  }
+}
+
+//==============================================================================
+TEST(DynamicsTape, UnsupportedSkeleton)
+{
+  SkeletonPtr skel = createMixedSkeleton();
+  skel->getJoint(1)->setActuatorType(Joint::VELOCITY);
+
+  DynamicsTape tape;
+  EXPECT_FALSE(tape.computeForwardDynamics(*skel));
+
+  // The Skeleton falls back to the regular recursions
+  SkeletonPtr taped = skel->clone();
+  taped->setUseDynamicsTape(true);
+  randomizeState(skel);
+  copyState(skel, taped);
+  skel->computeForwardDynamics();
+  taped->computeForwardDynamics();
+  EXPECT_TRUE(equals(skel->getAccelerations(), taped->getAccelerations(),
+                     1e-12));
+}
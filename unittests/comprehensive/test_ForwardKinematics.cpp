@@ -248,3 +248,213 @@ TEST(FORWARD_KINEMATICS, JACOBIAN_END_EFFECTOR_CHANGE)
 
   EXPECT_TRUE((fd_J - J).norm() < tolerance);
 }
+
+//==============================================================================
+template <typename JointType>
+BodyNode* addBatchLink(const SkeletonPtr& skel, BodyNode* parent,
+                       const Eigen::Vector3d& offset)
+{
+  typename JointType::Properties properties;
+  properties.mT_ParentBodyToJoint.translation() = offset;
+  properties.mT_ChildBodyToJoint.translation()
+      = Eigen::Vector3d(0.0, 0.05, 0.1);
+  return skel->createJointAndBodyNodePair<JointType>(
+        parent, properties).second;
+}
+
+//==============================================================================
+SkeletonPtr createBatchSkeleton()
+{
+  SkeletonPtr skel = Skeleton::create("batch");
+  const Eigen::Vector3d offset(0.1, 0.0, 0.3);
+
+  BodyNode* root = addBatchLink<FreeJoint>(skel, nullptr, offset);
+  BodyNode* bn = addBatchLink<RevoluteJoint>(skel, root, offset);
+  bn = addBatchLink<PrismaticJoint>(skel, bn, offset);
+  bn = addBatchLink<BallJoint>(skel, bn, offset);
+  bn = addBatchLink<WeldJoint>(skel, bn, offset);
+  bn = addBatchLink<UniversalJoint>(skel, bn, offset);
+  addBatchLink<ScrewJoint>(skel, bn, offset);
+
+  bn = addBatchLink<EulerJoint>(skel, root, offset);
+  bn = addBatchLink<TranslationalJoint>(skel, bn, offset);
+  addBatchLink<PlanarJoint>(skel, bn, offset);
+
+  return skel;
+}
+
+//==============================================================================
+TEST(FORWARD_KINEMATICS, BATCH)
+{
+  const double tolerance = 1e-10;
+  const std::size_t numConfigs = 50;
+
+  SkeletonPtr skel = createBatchSkeleton();
+  SkeletonPtr reference = skel->clone();
+
+  std::vector<const BodyNode*> bodyNodes;
+  for(std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+    bodyNodes.push_back(skel->getBodyNode(i));
+
+  const Eigen::VectorXd initial = Eigen::VectorXd::Random(skel->getNumDofs());
+  skel->setPositions(initial);
+
+  const Eigen::MatrixXd configs
+      = Eigen::MatrixXd::Random(skel->getNumDofs(), numConfigs);
+
+  for(const std::size_t numThreads : {1u, 4u})
+  {
+    dart::common::aligned_vector<Eigen::Isometry3d> transforms;
+    Eigen::MatrixXd jacobians;
+    skel->computeBatchForwardKinematics(
+          configs, bodyNodes, transforms, &jacobians, numThreads);
+
+    ASSERT_EQ(transforms.size(), numConfigs * bodyNodes.size());
+
+    // The Skeleton itself must be left untouched
+    EXPECT_TRUE(equals(skel->getPositions(), initial, 0.0));
+
+    for(std::size_t c = 0; c < numConfigs; ++c)
+    {
+      reference->setPositions(configs.col(c));
+      for(std::size_t b = 0; b < bodyNodes.size(); ++b)
+      {
+        const BodyNode* bn = reference->getBodyNode(b);
+        const std::size_t index = c * bodyNodes.size() + b;
+
+        EXPECT_TRUE(equals(transforms[index].matrix(),
+                           bn->getWorldTransform().matrix(), tolerance));
+
+        const Jacobian J = jacobians.block(
+              0, index * skel->getNumDofs(), 6, skel->getNumDofs());
+        EXPECT_TRUE(equals(J, reference->getWorldJacobian(bn), tolerance));
+      }
+    }
+  }
+
+  // A Group that only covers some of the DOFs: the remaining ones keep their
+  // current positions
+  std::vector<DegreeOfFreedom*> dofs;
+  std::vector<DegreeOfFreedom*> referenceDofs;
+  for(std::size_t i = 6; i < skel->getNumDofs(); i += 2)
+  {
+    dofs.push_back(skel->getDof(i));
+    referenceDofs.push_back(reference->getDof(i));
+  }
+  GroupPtr group = Group::create("group", dofs);
+  GroupPtr referenceGroup = Group::create("reference", referenceDofs);
+
+  const Eigen::MatrixXd groupConfigs
+      = Eigen::MatrixXd::Random(group->getNumDofs(), numConfigs);
+  dart::common::aligned_vector<Eigen::Isometry3d> transforms;
+  Eigen::MatrixXd jacobians;
+  group->computeBatchForwardKinematics(
+        groupConfigs, bodyNodes, transforms, &jacobians);
+
+  reference->setPositions(initial);
+  for(std::size_t c = 0; c < numConfigs; ++c)
+  {
+    referenceGroup->setPositions(groupConfigs.col(c));
+    for(std::size_t b = 0; b < bodyNodes.size(); ++b)
+    {
+      const BodyNode* bn = reference->getBodyNode(b);
+      const std::size_t index = c * bodyNodes.size() + b;
+
+      EXPECT_TRUE(equals(transforms[index].matrix(),
+                         bn->getWorldTransform().matrix(), tolerance));
+
+      const Jacobian J = jacobians.block(
+            0, index * group->getNumDofs(), 6, group->getNumDofs());
+      EXPECT_TRUE(equals(J, referenceGroup->getWorldJacobian(bn), tolerance));
+    }
+  }
+}
+
+//==============================================================================
+/// RevoluteJoint that behaves like a custom Joint type which does not
+/// implement computeRelativeTransform()
+class OpaqueRevoluteJoint : public RevoluteJoint
+{
+public:
+  OpaqueRevoluteJoint(const Properties& properties)
+    : RevoluteJoint(properties)
+  {
+    // Do nothing
+  }
+
+  Eigen::Isometry3d computeRelativeTransform(
+      const Eigen::VectorXd& positions) const override
+  {
+    return Joint::computeRelativeTransform(positions);
+  }
+
+  bool canComputeRelativeTransform() const override
+  {
+    return false;
+  }
+};
+
+//==============================================================================
+TEST(FORWARD_KINEMATICS, DEFAULT_RELATIVE_TRANSFORM)
+{
+  const double tolerance = 1e-10;
+  const std::size_t numConfigs = 10;
+
+  SkeletonPtr skel = createBatchSkeleton();
+
+  // Every Joint type of DART computes its relative transform
+  for(std::size_t i = 0; i < skel->getNumJoints(); ++i)
+    EXPECT_TRUE(skel->getJoint(i)->canComputeRelativeTransform());
+
+  BodyNode* bn = addBatchLink<OpaqueRevoluteJoint>(
+        skel, skel->getBodyNode(1), Eigen::Vector3d(0.1, 0.0, 0.3));
+  addBatchLink<RevoluteJoint>(skel, bn, Eigen::Vector3d(0.1, 0.0, 0.3));
+
+  // The default implementation refuses to compute the transform instead of
+  // touching the state of the Joint
+  const Joint* joint = bn->getParentJoint();
+  EXPECT_FALSE(joint->canComputeRelativeTransform());
+  EXPECT_TRUE(equals(joint->computeRelativeTransform(
+                       Eigen::VectorXd::Constant(1, 0.5)).matrix(),
+                     Eigen::Isometry3d::Identity().matrix(), 0.0));
+
+  // The batched forward kinematics falls back to setting the positions of the
+  // Skeleton for each configuration, and restores them afterwards
+  std::vector<const BodyNode*> bodyNodes;
+  for(std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+    bodyNodes.push_back(skel->getBodyNode(i));
+
+  const Eigen::VectorXd initial = Eigen::VectorXd::Random(skel->getNumDofs());
+  skel->setPositions(initial);
+
+  const Eigen::MatrixXd configs
+      = Eigen::MatrixXd::Random(skel->getNumDofs(), numConfigs);
+
+  dart::common::aligned_vector<Eigen::Isometry3d> transforms;
+  Eigen::MatrixXd jacobians;
+  skel->computeBatchForwardKinematics(
+        configs, bodyNodes, transforms, &jacobians, 4u);
+
+  ASSERT_EQ(transforms.size(), numConfigs * bodyNodes.size());
+  EXPECT_TRUE(equals(skel->getPositions(), initial, 0.0));
+
+  SkeletonPtr reference = skel->clone();
+  for(std::size_t c = 0; c < numConfigs; ++c)
+  {
+    reference->setPositions(configs.col(c));
+    for(std::size_t b = 0; b < bodyNodes.size(); ++b)
+    {
+      const BodyNode* referenceBn = reference->getBodyNode(b);
+      const std::size_t index = c * bodyNodes.size() + b;
+
+      EXPECT_TRUE(equals(transforms[index].matrix(),
+                         referenceBn->getWorldTransform().matrix(),
+                         tolerance));
+
+      const Jacobian J = jacobians.block(
+            0, index * skel->getNumDofs(), 6, skel->getNumDofs());
+      EXPECT_TRUE(equals(J, reference->getWorldJacobian(referenceBn),
+                         tolerance));
+    }
+  }
+}
@@ -740,3 +740,65 @@ TEST(FRAMES, CHILDHOOD)
 
   EXPECT_TRUE(F1.getNumChildFrames() == 1);
 }
+
+//==============================================================================
+TEST(FRAMES, INVALIDATION)
+{
+  // Reparenting must keep the Frames that get invalidated in sync with the
+  // child Entities of each Frame
+  SimpleFrame F1(Frame::World(), "F1");
+  SimpleFrame F2(&F1, "F2");
+  SimpleFrame F3(&F1, "F3");
+  F3.setParentFrame(&F2);
+
+  Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+  tf.translation() = Eigen::Vector3d(1.0, 2.0, 3.0);
+
+  EXPECT_EQ(F1.getNumChildEntities(), 1u);
+  EXPECT_EQ(F2.getNumChildEntities(), 1u);
+  F3.getWorldTransform();
+  F1.setRelativeTransform(tf);
+  EXPECT_TRUE(F3.needsTransformUpdate());
+  EXPECT_TRUE(equals(F3.getWorldTransform().matrix(), tf.matrix()));
+
+  F3.setParentFrame(Frame::World());
+  EXPECT_EQ(F2.getNumChildEntities(), 0u);
+  F3.getWorldTransform();
+  F1.setRelativeTransform(Eigen::Isometry3d::Identity());
+  EXPECT_FALSE(F3.needsTransformUpdate());
+
+  // Setting all the positions of a Skeleton at once must give the same result
+  // as setting them one DegreeOfFreedom at a time, and must invalidate the
+  // whole subtree of each Joint whose positions changed.
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  bn = skel->createJointAndBodyNodePair<BallJoint>(bn).second;
+  bn = skel->createJointAndBodyNodePair<RevoluteJoint>(bn).second;
+  bn = skel->createJointAndBodyNodePair<BallJoint>(bn).second;
+  SimpleFrame F4(bn, "F4", tf);
+
+  SkeletonPtr other = skel->clone();
+  const Eigen::VectorXd q = Eigen::VectorXd::Random(skel->getNumDofs());
+  skel->setPositions(q);
+  for(std::size_t i = 0; i < other->getNumDofs(); ++i)
+    other->setPosition(i, q[i]);
+
+  for(std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+  {
+    EXPECT_TRUE(equals(skel->getBodyNode(i)->getWorldTransform().matrix(),
+                       other->getBodyNode(i)->getWorldTransform().matrix()));
+  }
+  EXPECT_TRUE(equals(F4.getWorldTransform().matrix(),
+                     (bn->getWorldTransform() * tf).matrix()));
+
+  skel->setPositions(q);
+  EXPECT_FALSE(bn->needsTransformUpdate());
+  EXPECT_FALSE(F4.needsTransformUpdate());
+
+  Eigen::VectorXd q2 = q;
+  q2[3] += 0.5;
+  skel->setPositions(q2);
+  EXPECT_TRUE(bn->needsTransformUpdate());
+  EXPECT_TRUE(F4.needsTransformUpdate());
+  EXPECT_TRUE(equals(skel->getPositions(), q2));
+}
@@ -31,10 +31,13 @@
  */
 
 #include <iostream>
+#include <set>
+#include <thread>
 #include <gtest/gtest.h>
 
 #include "dart/config.hpp"
 #include "dart/math/Helpers.hpp"
+#include "dart/optimizer/LevenbergMarquardtSolver.hpp"
 #include "TestHelpers.hpp"
 
 using namespace Eigen;
@@ -248,3 +251,311 @@ SkeletonPtr createFreeFloatingTwoLinkRobot(Vector3d dim1,
 //  }
 //}
 #endif
+
+//==============================================================================
+TEST(InverseKinematics, SolveBatch)
+{
+  const std::size_t numTargets = 24;
+
+  SkeletonPtr robot = createFreeFloatingTwoLinkRobot(
+        Vector3d(0.3, 0.3, 1.0), Vector3d(0.3, 0.3, 1.0), DOF_PITCH);
+  BodyNode* ee = robot->getBodyNode("ee");
+  ASSERT_NE(ee, nullptr);
+
+  const InverseKinematicsPtr ik = ee->getIK(true);
+  const Eigen::VectorXd originalPositions = robot->getPositions();
+
+  // Generate reachable targets by sampling configurations near the current one
+  common::aligned_vector<Isometry3d> targets;
+  for(std::size_t i=0; i < numTargets; ++i)
+  {
+    robot->setPositions(originalPositions + 0.3*VectorXd::Random(
+                          static_cast<int>(robot->getNumDofs())));
+    targets.push_back(ee->getWorldTransform());
+  }
+  robot->setPositions(originalPositions);
+
+  std::vector<VectorXd> solutions;
+  std::vector<bool> successes;
+  for(const bool warmStart : {false, true})
+  {
+    const std::size_t numSolved = ik->solveBatch(
+          targets, std::vector<VectorXd>(), solutions, successes,
+          InverseKinematics::BatchOptions(warmStart, 3));
+
+    EXPECT_EQ(numSolved, numTargets);
+    ASSERT_EQ(solutions.size(), numTargets);
+    ASSERT_EQ(successes.size(), numTargets);
+
+    // The original Skeleton must not be modified
+    EXPECT_TRUE(equals(robot->getPositions(), originalPositions, 0.0));
+
+    SkeletonPtr check = robot->clone();
+    for(std::size_t i=0; i < numTargets; ++i)
+    {
+      EXPECT_TRUE(successes[i]);
+      check->setPositions(ik->getDofs(), solutions[i]);
+      EXPECT_TRUE(equals(check->getBodyNode("ee")->getWorldTransform(),
+                         targets[i], 1e-3));
+    }
+  }
+
+  // An objective that cannot be cloned must only be used by one thread
+  std::set<std::thread::id> threadIds;
+  auto objective = std::make_shared<optimizer::ModularFunction>();
+  objective->setCostFunction([&](const Eigen::VectorXd&)
+  {
+    threadIds.insert(std::this_thread::get_id());
+    return 0.0;
+  });
+  ik->setObjective(objective);
+
+  EXPECT_EQ(ik->solveBatch(targets, std::vector<VectorXd>(), solutions,
+                           successes, InverseKinematics::BatchOptions(true, 3)),
+            numTargets);
+  EXPECT_EQ(threadIds.size(), 1u);
+  ik->setObjective(nullptr);
+}
+
+//==============================================================================
+TEST(InverseKinematics, EvalWithGradient)
+{
+  SkeletonPtr robot = createFreeFloatingTwoLinkRobot(
+        Vector3d(0.3, 0.3, 1.0), Vector3d(0.3, 0.3, 1.0), DOF_PITCH);
+  robot->setPositions(0.5*VectorXd::Random(
+                        static_cast<int>(robot->getNumDofs())));
+  BodyNode* ee = robot->getBodyNode("ee");
+  ASSERT_NE(ee, nullptr);
+
+  const Vector3d offset(0.1, -0.2, 0.3);
+  const InverseKinematicsPtr ik = ee->getIK(true);
+  ik->setOffset(offset);
+
+  // The IK Jacobian applies the offset to each column it uses, so it must
+  // match the columns of the Node's offset Jacobian
+  const math::Jacobian fullJacobian = ee->getWorldJacobian(offset);
+  const math::Jacobian& J = ik->computeJacobian();
+  for(std::size_t i=0; i < ik->getDofMap().size(); ++i)
+  {
+    const int j = ik->getDofMap()[i];
+    if(j >= 0)
+      EXPECT_TRUE(equals(Eigen::Vector6d(J.col(j)),
+                         Eigen::Vector6d(fullJacobian.col(i)), 1e-10));
+  }
+
+  Isometry3d target = ee->getWorldTransform();
+  target.translation() += Vector3d(0.05, 0.1, -0.05);
+  ik->getTarget()->setTransform(target);
+
+  const std::shared_ptr<optimizer::Function> constraint =
+      ik->getProblem()->getEqConstraint(0);
+  const VectorXd q = ik->getPositions();
+
+  const double value = constraint->eval(q);
+  VectorXd grad = VectorXd::Zero(q.size());
+  constraint->evalGradient(q, grad);
+
+  VectorXd fusedGrad = VectorXd::Zero(q.size());
+  const double fusedValue = constraint->evalWithGradient(q, fusedGrad);
+
+  EXPECT_GT(value, 0.0);
+  EXPECT_NEAR(value, fusedValue, 1e-12);
+  EXPECT_TRUE(equals(grad, fusedGrad, 1e-12));
+
+  // Evaluating at a different configuration must not reuse stale caches
+  const VectorXd q2 = q + 0.1*VectorXd::Ones(q.size());
+  ik->setPositions(q2);
+  VectorXd grad2 = VectorXd::Zero(q.size());
+  const double value2 = constraint->evalWithGradient(q2, grad2);
+
+  ik->setPositions(q2);
+  VectorXd expectedGrad2 = VectorXd::Zero(q.size());
+  const double expectedValue2 = constraint->eval(q2);
+  constraint->evalGradient(q2, expectedGrad2);
+
+  EXPECT_NEAR(value2, expectedValue2, 1e-12);
+  EXPECT_TRUE(equals(grad2, expectedGrad2, 1e-12));
+  EXPECT_FALSE(equals(grad, grad2, 1e-6));
+
+  // Changing the gradient properties must not reuse the cached gradient
+  // either, even at the same configuration
+  ik->getGradientMethod().setComponentWiseClamp(HUGE_VAL);
+  VectorXd unclampedGrad = VectorXd::Zero(q.size());
+  constraint->evalGradient(q2, unclampedGrad);
+  ik->getGradientMethod().setComponentWeights(
+        0.5*VectorXd::Ones(q2.size()));
+  VectorXd weightedGrad = VectorXd::Zero(q.size());
+  constraint->evalGradient(q2, weightedGrad);
+  EXPECT_TRUE(equals(weightedGrad, VectorXd(0.5*unclampedGrad), 1e-12));
+
+  ik->getGradientMethod().setComponentWiseClamp(1e-3);
+  VectorXd clampedGrad = VectorXd::Zero(q.size());
+  constraint->evalGradient(q2, clampedGrad);
+  EXPECT_LE(clampedGrad.cwiseAbs().maxCoeff(), 1e-3);
+
+  InverseKinematics::JacobianDLS& dls =
+      ik->setGradientMethod<InverseKinematics::JacobianDLS>();
+  dls.setComponentWiseClamp(HUGE_VAL);
+  VectorXd dlsGrad = VectorXd::Zero(q.size());
+  constraint->evalGradient(q2, dlsGrad);
+  dls.setDampingCoefficient(10.0);
+  VectorXd dampedGrad = VectorXd::Zero(q.size());
+  constraint->evalGradient(q2, dampedGrad);
+  EXPECT_FALSE(equals(dlsGrad, dampedGrad, 1e-6));
+}
+
+//==============================================================================
+TEST(InverseKinematics, HierarchicalLevenbergMarquardt)
+{
+  SkeletonPtr robot = createFreeFloatingTwoLinkRobot(
+        Vector3d(0.3, 0.3, 1.0), Vector3d(0.3, 0.3, 1.0), DOF_PITCH);
+  BodyNode* ee = robot->getBodyNode("ee");
+  ASSERT_NE(ee, nullptr);
+
+  const InverseKinematicsPtr ik = ee->getIK(true);
+  Isometry3d target = ee->getWorldTransform();
+  target.translation() += Vector3d(0.2, -0.1, 0.3);
+  target.rotate(AngleAxisd(0.3, Vector3d::UnitZ()));
+  ik->getTarget()->setTransform(target);
+
+  // TaskSpaceRegion clamps the error, but least-squares solvers must see the
+  // unclamped error
+  const VectorXd q = ik->getPositions();
+  InverseKinematics::ErrorMethod& errorMethod = ik->getErrorMethod();
+  errorMethod.setErrorLengthClamp(0.01);
+  EXPECT_NEAR(errorMethod.evalError(q).norm(), 0.01, 1e-12);
+  EXPECT_GT(errorMethod.evalUnclampedError(q).norm(), 0.1);
+  errorMethod.setErrorLengthClamp();
+
+  const std::shared_ptr<WholeBodyIK>& wholeBodyIk = robot->getIK(true);
+  auto solver = std::make_shared<optimizer::LevenbergMarquardtSolver>();
+  wholeBodyIk->setSolver(solver);
+
+  EXPECT_TRUE(wholeBodyIk->solve());
+  EXPECT_TRUE(equals(target, ee->getWorldTransform(), 1e-5));
+  EXPECT_EQ(solver->getLastStatistics().mNumAcceptedSteps
+            + solver->getLastStatistics().mNumRejectedSteps,
+            solver->getLastStatistics().mNumIterations);
+}
+
+//==============================================================================
+static SkeletonPtr createBranchingRobot(std::size_t numBranches,
+                                        std::size_t branchLength)
+{
+  SkeletonPtr robot = Skeleton::create();
+  BodyNode* root = robot->createJointAndBodyNodePair<FreeJoint>().second;
+
+  for(std::size_t i=0; i < numBranches; ++i)
+  {
+    BodyNode* parent = root;
+    for(std::size_t j=0; j < branchLength; ++j)
+    {
+      RevoluteJoint::Properties joint;
+      joint.mAxis = (j%2 == 0)? Vector3d::UnitY() : Vector3d::UnitX();
+      joint.mT_ParentBodyToJoint.translation() =
+          (j == 0)? Vector3d(std::cos(i), std::sin(i), 0.0)
+                  : Vector3d(0.0, 0.0, 0.3);
+      parent = robot->createJointAndBodyNodePair<RevoluteJoint>(
+            parent, joint).second;
+    }
+  }
+
+  return robot;
+}
+
+//==============================================================================
+static std::vector<MatrixXd> computeReferenceNullSpaces(
+    const HierarchicalIK& hik)
+{
+  const std::size_t nDofs = hik.getSkeleton()->getNumDofs();
+  const IKHierarchy& hierarchy = hik.getIKHierarchy();
+  std::vector<MatrixXd> nullSpaces(hierarchy.size());
+
+  MatrixXd NS = MatrixXd::Identity(nDofs, nDofs);
+  for(std::size_t i=0; i < hierarchy.size(); ++i)
+  {
+    for(const std::shared_ptr<InverseKinematics>& ik : hierarchy[i])
+    {
+      if(!ik->isActive())
+        continue;
+
+      const math::Jacobian& J = ik->computeJacobian();
+      const std::vector<std::size_t>& dofs = ik->getDofs();
+      MatrixXd fullJ = MatrixXd::Zero(6, nDofs);
+      for(std::size_t d=0; d < dofs.size(); ++d)
+        fullJ.col(dofs[d]) = J.col(d);
+
+      JacobiSVD<MatrixXd> svd(fullJ, ComputeFullV);
+      MatrixXd N;
+      math::extractNullSpace(svd, N);
+      if(N.cols() > 0)
+        NS = NS * N * N.transpose();
+      else
+        NS.setZero();
+    }
+
+    nullSpaces[i] = NS;
+  }
+
+  return nullSpaces;
+}
+
+//==============================================================================
+TEST(InverseKinematics, HierarchicalNullSpaces)
+{
+  SkeletonPtr robot = createBranchingRobot(4, 5);
+
+  // One end effector per branch, each on its own level of the hierarchy, plus
+  // a mid-branch module sharing a level with one of the end effectors.
+  for(std::size_t i=0; i < 4; ++i)
+  {
+    BodyNode* tip = robot->getBodyNode(5*(i+1));
+    const InverseKinematicsPtr ik = tip->getIK(true);
+    ik->setHierarchyLevel(i);
+    ik->setOffset(Vector3d(0.0, 0.0, 0.1));
+  }
+  robot->getBodyNode(3)->getIK(true)->setHierarchyLevel(1);
+
+  const std::shared_ptr<WholeBodyIK>& wholeBodyIk = robot->getIK(true);
+
+  for(std::size_t trial=0; trial < 5; ++trial)
+  {
+    robot->setPositions(VectorXd::Random(robot->getNumDofs()));
+
+    const std::vector<MatrixXd>& nullSpaces = wholeBodyIk->computeNullSpaces();
+    const std::vector<MatrixXd> expected =
+        computeReferenceNullSpaces(*wholeBodyIk);
+
+    ASSERT_EQ(nullSpaces.size(), expected.size());
+    for(std::size_t i=0; i < expected.size(); ++i)
+      EXPECT_TRUE(equals(nullSpaces[i], expected[i], 1e-8));
+
+    // Moving a single branch should give the same answer as a full
+    // recomputation, even though most of the cached row spaces are reused.
+    robot->getDof(6 + 5*(trial%4))->setPosition(
+          math::random(-1.0, 1.0));
+    const std::vector<MatrixXd>& updated = wholeBodyIk->computeNullSpaces();
+    const std::vector<MatrixXd> updatedExpected =
+        computeReferenceNullSpaces(*wholeBodyIk);
+    for(std::size_t i=0; i < updatedExpected.size(); ++i)
+      EXPECT_TRUE(equals(updated[i], updatedExpected[i], 1e-8));
+  }
+
+  // Deactivating a module must invalidate the affected levels
+  robot->getBodyNode(3)->getIK()->setActive(false);
+  const std::vector<MatrixXd>& nullSpaces = wholeBodyIk->computeNullSpaces();
+  const std::vector<MatrixXd> expected =
+      computeReferenceNullSpaces(*wholeBodyIk);
+  for(std::size_t i=0; i < expected.size(); ++i)
+    EXPECT_TRUE(equals(nullSpaces[i], expected[i], 1e-8));
+
+  // So must changing the properties of a Joint without moving anything
+  RevoluteJoint* joint =
+      static_cast<RevoluteJoint*>(robot->getDof(6)->getJoint());
+  joint->setAxis(Vector3d(1.0, 1.0, 0.0).normalized());
+  const std::vector<MatrixXd>& reaxed = wholeBodyIk->computeNullSpaces();
+  const std::vector<MatrixXd> reaxedExpected =
+      computeReferenceNullSpaces(*wholeBodyIk);
+  for(std::size_t i=0; i < reaxedExpected.size(); ++i)
+    EXPECT_TRUE(equals(reaxed[i], reaxedExpected[i], 1e-8));
+}
@@ -30,6 +30,7 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <limits>
 #include <vector>
 #include <string>
 
@@ -38,6 +39,8 @@
 
 #include "dart/common/Console.hpp"
 #include "dart/math/Constants.hpp"
+#include "dart/math/Geometry.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/Joint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/dynamics/SoftBodyNode.hpp"
@@ -458,3 +461,189 @@ TEST_F(SoftDynamicsTest, compareEquationsOfMotion)
 //    compareEquationsOfMotion(getList()[i]);
 //  }
 }
+
+//==============================================================================
+static dynamics::SkeletonPtr createSoftBox(const Eigen::Vector3i& _frags)
+{
+  using namespace dynamics;
+
+  SkeletonPtr skel = Skeleton::create();
+  SoftBodyNode::Properties properties(
+        BodyNode::AspectProperties("soft box"),
+        SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d(0.3, 0.2, 0.1), Eigen::Isometry3d::Identity(),
+          _frags, 2.0));
+  skel->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>(
+        nullptr, FreeJoint::Properties(), properties);
+
+  return skel;
+}
+
+//==============================================================================
+TEST(SoftDynamics, PointMassThreads)
+{
+  using namespace dynamics;
+
+  // Enough PointMasses for the updates to be split across at least two
+  // threads of 4096 PointMasses each
+  const Eigen::Vector3i frags(40, 40, 40);
+  SkeletonPtr serial = createSoftBox(frags);
+  SkeletonPtr threaded = createSoftBox(frags);
+
+  SoftBodyNode* serialBody = serial->getSoftBodyNode(0);
+  SoftBodyNode* threadedBody = threaded->getSoftBodyNode(0);
+  ASSERT_GT(serialBody->getNumPointMasses(), 8192u);
+  threadedBody->setNumPointMassThreads(4u);
+  EXPECT_EQ(serialBody->getNumPointMassThreads(), 1u);
+  EXPECT_EQ(threadedBody->getNumPointMassThreads(), 4u);
+
+  for(std::size_t i = 0; i < serialBody->getNumPointMasses(); ++i)
+  {
+    const Eigen::Vector3d q = 0.01 * Eigen::Vector3d::Random();
+    const Eigen::Vector3d dq = 0.1 * Eigen::Vector3d::Random();
+    serialBody->getPointMass(i)->setPositions(q);
+    serialBody->getPointMass(i)->setVelocities(dq);
+    threadedBody->getPointMass(i)->setPositions(q);
+    threadedBody->getPointMass(i)->setVelocities(dq);
+  }
+
+  const Eigen::VectorXd q = Eigen::VectorXd::Random(serial->getNumDofs());
+  const Eigen::VectorXd dq = Eigen::VectorXd::Random(serial->getNumDofs());
+  for(const SkeletonPtr& skel : {serial, threaded})
+  {
+    skel->setPositions(q);
+    skel->setVelocities(dq);
+    skel->computeForwardDynamics();
+  }
+
+  // The threads only split the per PointMass work, so the results must not
+  // change at all
+  EXPECT_TRUE(serial->getAccelerations() == threaded->getAccelerations());
+  for(std::size_t i = 0; i < serialBody->getNumPointMasses(); ++i)
+  {
+    const PointMass* a = serialBody->getPointMass(i);
+    const PointMass* b = threadedBody->getPointMass(i);
+    EXPECT_TRUE(a->getAccelerations() == b->getAccelerations());
+    EXPECT_TRUE(a->getWorldPosition() == b->getWorldPosition());
+    EXPECT_TRUE(a->getBodyVelocity() == b->getBodyVelocity());
+  }
+
+  // The contribution of the PointMasses to the articulated inertia must match
+  // the sum of their individual contributions
+  Eigen::Matrix6d AI = serialBody->getSpatialInertia();
+  for(std::size_t i = 0; i < serialBody->getNumPointMasses(); ++i)
+  {
+    const PointMass* pm = serialBody->getPointMass(i);
+    const double pi = pm->getImplicitPi();
+    const Eigen::Matrix3d x = math::makeSkewSymmetric(pm->getLocalPosition());
+    AI.topLeftCorner<3, 3>() -= pi * x * x;
+    AI.topRightCorner<3, 3>() += pi * x;
+    AI.bottomLeftCorner<3, 3>() -= pi * x;
+    AI.bottomRightCorner<3, 3>() += pi * Eigen::Matrix3d::Identity();
+  }
+  EXPECT_TRUE(equals(AI, serialBody->getArticulatedInertiaImplicit(), 1e-10));
+}
+
+//==============================================================================
+static std::size_t findNearestPointMass(const dynamics::SoftBodyNode* _body,
+                                        const Eigen::Vector3d& _point)
+{
+  std::size_t nearest = 0;
+  double minDistance = std::numeric_limits<double>::infinity();
+  for(std::size_t i = 0; i < _body->getNumPointMasses(); ++i)
+  {
+    const double distance =
+        (_body->getPointMass(i)->getWorldPosition() - _point).squaredNorm();
+    if(distance < minDistance)
+    {
+      minDistance = distance;
+      nearest = i;
+    }
+  }
+
+  return nearest;
+}
+
+//==============================================================================
+TEST(SoftDynamics, NearestPointMass)
+{
+  using namespace dynamics;
+
+  SkeletonPtr skel = createSoftBox(Eigen::Vector3i(8, 6, 4));
+  SoftBodyNode* body = skel->getSoftBodyNode(0);
+  ASSERT_GT(body->getNumPointMasses(), 0u);
+
+  for(int trial = 0; trial < 3; ++trial)
+  {
+    if(trial == 1)
+    {
+      // Moving the body must invalidate the lookup
+      skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+    }
+    else if(trial == 2)
+    {
+      // And so must moving a single PointMass
+      body->getPointMass(0)->setPositions(Eigen::Vector3d(0.0, 0.0, 5.0));
+    }
+
+    for(int i = 0; i < 200; ++i)
+    {
+      // Query points both inside and well outside of the mesh
+      const Eigen::Vector3d point = body->getWorldTransform().translation()
+          + (i % 2 == 0 ? 0.2 : 2.0) * Eigen::Vector3d::Random();
+      const PointMass* nearest = body->getNearestPointMass(point);
+      ASSERT_NE(nearest, nullptr);
+
+      // Compare distances rather than indices in case of ties
+      const std::size_t expected = findNearestPointMass(body, point);
+      EXPECT_DOUBLE_EQ(
+            (nearest->getWorldPosition() - point).squaredNorm(),
+            (body->getPointMass(expected)->getWorldPosition()
+             - point).squaredNorm());
+    }
+  }
+
+  const SoftBodyNode* constBody = body;
+  EXPECT_EQ(constBody->getNearestPointMass(
+              body->getPointMass(3)->getWorldPosition()),
+            body->getPointMass(3));
+}
+
+//==============================================================================
+TEST(SoftDynamics, ImplicitEuler)
+{
+  using namespace dynamics;
+
+  SkeletonPtr skel = createSoftBox(Eigen::Vector3i(4, 4, 4));
+  SoftBodyNode* body = skel->getSoftBodyNode(0);
+  EXPECT_FALSE(skel->isUsingImplicitEuler());
+  EXPECT_FALSE(skel->clone()->isUsingImplicitEuler());
+
+  const double dt = skel->getTimeStep();
+  const double kv = body->getVertexSpringStiffness();
+  const double ke = body->getEdgeSpringStiffness();
+  const double kd = body->getDampingCoefficient();
+
+  skel->computeForwardDynamics();
+  for(std::size_t i = 0; i < body->getNumPointMasses(); ++i)
+  {
+    const PointMass* pm = body->getPointMass(i);
+    EXPECT_DOUBLE_EQ(pm->getImplicitPsi(),
+                     1.0 / (pm->getMass() + dt * kd + dt * dt * kv));
+  }
+
+  // Turning the mode on must invalidate the articulated inertia and fold the
+  // edge springs into the implicit terms
+  skel->setUseImplicitEuler(true);
+  EXPECT_TRUE(skel->isUsingImplicitEuler());
+  EXPECT_TRUE(skel->clone()->isUsingImplicitEuler());
+
+  skel->computeForwardDynamics();
+  for(std::size_t i = 0; i < body->getNumPointMasses(); ++i)
+  {
+    const PointMass* pm = body->getPointMass(i);
+    const double k = kv + pm->getNumConnectedPointMasses() * ke;
+    EXPECT_DOUBLE_EQ(pm->getImplicitPsi(),
+                     1.0 / (pm->getMass() + dt * kd + dt * dt * k));
+  }
+}
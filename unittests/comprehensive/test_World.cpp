@@ -40,6 +40,7 @@
 #include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/collision/collision.hpp"
+#include "dart/constraint/WeldJointConstraint.hpp"
 #if HAVE_BULLET
   #include "dart/collision/bullet/bullet.hpp"
 #endif
@@ -303,3 +304,300 @@ TEST(World, ValidatingClones)
     }
   }
 }
+
+//==============================================================================
+TEST(World, SubSteps)
+{
+  const double timeStep = 1e-3;
+  const std::size_t numSubSteps = 4u;
+
+  auto createPendulum = []()
+  {
+    SkeletonPtr pendulum = createNLinkPendulum(
+          3u, Eigen::Vector3d(0.1, 0.1, 0.5), DOF_ROLL,
+          Eigen::Vector3d(0.0, 0.0, 0.25));
+    pendulum->setPositions(Eigen::Vector3d(0.5, -0.3, 0.2));
+    return pendulum;
+  };
+
+  auto createFallingSphere = []()
+  {
+    return createSphere(0.1, Eigen::Vector3d(10.0, 0.0, 0.0));
+  };
+
+  // The pendulum runs at four times the rate of the sphere
+  WorldPtr multiRate = World::create();
+  multiRate->setTimeStep(timeStep);
+  SkeletonPtr fastPendulum = createPendulum();
+  SkeletonPtr slowSphere = createFallingSphere();
+  multiRate->addSkeleton(fastPendulum);
+  multiRate->addSkeleton(slowSphere);
+  multiRate->setNumSubSteps(fastPendulum, numSubSteps);
+  EXPECT_EQ(multiRate->getNumSubSteps(fastPendulum), numSubSteps);
+  EXPECT_EQ(multiRate->getNumSubSteps(slowSphere), 1u);
+  EXPECT_EQ(multiRate->getNumSubSteps(createFallingSphere()), 0u);
+  EXPECT_DOUBLE_EQ(fastPendulum->getTimeStep(), timeStep / numSubSteps);
+  EXPECT_DOUBLE_EQ(slowSphere->getTimeStep(), timeStep);
+
+  WorldPtr fine = World::create();
+  fine->setTimeStep(timeStep / numSubSteps);
+  SkeletonPtr pendulum = createPendulum();
+  fine->addSkeleton(pendulum);
+
+  WorldPtr coarse = World::create();
+  coarse->setTimeStep(timeStep);
+  SkeletonPtr sphere = createFallingSphere();
+  coarse->addSkeleton(sphere);
+
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    multiRate->step();
+    coarse->step();
+    for (std::size_t j = 0; j < numSubSteps; ++j)
+      fine->step();
+  }
+
+  EXPECT_NEAR(multiRate->getTime(), coarse->getTime(), 1e-12);
+  EXPECT_TRUE(equals(fastPendulum->getPositions(), pendulum->getPositions()));
+  EXPECT_TRUE(equals(fastPendulum->getVelocities(),
+                     pendulum->getVelocities()));
+  EXPECT_TRUE(equals(slowSphere->getPositions(), sphere->getPositions()));
+  EXPECT_TRUE(equals(slowSphere->getVelocities(), sphere->getVelocities()));
+
+  // Clones keep the sub-step counts
+  WorldPtr clone = multiRate->clone();
+  EXPECT_EQ(clone->getNumSubSteps(clone->getSkeleton(0)), numSubSteps);
+  EXPECT_EQ(clone->getNumSubSteps(clone->getSkeleton(1)), 1u);
+}
+
+//==============================================================================
+TEST(World, SubStepsInContact)
+{
+  const double timeStep = 1e-3;
+  const std::size_t numSubSteps = 4u;
+  const Eigen::Vector3d slowSize(0.4, 0.4, 0.2);
+  const Eigen::Vector3d fastSize(0.2, 0.2, 0.2);
+  const Eigen::Vector3d slowPosition(0.0, 0.0, 0.15 - 5e-5);
+  const Eigen::Vector3d fastPosition(0.0, 0.0, 0.35 - 5e-5);
+
+  // A box that runs four times as fast as the box it rests on, which in turn
+  // rests on the ground. Both start slightly sunk in, so the error reduction
+  // pushes them out at a speed that depends on the constraint time step
+  WorldPtr world = World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+  world->setTimeStep(timeStep);
+
+  SkeletonPtr ground = createGround(Eigen::Vector3d(10.0, 10.0, 0.1));
+  SkeletonPtr slowBox = createBox(slowSize, slowPosition);
+  SkeletonPtr fastBox = createBox(fastSize, fastPosition);
+  world->addSkeleton(ground);
+  world->addSkeleton(slowBox);
+  world->addSkeleton(fastBox);
+  world->setNumSubSteps(fastBox, numSubSteps);
+
+  // The same boxes on the ground at a single rate
+  WorldPtr reference = World::create();
+  reference->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+  reference->setTimeStep(timeStep);
+  SkeletonPtr referenceBox = createBox(slowSize, slowPosition);
+  reference->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  reference->addSkeleton(referenceBox);
+  reference->addSkeleton(createBox(fastSize, fastPosition));
+
+  double maxError = 0.0;
+  for (std::size_t i = 0; i < 500; ++i)
+  {
+    world->step();
+    reference->step();
+
+    maxError = std::max(maxError, std::abs(
+        slowBox->getPositions()[5] - referenceBox->getPositions()[5]));
+  }
+
+  // Each box is solved for its own sub-step, so the slow box is pushed out as
+  // fast as it is at a single rate rather than four times as fast
+  EXPECT_LT(maxError, 5e-6);
+  EXPECT_NEAR(slowBox->getPositions()[5], 0.15, 1e-3);
+  EXPECT_NEAR(fastBox->getPositions()[5], 0.35, 1e-3);
+  EXPECT_LT(slowBox->getVelocities().norm(), 1e-2);
+  EXPECT_LT(fastBox->getVelocities().norm(), 1e-2);
+}
+
+//==============================================================================
+TEST(World, AdaptiveTimeStep)
+{
+  const double timeStep = 1e-2;
+  const double minTimeStep = 1e-4;
+
+  WorldPtr world = World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+  world->setTimeStep(timeStep);
+  world->setAdaptiveTimeStep(true, 1e-3, minTimeStep);
+  EXPECT_TRUE(world->isUsingAdaptiveTimeStep());
+  EXPECT_TRUE(world->clone()->isUsingAdaptiveTimeStep());
+
+  SkeletonPtr ground = createGround(Eigen::Vector3d(10.0, 10.0, 0.1));
+  SkeletonPtr sphere = createSphere(0.1, Eigen::Vector3d(0.0, 0.0, 0.5));
+  Eigen::Vector6d velocity = Eigen::Vector6d::Zero();
+  velocity[5] = -5.0;
+  sphere->setVelocities(velocity);
+  world->addSkeleton(ground);
+  world->addSkeleton(sphere);
+
+  // The sphere hits the ground at a speed that makes the nominal time step
+  // penetrate far too deep
+  double elapsed = 0.0;
+  double shortest = timeStep;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    const double current = world->getCurrentTimeStep();
+    EXPECT_LE(current, timeStep);
+    EXPECT_GE(current, minTimeStep);
+    shortest = std::min(shortest, current);
+    elapsed += current;
+
+    world->step();
+  }
+
+  EXPECT_LT(shortest, timeStep);
+  EXPECT_NEAR(world->getTime(), elapsed, 1e-12);
+  EXPECT_GT(sphere->getPositions()[5], 0.0);
+
+  world->setAdaptiveTimeStep(false);
+  EXPECT_EQ(world->getCurrentTimeStep(), timeStep);
+  EXPECT_EQ(sphere->getTimeStep(), timeStep);
+}
+
+//==============================================================================
+TEST(World, Sleeping)
+{
+  const std::size_t numStepsToSleep = 20u;
+
+  WorldPtr world = World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+  world->setSleepingEnabled(true, 1e-4, numStepsToSleep);
+  EXPECT_TRUE(world->isSleepingEnabled());
+  EXPECT_TRUE(world->clone()->isSleepingEnabled());
+
+  SkeletonPtr ground = createGround(Eigen::Vector3d(10.0, 10.0, 0.1));
+  SkeletonPtr box = createBox(Eigen::Vector3d(0.2, 0.2, 0.2),
+                              Eigen::Vector3d(0.0, 0.0, 0.2));
+  world->addSkeleton(ground);
+  world->addSkeleton(box);
+
+  // The box settles on the ground and falls asleep
+  for (std::size_t i = 0; i < 1000 && !world->isSleeping(box); ++i)
+    world->step();
+  ASSERT_TRUE(world->isSleeping(box));
+  EXPECT_FALSE(world->isSleeping(ground));
+  EXPECT_TRUE(box->getVelocities().isZero(0.0));
+
+  const Eigen::VectorXd restingPositions = box->getPositions();
+  for (std::size_t i = 0; i < numStepsToSleep; ++i)
+    world->step();
+  EXPECT_TRUE(world->isSleeping(box));
+  EXPECT_TRUE(box->getPositions() == restingPositions);
+
+  // An external force wakes it up
+  box->getBodyNode(0)->addExtForce(Eigen::Vector3d(0.0, 0.0, 100.0));
+  world->step();
+  EXPECT_FALSE(world->isSleeping(box));
+  EXPECT_GT(box->getPositions()[5], restingPositions[5]);
+
+  // So does a sphere that drops onto it
+  for (std::size_t i = 0; i < 1000 && !world->isSleeping(box); ++i)
+    world->step();
+  ASSERT_TRUE(world->isSleeping(box));
+
+  SkeletonPtr sphere = createSphere(0.1, Eigen::Vector3d(0.0, 0.0, 0.5));
+  Eigen::Vector6d velocity = Eigen::Vector6d::Zero();
+  velocity[5] = -2.0;
+  sphere->setVelocities(velocity);
+  world->addSkeleton(sphere);
+
+  bool woken = false;
+  for (std::size_t i = 0; i < 500 && !woken; ++i)
+  {
+    world->step();
+    woken = !world->isSleeping(box);
+  }
+  EXPECT_TRUE(woken);
+
+  // Turning sleeping off wakes everything up
+  for (std::size_t i = 0; i < 1000 && !world->isSleeping(box); ++i)
+    world->step();
+  world->setSleepingEnabled(false);
+  EXPECT_FALSE(world->isSleeping(box));
+  EXPECT_FALSE(world->isSleeping(sphere));
+}
+
+//==============================================================================
+TEST(World, SleepingIslands)
+{
+  const std::size_t numStepsToSleep = 20u;
+
+  WorldPtr world = World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+  world->setSleepingEnabled(true, 1e-4, numStepsToSleep);
+
+  SkeletonPtr ground = createGround(Eigen::Vector3d(10.0, 10.0, 0.1));
+  SkeletonPtr bottom = createBox(Eigen::Vector3d(0.2, 0.2, 0.2),
+                                 Eigen::Vector3d(0.0, 0.0, 0.15));
+  SkeletonPtr top = createBox(Eigen::Vector3d(0.2, 0.2, 0.2),
+                              Eigen::Vector3d(0.0, 0.0, 0.35));
+  SkeletonPtr welded = createBox(Eigen::Vector3d(0.2, 0.2, 0.2),
+                                 Eigen::Vector3d(1.0, 0.0, 0.5));
+  SkeletonPtr support = createBox(Eigen::Vector3d(0.2, 0.2, 0.2),
+                                  Eigen::Vector3d(1.0, 0.0, 0.15));
+  world->addSkeleton(ground);
+  world->addSkeleton(bottom);
+  world->addSkeleton(top);
+  world->addSkeleton(welded);
+  world->addSkeleton(support);
+
+  // The welded box hangs off the support without touching it
+  world->getConstraintSolver()->addConstraint(
+      std::make_shared<constraint::WeldJointConstraint>(
+        welded->getBodyNode(0), support->getBodyNode(0)));
+
+  auto isAsleep = [&]()
+  {
+    return world->isSleeping(bottom) && world->isSleeping(top)
+        && world->isSleeping(welded) && world->isSleeping(support);
+  };
+
+  for (std::size_t i = 0; i < 1000 && !isAsleep(); ++i)
+    world->step();
+  ASSERT_TRUE(isAsleep());
+
+  // Waking up a Skeleton wakes up the Skeletons that are stacked on it or
+  // constrained to it, but not the other islands
+  world->wakeUp(bottom);
+  EXPECT_FALSE(world->isSleeping(bottom));
+  EXPECT_FALSE(world->isSleeping(top));
+  EXPECT_TRUE(world->isSleeping(welded));
+  EXPECT_TRUE(world->isSleeping(support));
+
+  world->wakeUp(support);
+  EXPECT_FALSE(world->isSleeping(welded));
+  EXPECT_FALSE(world->isSleeping(support));
+
+  // Removing a sleeping Skeleton wakes up the Skeletons it held up
+  for (std::size_t i = 0; i < 1000 && !isAsleep(); ++i)
+    world->step();
+  ASSERT_TRUE(isAsleep());
+
+  world->removeSkeleton(bottom);
+  EXPECT_FALSE(world->isSleeping(top));
+  EXPECT_TRUE(world->isSleeping(welded));
+
+  const double height = top->getPositions()[5];
+  for (std::size_t i = 0; i < 10; ++i)
+    world->step();
+  EXPECT_LT(top->getPositions()[5], height);
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2011-2018, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dart/external/odelcpsolver/lcp.h"
+#include "dart/external/odelcpsolver/matrix.h"
+#include "dart/external/odelcpsolver/simd.h"
+#include "dart/math/Helpers.hpp"
+
+//==============================================================================
+/// Restores the kernels that were selected before a test changed them
+class SimdLevelGuard
+{
+public:
+  SimdLevelGuard() : mLevel(dGetSimdLevel()) {}
+  ~SimdLevelGuard() { dSetSimdLevel(mLevel); }
+
+private:
+  int mLevel;
+};
+
+//==============================================================================
+/// Random n x n unit lower triangular matrix stored by rows with the leading
+/// dimension that dSolveLCP() uses. The off-diagonal entries of row i are
+/// scaled by 1/i to keep large solves well conditioned. The strict upper part
+/// is filled with garbage to make sure the kernels do not read it.
+static std::vector<dReal> randomUnitLowerTriangular(int n, int nskip)
+{
+  std::vector<dReal> L(static_cast<std::size_t>(n*nskip));
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; j < nskip; ++j)
+    {
+      dReal& value = L[static_cast<std::size_t>(i*nskip + j)];
+      if (j < i)
+        value = dart::math::random(-0.5, 0.5) / i;
+      else if (j == i)
+        value = 1.0;
+      else
+        value = 1e+10;
+    }
+  }
+
+  return L;
+}
+
+//==============================================================================
+static std::vector<dReal> randomVector(int n)
+{
+  std::vector<dReal> v(static_cast<std::size_t>(n));
+  for (dReal& value : v)
+    value = dart::math::random(-1.0, 1.0);
+
+  return v;
+}
+
+//==============================================================================
+TEST(DantzigLCP, SimdKernels)
+{
+  SimdLevelGuard guard;
+
+  // Small problems are dispatched to the scalar kernels, so also check sizes
+  // around the thresholds where the AVX2 and AVX-512 kernels take over.
+  std::vector<int> sizes;
+  for (int n = 0; n < 40; ++n)
+    sizes.push_back(n);
+  for (int n : {127, 128, 129, 131, 255, 256, 257, 263, 511, 512, 513, 519})
+    sizes.push_back(n);
+
+  for (int level = dSimdLevelScalar + 1; level <= dGetMaxSimdLevel(); ++level)
+  {
+    for (const int n : sizes)
+    {
+      const int nskip = dPAD(n);
+      const std::vector<dReal> L = randomUnitLowerTriangular(n, nskip);
+      const std::vector<dReal> a = randomVector(n);
+      const std::vector<dReal> b = randomVector(n);
+
+      std::vector<dReal> x1 = b;
+      std::vector<dReal> x2 = b;
+      std::vector<dReal> y1 = b;
+      std::vector<dReal> y2 = b;
+
+      dSetSimdLevel(dSimdLevelScalar);
+      const dReal dot1 = dDot(a.data(), b.data(), n);
+      dSolveL1(L.data(), x1.data(), n, nskip);
+      dSolveL1T(L.data(), y1.data(), n, nskip);
+
+      EXPECT_EQ(dSetSimdLevel(level), level);
+      const dReal dot2 = dDot(a.data(), b.data(), n);
+      dSolveL1(L.data(), x2.data(), n, nskip);
+      dSolveL1T(L.data(), y2.data(), n, nskip);
+
+      EXPECT_NEAR(dot1, dot2, 1e-12 * (1 + n))
+          << dGetSimdLevelName(level) << ", n=" << n;
+      for (int i = 0; i < n; ++i)
+      {
+        EXPECT_NEAR(x1[i], x2[i], 1e-9 * (1.0 + std::abs(x1[i])))
+            << dGetSimdLevelName(level) << ", n=" << n << ", i=" << i;
+        EXPECT_NEAR(y1[i], y2[i], 1e-9 * (1.0 + std::abs(y1[i])))
+            << dGetSimdLevelName(level) << ", n=" << n << ", i=" << i;
+      }
+    }
+  }
+
+  // Levels the CPU does not support fall back to the widest supported one
+  EXPECT_EQ(dSetSimdLevel(dSimdLevelAVX512 + 1), dGetMaxSimdLevel());
+  EXPECT_EQ(dGetSimdLevel(), dGetMaxSimdLevel());
+}
+
+//==============================================================================
+TEST(DantzigLCP, SimdSolveLCP)
+{
+  SimdLevelGuard guard;
+
+  // Frictional contact LCP: one normal and two friction directions per contact
+  const int numContacts = 20;
+  const int n = 3*numContacts;
+  const int nskip = dPAD(n);
+  const int numDofs = 30;
+
+  std::vector<dReal> J(static_cast<std::size_t>(n*numDofs));
+  for (dReal& value : J)
+    value = dart::math::random(-1.0, 1.0);
+
+  std::vector<dReal> A(static_cast<std::size_t>(n*nskip), 0.0);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      A[i*nskip + j] = dDot(&J[i*numDofs], &J[j*numDofs], numDofs);
+      if (i == j)
+        A[i*nskip + j] += 1e-4;
+    }
+  }
+
+  std::vector<dReal> b = randomVector(n);
+  std::vector<dReal> lo(static_cast<std::size_t>(n));
+  std::vector<dReal> hi(static_cast<std::size_t>(n));
+  std::vector<int> findex(static_cast<std::size_t>(n));
+  for (int i = 0; i < numContacts; ++i)
+  {
+    lo[3*i] = 0.0;
+    hi[3*i] = dInfinity;
+    findex[3*i] = -1;
+    for (int j = 1; j < 3; ++j)
+    {
+      lo[3*i + j] = -0.5;
+      hi[3*i + j] = 0.5;
+      findex[3*i + j] = 3*i;
+    }
+  }
+
+  std::vector<std::vector<dReal>> solutions;
+  for (int level = dSimdLevelScalar; level <= dGetMaxSimdLevel(); ++level)
+  {
+    EXPECT_EQ(dSetSimdLevel(level), level);
+
+    // dSolveLCP() overwrites its inputs
+    std::vector<dReal> A2 = A;
+    std::vector<dReal> b2 = b;
+    std::vector<dReal> lo2 = lo;
+    std::vector<dReal> hi2 = hi;
+    std::vector<int> findex2 = findex;
+    std::vector<dReal> x(static_cast<std::size_t>(n), 0.0);
+    std::vector<dReal> w(static_cast<std::size_t>(n), 0.0);
+    dSolveLCP(n, A2.data(), x.data(), b2.data(), w.data(), 0, lo2.data(),
+              hi2.data(), findex2.data());
+
+    solutions.push_back(x);
+  }
+
+  for (std::size_t level = 1; level < solutions.size(); ++level)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      EXPECT_NEAR(solutions[0][i], solutions[level][i], 1e-8)
+          << dGetSimdLevelName(static_cast<int>(level)) << ", i=" << i;
+    }
+  }
+}
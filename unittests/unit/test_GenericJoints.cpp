@@ -106,6 +106,10 @@ public:
       const Vector& /*positions*/) const override
   { return JacobianMatrix(); }
 
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Vector& /*positions*/) const override
+  { return Eigen::Isometry3d::Identity(); }
+
 protected:
   // Documentation inherited
   Joint* clone() const override { return nullptr; }
@@ -148,6 +152,10 @@ public:
       const Vector& /*positions*/) const override
   { return JacobianMatrix(); }
 
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Vector& /*positions*/) const override
+  { return Eigen::Isometry3d::Identity(); }
+
 protected:
   // Documentation inherited
   Joint* clone() const override { return nullptr; }
@@ -190,6 +198,10 @@ public:
       const Vector& /*positions*/) const override
   { return JacobianMatrix(); }
 
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Vector& /*positions*/) const override
+  { return Eigen::Isometry3d::Identity(); }
+
 protected:
   // Documentation inherited
   Joint* clone() const override { return nullptr; }
@@ -215,3 +227,51 @@ TEST(GenericJoint, Basic)
   MultiDofJointTest genericJoint;
   SO3JointTest so3Joint;
 }
+
+//==============================================================================
+template <int NumDofs>
+void testKernels(const Eigen::Matrix<double, 6, NumDofs>& J)
+{
+  using Kernels = dynamics::detail::GenericJointKernels<NumDofs>;
+  using Matrix = Eigen::Matrix<double, NumDofs, NumDofs>;
+  using Vector = Eigen::Matrix<double, NumDofs, 1>;
+
+  const Eigen::Matrix6d R = Eigen::Matrix6d::Random();
+  const Eigen::Matrix6d AI
+      = R * R.transpose() + Eigen::Matrix6d::Identity();
+  const Eigen::Vector6d v = Eigen::Vector6d::Random();
+  const Vector x = Vector::Random();
+
+  const Matrix projAI = J.transpose() * AI * J;
+  EXPECT_TRUE(equals(Kernels::projectInertia(AI, J), projAI));
+
+  const Matrix invProjAI = projAI.inverse();
+  const Eigen::Matrix6d PI
+      = AI - AI * J * invProjAI * J.transpose() * AI;
+  Eigen::Matrix6d result;
+  Kernels::complementInertia(result, AI, J, invProjAI);
+  EXPECT_TRUE(equals(result, PI));
+
+  const Vector force = J.transpose() * AI * v;
+  EXPECT_TRUE(equals(Kernels::projectForce(AI, J, v), force));
+
+  const Eigen::Vector6d AIJx = AI * J * x;
+  EXPECT_TRUE(equals(Kernels::multiplyInertia(AI, J, x), AIJx));
+}
+
+//==============================================================================
+TEST(GenericJoint, Kernels)
+{
+  // Single DOF: dense, revolute about the child frame, and prismatic
+  Eigen::Vector6d S = Eigen::Vector6d::Random();
+  testKernels<1>(S);
+  S.tail<3>().setZero();
+  testKernels<1>(S);
+  S = Eigen::Vector6d::Random();
+  S.head<3>().setZero();
+  testKernels<1>(S);
+
+  // Ball and free joints
+  testKernels<3>(Eigen::Matrix<double, 6, 3>::Random());
+  testKernels<6>(Eigen::Matrix6d::Random());
+}
@@ -180,6 +180,101 @@ TEST(Lemke, Lemke_12D)
   EXPECT_TRUE(dart::lcpsolver::validate(A,(*f),b));
 }
 
+//==============================================================================
+static void createRandomLCP(
+    int n, Eigen::MatrixXd& A, Eigen::VectorXd& b, unsigned int seed)
+{
+  std::srand(seed);
+  const Eigen::MatrixXd J = Eigen::MatrixXd::Random(n, n);
+  A = J * J.transpose() + 0.1 * Eigen::MatrixXd::Identity(n, n);
+  b = Eigen::VectorXd::Random(n);
+}
+
+//==============================================================================
+TEST(Lemke, LemkeSolverMatchesLemke)
+{
+  Eigen::MatrixXd A;
+  Eigen::VectorXd b;
+  createRandomLCP(30, A, b, 0u);
+
+  // Force several refactorizations along the way
+  dart::lcpsolver::LemkeSolver solver(
+      dart::lcpsolver::LemkeSolver::Options(false, false, 1000, 3));
+
+  Eigen::VectorXd f;
+  Eigen::VectorXd expected;
+  EXPECT_EQ(solver.solve(A, b, &f), 0);
+  EXPECT_EQ(dart::lcpsolver::Lemke(A, b, &expected), 0);
+  EXPECT_TRUE(dart::lcpsolver::validate(A, f, b));
+  EXPECT_TRUE(equals(f, expected, 1e-6));
+  EXPECT_GT(solver.getNumFactorizations(), 1);
+}
+
+//==============================================================================
+TEST(Lemke, LemkeSolverWarmStart)
+{
+  Eigen::MatrixXd A;
+  Eigen::VectorXd b;
+  createRandomLCP(30, A, b, 1u);
+
+  dart::lcpsolver::LemkeSolver solver;
+  Eigen::VectorXd f;
+  EXPECT_EQ(solver.solve(A, b, &f), 0);
+  EXPECT_FALSE(solver.isWarmStarted());
+  const int coldPivots = solver.getNumPivots();
+  EXPECT_GT(coldPivots, 0);
+
+  // A nearby problem should be solved from the previous basis
+  b += 1e-3 * Eigen::VectorXd::Random(b.size());
+  EXPECT_EQ(solver.solve(A, b, &f), 0);
+  EXPECT_TRUE(solver.isWarmStarted());
+  EXPECT_LT(solver.getNumPivots(), coldPivots);
+  EXPECT_TRUE(dart::lcpsolver::validate(A, f, b));
+
+  // A completely different problem must still be solved correctly
+  b = Eigen::VectorXd::Random(b.size());
+  EXPECT_EQ(solver.solve(A, b, &f), 0);
+  EXPECT_TRUE(dart::lcpsolver::validate(A, f, b));
+}
+
+//==============================================================================
+TEST(Lemke, LemkeSolverBlocks)
+{
+  Eigen::MatrixXd A1, A2;
+  Eigen::VectorXd b1, b2;
+  createRandomLCP(6, A1, b1, 2u);
+  createRandomLCP(6, A2, b2, 3u);
+
+  // Interleave the two blocks so that the splitting has to find them
+  const int n = 12;
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(n, n);
+  Eigen::VectorXd b(n);
+  std::vector<int> index1, index2;
+  for (int i = 0; i < n; ++i)
+    (i % 2 == 0 ? index1 : index2).push_back(i);
+
+  for (int i = 0; i < 6; ++i)
+  {
+    b[index1[i]] = b1[i];
+    b[index2[i]] = b2[i];
+    for (int j = 0; j < 6; ++j)
+    {
+      A(index1[i], index1[j]) = A1(i, j);
+      A(index2[i], index2[j]) = A2(i, j);
+    }
+  }
+
+  dart::lcpsolver::LemkeSolver solver(
+      dart::lcpsolver::LemkeSolver::Options(true, true));
+  Eigen::VectorXd f;
+  EXPECT_EQ(solver.solve(A, b, &f), 0);
+  EXPECT_TRUE(dart::lcpsolver::validate(A, f, b));
+
+  Eigen::VectorXd expected;
+  EXPECT_EQ(dart::lcpsolver::Lemke(A, b, &expected), 0);
+  EXPECT_TRUE(equals(f, expected, 1e-6));
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
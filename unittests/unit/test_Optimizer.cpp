@@ -43,8 +43,11 @@
 #include "dart/optimizer/Function.hpp"
 #include "dart/optimizer/Problem.hpp"
 #include "dart/optimizer/GradientDescentSolver.hpp"
+#include "dart/optimizer/LevenbergMarquardtSolver.hpp"
+#include "dart/optimizer/ResidualFunction.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/InverseKinematics.hpp"
 #if HAVE_NLOPT
   #include "dart/optimizer/nlopt/NloptSolver.hpp"
@@ -142,6 +145,90 @@ TEST(Optimizer, GradientDescent)
   EXPECT_NEAR(optX[1], 0.0, solver.getTolerance());
 }
 
+//==============================================================================
+/// Rosenbrock function written as the residuals (10*(x1-x0^2), 1-x0)
+class RosenbrockResidual : public ResidualFunction
+{
+public:
+  /// Constructor
+  RosenbrockResidual(bool _analytical) : mAnalytical(_analytical) {}
+
+  /// \copydoc ResidualFunction::getResidualDimension
+  std::size_t getResidualDimension() const override
+  {
+    return 2u;
+  }
+
+  /// \copydoc ResidualFunction::evalResidual
+  void evalResidual(const Eigen::VectorXd& _x,
+                    Eigen::Map<Eigen::VectorXd> _residual) const override
+  {
+    _residual[0] = 10.0*(_x[1] - _x[0]*_x[0]);
+    _residual[1] = 1.0 - _x[0];
+  }
+
+  /// \copydoc ResidualFunction::evalResidualJacobian
+  void evalResidualJacobian(
+      const Eigen::VectorXd& _x,
+      Eigen::Map<Eigen::MatrixXd> _jacobian) const override
+  {
+    if(!mAnalytical)
+    {
+      ResidualFunction::evalResidualJacobian(_x, _jacobian);
+      return;
+    }
+
+    _jacobian << -20.0*_x[0], 10.0,
+                 -1.0,        0.0;
+  }
+
+private:
+  /// True if the analytical Jacobian should be used
+  bool mAnalytical;
+};
+
+//==============================================================================
+TEST(Optimizer, LevenbergMarquardt)
+{
+  for(const bool analytical : {true, false})
+  {
+    std::shared_ptr<Problem> prob = std::make_shared<Problem>(2);
+    prob->setInitialGuess(Eigen::Vector2d(-1.2, 1.0));
+    prob->setObjective(std::make_shared<RosenbrockResidual>(analytical));
+
+    LevenbergMarquardtSolver solver(prob);
+    EXPECT_TRUE(solver.solve());
+
+    const Eigen::VectorXd optX = prob->getOptimalSolution();
+    EXPECT_NEAR(optX[0], 1.0, 1e-6);
+    EXPECT_NEAR(optX[1], 1.0, 1e-6);
+    EXPECT_NEAR(prob->getOptimumValue(), 0.0, 1e-12);
+
+    const LevenbergMarquardtSolver::Statistics& stats =
+        solver.getLastStatistics();
+    EXPECT_LT(stats.mNumIterations, 100u);
+    EXPECT_EQ(stats.mNumIterations,
+              stats.mNumAcceptedSteps + stats.mNumRejectedSteps);
+    EXPECT_GT(stats.mInitialCost, stats.mFinalCost);
+  }
+
+  // The unconstrained minimum is outside of these bounds, so the solution
+  // should end up on the boundary at x0 = 0.5, where the best x1 is 0.25
+  std::shared_ptr<Problem> prob = std::make_shared<Problem>(2);
+  prob->setInitialGuess(Eigen::Vector2d(-1.2, 1.0));
+  prob->setUpperBounds(Eigen::Vector2d(0.5, HUGE_VAL));
+  prob->setObjective(std::make_shared<RosenbrockResidual>(true));
+
+  LevenbergMarquardtSolver solver(prob);
+  EXPECT_TRUE(solver.solve());
+
+  const Eigen::VectorXd optX = prob->getOptimalSolution();
+  EXPECT_DOUBLE_EQ(optX[0], 0.5);
+  EXPECT_NEAR(optX[1], 0.25, 1e-6);
+  EXPECT_NE(solver.getLastStatistics().mTermination,
+            LevenbergMarquardtSolver::SMALL_RESIDUAL);
+}
+
 //==============================================================================
 #if HAVE_NLOPT
 TEST(Optimizer, BasicNlopt)
@@ -243,6 +330,46 @@ TEST(Optimizer, InverseKinematics)
                      skel->getBodyNode(0)->getTransform().matrix(), 1e-8));
 }
 
+//==============================================================================
+TEST(Optimizer, InverseKinematicsLevenbergMarquardt)
+{
+  // Three revolute joints that can reach a point in their plane
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* bn = nullptr;
+  for(std::size_t i=0; i < 3; ++i)
+  {
+    RevoluteJoint::Properties joint;
+    joint.mAxis = Eigen::Vector3d::UnitY();
+    joint.mT_ParentBodyToJoint.translation() =
+        Eigen::Vector3d(0.0, 0.0, i == 0? 0.0 : 0.5);
+    bn = skel->createJointAndBodyNodePair<RevoluteJoint>(bn, joint).second;
+  }
+  skel->setPositions(Eigen::Vector3d(0.1, 0.2, 0.3));
+
+  std::shared_ptr<InverseKinematics> ik = bn->getIK(true);
+
+  // Only constrain the position, since three planar joints cannot match an
+  // arbitrary orientation as well
+  ik->getErrorMethod().setAngularBounds(
+        Eigen::Vector3d::Constant(-HUGE_VAL),
+        Eigen::Vector3d::Constant( HUGE_VAL));
+
+  Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+  tf.translation() = Eigen::Vector3d(0.6, 0.0, 0.5);
+  ik->getTarget()->setTransform(tf);
+
+  std::shared_ptr<LevenbergMarquardtSolver> solver =
+      std::make_shared<LevenbergMarquardtSolver>();
+  ik->setSolver(solver);
+  EXPECT_EQ(solver->getProblem(), ik->getProblem());
+
+  EXPECT_TRUE(ik->solve());
+  EXPECT_TRUE(equals(Eigen::Vector3d(tf.translation()),
+                     Eigen::Vector3d(bn->getWorldTransform().translation()),
+                     1e-6));
+  EXPECT_LT(solver->getLastStatistics().mNumIterations, 50u);
+}
+
 //==============================================================================
 bool compareStringAndFile(const std::string& content,
                           const std::string& fileName)